@@ -33,9 +33,27 @@
 /*
 - if sum of fwd- and bwd-propagations exceeds limit then abort
 - default values; actual ones set dynamically depending on subgraph size 
+- limits are kept per instance in 'atpg_rr->atpg_prop_limit' and
+  'atpg_rr->global_flow_prop_limit'
 */
-static unsigned int ATPG_PROPAGATION_LIMIT = 50000;
-static unsigned int GLOBAL_FLOW_PROPAGATION_LIMIT = 50000;
+#define DEFAULT_ATPG_PROPAGATION_LIMIT 50000
+#define DEFAULT_GLOBAL_FLOW_PROPAGATION_LIMIT 50000
+
+/*
+- adaptive propagation budget (default, unless '--opt-budget=static'):
+  size-based limits are scaled by a factor in 
+  ['ADAPTIVE_BUDGET_MIN_SCALE', 'ADAPTIVE_BUDGET_MAX_SCALE'] 
+- success rate of a call is number of nodes deleted per 1000 propagations,
+  averaged with weight 'ADAPTIVE_BUDGET_DECAY' of the latest call and
+  starting at 'ADAPTIVE_BUDGET_MIN_YIELD'
+- time share is checked only after 'ADAPTIVE_BUDGET_MIN_ELAPSED' seconds
+*/
+#define ADAPTIVE_BUDGET_MIN_SCALE (1.0 / 8)
+#define ADAPTIVE_BUDGET_MAX_SCALE 4.0
+#define ADAPTIVE_BUDGET_MIN_LIMIT 10000
+#define ADAPTIVE_BUDGET_DECAY 0.25
+#define ADAPTIVE_BUDGET_MIN_YIELD 0.1
+#define ADAPTIVE_BUDGET_MIN_ELAPSED 1.0
 
 /* 
 - disabling recommended: print detailed information 
@@ -61,6 +79,15 @@ static unsigned int GLOBAL_FLOW_PROPAGATION_LIMIT = 50000;
 #define GLOBAL_FLOW_SKIP_FAULT_NODES_NO_LIT_CHILDREN 1
 #define GLOBAL_FLOW_SKIP_FAULT_NODES_OP_CHILDREN 1
 
+/*
+- simulate "changed-subformula" on random input patterns before testing,
+  64 patterns per round packed into machine words
+- a fault whose effect reaches the root of "changed-subformula" under some
+  pattern is testable and need not be tested by propagation
+*/
+#define ATPG_SIMULATION 1
+#define ATPG_SIMULATION_ROUNDS 2
+
 /* 
 - BUGGY: IF ENABLED, ASSUMPTIONS FOR RELINKING IMPLICANTS RATHER 
    THAN COPYING  D O  N O T  HOLD ANY LONGER
@@ -108,7 +135,7 @@ static FaultNode *
 create_fault_node (ATPGRedundancyRemover * atpg_rr, Node * node)
 {
   size_t bytes = sizeof (FaultNode);
-  FaultNode *result = (FaultNode *) mem_malloc (atpg_rr->mm, bytes);
+  FaultNode *result = (FaultNode *) mem_slab_malloc (atpg_rr->mm, bytes);
   memset (result, 0, bytes);
   result->node = node;
   return result;
@@ -118,7 +145,7 @@ create_fault_node (ATPGRedundancyRemover * atpg_rr, Node * node)
 static void
 delete_fault_node (ATPGRedundancyRemover * atpg_rr, FaultNode * fault_node)
 {
-  mem_free (atpg_rr->mm, fault_node, sizeof (FaultNode));
+  mem_slab_free (atpg_rr->mm, fault_node, sizeof (FaultNode));
 }
 
 
@@ -132,6 +159,10 @@ create_atpg_redundancy_remover (MemManager *mm)
   memset (result, 0, bytes);
 
   result->mm = mm;
+  result->atpg_prop_limit = DEFAULT_ATPG_PROPAGATION_LIMIT;
+  result->global_flow_prop_limit = DEFAULT_GLOBAL_FLOW_PROPAGATION_LIMIT;
+  result->budget.scale = 1;
+  result->budget.yield = ADAPTIVE_BUDGET_MIN_YIELD;
 
   result->subformula_vars = create_stack (mm, DEFAULT_STACK_SIZE);
   result->fault_queue = create_queue (mm, DEFAULT_QUEUE_SIZE);
@@ -145,8 +176,9 @@ create_atpg_redundancy_remover (MemManager *mm)
 
 
 static void
-reset_atpg_redundancy_remover (ATPGRedundancyRemover * atpg_rr)
+reset_atpg_redundancy_remover (Nenofex * nenofex)
 {
+  ATPGRedundancyRemover *atpg_rr = nenofex->atpg_rr;
   reset_queue (atpg_rr->fault_queue);
   reset_queue (atpg_rr->propagation_queue);
 
@@ -187,7 +219,7 @@ reset_atpg_redundancy_remover (ATPGRedundancyRemover * atpg_rr)
       if (!fault_node->deleted)
         {
           Node *node = fault_node->node;
-          node->atpg_info = 0;
+          alloc_node_cold (nenofex, node)->atpg_info = 0;
         }
 
       if (atpg_info_p->atpg_ch)
@@ -248,8 +280,9 @@ free_atpg_redundancy_remover (ATPGRedundancyRemover * atpg_rr)
 	-> must maintain list of watchers
 */
 static void
-assign_node_atpg_info (ATPGRedundancyRemover * atpg_rr, Node * new_node)
+assign_node_atpg_info (Nenofex * nenofex, Node * new_node)
 {
+  ATPGRedundancyRemover *atpg_rr = nenofex->atpg_rr;
   assert (atpg_rr->end_atpg_info ==
           (atpg_rr->atpg_info_array +
            atpg_rr->byte_size_atpg_info_array / sizeof (ATPGInfo)));
@@ -260,17 +293,20 @@ assign_node_atpg_info (ATPGRedundancyRemover * atpg_rr, Node * new_node)
       exit (1);
     }
 
-  assert (!new_node->atpg_info);
-  new_node->atpg_info = atpg_rr->cur_atpg_info++;
+  assert (!node_atpg_info (nenofex, new_node));
+  alloc_node_cold (nenofex, new_node)->atpg_info = atpg_rr->cur_atpg_info++;
 
-  assert (!new_node->atpg_info->fault_node);
-  new_node->atpg_info->fault_node = create_fault_node (atpg_rr, new_node);
+  assert (!node_atpg_info (nenofex, new_node)->fault_node);
+  node_atpg_info (nenofex, new_node)->fault_node =
+    create_fault_node (atpg_rr, new_node);
 
   if (!is_literal_node (new_node))
     {                           /* average case: assign watchers for operator nodes */
-      new_node->atpg_info->watcher = new_node->child_list.first;
-      new_node->atpg_info->unassigned_ch_cnt = new_node->num_children;
-      assert (!new_node->atpg_info->atpg_ch);
+      node_atpg_info (nenofex, new_node)->watcher =
+        node_at (nenofex, new_node->child_list.first);
+      node_atpg_info (nenofex, new_node)->unassigned_ch_cnt =
+        new_node->num_children;
+      assert (!node_atpg_info (nenofex, new_node)->atpg_ch);
     }
 }
 
@@ -288,10 +324,10 @@ init_subformula_atpg_info (Nenofex * nenofex)
 
   assert (root);
   assert (!is_literal_node (root));
-  assert (!root->atpg_info);
+  assert (!node_atpg_info (nenofex, root));
 
-  assign_node_atpg_info (atpg_rr, root);
-  ATPGInfo *root_atpg_info = root->atpg_info;
+  assign_node_atpg_info (nenofex, root);
+  ATPGInfo *root_atpg_info = node_atpg_info (nenofex, root);
 
   Stack *stack = create_stack (atpg_rr->mm, DEFAULT_STACK_SIZE);
 
@@ -301,26 +337,29 @@ init_subformula_atpg_info (Nenofex * nenofex)
 
   if (count_stack (stack) < root->num_children)
     {                           /* not all children participate in global-flow/atpg -> collect on stack */
-      root->atpg_info->atpg_ch = create_stack (atpg_rr->mm, DEFAULT_STACK_SIZE);
+      node_atpg_info (nenofex, root)->atpg_ch =
+        create_stack (atpg_rr->mm, DEFAULT_STACK_SIZE);
     }
 
   Node *cur;
   while ((cur = pop_stack (stack)))
     {
-      assert (!cur->atpg_info);
+      assert (!node_atpg_info (nenofex, cur));
 
-      assign_node_atpg_info (atpg_rr, cur);
+      assign_node_atpg_info (nenofex, cur);
 
       /* NOTE: this could/should be done outside while-loop -> wasting check */
-      if (root_atpg_info->atpg_ch && cur->parent == root)
+      if (root_atpg_info->atpg_ch && node_at (nenofex, cur->parent) == root)
         {
-          push_stack (atpg_rr->mm, root_atpg_info->atpg_ch, cur->atpg_info->fault_node);
+          push_stack (atpg_rr->mm, root_atpg_info->atpg_ch,
+                      node_atpg_info (nenofex, cur)->fault_node);
         }
 
       if (!is_literal_node (cur))
         {
           Node *ch;
-          for (ch = cur->child_list.last; ch; ch = ch->level_link.prev)
+          for (ch = node_at (nenofex, cur->child_list.last); ch;
+               ch = node_at (nenofex, ch->level_link.prev))
             push_stack (atpg_rr->mm, stack, ch);
         }
       else
@@ -342,9 +381,11 @@ init_subformula_atpg_info (Nenofex * nenofex)
 
           /* need to collect proxy occs, because must check for deleted occs */
           if (cur->lit->negated)
-            push_stack (atpg_rr->mm, var->subformula_neg_occs, cur->atpg_info->fault_node);
+            push_stack (atpg_rr->mm, var->subformula_neg_occs,
+                        node_atpg_info (nenofex, cur)->fault_node);
           else
-            push_stack (atpg_rr->mm, var->subformula_pos_occs, cur->atpg_info->fault_node);
+            push_stack (atpg_rr->mm, var->subformula_pos_occs,
+                        node_atpg_info (nenofex, cur)->fault_node);
         }
     }                           /* end: while stack not empty */
 
@@ -360,7 +401,8 @@ init_subformula_atpg_info (Nenofex * nenofex)
     }
   else
     {
-      assert (root_atpg_info->watcher == root->child_list.first);
+      assert (root_atpg_info->watcher ==
+              node_at (nenofex, root->child_list.first));
       assert (root_atpg_info->unassigned_ch_cnt == root->num_children);
     }
 
@@ -378,8 +420,8 @@ collect_fault_nodes_by_dfs (Nenofex * nenofex)
   ATPGRedundancyRemover *atpg_rr = nenofex->atpg_rr;
   Queue *atpg_rr_fault_queue = atpg_rr->fault_queue;
 
-  assert (root->atpg_info);
-  assert (root->atpg_info->fault_node);
+  assert (node_atpg_info (nenofex, root));
+  assert (node_atpg_info (nenofex, root)->fault_node);
 
   Stack *stack = create_stack (atpg_rr->mm, DEFAULT_STACK_SIZE);
   collect_faults_mark (root);
@@ -392,17 +434,19 @@ collect_fault_nodes_by_dfs (Nenofex * nenofex)
   Node *cur;
   while ((cur = pop_stack (stack)))
     {
-      assert (cur->atpg_info);
-      assert (cur->atpg_info->fault_node);
+      assert (node_atpg_info (nenofex, cur));
+      assert (node_atpg_info (nenofex, cur)->fault_node);
 
       if (is_literal_node (cur))
-        enqueue (atpg_rr->mm, atpg_rr_fault_queue, cur->atpg_info->fault_node);
+        enqueue (atpg_rr->mm, atpg_rr_fault_queue,
+                 node_atpg_info (nenofex, cur)->fault_node);
       else
         {
           if (collect_faults_marked (cur))
             {
               collect_faults_unmark (cur);
-              enqueue (atpg_rr->mm, atpg_rr_fault_queue, cur->atpg_info->fault_node);
+              enqueue (atpg_rr->mm, atpg_rr_fault_queue,
+                       node_atpg_info (nenofex, cur)->fault_node);
             }
           else                  /* mark and visit children */
             {
@@ -410,7 +454,8 @@ collect_fault_nodes_by_dfs (Nenofex * nenofex)
               push_stack (atpg_rr->mm, stack, cur);
 
               Node *ch;
-              for (ch = cur->child_list.last; ch; ch = ch->level_link.prev)
+              for (ch = node_at (nenofex, cur->child_list.last); ch;
+                   ch = node_at (nenofex, ch->level_link.prev))
                 push_stack (atpg_rr->mm, stack, ch);
             }
         }
@@ -430,11 +475,12 @@ collect_fault_nodes_by_bfs (Nenofex * nenofex)
   ATPGRedundancyRemover *atpg_rr = nenofex->atpg_rr;
   Queue *atpg_rr_fault_queue = atpg_rr->fault_queue;
 
-  assert (root->atpg_info);
-  assert (root->atpg_info->fault_node);
+  assert (node_atpg_info (nenofex, root));
+  assert (node_atpg_info (nenofex, root)->fault_node);
 
   Queue *queue = create_queue (atpg_rr->mm, DEFAULT_QUEUE_SIZE);
-  enqueue (atpg_rr->mm, atpg_rr_fault_queue, root->atpg_info->fault_node);
+  enqueue (atpg_rr->mm, atpg_rr_fault_queue,
+           node_atpg_info (nenofex, root)->fault_node);
 
   Node **ch, *child;
   for (ch = nenofex->changed_subformula.children; (child = *ch); ch++)
@@ -443,15 +489,17 @@ collect_fault_nodes_by_bfs (Nenofex * nenofex)
   Node *cur;
   while ((cur = dequeue (queue)))
     {
-      assert (cur->atpg_info);
-      assert (cur->atpg_info->fault_node);
+      assert (node_atpg_info (nenofex, cur));
+      assert (node_atpg_info (nenofex, cur)->fault_node);
 
-      enqueue (atpg_rr->mm, atpg_rr_fault_queue, cur->atpg_info->fault_node);
+      enqueue (atpg_rr->mm, atpg_rr_fault_queue,
+               node_atpg_info (nenofex, cur)->fault_node);
 
       if (!is_literal_node (cur))
         {
           Node *ch;
-          for (ch = cur->child_list.first; ch; ch = ch->level_link.next)
+          for (ch = node_at (nenofex, cur->child_list.first); ch;
+               ch = node_at (nenofex, ch->level_link.next))
             enqueue (atpg_rr->mm, queue, ch);
         }
 
@@ -472,12 +520,13 @@ collect_fault_nodes_bottom_up (Nenofex * nenofex)
   ATPGRedundancyRemover *atpg_rr = nenofex->atpg_rr;
   Queue *atpg_rr_fault_queue = atpg_rr->fault_queue;
 
-  assert (root->atpg_info);
-  assert (root->atpg_info->fault_node);
+  assert (node_atpg_info (nenofex, root));
+  assert (node_atpg_info (nenofex, root)->fault_node);
 
   Queue *queue = create_queue (atpg_rr->mm, DEFAULT_QUEUE_SIZE);
   Stack *fault_stack = create_stack (atpg_rr->mm, DEFAULT_STACK_SIZE);
-  push_stack (atpg_rr->mm, fault_stack, root->atpg_info->fault_node);
+  push_stack (atpg_rr->mm, fault_stack,
+              node_atpg_info (nenofex, root)->fault_node);
 
   Node **ch, *child;
   for (ch = nenofex->changed_subformula.children; (child = *ch); ch++)
@@ -488,20 +537,23 @@ collect_fault_nodes_bottom_up (Nenofex * nenofex)
   Node *cur;
   while ((cur = dequeue (queue)))
     {
-      assert (cur->atpg_info);
-      assert (cur->atpg_info->fault_node);
+      assert (node_atpg_info (nenofex, cur));
+      assert (node_atpg_info (nenofex, cur)->fault_node);
 
       if (!is_literal_node (cur))
         {
-          push_stack (atpg_rr->mm, fault_stack, cur->atpg_info->fault_node);
+          push_stack (atpg_rr->mm, fault_stack,
+                      node_atpg_info (nenofex, cur)->fault_node);
 
           Node *ch;
-          for (ch = cur->child_list.first; ch; ch = ch->level_link.next)
+          for (ch = node_at (nenofex, cur->child_list.first); ch;
+               ch = node_at (nenofex, ch->level_link.next))
             enqueue (atpg_rr->mm, queue, ch);
         }
       else
         {
-          enqueue (atpg_rr->mm, atpg_rr_fault_queue, cur->atpg_info->fault_node);
+          enqueue (atpg_rr->mm, atpg_rr_fault_queue,
+                   node_atpg_info (nenofex, cur)->fault_node);
         }
     }                           /* end: while queue not empty */
 
@@ -517,9 +569,10 @@ collect_fault_nodes_bottom_up (Nenofex * nenofex)
 - collected nodes wil be reset after propagation
 */
 void
-collect_assigned_node (ATPGRedundancyRemover * atpg_rr, Node * node)
+collect_assigned_node (Nenofex * nenofex, Node * node)
 {
-  ATPGInfo *atpg_info = node->atpg_info;
+  ATPGRedundancyRemover *atpg_rr = nenofex->atpg_rr;
+  ATPGInfo *atpg_info = node_atpg_info (nenofex, node);
 
   if (!atpg_info->collected)
     {
@@ -534,7 +587,7 @@ collect_assigned_node (ATPGRedundancyRemover * atpg_rr, Node * node)
 - called on demand
 */
 static void
-clean_up_watcher_atpg_child_list (ATPGInfo * atpg_info)
+clean_up_watcher_atpg_child_list (Nenofex * nenofex, ATPGInfo * atpg_info)
 {
   assert (atpg_info->atpg_ch);
   assert (atpg_info->watcher_pos);
@@ -582,15 +635,16 @@ clean_up_watcher_atpg_child_list (ATPGInfo * atpg_info)
 }
 
 
-static void init_counter_and_watcher (Node * node);
+static void init_counter_and_watcher (Nenofex * nenofex, Node * node);
 
 
 /* 
 - TODO: warning if only 1 unassigned child after initialization -> unclear...
 */
 static void
-reset_touched_nodes (ATPGRedundancyRemover * atpg_rr)
+reset_touched_nodes (Nenofex * nenofex)
 {
+  ATPGRedundancyRemover *atpg_rr = nenofex->atpg_rr;
   ATPGInfo *atpg_info;
   Stack *atpg_rr_touched_nodes = atpg_rr->touched_nodes;
 
@@ -614,13 +668,13 @@ reset_touched_nodes (ATPGRedundancyRemover * atpg_rr)
 
           if (!is_literal_node (node))
             {                   /* init watchers */
-              init_counter_and_watcher (node);
+              init_counter_and_watcher (nenofex, node);
             }
 
         }
       else                      /* unassigned node -> init watchers */
         {
-          init_counter_and_watcher (node);
+          init_counter_and_watcher (nenofex, node);
         }                       /* end: node not assigned */
 
       /* TODO: warnif only 1 unassigned child after initialization -> unclear... */
@@ -635,9 +689,10 @@ reset_touched_nodes (ATPGRedundancyRemover * atpg_rr)
 - BOTTLENECK: skipping of nodes? -> very unlikely since only lit-ch are inspected
 */
 static void
-fault_sensitization (ATPGRedundancyRemover * atpg_rr,
-                     Node * fault_node, ATPGFaultType fault_type)
+fault_sensitization (Nenofex * nenofex, Node * fault_node,
+                     ATPGFaultType fault_type)
 {
+  ATPGRedundancyRemover *atpg_rr = nenofex->atpg_rr;
   Queue *atpg_rr_propagation_queue = atpg_rr->propagation_queue;
   Var *var;
   Lit *lit;
@@ -665,11 +720,12 @@ fault_sensitization (ATPGRedundancyRemover * atpg_rr,
           assert (is_and_node (fault_node));
 
           Node *ch;
-          for (ch = fault_node->child_list.first;
-               ch && is_literal_node (ch); ch = ch->level_link.next)
+          for (ch = node_at (nenofex, fault_node->child_list.first);
+               ch && is_literal_node (ch);
+                 ch = node_at (nenofex, ch->level_link.next))
             {
               /* atpg restriction */
-              if (!ch->atpg_info)
+              if (!node_atpg_info (nenofex, ch))
                 continue;
               /* end: atpg restriction */
 
@@ -712,11 +768,12 @@ fault_sensitization (ATPGRedundancyRemover * atpg_rr,
           assert (is_or_node (fault_node));
 
           Node *ch;
-          for (ch = fault_node->child_list.first;
-               ch && is_literal_node (ch); ch = ch->level_link.next)
+          for (ch = node_at (nenofex, fault_node->child_list.first);
+               ch && is_literal_node (ch);
+                 ch = node_at (nenofex, ch->level_link.next))
             {
               /* atpg restriction */
-              if (!ch->atpg_info)
+              if (!node_atpg_info (nenofex, ch))
                 continue;
               /* end: atpg restriction */
 
@@ -743,7 +800,8 @@ fault_sensitization (ATPGRedundancyRemover * atpg_rr,
 - the following functions are used in assertion-checking only
 */
 static int
-all_children_assigned_value (Node * parent, ATPGAssignment v)
+all_children_assigned_value (Nenofex * nenofex, Node * parent,
+                             ATPGAssignment v)
 {
   int result = 1;
 
@@ -752,11 +810,11 @@ all_children_assigned_value (Node * parent, ATPGAssignment v)
     case ATPG_ASSIGNMENT_UNDEFINED:
       {
         Node *ch;
-        for (ch = parent->child_list.first; result && ch;
-             ch = ch->level_link.next)
+        for (ch = node_at (nenofex, parent->child_list.first); result && ch;
+             ch = node_at (nenofex, ch->level_link.next))
           {
             /* atpg restriction */
-            if (!ch->atpg_info)
+            if (!node_atpg_info (nenofex, ch))
               continue;
             /* end: atpg restriction */
 
@@ -768,11 +826,11 @@ all_children_assigned_value (Node * parent, ATPGAssignment v)
     case ATPG_ASSIGNMENT_FALSE:
       {
         Node *ch;
-        for (ch = parent->child_list.first; result && ch;
-             ch = ch->level_link.next)
+        for (ch = node_at (nenofex, parent->child_list.first); result && ch;
+             ch = node_at (nenofex, ch->level_link.next))
           {
             /* atpg restriction */
-            if (!ch->atpg_info)
+            if (!node_atpg_info (nenofex, ch))
               continue;
             /* end: atpg restriction */
 
@@ -784,11 +842,11 @@ all_children_assigned_value (Node * parent, ATPGAssignment v)
     case ATPG_ASSIGNMENT_TRUE:
       {
         Node *ch;
-        for (ch = parent->child_list.first; result && ch;
-             ch = ch->level_link.next)
+        for (ch = node_at (nenofex, parent->child_list.first); result && ch;
+             ch = node_at (nenofex, ch->level_link.next))
           {
             /* atpg restriction */
-            if (!ch->atpg_info)
+            if (!node_atpg_info (nenofex, ch))
               continue;
             /* end: atpg restriction */
 
@@ -803,7 +861,8 @@ all_children_assigned_value (Node * parent, ATPGAssignment v)
 
 
 static int
-count_children_assigned_value (Node * parent, ATPGAssignment v)
+count_children_assigned_value (Nenofex * nenofex, Node * parent,
+                               ATPGAssignment v)
 {
   int result = 0;
 
@@ -812,10 +871,11 @@ count_children_assigned_value (Node * parent, ATPGAssignment v)
     case ATPG_ASSIGNMENT_UNDEFINED:
       {
         Node *ch;
-        for (ch = parent->child_list.first; ch; ch = ch->level_link.next)
+        for (ch = node_at (nenofex, parent->child_list.first); ch;
+             ch = node_at (nenofex, ch->level_link.next))
           {
             /* atpg restriction */
-            if (!ch->atpg_info)
+            if (!node_atpg_info (nenofex, ch))
               continue;
             /* end: atpg restriction */
 
@@ -828,10 +888,11 @@ count_children_assigned_value (Node * parent, ATPGAssignment v)
     case ATPG_ASSIGNMENT_FALSE:
       {
         Node *ch;
-        for (ch = parent->child_list.first; ch; ch = ch->level_link.next)
+        for (ch = node_at (nenofex, parent->child_list.first); ch;
+             ch = node_at (nenofex, ch->level_link.next))
           {
             /* atpg restriction */
-            if (!ch->atpg_info)
+            if (!node_atpg_info (nenofex, ch))
               continue;
             /* end: atpg restriction */
 
@@ -844,10 +905,11 @@ count_children_assigned_value (Node * parent, ATPGAssignment v)
     case ATPG_ASSIGNMENT_TRUE:
       {
         Node *ch;
-        for (ch = parent->child_list.first; ch; ch = ch->level_link.next)
+        for (ch = node_at (nenofex, parent->child_list.first); ch;
+             ch = node_at (nenofex, ch->level_link.next))
           {
             /* atpg restriction */
-            if (!ch->atpg_info)
+            if (!node_atpg_info (nenofex, ch))
               continue;
             /* end: atpg restriction */
 
@@ -863,7 +925,7 @@ count_children_assigned_value (Node * parent, ATPGAssignment v)
 
 
 static Node *
-find_child_assigned_value (Node * parent, ATPGAssignment v)
+find_child_assigned_value (Nenofex * nenofex, Node * parent, ATPGAssignment v)
 {
   Node *result = 0;
 
@@ -872,11 +934,11 @@ find_child_assigned_value (Node * parent, ATPGAssignment v)
     case ATPG_ASSIGNMENT_UNDEFINED:
       {
         Node *ch;
-        for (ch = parent->child_list.first; !result && ch;
-             ch = ch->level_link.next)
+        for (ch = node_at (nenofex, parent->child_list.first); !result && ch;
+             ch = node_at (nenofex, ch->level_link.next))
           {
             /* atpg restriction */
-            if (!ch->atpg_info)
+            if (!node_atpg_info (nenofex, ch))
               continue;
             /* end: atpg restriction */
 
@@ -889,11 +951,11 @@ find_child_assigned_value (Node * parent, ATPGAssignment v)
     case ATPG_ASSIGNMENT_FALSE:
       {
         Node *ch;
-        for (ch = parent->child_list.first; !result && ch;
-             ch = ch->level_link.next)
+        for (ch = node_at (nenofex, parent->child_list.first); !result && ch;
+             ch = node_at (nenofex, ch->level_link.next))
           {
             /* atpg restriction */
-            if (!ch->atpg_info)
+            if (!node_atpg_info (nenofex, ch))
               continue;
             /* end: atpg restriction */
 
@@ -906,11 +968,11 @@ find_child_assigned_value (Node * parent, ATPGAssignment v)
     case ATPG_ASSIGNMENT_TRUE:
       {
         Node *ch;
-        for (ch = parent->child_list.first; !result && ch;
-             ch = ch->level_link.next)
+        for (ch = node_at (nenofex, parent->child_list.first); !result && ch;
+             ch = node_at (nenofex, ch->level_link.next))
           {
             /* atpg restriction */
-            if (!ch->atpg_info)
+            if (!node_atpg_info (nenofex, ch))
               continue;
             /* end: atpg restriction */
 
@@ -933,9 +995,9 @@ find_child_assigned_value (Node * parent, ATPGAssignment v)
 - watcher update by real child list could become bottleneck for such nodes
 */
 static void
-update_watcher_by_watcher_list (Node * parent)
+update_watcher_by_watcher_list (Nenofex * nenofex, Node * parent)
 {
-  ATPGInfo *atpg_info = parent->atpg_info;
+  ATPGInfo *atpg_info = node_atpg_info (nenofex, parent);
   Node *watcher = atpg_info->watcher;
 
   assert (atpg_info->atpg_ch);
@@ -978,9 +1040,9 @@ update_watcher_by_watcher_list (Node * parent)
 - average case: searches for unassigned child in child list
 */
 static void
-update_watcher_by_child_list (Node * parent)
+update_watcher_by_child_list (Nenofex * nenofex, Node * parent)
 {
-  ATPGInfo *atpg_info = parent->atpg_info;
+  ATPGInfo *atpg_info = node_atpg_info (nenofex, parent);
   Node *watcher = atpg_info->watcher;
 
   assert (!atpg_info->atpg_ch);
@@ -990,7 +1052,7 @@ update_watcher_by_child_list (Node * parent)
     {
       do
         {
-          watcher = watcher->level_link.next;
+          watcher = node_at (nenofex, watcher->level_link.next);
         }
       while (watcher && node_assigned (watcher));
 
@@ -1004,11 +1066,11 @@ update_watcher_by_child_list (Node * parent)
 - clean up of watcher list is done on demand
 */
 static void
-init_counter_and_watcher (Node * node)
+init_counter_and_watcher (Nenofex * nenofex, Node * node)
 {
   assert (!is_literal_node (node));
 
-  ATPGInfo *atpg_info = node->atpg_info;
+  ATPGInfo *atpg_info = node_atpg_info (nenofex, node);
   Stack *atpg_info_atpg_ch = atpg_info->atpg_ch;
 
   if (atpg_info_atpg_ch)
@@ -1016,7 +1078,7 @@ init_counter_and_watcher (Node * node)
       if (atpg_info->clean_up_watcher_list)
         {
           atpg_info->clean_up_watcher_list = 0;
-          clean_up_watcher_atpg_child_list (atpg_info);
+          clean_up_watcher_atpg_child_list (nenofex, atpg_info);
         }
 
       atpg_info->watcher_pos = atpg_info_atpg_ch->elems;
@@ -1028,7 +1090,7 @@ init_counter_and_watcher (Node * node)
       assert (!atpg_info->watcher_pos);
       assert (!atpg_info->clean_up_watcher_list);
 
-      atpg_info->watcher = node->child_list.first;
+      atpg_info->watcher = node_at (nenofex, node->child_list.first);
       atpg_info->unassigned_ch_cnt = node->num_children;
     }
 
@@ -1039,11 +1101,11 @@ init_counter_and_watcher (Node * node)
 - called whenever one of some node's children has been assigned a value
 */
 static void
-update_counter_and_watcher (Node * parent)
+update_counter_and_watcher (Nenofex * nenofex, Node * parent)
 {
   assert (!is_literal_node (parent));
 
-  ATPGInfo *atpg_info = parent->atpg_info;
+  ATPGInfo *atpg_info = node_atpg_info (nenofex, parent);
 
   assert (!atpg_info->atpg_ch || (atpg_info->unassigned_ch_cnt > 0 &&
                                   atpg_info->unassigned_ch_cnt <=
@@ -1055,9 +1117,9 @@ update_counter_and_watcher (Node * parent)
   atpg_info->unassigned_ch_cnt--;
 
   if (atpg_info->atpg_ch)
-    update_watcher_by_watcher_list (parent);
+    update_watcher_by_watcher_list (nenofex, parent);
   else
-    update_watcher_by_child_list (parent);
+    update_watcher_by_child_list (nenofex, parent);
 }
 
 
@@ -1068,13 +1130,13 @@ update_counter_and_watcher (Node * parent)
    in watcher list for each node -> need not search explicitly then
 */
 static void
-remove_child_from_watcher_list (Node * parent, Node * child)
+remove_child_from_watcher_list (Nenofex * nenofex, Node * parent, Node * child)
 {
   assert (!is_literal_node (parent));
-  assert (child->parent == parent);
-  assert (parent->atpg_info->atpg_ch);
+  assert (node_at (nenofex, child->parent) == parent);
+  assert (node_atpg_info (nenofex, parent)->atpg_ch);
 
-  ATPGInfo *atpg_info = parent->atpg_info;
+  ATPGInfo *atpg_info = node_atpg_info (nenofex, parent);
   Stack *atpg_info_atpg_ch = atpg_info->atpg_ch;
 
   void **cur, **end;
@@ -1105,18 +1167,19 @@ remove_child_from_watcher_list (Node * parent, Node * child)
 - recursive version
 */
 static void
-backward_propagate_truth (ATPGRedundancyRemover * atpg_rr, Node * node)
+backward_propagate_truth (Nenofex * nenofex, Node * node)
 {
+  ATPGRedundancyRemover *atpg_rr = nenofex->atpg_rr;
   assert (!atpg_rr->global_flow_optimizing);
 
   atpg_rr->stats.bwd_prop_cnt++;
 
   if ((!atpg_rr->global_flow_optimizing &&
        (atpg_rr->stats.bwd_prop_cnt + atpg_rr->stats.fwd_prop_cnt >
-        ATPG_PROPAGATION_LIMIT)) || (atpg_rr->global_flow_optimizing
+        atpg_rr->atpg_prop_limit)) || (atpg_rr->global_flow_optimizing
                                      && (atpg_rr->stats.bwd_prop_cnt +
                                          atpg_rr->stats.fwd_prop_cnt >
-                                         GLOBAL_FLOW_PROPAGATION_LIMIT)))
+                                         atpg_rr->global_flow_prop_limit)))
     {
       atpg_rr->prop_cutoff = 1;
       return;
@@ -1153,47 +1216,49 @@ backward_propagate_truth (ATPGRedundancyRemover * atpg_rr, Node * node)
   else if (is_and_node (node))
     {                           /* backward-propagate truth to all unassigned ch. -> assert: no child is 0 */
 #if ASSERT_CHILDREN_ASSIGNMENTS
-      assert (!count_children_assigned_value (node, ATPG_ASSIGNMENT_FALSE));
+      assert (!count_children_assigned_value (nenofex, node,
+                                              ATPG_ASSIGNMENT_FALSE));
 #endif
 
       node_assign_true (node);
-      collect_assigned_node (atpg_rr, node);
+      collect_assigned_node (nenofex, node);
 
       Node *ch;
-      for (ch = node->child_list.first;
+      for (ch = node_at (nenofex, node->child_list.first);
            !atpg_rr->conflict && !atpg_rr->prop_cutoff && ch;
-           ch = ch->level_link.next)
+           ch = node_at (nenofex, ch->level_link.next))
         {
           if (!node_assigned (ch))
-            backward_propagate_truth (atpg_rr, ch);
+            backward_propagate_truth (nenofex, ch);
           else if (is_or_node (ch))
             {
               assert (node_assigned_true (ch));
 #if ASSERT_CHILDREN_ASSIGNMENTS
               assert (count_children_assigned_value
-                      (ch, ATPG_ASSIGNMENT_TRUE));
+                      (nenofex, ch, ATPG_ASSIGNMENT_TRUE));
 #endif
             }
         }                       /* end: for all children */
 
-      node->atpg_info->justified = 1;
+      node_atpg_info (nenofex, node)->justified = 1;
     }
   else                          /* OR */
     {
 #if ASSERT_CHILDREN_ASSIGNMENTS
-      assert (!count_children_assigned_value (node, ATPG_ASSIGNMENT_TRUE));
+      assert (!count_children_assigned_value (nenofex, node,
+                                              ATPG_ASSIGNMENT_TRUE));
 #endif
 
       node_assign_true (node);
-      collect_assigned_node (atpg_rr, node);
+      collect_assigned_node (nenofex, node);
 
-      if (node->atpg_info->unassigned_ch_cnt == 1)
+      if (node_atpg_info (nenofex, node)->unassigned_ch_cnt == 1)
         {                       /* must justify '1' via single remaining unassigned child */
-          Node *implied_node = node->atpg_info->watcher;
+          Node *implied_node = node_atpg_info (nenofex, node)->watcher;
           assert (implied_node);
-          backward_propagate_truth (atpg_rr, implied_node);
+          backward_propagate_truth (nenofex, implied_node);
 
-          node->atpg_info->justified = 1;
+          node_atpg_info (nenofex, node)->justified = 1;
         }
     }                           /* end: OR */
 }
@@ -1205,8 +1270,9 @@ backward_propagate_truth (ATPGRedundancyRemover * atpg_rr, Node * node)
 - note: no fwd-propagation can occur until all nodes have been bwd-propagated
 */
 static void
-backward_propagate_truth (ATPGRedundancyRemover * atpg_rr, Node * node)
+backward_propagate_truth (Nenofex * nenofex, Node * node)
 {
+  ATPGRedundancyRemover *atpg_rr = nenofex->atpg_rr;
   assert (!atpg_rr->global_flow_optimizing);
   assert (!atpg_rr->conflict);  /* not sure about this */
   assert (!atpg_rr->prop_cutoff);
@@ -1225,10 +1291,10 @@ backward_propagate_truth (ATPGRedundancyRemover * atpg_rr, Node * node)
 
       if ((!atpg_rr->global_flow_optimizing &&
            (atpg_rr->stats.bwd_prop_cnt + atpg_rr->stats.fwd_prop_cnt >
-            ATPG_PROPAGATION_LIMIT)) || (atpg_rr->global_flow_optimizing
+            atpg_rr->atpg_prop_limit)) || (atpg_rr->global_flow_optimizing
                                          && (atpg_rr->stats.bwd_prop_cnt +
                                              atpg_rr->stats.fwd_prop_cnt >
-                                             GLOBAL_FLOW_PROPAGATION_LIMIT)))
+                                             atpg_rr->global_flow_prop_limit)))
         {
           atpg_rr->prop_cutoff = 1;
           break;
@@ -1265,14 +1331,15 @@ backward_propagate_truth (ATPGRedundancyRemover * atpg_rr, Node * node)
         {                       /* bwd-propagate truth to all unassigned children -> assert: no child is 0 */
 #if ASSERT_CHILDREN_ASSIGNMENTS
           assert (!count_children_assigned_value
-                  (node, ATPG_ASSIGNMENT_FALSE));
+                  (nenofex, node, ATPG_ASSIGNMENT_FALSE));
 #endif
 
           node_assign_true (node);
-          collect_assigned_node (atpg_rr, node);
+          collect_assigned_node (nenofex, node);
 
           Node *ch;
-          for (ch = node->child_list.last; ch; ch = ch->level_link.prev)
+          for (ch = node_at (nenofex, node->child_list.last); ch;
+               ch = node_at (nenofex, ch->level_link.prev))
             {
               if (!node_assigned (ch))
                 {
@@ -1283,31 +1350,31 @@ backward_propagate_truth (ATPGRedundancyRemover * atpg_rr, Node * node)
                   assert (node_assigned_true (ch));
 #if ASSERT_CHILDREN_ASSIGNMENTS
                   assert (count_children_assigned_value
-                          (ch, ATPG_ASSIGNMENT_TRUE));
+                          (nenofex, ch, ATPG_ASSIGNMENT_TRUE));
 #endif
                 }
             }                   /* end: for all children */
 
-          node->atpg_info->justified = 1;
+          node_atpg_info (nenofex, node)->justified = 1;
         }
       else                      /* OR */
         {
 #if ASSERT_CHILDREN_ASSIGNMENTS
           assert (!count_children_assigned_value
-                  (node, ATPG_ASSIGNMENT_TRUE));
+                  (nenofex, node, ATPG_ASSIGNMENT_TRUE));
 #endif
 
           node_assign_true (node);
-          collect_assigned_node (atpg_rr, node);
+          collect_assigned_node (nenofex, node);
 
-          if (node->atpg_info->unassigned_ch_cnt == 1)
+          if (node_atpg_info (nenofex, node)->unassigned_ch_cnt == 1)
             {                   /* must justify '1' via single remaining unassigned child */
-              Node *implied_node = node->atpg_info->watcher;
+              Node *implied_node = node_atpg_info (nenofex, node)->watcher;
               assert (implied_node);
 
               push_stack (atpg_rr->mm, bwd_prop_stack, implied_node);
 
-              node->atpg_info->justified = 1;
+              node_atpg_info (nenofex, node)->justified = 1;
             }
         }                       /* end: OR */
     }                           /* end: while propagation stack not empty */
@@ -1325,18 +1392,19 @@ backward_propagate_truth (ATPGRedundancyRemover * atpg_rr, Node * node)
 - recursive version
 */
 static void
-backward_propagate_falsity (ATPGRedundancyRemover * atpg_rr, Node * node)
+backward_propagate_falsity (Nenofex * nenofex, Node * node)
 {
+  ATPGRedundancyRemover *atpg_rr = nenofex->atpg_rr;
   assert (!atpg_rr->global_flow_optimizing);
 
   atpg_rr->stats.bwd_prop_cnt++;
 
   if ((!atpg_rr->global_flow_optimizing &&
        (atpg_rr->stats.bwd_prop_cnt + atpg_rr->stats.fwd_prop_cnt >
-        ATPG_PROPAGATION_LIMIT)) || (atpg_rr->global_flow_optimizing
+        atpg_rr->atpg_prop_limit)) || (atpg_rr->global_flow_optimizing
                                      && (atpg_rr->stats.bwd_prop_cnt +
                                          atpg_rr->stats.fwd_prop_cnt >
-                                         GLOBAL_FLOW_PROPAGATION_LIMIT)))
+                                         atpg_rr->global_flow_prop_limit)))
     {
       atpg_rr->prop_cutoff = 1;
       return;
@@ -1373,49 +1441,51 @@ backward_propagate_falsity (ATPGRedundancyRemover * atpg_rr, Node * node)
   else if (is_and_node (node))
     {
 #if ASSERT_CHILDREN_ASSIGNMENTS
-      assert (!count_children_assigned_value (node, ATPG_ASSIGNMENT_FALSE));
+      assert (!count_children_assigned_value (nenofex, node,
+                                              ATPG_ASSIGNMENT_FALSE));
 #endif
 
       node_assign_false (node);
-      collect_assigned_node (atpg_rr, node);
+      collect_assigned_node (nenofex, node);
 
-      if (node->atpg_info->unassigned_ch_cnt == 1)
+      if (node_atpg_info (nenofex, node)->unassigned_ch_cnt == 1)
         {                       /* must justify '1' via single remaining unassigned child */
-          Node *implied_node = node->atpg_info->watcher;
+          Node *implied_node = node_atpg_info (nenofex, node)->watcher;
           assert (implied_node);
 
-          backward_propagate_falsity (atpg_rr, implied_node);
+          backward_propagate_falsity (nenofex, implied_node);
 
-          node->atpg_info->justified = 1;
+          node_atpg_info (nenofex, node)->justified = 1;
         }
     }
   else                          /* OR */
     {                           /* bwd-propagate falsity to all unassigned children -> assert: no child is 1 */
 #if ASSERT_CHILDREN_ASSIGNMENTS
-      assert (!count_children_assigned_value (node, ATPG_ASSIGNMENT_TRUE));
+      assert (!count_children_assigned_value (nenofex, node,
+                                              ATPG_ASSIGNMENT_TRUE));
 #endif
 
       node_assign_false (node);
-      collect_assigned_node (atpg_rr, node);
+      collect_assigned_node (nenofex, node);
 
       Node *ch;
-      for (ch = node->child_list.first;
+      for (ch = node_at (nenofex, node->child_list.first);
            !atpg_rr->conflict && !atpg_rr->prop_cutoff && ch;
-           ch = ch->level_link.next)
+           ch = node_at (nenofex, ch->level_link.next))
         {
           if (!node_assigned (ch))
-            backward_propagate_falsity (atpg_rr, ch);
+            backward_propagate_falsity (nenofex, ch);
           else if (is_and_node (ch))
             {
               assert (node_assigned_false (ch));
 #if ASSERT_CHILDREN_ASSIGNMENTS
               assert (count_children_assigned_value
-                      (ch, ATPG_ASSIGNMENT_FALSE));
+                      (nenofex, ch, ATPG_ASSIGNMENT_FALSE));
 #endif
             }
         }                       /* end: for all children */
 
-      node->atpg_info->justified = 1;
+      node_atpg_info (nenofex, node)->justified = 1;
     }                           /* end: OR */
 }
 
@@ -1426,8 +1496,9 @@ backward_propagate_falsity (ATPGRedundancyRemover * atpg_rr, Node * node)
 - note that no fwd- propagation can occur until all nodes have been bwd-propagated
 */
 static void
-backward_propagate_falsity (ATPGRedundancyRemover * atpg_rr, Node * node)
+backward_propagate_falsity (Nenofex * nenofex, Node * node)
 {
+  ATPGRedundancyRemover *atpg_rr = nenofex->atpg_rr;
   assert (!atpg_rr->global_flow_optimizing);
   assert (!atpg_rr->conflict);
   assert (!atpg_rr->prop_cutoff);
@@ -1445,10 +1516,10 @@ backward_propagate_falsity (ATPGRedundancyRemover * atpg_rr, Node * node)
 
       if ((!atpg_rr->global_flow_optimizing &&
            (atpg_rr->stats.bwd_prop_cnt + atpg_rr->stats.fwd_prop_cnt >
-            ATPG_PROPAGATION_LIMIT)) || (atpg_rr->global_flow_optimizing
+            atpg_rr->atpg_prop_limit)) || (atpg_rr->global_flow_optimizing
                                          && (atpg_rr->stats.bwd_prop_cnt +
                                              atpg_rr->stats.fwd_prop_cnt >
-                                             GLOBAL_FLOW_PROPAGATION_LIMIT)))
+                                             atpg_rr->global_flow_prop_limit)))
         {
           atpg_rr->prop_cutoff = 1;
           break;
@@ -1485,34 +1556,35 @@ backward_propagate_falsity (ATPGRedundancyRemover * atpg_rr, Node * node)
         {
 #if ASSERT_CHILDREN_ASSIGNMENTS
           assert (!count_children_assigned_value
-                  (node, ATPG_ASSIGNMENT_FALSE));
+                  (nenofex, node, ATPG_ASSIGNMENT_FALSE));
 #endif
 
           node_assign_false (node);
-          collect_assigned_node (atpg_rr, node);
+          collect_assigned_node (nenofex, node);
 
-          if (node->atpg_info->unassigned_ch_cnt == 1)
+          if (node_atpg_info (nenofex, node)->unassigned_ch_cnt == 1)
             {                   /* must justify '1' via single remaining unassigned child */
-              Node *implied_node = node->atpg_info->watcher;
+              Node *implied_node = node_atpg_info (nenofex, node)->watcher;
               assert (implied_node);
 
               push_stack (atpg_rr->mm, bwd_prop_stack, implied_node);
 
-              node->atpg_info->justified = 1;
+              node_atpg_info (nenofex, node)->justified = 1;
             }
         }
       else                      /* OR */
         {                       /* bwd-propagate falsity to all unassigned children -> assert: no child is 1 */
 #if ASSERT_CHILDREN_ASSIGNMENTS
           assert (!count_children_assigned_value
-                  (node, ATPG_ASSIGNMENT_TRUE));
+                  (nenofex, node, ATPG_ASSIGNMENT_TRUE));
 #endif
 
           node_assign_false (node);
-          collect_assigned_node (atpg_rr, node);
+          collect_assigned_node (nenofex, node);
 
           Node *ch;
-          for (ch = node->child_list.last; ch; ch = ch->level_link.prev)
+          for (ch = node_at (nenofex, node->child_list.last); ch;
+               ch = node_at (nenofex, ch->level_link.prev))
             {
               if (!node_assigned (ch))
                 {
@@ -1523,12 +1595,12 @@ backward_propagate_falsity (ATPGRedundancyRemover * atpg_rr, Node * node)
                   assert (node_assigned_false (ch));
 #if ASSERT_CHILDREN_ASSIGNMENTS
                   assert (count_children_assigned_value
-                          (ch, ATPG_ASSIGNMENT_FALSE));
+                          (nenofex, ch, ATPG_ASSIGNMENT_FALSE));
 #endif
                 }
             }                   /* end: for all children */
 
-          node->atpg_info->justified = 1;
+          node_atpg_info (nenofex, node)->justified = 1;
         }                       /* end: OR */
     }                           /* end: while stack not empty */
 
@@ -1555,10 +1627,10 @@ TAIL_RECURSIVE_CALL:
 
   if ((!atpg_rr->global_flow_optimizing &&
        (atpg_rr->stats.bwd_prop_cnt + atpg_rr->stats.fwd_prop_cnt >
-        ATPG_PROPAGATION_LIMIT)) || (atpg_rr->global_flow_optimizing
+        atpg_rr->atpg_prop_limit)) || (atpg_rr->global_flow_optimizing
                                      && (atpg_rr->stats.bwd_prop_cnt +
                                          atpg_rr->stats.fwd_prop_cnt >
-                                         GLOBAL_FLOW_PROPAGATION_LIMIT)))
+                                         atpg_rr->global_flow_prop_limit)))
     {
       atpg_rr->prop_cutoff = 1;
       return;
@@ -1569,10 +1641,10 @@ TAIL_RECURSIVE_CALL:
   assert (!atpg_rr->prop_cutoff);
 
   node_assign_true (node);
-  node->atpg_info->justified = 1;
-  collect_assigned_node (atpg_rr, node);
+  node_atpg_info (nenofex, node)->justified = 1;
+  collect_assigned_node (nenofex, node);
 
-  Node *parent = node->parent;
+  Node *parent = node_at (nenofex, node->parent);
 
   if (node == nenofex->changed_subformula.lca)
     {
@@ -1580,35 +1652,37 @@ TAIL_RECURSIVE_CALL:
     }
   assert (parent);
 
+  ATPGInfo *parent_atpg_info = node_atpg_info (nenofex, parent);
+
   if (ALWAYS_UPDATE_WATCHER || !node_assigned (parent)
-      || !parent->atpg_info->justified)
+      || !parent_atpg_info->justified)
     {                           /* else skip unnecessary calls to update function */
-      update_counter_and_watcher (parent);
-      collect_assigned_node (atpg_rr, parent);
+      update_counter_and_watcher (nenofex, parent);
+      collect_assigned_node (nenofex, parent);
     }
 
-  Node *parent_parent = parent->parent;
+  Node *parent_parent = node_at (nenofex, parent->parent);
 
   if (is_and_node (parent))
     {
-      if ((node_assigned_false (parent) && !parent->atpg_info->justified)       /* BUG-FIX */
-          || (!node_assigned (parent) && !parent->atpg_info->path_mark
-              && parent_parent && parent_parent->atpg_info
-              && parent_parent->atpg_info->path_mark))
+      if ((node_assigned_false (parent) && !parent_atpg_info->justified)        /* BUG-FIX */
+          || (!node_assigned (parent) && !parent_atpg_info->path_mark
+              && parent_parent && node_atpg_info (nenofex, parent_parent)
+              && node_atpg_info (nenofex, parent_parent)->path_mark))
         {                       /* parent is off-path input of an OR  -> must be set to false */
           assert (!atpg_rr->global_flow_optimizing);
 #if ASSERT_CHILDREN_ASSIGNMENTS
           assert (!count_children_assigned_value
-                  (parent, ATPG_ASSIGNMENT_FALSE));
+                  (nenofex, parent, ATPG_ASSIGNMENT_FALSE));
 #endif
 
-          if (parent->atpg_info->unassigned_ch_cnt == 1)
+          if (parent_atpg_info->unassigned_ch_cnt == 1)
             {
-              Node *implied_ch = parent->atpg_info->watcher;
+              Node *implied_ch = parent_atpg_info->watcher;
               assert (implied_ch);
-              assert (!parent->atpg_info->justified);
+              assert (!parent_atpg_info->justified);
 
-              backward_propagate_falsity (atpg_rr, implied_ch);
+              backward_propagate_falsity (nenofex, implied_ch);
 
               if (!node_assigned (parent) && !atpg_rr->conflict)
                 {
@@ -1618,15 +1692,15 @@ TAIL_RECURSIVE_CALL:
         }
       else if (!node_assigned (parent)) /* average case */
         {
-          if (parent->atpg_info->unassigned_ch_cnt == 0)
+          if (parent_atpg_info->unassigned_ch_cnt == 0)
             {
 #if ASSERT_CHILDREN_ASSIGNMENTS
               assert (!count_children_assigned_value
-                      (parent, ATPG_ASSIGNMENT_UNDEFINED));
+                      (nenofex, parent, ATPG_ASSIGNMENT_UNDEFINED));
               assert (!count_children_assigned_value
-                      (parent, ATPG_ASSIGNMENT_FALSE));
+                      (nenofex, parent, ATPG_ASSIGNMENT_FALSE));
 #endif
-              assert (!parent->atpg_info->justified);
+              assert (!parent_atpg_info->justified);
 
               node = parent;
               goto TAIL_RECURSIVE_CALL;
@@ -1637,7 +1711,8 @@ TAIL_RECURSIVE_CALL:
     {
       assert (is_or_node (parent));
 
-      if (!node->atpg_info->path_mark && parent->atpg_info->path_mark)
+      if (!node_atpg_info (nenofex, node)->path_mark
+          && parent_atpg_info->path_mark)
         {                       /* node is off-path input of OR-node */
           assert (!atpg_rr->global_flow_optimizing);
           assert (is_literal_node (node));
@@ -1646,13 +1721,14 @@ TAIL_RECURSIVE_CALL:
         }
       else if (!node_assigned (parent)) /* average case */
         {
-          assert (!node->atpg_info->path_mark
-                  || parent->atpg_info->path_mark);
+          assert (!node_atpg_info (nenofex, node)->path_mark
+                  || parent_atpg_info->path_mark);
 #if ASSERT_CHILDREN_ASSIGNMENTS
-          assert (count_children_assigned_value (parent, ATPG_ASSIGNMENT_TRUE)
+          assert (count_children_assigned_value (nenofex, parent,
+                                                 ATPG_ASSIGNMENT_TRUE)
                   == 1);
 #endif
-          assert (!parent->atpg_info->justified);
+          assert (!parent_atpg_info->justified);
 
           node = parent;
           goto TAIL_RECURSIVE_CALL;
@@ -1660,7 +1736,7 @@ TAIL_RECURSIVE_CALL:
       else
         {
           assert (node_assigned_true (parent));
-          parent->atpg_info->justified = 1;     /* BUG-FIX (watcher) */
+          parent_atpg_info->justified = 1;      /* BUG-FIX (watcher) */
         }
     }                           /* end: parent is OR */
 }
@@ -1681,10 +1757,10 @@ TAIL_RECURSIVE_CALL:
 
   if ((!atpg_rr->global_flow_optimizing &&
        (atpg_rr->stats.bwd_prop_cnt + atpg_rr->stats.fwd_prop_cnt >
-        ATPG_PROPAGATION_LIMIT)) || (atpg_rr->global_flow_optimizing
+        atpg_rr->atpg_prop_limit)) || (atpg_rr->global_flow_optimizing
                                      && (atpg_rr->stats.bwd_prop_cnt +
                                          atpg_rr->stats.fwd_prop_cnt >
-                                         GLOBAL_FLOW_PROPAGATION_LIMIT)))
+                                         atpg_rr->global_flow_prop_limit)))
     {
       atpg_rr->prop_cutoff = 1;
       return;
@@ -1695,10 +1771,10 @@ TAIL_RECURSIVE_CALL:
   assert (!atpg_rr->prop_cutoff);
 
   node_assign_false (node);
-  node->atpg_info->justified = 1;
-  collect_assigned_node (atpg_rr, node);
+  node_atpg_info (nenofex, node)->justified = 1;
+  collect_assigned_node (nenofex, node);
 
-  Node *parent = node->parent;
+  Node *parent = node_at (nenofex, node->parent);
 
   if (node == nenofex->changed_subformula.lca)
     {
@@ -1706,35 +1782,37 @@ TAIL_RECURSIVE_CALL:
     }
   assert (parent);
 
+  ATPGInfo *parent_atpg_info = node_atpg_info (nenofex, parent);
+
   if (ALWAYS_UPDATE_WATCHER || !node_assigned (parent)
-      || !parent->atpg_info->justified)
+      || !parent_atpg_info->justified)
     {                           /* else skip unnecessary calls to update function */
-      update_counter_and_watcher (parent);
-      collect_assigned_node (atpg_rr, parent);
+      update_counter_and_watcher (nenofex, parent);
+      collect_assigned_node (nenofex, parent);
     }
 
-  Node *parent_parent = parent->parent;
+  Node *parent_parent = node_at (nenofex, parent->parent);
 
   if (is_or_node (parent))
     {
-      if ((node_assigned_true (parent) && !parent->atpg_info->justified)        /* BUG-FIX */
-          || (!node_assigned (parent) && !parent->atpg_info->path_mark
-              && parent_parent && parent_parent->atpg_info
-              && parent_parent->atpg_info->path_mark))
+      if ((node_assigned_true (parent) && !parent_atpg_info->justified)        /* BUG-FIX */
+          || (!node_assigned (parent) && !parent_atpg_info->path_mark
+              && parent_parent && node_atpg_info (nenofex, parent_parent)
+              && node_atpg_info (nenofex, parent_parent)->path_mark))
         {                       /* parent is off-path input of an AND  -> must be set to true */
           assert (!atpg_rr->global_flow_optimizing);
 #if ASSERT_CHILDREN_ASSIGNMENTS
           assert (!count_children_assigned_value
-                  (parent, ATPG_ASSIGNMENT_TRUE));
+                  (nenofex, parent, ATPG_ASSIGNMENT_TRUE));
 #endif
 
-          if (parent->atpg_info->unassigned_ch_cnt == 1)
+          if (parent_atpg_info->unassigned_ch_cnt == 1)
             {
-              Node *implied_ch = parent->atpg_info->watcher;
+              Node *implied_ch = parent_atpg_info->watcher;
               assert (implied_ch);
-              assert (!parent->atpg_info->justified);
+              assert (!parent_atpg_info->justified);
 
-              backward_propagate_truth (atpg_rr, implied_ch);
+              backward_propagate_truth (nenofex, implied_ch);
 
               if (!node_assigned (parent) && !atpg_rr->conflict)
                 {
@@ -1744,15 +1822,15 @@ TAIL_RECURSIVE_CALL:
         }
       else if (!node_assigned (parent)) /* average case */
         {
-          if (parent->atpg_info->unassigned_ch_cnt == 0)
+          if (parent_atpg_info->unassigned_ch_cnt == 0)
             {
 #if ASSERT_CHILDREN_ASSIGNMENTS
               assert (!count_children_assigned_value
-                      (parent, ATPG_ASSIGNMENT_UNDEFINED));
+                      (nenofex, parent, ATPG_ASSIGNMENT_UNDEFINED));
               assert (!count_children_assigned_value
-                      (parent, ATPG_ASSIGNMENT_TRUE));
+                      (nenofex, parent, ATPG_ASSIGNMENT_TRUE));
 #endif
-              assert (!parent->atpg_info->justified);
+              assert (!parent_atpg_info->justified);
 
               node = parent;
               goto TAIL_RECURSIVE_CALL;
@@ -1763,7 +1841,8 @@ TAIL_RECURSIVE_CALL:
     {
       assert (is_and_node (parent));
 
-      if (!node->atpg_info->path_mark && parent->atpg_info->path_mark)
+      if (!node_atpg_info (nenofex, node)->path_mark
+          && parent_atpg_info->path_mark)
         {                       /* node is off-path input of AND-node */
           assert (!atpg_rr->global_flow_optimizing);
           assert (is_literal_node (node));
@@ -1772,13 +1851,13 @@ TAIL_RECURSIVE_CALL:
         }
       else if (!node_assigned (parent)) /* average case */
         {
-          assert (!node->atpg_info->path_mark
-                  || parent->atpg_info->path_mark);
+          assert (!node_atpg_info (nenofex, node)->path_mark
+                  || parent_atpg_info->path_mark);
 #if ASSERT_CHILDREN_ASSIGNMENTS
           assert (count_children_assigned_value
-                  (parent, ATPG_ASSIGNMENT_FALSE) == 1);
+                  (nenofex, parent, ATPG_ASSIGNMENT_FALSE) == 1);
 #endif
-          assert (!parent->atpg_info->justified);
+          assert (!parent_atpg_info->justified);
 
           node = parent;
           goto TAIL_RECURSIVE_CALL;
@@ -1786,7 +1865,7 @@ TAIL_RECURSIVE_CALL:
       else
         {
           assert (node_assigned_false (parent));
-          parent->atpg_info->justified = 1;     /* BUG-FIX (watcher) */
+          parent_atpg_info->justified = 1;      /* BUG-FIX (watcher) */
         }
     }                           /* end: parent is AND */
 }
@@ -1845,7 +1924,7 @@ propagate_variable_assigned_true (Nenofex * nenofex, Var * var)
 #endif /* end: clean up occ-list */
         }
 
-      assert (occ->node->atpg_info);
+      assert (node_atpg_info (nenofex, occ->node));
       assert (is_literal_node (occ->node));
       assert (occ->node->lit->negated);
       assert (!node_assigned (occ->node));
@@ -1900,7 +1979,7 @@ propagate_variable_assigned_true (Nenofex * nenofex, Var * var)
 #endif /* end: clean up occ-list */
         }
 
-      assert (occ->node->atpg_info);
+      assert (node_atpg_info (nenofex, occ->node));
       assert (is_literal_node (occ->node));
       assert (!occ->node->lit->negated);
       assert (!node_assigned (occ->node));
@@ -1966,7 +2045,7 @@ propagate_variable_assigned_false (Nenofex * nenofex, Var * var)
 #endif /* end: clean up occ-list */
         }
 
-      assert (occ->node->atpg_info);
+      assert (node_atpg_info (nenofex, occ->node));
       assert (is_literal_node (occ->node));
       assert (occ->node->lit->negated);
       assert (!node_assigned (occ->node));
@@ -2021,7 +2100,7 @@ propagate_variable_assigned_false (Nenofex * nenofex, Var * var)
 #endif /* end: clean up occ-list */
         }
 
-      assert (occ->node->atpg_info);
+      assert (node_atpg_info (nenofex, occ->node));
       assert (is_literal_node (occ->node));
       assert (!occ->node->lit->negated);
       assert (!node_assigned (occ->node));
@@ -2092,18 +2171,17 @@ mark_path_nodes (Nenofex * nenofex, Node * fault_node)
 
   do
     {
-      assert (!fault_node->atpg_info->path_mark);
-      fault_node->atpg_info->path_mark = 1;
+      assert (!node_atpg_info (nenofex, fault_node)->path_mark);
+      node_atpg_info (nenofex, fault_node)->path_mark = 1;
 
-      fault_node = fault_node->parent;
+      fault_node = node_at (nenofex, fault_node->parent);
     }
   while (fault_node && fault_node->level >= atpg_root_level);
 }
 
 
 static void
-collect_fault_path_node (ATPGRedundancyRemover * atpg_rr,
-                         Node * fault_path_node);
+collect_fault_path_node (Nenofex * nenofex, Node * fault_path_node);
 
 
 /*
@@ -2119,14 +2197,14 @@ unmark_path_nodes (Nenofex * nenofex, Node * fault_node,
 
   do
     {
-      assert (fault_node->atpg_info->path_mark);
+      assert (node_atpg_info (nenofex, fault_node)->path_mark);
 
       /* NOTE: check could be hoisted up */
       if (collect_fault_path_nodes)
-        collect_fault_path_node (nenofex->atpg_rr, fault_node);
+        collect_fault_path_node (nenofex, fault_node);
 
-      fault_node->atpg_info->path_mark = 0;
-      fault_node = fault_node->parent;
+      node_atpg_info (nenofex, fault_node)->path_mark = 0;
+      fault_node = node_at (nenofex, fault_node->parent);
     }
   while (fault_node && fault_node->level >= atpg_root_level);
 }
@@ -2142,7 +2220,7 @@ collect_necessary_off_path_literal_at_or (Nenofex * nenofex, Node * ch)
   ATPGRedundancyRemover *atpg_rr = nenofex->atpg_rr;
   Queue *atpg_rr_propagation_queue = atpg_rr->propagation_queue;
 
-  assert (is_or_node (ch->parent));
+  assert (is_or_node (node_at (nenofex, ch->parent)));
   assert (is_literal_node (ch));
 
   Lit *lit = ch->lit;
@@ -2182,7 +2260,7 @@ collect_necessary_off_path_literal_at_and (Nenofex * nenofex, Node * ch)
   ATPGRedundancyRemover *atpg_rr = nenofex->atpg_rr;
   Queue *atpg_rr_propagation_queue = atpg_rr->propagation_queue;
 
-  assert (is_and_node (ch->parent));
+  assert (is_and_node (node_at (nenofex, ch->parent)));
   assert (is_literal_node (ch));
 
   Lit *lit = ch->lit;
@@ -2226,7 +2304,7 @@ collect_necessary_off_path_literals (Nenofex * nenofex, Node * fault_node)
 
   Node *cur, *prev;
 
-  cur = fault_node->parent;
+  cur = node_at (nenofex, fault_node->parent);
   assert (cur);
 
   /* handle fault_node's parent first -> saves check for fault_node later
@@ -2235,10 +2313,11 @@ collect_necessary_off_path_literals (Nenofex * nenofex, Node * fault_node)
   if (is_or_node (cur))
     {
       Node *ch;
-      for (ch = cur->child_list.first;
-           ch && (is_literal_node (ch)); ch = ch->level_link.next)
+      for (ch = node_at (nenofex, cur->child_list.first);
+           ch && (is_literal_node (ch));
+             ch = node_at (nenofex, ch->level_link.next))
         {
-          if (ch == fault_node || !ch->atpg_info)
+          if (ch == fault_node || !node_atpg_info (nenofex, ch))
             continue;
 
           collect_necessary_off_path_literal_at_or (nenofex, ch);
@@ -2249,10 +2328,11 @@ collect_necessary_off_path_literals (Nenofex * nenofex, Node * fault_node)
       assert (is_and_node (cur));
 
       Node *ch;
-      for (ch = cur->child_list.first;
-           ch && (is_literal_node (ch)); ch = ch->level_link.next)
+      for (ch = node_at (nenofex, cur->child_list.first);
+           ch && (is_literal_node (ch));
+             ch = node_at (nenofex, ch->level_link.next))
         {
-          if (ch == fault_node || !ch->atpg_info)
+          if (ch == fault_node || !node_atpg_info (nenofex, ch))
             continue;
 
           collect_necessary_off_path_literal_at_and (nenofex, ch);
@@ -2261,7 +2341,7 @@ collect_necessary_off_path_literals (Nenofex * nenofex, Node * fault_node)
 
   unsigned const int top_level = nenofex->changed_subformula.lca->level;
   prev = cur;
-  cur = cur->parent;
+  cur = node_at (nenofex, cur->parent);
 
   /* traverse fault path upwards until root of 'changed-subformula' */
 
@@ -2270,10 +2350,11 @@ collect_necessary_off_path_literals (Nenofex * nenofex, Node * fault_node)
       if (is_or_node (cur))
         {
           Node *ch;
-          for (ch = cur->child_list.first;
-               ch && (is_literal_node (ch)); ch = ch->level_link.next)
+          for (ch = node_at (nenofex, cur->child_list.first);
+               ch && (is_literal_node (ch));
+                 ch = node_at (nenofex, ch->level_link.next))
             {
-              if (!ch->atpg_info)
+              if (!node_atpg_info (nenofex, ch))
                 continue;
 
               collect_necessary_off_path_literal_at_or (nenofex, ch);
@@ -2284,10 +2365,11 @@ collect_necessary_off_path_literals (Nenofex * nenofex, Node * fault_node)
           assert (is_and_node (cur));
 
           Node *ch;
-          for (ch = cur->child_list.first;
-               ch && (is_literal_node (ch)); ch = ch->level_link.next)
+          for (ch = node_at (nenofex, cur->child_list.first);
+               ch && (is_literal_node (ch));
+                 ch = node_at (nenofex, ch->level_link.next))
             {
-              if (!ch->atpg_info)
+              if (!node_atpg_info (nenofex, ch))
                 continue;
 
               collect_necessary_off_path_literal_at_and (nenofex, ch);
@@ -2295,7 +2377,7 @@ collect_necessary_off_path_literals (Nenofex * nenofex, Node * fault_node)
         }                       /* end: cur is AND */
 
       prev = cur;
-      cur = cur->parent;
+      cur = node_at (nenofex, cur->parent);
     }                           /* end: while top of atpg-relevant graph not reached */
 }
 
@@ -2323,18 +2405,18 @@ test_fault_is_redundant (Nenofex * nenofex, Node * fault_node)
     }
   else
     {
-      fault_type = is_or_node (fault_node->parent) ?
+      fault_type = is_or_node (node_at (nenofex, fault_node->parent)) ?
         ATPG_FAULT_TYPE_STUCK_AT_0 : ATPG_FAULT_TYPE_STUCK_AT_1;
     }
 
   assert (fault_type != ATPG_FAULT_TYPE_STUCK_AT_0 || is_and_node (fault_node)
           || (is_literal_node (fault_node)
-              && is_or_node (fault_node->parent)));
+              && is_or_node (node_at (nenofex, fault_node->parent))));
   assert (fault_type != ATPG_FAULT_TYPE_STUCK_AT_1 || is_or_node (fault_node)
           || (is_literal_node (fault_node)
-              && is_and_node (fault_node->parent)));
+              && is_and_node (node_at (nenofex, fault_node->parent))));
 
-  fault_sensitization (atpg_rr, fault_node, fault_type);
+  fault_sensitization (nenofex, fault_node, fault_type);
   assert (!atpg_rr->conflict);
 
   /* NOTE: could merge path marking and off-path-literal collection */
@@ -2400,10 +2482,10 @@ delete_redundant_subformula (Nenofex * nenofex, Node * redundant_fault)
 - used for marking variables for updates
 */
 static void
-collect_fault_path_node (ATPGRedundancyRemover * atpg_rr,
-                         Node * fault_path_node)
+collect_fault_path_node (Nenofex * nenofex, Node * fault_path_node)
 {
-  ATPGInfo *atpg_info = fault_path_node->atpg_info;
+  ATPGRedundancyRemover *atpg_rr = nenofex->atpg_rr;
+  ATPGInfo *atpg_info = node_atpg_info (nenofex, fault_path_node);
 
   if (!atpg_info->fault_path_node_collected)
     {
@@ -2435,6 +2517,204 @@ reset_touched_variables (ATPGRedundancyRemover * atpg_rr)
 }
 
 
+#if ATPG_SIMULATION
+
+#define ATPG_SIM_ALL_ONES (~(ATPGSimWord) 0)
+
+/*
+- pseudo-random pattern word of a variable in simulation round 'seed'
+- any function of the variable gives consistent assignments
+*/
+static ATPGSimWord
+atpg_sim_var_patterns (Var * var, ATPGSimWord seed)
+{
+  ATPGSimWord z = seed + (ATPGSimWord) var->id * 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+
+/*
+- push children of 'node' which participate in ATPG
+- at root of "changed-subformula", these are the changed children only
+*/
+static void
+atpg_sim_push_children (Nenofex * nenofex, Stack * stack, Node * node)
+{
+  ATPGRedundancyRemover *atpg_rr = nenofex->atpg_rr;
+
+  if (node == nenofex->changed_subformula.lca)
+    {
+      Node **ch, *child;
+      for (ch = nenofex->changed_subformula.children; (child = *ch); ch++)
+        {
+          assert (node_atpg_info (nenofex, child));
+          push_stack (atpg_rr->mm, stack, child);
+        }
+    }
+  else
+    {
+      Node *child;
+      for (child = node_at (nenofex, node->child_list.first); child;
+           child = node_at (nenofex, child->level_link.next))
+        {
+          if (node_atpg_info (nenofex, child))
+            push_stack (atpg_rr->mm, stack, child);
+        }
+    }
+}
+
+
+/*
+- one simulation round on 'nodes', which holds "changed-subformula" in BFS-order
+- bottom-up: evaluate nodes, count controlling children (at least one / two)
+- top-down: patterns under which a changed value of a node is observable at
+  the root, i.e. all siblings on the path have non-controlling values
+- children without ATPGInfo are ignored, i.e. fixed to non-controlling value
+*/
+static void
+atpg_simulation_round (Nenofex * nenofex, Stack * nodes, ATPGSimWord seed)
+{
+  Node *root = nenofex->changed_subformula.lca;
+  void **v_node;
+
+  for (v_node = nodes->top - 1; v_node >= nodes->elems; v_node--)
+    {
+      Node *node = *v_node;
+      ATPGInfo *atpg_info = node_atpg_info (nenofex, node);
+
+      if (is_literal_node (node))
+        {
+          ATPGSimWord patterns = atpg_sim_var_patterns (node->lit->var, seed);
+          atpg_info->sim_value = node->lit->negated ? ~patterns : patterns;
+        }
+      /* else: children have been evaluated already */
+
+      if (node != root)
+        {
+          Node *parent = node_at (nenofex, node->parent);
+          ATPGInfo *parent_info = node_atpg_info (nenofex, parent);
+          if (is_and_node (parent))
+            {
+              parent_info->sim_ctrl2 |=
+                ~parent_info->sim_value & ~atpg_info->sim_value;
+              parent_info->sim_value &= atpg_info->sim_value;
+            }
+          else
+            {
+              parent_info->sim_ctrl2 |=
+                parent_info->sim_value & atpg_info->sim_value;
+              parent_info->sim_value |= atpg_info->sim_value;
+            }
+        }
+    }
+
+  for (v_node = nodes->elems; v_node < nodes->top; v_node++)
+    {
+      Node *node = *v_node;
+      ATPGInfo *atpg_info = node_atpg_info (nenofex, node);
+
+      if (node == root)
+        atpg_info->sim_obs = ATPG_SIM_ALL_ONES;
+      else
+        {
+          Node *parent = node_at (nenofex, node->parent);
+          ATPGInfo *parent_info = node_atpg_info (nenofex, parent);
+          ATPGSimWord ctrl1, ctrl;
+          if (is_and_node (parent))
+            {
+              ctrl1 = ~parent_info->sim_value;
+              ctrl = ~atpg_info->sim_value;
+            }
+          else
+            {
+              ctrl1 = parent_info->sim_value;
+              ctrl = atpg_info->sim_value;
+            }
+          atpg_info->sim_obs = parent_info->sim_obs &
+            (~ctrl1 | (ctrl & ~parent_info->sim_ctrl2));
+        }
+
+      /* stuck-at value as in 'test_fault_is_redundant' */
+      int stuck_at_1 = node_at (nenofex, node->parent)
+        ? is_and_node (node_at (nenofex, node->parent)) :
+        is_or_node (node);
+      if (atpg_info->sim_obs &
+          (stuck_at_1 ? ~atpg_info->sim_value : atpg_info->sim_value))
+        atpg_info->sim_detected = 1;
+    }
+}
+
+
+/*
+- mark faults which are detected by random simulation
+- a detected fault is testable -> 'test_fault_is_redundant' can not derive
+  a conflict for it
+*/
+static void
+simulate_faults (Nenofex * nenofex, ATPGRedundancyRemover * atpg_rr)
+{
+  Node *root = nenofex->changed_subformula.lca;
+  assert (root);
+  assert (node_atpg_info (nenofex, root));
+
+  ATPGInfo *atpg_info_p;
+  for (atpg_info_p = atpg_rr->atpg_info_array;
+       atpg_info_p < atpg_rr->cur_atpg_info; atpg_info_p++)
+    atpg_info_p->sim_detected = 0;
+
+  /* collect "changed-subformula" in BFS-order: parents before children */
+  Stack *nodes = create_stack (atpg_rr->mm, DEFAULT_STACK_SIZE);
+  push_stack (atpg_rr->mm, nodes, root);
+
+  unsigned int pos;
+  for (pos = 0; pos < count_stack (nodes); pos++)
+    {
+      Node *node = nodes->elems[pos];
+      if (!is_literal_node (node))
+        atpg_sim_push_children (nenofex, nodes, node);
+    }
+
+  unsigned int round;
+  for (round = 0; round < ATPG_SIMULATION_ROUNDS; round++)
+    {
+      void **v_node;
+      for (v_node = nodes->elems; v_node < nodes->top; v_node++)
+        {
+          Node *node = *v_node;
+          if (!is_literal_node (node))
+            {
+              node_atpg_info (nenofex, node)->sim_value = is_and_node (node) ?
+                ATPG_SIM_ALL_ONES : 0;
+              node_atpg_info (nenofex, node)->sim_ctrl2 = 0;
+            }
+        }
+
+      atpg_simulation_round (nenofex, nodes,
+                             ++atpg_rr->sim_seed * 0xd1b54a32d192ed03ULL);
+    }
+
+  delete_stack (atpg_rr->mm, nodes);
+}
+
+#endif /* ATPG_SIMULATION */
+
+
+/*
+- expired deadline acts like a propagation cutoff between two faults
+- returns 'atpg_rr->prop_cutoff'
+*/
+static int
+deadline_cutoff (Nenofex * nenofex, ATPGRedundancyRemover * atpg_rr)
+{
+  if (!atpg_rr->prop_cutoff && deadline_expired (nenofex, 0))
+    atpg_rr->prop_cutoff = 1;
+
+  return atpg_rr->prop_cutoff;
+}
+
+
 /*
 - core function for ATPG-redundancy-removal
 - test all nodes on fault-queue for untestable stuck-at-faults
@@ -2462,6 +2742,8 @@ test_all_faults (Nenofex * nenofex, ATPGRedundancyRemover * atpg_rr)
   assert (count_stack (atpg_rr->propagated_vars) == 0);
   assert (!nenofex->atpg_rr_abort);
 
+  profile_enter (nenofex, NENOFEX_PHASE_ATPG);
+
   atpg_rr->stats.fwd_prop_cnt = atpg_rr->atpg_fwd_prop_cnt;
   atpg_rr->stats.bwd_prop_cnt = atpg_rr->atpg_bwd_prop_cnt;
 
@@ -2475,14 +2757,21 @@ test_all_faults (Nenofex * nenofex, ATPGRedundancyRemover * atpg_rr)
       assert (atpg_rr->global_atpg_test_node_mark == 0);
 #endif
 
-      while (!atpg_rr->prop_cutoff
+#if ATPG_SIMULATION
+      /* NOTE: not repeated after deletions in this pass, faults becoming
+         redundant by a deletion will be tested in the next pass */
+      simulate_faults (nenofex, atpg_rr);
+#endif
+
+      while (!deadline_cutoff (nenofex, atpg_rr)
              && (fault_node = dequeue (atpg_rr->fault_queue)))
         {
           if (fault_node->deleted || fault_node->skip)
             continue;
 
 #if RESTRICT_ATPG_FAULT_NODE_SET
-          ATPGInfo *node_atpg_info = fault_node->node->atpg_info;
+          ATPGInfo *node_atpg_info =
+            node_atpg_info (nenofex, fault_node->node);
           /* IMPORTANT NOTE: THIS DOES NOT YET WORK PROPERLY TOGETHER WITH SUCCESSIVE CALLS OF FUNCTION */
           node_atpg_info->queue_mark = !atpg_rr->global_atpg_test_node_mark;    /* mark as being taken from queue */
 
@@ -2504,7 +2793,8 @@ test_all_faults (Nenofex * nenofex, ATPGRedundancyRemover * atpg_rr)
 
 #if ATPG_SKIP_FAULT_NODES_NO_LIT_CHILDREN
           if (!is_literal_node (fault_node->node) &&
-              !is_literal_node (fault_node->node->child_list.first))
+              !is_literal_node (node_at (nenofex,
+                                         fault_node->node->child_list.first)))
             {
               enqueue (atpg_rr->mm, non_redundant_faults, fault_node);
               continue;
@@ -2513,18 +2803,28 @@ test_all_faults (Nenofex * nenofex, ATPGRedundancyRemover * atpg_rr)
 
 #if ATPG_SKIP_FAULT_NODES_OP_CHILDREN
           if (!is_literal_node (fault_node->node) &&
-              !is_literal_node (fault_node->node->child_list.last))
+              !is_literal_node (node_at (nenofex,
+                                         fault_node->node->child_list.last)))
             {
               enqueue (atpg_rr->mm, non_redundant_faults, fault_node);
               continue;
             }
 #endif
 
-          assert (fault_node->node->atpg_info->fault_node);
+#if ATPG_SIMULATION
+          if (node_atpg_info (nenofex, fault_node->node)->sim_detected)
+            {                   /* testable -> can not be redundant */
+              atpg_rr->stats.sim_detected_fault_cnt++;
+              enqueue (atpg_rr->mm, non_redundant_faults, fault_node);
+              continue;
+            }
+#endif
+
+          assert (node_atpg_info (nenofex, fault_node->node)->fault_node);
           assert (nenofex->changed_subformula.lca || nenofex->atpg_rr_abort);
           assert (!nenofex->atpg_rr_reset_changed_subformula ||
                   nenofex->changed_subformula.lca);
-          assert (!fault_node->node->atpg_info->collected);
+          assert (!node_atpg_info (nenofex, fault_node->node)->collected);
           assert (!nenofex->atpg_rr_abort);
           assert (!count_stack (atpg_rr->touched_nodes));
           assert (!count_queue (atpg_rr->propagation_queue));
@@ -2555,7 +2855,7 @@ test_all_faults (Nenofex * nenofex, ATPGRedundancyRemover * atpg_rr)
                 }
 
               reset_touched_variables (atpg_rr);
-              reset_touched_nodes (atpg_rr);
+              reset_touched_nodes (nenofex);
               atpg_rr->conflict = 0;
             }                   /* end: redundant fault */
           else
@@ -2570,7 +2870,7 @@ test_all_faults (Nenofex * nenofex, ATPGRedundancyRemover * atpg_rr)
               if (!atpg_rr->restricted_clean_up)
                 {
                   reset_touched_variables (atpg_rr);
-                  reset_touched_nodes (atpg_rr);
+                  reset_touched_nodes (nenofex);
                 }
               else              /* path nodes already unmarked */
                 {
@@ -2634,9 +2934,19 @@ test_all_faults (Nenofex * nenofex, ATPGRedundancyRemover * atpg_rr)
                nenofex->atpg_rr->stats.fault_cnt);
       fprintf (stderr, " #red_faults = %d\n",
                nenofex->atpg_rr->stats.red_fault_cnt);
+      fprintf (stderr, " #sim_detected_faults = %d\n",
+               nenofex->atpg_rr->stats.sim_detected_fault_cnt);
       fprintf (stderr, "\n");
     }
 
+  if (stats_basic (nenofex))
+    {
+      nenofex->stats.atpg_tested_faults += atpg_rr->stats.fault_cnt;
+      nenofex->stats.atpg_redundant_faults += atpg_rr->stats.red_fault_cnt;
+      nenofex->stats.atpg_sim_detected_faults +=
+        atpg_rr->stats.sim_detected_fault_cnt;
+    }
+
   redundancies_found = nenofex->atpg_rr->stats.red_fault_cnt;
   atpg_rr->atpg_fwd_prop_cnt = atpg_rr->stats.fwd_prop_cnt;
   atpg_rr->atpg_bwd_prop_cnt = atpg_rr->stats.bwd_prop_cnt;
@@ -2653,6 +2963,8 @@ test_all_faults (Nenofex * nenofex, ATPGRedundancyRemover * atpg_rr)
   reset_stack (atpg_rr->bwd_prop_stack);
   atpg_rr->prop_cutoff = atpg_rr->restricted_clean_up = 0;
 
+  profile_leave (nenofex, NENOFEX_PHASE_ATPG);
+
   return redundancies_found;
 }
 
@@ -2697,14 +3009,14 @@ print_atpg_graph (Nenofex * nenofex)
           printf ("%d (%s): ", cur->id, is_or_node (cur) ? "||" : "&&");
 
           Node *child;
-          for (child = cur->child_list.last; child;
-               child = child->level_link.prev)
+          for (child = node_at (nenofex, cur->child_list.last); child;
+               child = node_at (nenofex, child->level_link.prev))
             {
               push_stack (nenofex->mm, stack, (void *) child);
             }
 
-          for (child = cur->child_list.first; child;
-               child = child->level_link.next)
+          for (child = node_at (nenofex, cur->child_list.first); child;
+               child = node_at (nenofex, child->level_link.next))
             {
               printf ("%d", child->id);
               if (is_literal_node (child))
@@ -2727,14 +3039,15 @@ print_atpg_graph (Nenofex * nenofex)
 - could instead check if node has a watcher stack?
 */
 static long int
-all_children_atpg_relevant (Node * node)
+all_children_atpg_relevant (Nenofex * nenofex, Node * node)
 {
   long int result = 1;
 
   Node *ch;
-  for (ch = node->child_list.first; result && ch; ch = ch->level_link.next)
+  for (ch = node_at (nenofex, node->child_list.first); result && ch;
+       ch = node_at (nenofex, ch->level_link.next))
     {
-      result = (long int) ch->atpg_info;
+      result = (long int) node_atpg_info (nenofex, ch);
     }
 
   return result;
@@ -2760,7 +3073,7 @@ find_highest_implication_on_path (Nenofex * nenofex, Node * fault_node)
       assert (!is_literal_node (fault_node));
 #if ASSERT_CHILDREN_ASSIGNMENTS
       assert (count_children_assigned_value
-              (fault_node, ATPG_ASSIGNMENT_UNDEFINED));
+              (nenofex, fault_node, ATPG_ASSIGNMENT_UNDEFINED));
 #endif
       return 0;
     }
@@ -2775,7 +3088,7 @@ find_highest_implication_on_path (Nenofex * nenofex, Node * fault_node)
     return 0;
 
   Node *high_impl = 0;
-  Node *cur = fault_node->parent;
+  Node *cur = node_at (nenofex, fault_node->parent);
 
   assert ((!cur || cur->level != changed_subformula_lca_level) ||
           cur == changed_subformula_lca);
@@ -2783,7 +3096,7 @@ find_highest_implication_on_path (Nenofex * nenofex, Node * fault_node)
   if (!cur || cur->level <= changed_subformula_lca_level)
     return 0;
 
-  cur = cur->parent;
+  cur = node_at (nenofex, cur->parent);
 
   assert (cur);
   assert (cur->level >= changed_subformula_lca_level);
@@ -2792,7 +3105,7 @@ find_highest_implication_on_path (Nenofex * nenofex, Node * fault_node)
     {
       if (node_assigned (cur) == node_assigned (fault_node))
         high_impl = cur;
-      cur = cur->parent;
+      cur = node_at (nenofex, cur->parent);
     }
   while (cur && cur->level >= changed_subformula_lca_level);
 
@@ -2806,9 +3119,9 @@ find_highest_implication_on_path (Nenofex * nenofex, Node * fault_node)
   if (high_impl)
     {
       if ((is_and_node (high_impl) && node_assigned_true (high_impl) &&
-           !all_children_atpg_relevant (high_impl)) ||
+           !all_children_atpg_relevant (nenofex, high_impl)) ||
           (is_or_node (high_impl) && node_assigned_false (high_impl) &&
-           !all_children_atpg_relevant (high_impl)))
+           !all_children_atpg_relevant (nenofex, high_impl)))
         high_impl = 0;
     }
 
@@ -2835,7 +3148,7 @@ derive_implications_from_node (Nenofex * nenofex, Node * fault_node,
 
   Node *relevant_implication = 0;
 
-  fault_sensitization (atpg_rr, fault_node, fault_type);
+  fault_sensitization (nenofex, fault_node, fault_type);
   assert (!atpg_rr->conflict);
 
   if (count_queue (atpg_rr->propagation_queue) != 0)
@@ -2864,18 +3177,20 @@ static void
 unlink_and_add_implication (Nenofex * nenofex, Node * fault_node,
                             Node * insert_at)
 {
-  FaultNode *fault_parent = fault_node->parent->atpg_info->fault_node;
+  FaultNode *fault_parent =
+    node_atpg_info (nenofex,
+                    node_at (nenofex, fault_node->parent))->fault_node;
   Node *fault_parent_node = fault_parent->node;
 
-  if (fault_parent_node->atpg_info->atpg_ch)
+  if (node_atpg_info (nenofex, fault_parent_node)->atpg_ch)
     {
-      remove_child_from_watcher_list (fault_parent_node, fault_node);
+      remove_child_from_watcher_list (nenofex, fault_parent_node, fault_node);
     }
   unlink_node (nenofex, fault_node);
   update_size_subformula (nenofex, fault_parent_node,
                           -fault_node->size_subformula);
   add_node_to_child_list (nenofex, insert_at, fault_node);
-  update_size_subformula (nenofex, fault_node->parent,
+  update_size_subformula (nenofex, node_at (nenofex, fault_node->parent),
                           +fault_node->size_subformula);
   update_level (nenofex, fault_node);
 
@@ -2890,10 +3205,11 @@ unlink_and_add_implication (Nenofex * nenofex, Node * fault_node,
 
   if (!fault_parent->deleted && fault_parent_node->num_children == 1)
     {
-      assert (fault_parent_node->child_list.first ==
-              fault_parent_node->child_list.last);
+      assert (node_at (nenofex, fault_parent_node->child_list.first) ==
+              node_at (nenofex, fault_parent_node->child_list.last));
 
-      if (is_literal_node (fault_parent_node->child_list.first))
+      if (is_literal_node (node_at (nenofex,
+                                    fault_parent_node->child_list.first)))
         update_size_subformula (nenofex, fault_parent_node, -1);
       else
         update_size_subformula (nenofex, fault_parent_node, -2);        /* save another node */
@@ -2904,7 +3220,7 @@ unlink_and_add_implication (Nenofex * nenofex, Node * fault_node,
 #ifndef NDEBUG
   if (!fault_parent->deleted)
     {
-      assert (fault_parent_node->atpg_info->collected);
+      assert (node_atpg_info (nenofex, fault_parent_node)->collected);
     }
 #endif
 }
@@ -2930,15 +3246,16 @@ unlink_and_add_implication (Nenofex * nenofex, Node * fault_node,
 */
 
 #define apply_transformation() \
-  insert_at_fault_node = insert_at->atpg_info->fault_node; \
+  insert_at_fault_node = node_atpg_info (nenofex, insert_at)->fault_node; \
   unlink_and_add_implication(nenofex, fault_node, insert_at); \
   if (!insert_at_fault_node->deleted) \
   { /* transformation may cause deletion of insert-node */ \
-    if (insert_at->atpg_info->atpg_ch) \
+    if (node_atpg_info (nenofex, insert_at)->atpg_ch) \
     { \
-      push_stack(atpg_rr->mm, insert_at->atpg_info->atpg_ch, fault_node->atpg_info->fault_node); \
+      push_stack(atpg_rr->mm, node_atpg_info (nenofex, insert_at)->atpg_ch, \
+                 node_atpg_info (nenofex, fault_node)->fault_node); \
     } \
-    init_counter_and_watcher(insert_at); \
+    init_counter_and_watcher(nenofex, insert_at); \
   }
 
 static void
@@ -2981,7 +3298,7 @@ transform_subformula_by_global_flow_implication (Nenofex * nenofex,
           fprintf (stderr, "TRANSFORM CASE 1.1\n");
 #endif
 
-          collect_fault_path_node (atpg_rr, highest_implication);
+          collect_fault_path_node (nenofex, highest_implication);
 
           insert_at = is_and_node (highest_implication) ?
             or_node (nenofex) : and_node (nenofex);
@@ -2990,10 +3307,11 @@ transform_subformula_by_global_flow_implication (Nenofex * nenofex,
           update_size_subformula (nenofex, insert_at,
                                   nenofex->graph_root->size_subformula + 1);
 
-          assign_node_atpg_info (atpg_rr, insert_at);
-          assert (!insert_at->atpg_info->atpg_ch);
-          assert (!insert_at->atpg_info->watcher_pos);
-          enqueue (atpg_rr->mm, atpg_rr->fault_queue, insert_at->atpg_info->fault_node);
+          assign_node_atpg_info (nenofex, insert_at);
+          assert (!node_atpg_info (nenofex, insert_at)->atpg_ch);
+          assert (!node_atpg_info (nenofex, insert_at)->watcher_pos);
+          enqueue (atpg_rr->mm, atpg_rr->fault_queue,
+                   node_atpg_info (nenofex, insert_at)->fault_node);
 
           nenofex->graph_root = insert_at;
 
@@ -3002,8 +3320,11 @@ transform_subformula_by_global_flow_implication (Nenofex * nenofex,
 
           nenofex->changed_subformula.lca = insert_at;
           assert (insert_at->child_list.first);
-          assert (insert_at->child_list.first == insert_at->child_list.last);
-          add_changed_lca_child (nenofex, insert_at->child_list.first);
+          assert (node_at (nenofex, insert_at->child_list.first) ==
+                  node_at (nenofex, insert_at->child_list.last));
+          add_changed_lca_child (nenofex,
+                                 node_at (nenofex,
+                                          insert_at->child_list.first));
           add_changed_lca_child (nenofex, fault_node);
         }
       else
@@ -3027,8 +3348,8 @@ transform_subformula_by_global_flow_implication (Nenofex * nenofex,
       if ((true_implies_true && is_and_node (highest_implication)) ||
           (!true_implies_true && is_or_node (highest_implication)))
         {
-          insert_at = highest_implication->parent;
-          collect_fault_path_node (atpg_rr, highest_implication);
+          insert_at = node_at (nenofex, highest_implication->parent);
+          collect_fault_path_node (nenofex, highest_implication);
 
 #if PRINT_INFO_DETAILS
           fprintf (stderr, "TRANSFORM CASE 2.1\n");
@@ -3037,18 +3358,19 @@ transform_subformula_by_global_flow_implication (Nenofex * nenofex,
           ATPGInfo *insert_at_atpg_info;
           /* BUG-FIX: problem if changed-lca had only 1 child remaining -> will be set back; 
              ->parent will already have atpg_info-pointer */
-          if (!(insert_at_atpg_info = insert_at->atpg_info))
+          if (!(insert_at_atpg_info = node_atpg_info (nenofex, insert_at)))
             {
-              assign_node_atpg_info (atpg_rr, insert_at);
+              assign_node_atpg_info (nenofex, insert_at);
 
-              insert_at_atpg_info = insert_at->atpg_info;
+              insert_at_atpg_info = node_atpg_info (nenofex, insert_at);
               /* special case: 'insert_at' will get watcher list with exactly two ch. */
               insert_at_atpg_info->atpg_ch =
                 create_stack (atpg_rr->mm, DEFAULT_STACK_SIZE);
               insert_at_atpg_info->watcher_pos =
                 insert_at_atpg_info->atpg_ch->elems;
               push_stack (atpg_rr->mm, insert_at_atpg_info->atpg_ch,
-                          highest_implication->atpg_info->fault_node);
+                          node_atpg_info (nenofex,
+                                          highest_implication)->fault_node);
             }
           else                  /* has already pointer to ATPInfo -> must set up watchers */
             {
@@ -3058,12 +3380,16 @@ transform_subformula_by_global_flow_implication (Nenofex * nenofex,
               insert_at_atpg_info->watcher_pos =
                 insert_at_atpg_info->atpg_ch->elems;
               push_stack (atpg_rr->mm, insert_at_atpg_info->atpg_ch,
-                          highest_implication->atpg_info->fault_node);
+                          node_atpg_info (nenofex,
+                                          highest_implication)->fault_node);
             }
 
           /* NOT sure whether this is helpful: enqueue new root ? rather not */
           assert (insert_at_atpg_info->fault_node ==
-                  highest_implication->parent->atpg_info->fault_node);
+                  node_atpg_info (nenofex,
+                                  node_at (nenofex,
+                                           highest_implication->parent))->
+                  fault_node);
           enqueue (atpg_rr->mm, atpg_rr->fault_queue, insert_at_atpg_info->fault_node);
 
           Node *tmp = nenofex->changed_subformula.lca;
@@ -3087,7 +3413,8 @@ transform_subformula_by_global_flow_implication (Nenofex * nenofex,
 
       apply_transformation ();
     }
-  else if (highest_implication->parent == changed_subformula->lca)
+  else if (node_at (nenofex, highest_implication->parent) ==
+           changed_subformula->lca)
     {                           /* CASE 3 */
 
       if ((true_implies_true && is_and_node (highest_implication)) ||
@@ -3097,9 +3424,9 @@ transform_subformula_by_global_flow_implication (Nenofex * nenofex,
           fprintf (stderr, "TRANSFORM CASE 3.1\n");
 #endif
 
-          insert_at = highest_implication->parent;
+          insert_at = node_at (nenofex, highest_implication->parent);
 
-          collect_fault_path_node (atpg_rr, highest_implication);
+          collect_fault_path_node (nenofex, highest_implication);
           add_changed_lca_child (nenofex, fault_node);
         }
       else
@@ -3126,8 +3453,8 @@ transform_subformula_by_global_flow_implication (Nenofex * nenofex,
           fprintf (stderr, "TRANSFORM CASE 4.1\n");
 #endif
 
-          collect_fault_path_node (atpg_rr, highest_implication);
-          insert_at = highest_implication->parent;
+          collect_fault_path_node (nenofex, highest_implication);
+          insert_at = node_at (nenofex, highest_implication->parent);
         }
       else
         {
@@ -3154,8 +3481,9 @@ transform_subformula_by_global_flow_implication (Nenofex * nenofex,
 - used during assertion checking only
 */
 static void
-assert_all_atpg_info_reset (ATPGRedundancyRemover * atpg_rr)
+assert_all_atpg_info_reset (Nenofex * nenofex)
 {
+  ATPGRedundancyRemover *atpg_rr = nenofex->atpg_rr;
   ATPGInfo *atpg_info_p;
   ATPGInfo *end = atpg_rr->end_atpg_info;
 
@@ -3191,7 +3519,7 @@ assert_all_atpg_info_reset (ATPGRedundancyRemover * atpg_rr)
                   || atpg_info_p->watcher_pos == atpg_info_p->atpg_ch->elems);
           assert (atpg_info_p->atpg_ch
                   || atpg_info_p->watcher ==
-                  fault_node->node->child_list.first);
+                  node_at (nenofex, fault_node->node->child_list.first));
           assert (atpg_info_p->atpg_ch || !atpg_info_p->watcher_pos);
         }
     }                           /* end: for */
@@ -3216,7 +3544,7 @@ static void
 collect_implication_path_nodes (Nenofex * nenofex,
                                 Node * implicant, Node * highest_implication)
 {
-  Node *cur = implicant->parent;
+  Node *cur = node_at (nenofex, implicant->parent);
   assert (cur);
   assert (cur->parent);
 
@@ -3224,8 +3552,8 @@ collect_implication_path_nodes (Nenofex * nenofex,
 
   do
     {
-      collect_fault_path_node (nenofex->atpg_rr, cur);
-      cur = cur->parent;
+      collect_fault_path_node (nenofex, cur);
+      cur = node_at (nenofex, cur->parent);
     }
   while (cur->level > highest_implication_level);
 
@@ -3261,7 +3589,8 @@ mark_implicant_variables_for_update (Nenofex * nenofex,
       else
         {
           Node *ch;
-          for (ch = node->child_list.last; ch; ch = ch->level_link.prev)
+          for (ch = node_at (nenofex, node->child_list.last); ch;
+               ch = node_at (nenofex, ch->level_link.prev))
             push_stack (atpg_rr->mm, stack, ch);
         }
     }                           /* end: while stack not empty */
@@ -3302,6 +3631,8 @@ optimize_by_global_flow (Nenofex * nenofex, ATPGRedundancyRemover * atpg_rr)
   assert (count_stack (atpg_rr->touched_nodes) == 0);
   assert (count_stack (atpg_rr->propagated_vars) == 0);
 
+  profile_enter (nenofex, NENOFEX_PHASE_GLOBAL_FLOW);
+
   atpg_rr->stats.fwd_prop_cnt = atpg_rr->global_flow_fwd_prop_cnt;
   atpg_rr->stats.bwd_prop_cnt = atpg_rr->global_flow_bwd_prop_cnt;
   atpg_rr->global_flow_optimizing = 1;
@@ -3312,7 +3643,7 @@ optimize_by_global_flow (Nenofex * nenofex, ATPGRedundancyRemover * atpg_rr)
     {
       continue_optimizing = 0;
 
-      while (!atpg_rr->prop_cutoff
+      while (!deadline_cutoff (nenofex, atpg_rr)
              && (fault_node = dequeue (atpg_rr->fault_queue)))
         {
           if (fault_node->deleted)
@@ -3322,7 +3653,7 @@ optimize_by_global_flow (Nenofex * nenofex, ATPGRedundancyRemover * atpg_rr)
 
 #if GLOBAL_FLOW_SKIP_FAULT_NODES_NO_LIT_CHILDREN
           if (!is_literal_node (node)
-              && !is_literal_node (node->child_list.first))
+              && !is_literal_node (node_at (nenofex, node->child_list.first)))
             {
               enqueue (atpg_rr->mm, tested_nodes, fault_node);
               continue;
@@ -3331,7 +3662,7 @@ optimize_by_global_flow (Nenofex * nenofex, ATPGRedundancyRemover * atpg_rr)
 
 #if GLOBAL_FLOW_SKIP_FAULT_NODES_OP_CHILDREN
           if (!is_literal_node (node)
-              && !is_literal_node (node->child_list.last))
+              && !is_literal_node (node_at (nenofex, node->child_list.last)))
             {
               enqueue (atpg_rr->mm, tested_nodes, fault_node);
               continue;
@@ -3356,7 +3687,7 @@ optimize_by_global_flow (Nenofex * nenofex, ATPGRedundancyRemover * atpg_rr)
             fault_type = is_and_node (node) ?
               ATPG_FAULT_TYPE_STUCK_AT_0 : ATPG_FAULT_TYPE_STUCK_AT_1;
           else if (node->parent)
-            fault_type = is_and_node (node->parent) ?
+            fault_type = is_and_node (node_at (nenofex, node->parent)) ?
               ATPG_FAULT_TYPE_STUCK_AT_1 : ATPG_FAULT_TYPE_STUCK_AT_0;
           else
             {
@@ -3373,7 +3704,7 @@ optimize_by_global_flow (Nenofex * nenofex, ATPGRedundancyRemover * atpg_rr)
           assert (!nenofex->atpg_rr_abort);
           assert (!atpg_rr->conflict);
           assert (!atpg_rr->restricted_clean_up);
-          assert (!fault_node->node->atpg_info->collected);
+          assert (!node_atpg_info (nenofex, fault_node->node)->collected);
           assert (!count_stack (atpg_rr->touched_nodes));
           assert (!count_queue (atpg_rr->propagation_queue));
           assert (count_stack (atpg_rr->propagated_vars) == 0);
@@ -3411,7 +3742,7 @@ optimize_by_global_flow (Nenofex * nenofex, ATPGRedundancyRemover * atpg_rr)
                            "No ATPGInfo pointers left, aborting global flow optimization\n");
 #endif
                   reset_touched_variables (atpg_rr);
-                  reset_touched_nodes (atpg_rr);
+                  reset_touched_nodes (nenofex);
                   continue_optimizing = 0;
                   break;
                 }
@@ -3426,14 +3757,14 @@ optimize_by_global_flow (Nenofex * nenofex, ATPGRedundancyRemover * atpg_rr)
                 }
 
               reset_touched_variables (atpg_rr);
-              reset_touched_nodes (atpg_rr);
+              reset_touched_nodes (nenofex);
             }                   /* end: implication found  */
           else
             {
               if (!atpg_rr->restricted_clean_up)
                 {
                   reset_touched_variables (atpg_rr);
-                  reset_touched_nodes (atpg_rr);
+                  reset_touched_nodes (nenofex);
                 }
               else              /* need not reset anything in this context */
                 {
@@ -3441,7 +3772,7 @@ optimize_by_global_flow (Nenofex * nenofex, ATPGRedundancyRemover * atpg_rr)
 
 #ifndef NDEBUG
 #if ASSERT_ALL_ATPG_INFO_RESET
-                  assert_all_atpg_info_reset (atpg_rr);
+                  assert_all_atpg_info_reset (nenofex);
 #endif
 #endif
                 }               /* end: restricted clean up */
@@ -3497,6 +3828,13 @@ optimize_by_global_flow (Nenofex * nenofex, ATPGRedundancyRemover * atpg_rr)
       fprintf (stderr, "\n");
     }
 
+  if (stats_basic (nenofex))
+    {
+      nenofex->stats.global_flow_tested_nodes += atpg_rr->stats.fault_cnt;
+      nenofex->stats.global_flow_implications +=
+        atpg_rr->stats.derived_implications_cnt;
+    }
+
   implications_found = nenofex->atpg_rr->stats.derived_implications_cnt;
   atpg_rr->global_flow_fwd_prop_cnt = atpg_rr->stats.fwd_prop_cnt;
   atpg_rr->global_flow_bwd_prop_cnt = atpg_rr->stats.bwd_prop_cnt;
@@ -3512,6 +3850,8 @@ optimize_by_global_flow (Nenofex * nenofex, ATPGRedundancyRemover * atpg_rr)
   assert (!atpg_rr->conflict);
   atpg_rr->global_flow_optimizing = 0;
 
+  profile_leave (nenofex, NENOFEX_PHASE_GLOBAL_FLOW);
+
   return implications_found;
 }
 
@@ -3519,58 +3859,155 @@ optimize_by_global_flow (Nenofex * nenofex, ATPGRedundancyRemover * atpg_rr)
 
 
 /*
-- set propagation limits with respect to subformula size
+- propagation limit with respect to subformula size
 - favour small formulas
 - actually obsolete: optimizing large subformulae infeasible
 - subformulae sizes limited by default
 */
-static void
-set_propagation_limits (unsigned int size)
+static unsigned int
+size_propagation_limit (unsigned int size)
 {
+  unsigned int limit;
+
   if (size <= 800)
     {
-      ATPG_PROPAGATION_LIMIT = GLOBAL_FLOW_PROPAGATION_LIMIT = 1500000;
+      limit = 1500000;
     }
   else if (size <= 1000)
     {
-      ATPG_PROPAGATION_LIMIT = GLOBAL_FLOW_PROPAGATION_LIMIT = 1200000;
+      limit = 1200000;
     }
   else if (size <= 1500)
     {
-      ATPG_PROPAGATION_LIMIT = GLOBAL_FLOW_PROPAGATION_LIMIT = 800000;
+      limit = 800000;
     }
   else if (size <= 2000)
     {
-      ATPG_PROPAGATION_LIMIT = GLOBAL_FLOW_PROPAGATION_LIMIT = 700000;
+      limit = 700000;
     }
   else if (size <= 3000)
     {
-      ATPG_PROPAGATION_LIMIT = GLOBAL_FLOW_PROPAGATION_LIMIT = 600000;
+      limit = 600000;
     }
   else if (size <= 4000)
     {
-      ATPG_PROPAGATION_LIMIT = GLOBAL_FLOW_PROPAGATION_LIMIT = 500000;
+      limit = 500000;
     }
   else if (size <= 6000)
     {
-      ATPG_PROPAGATION_LIMIT = GLOBAL_FLOW_PROPAGATION_LIMIT = 300000;
+      limit = 300000;
     }
   else if (size <= 8000)
     {
-      ATPG_PROPAGATION_LIMIT = GLOBAL_FLOW_PROPAGATION_LIMIT = 200000;
+      limit = 200000;
     }
   else if (size <= 10000)
     {
-      ATPG_PROPAGATION_LIMIT = GLOBAL_FLOW_PROPAGATION_LIMIT = 100000;
+      limit = 100000;
     }
   else if (size <= 12000)
     {
-      ATPG_PROPAGATION_LIMIT = GLOBAL_FLOW_PROPAGATION_LIMIT = 50000;
+      limit = 50000;
     }
   else
     {
-      ATPG_PROPAGATION_LIMIT = GLOBAL_FLOW_PROPAGATION_LIMIT = 10000;
+      limit = 10000;
+    }
+
+  return limit;
+}
+
+
+/*
+- set propagation limits for next call of optimizations
+- static policy: size-based limit only
+- adaptive policy: size-based limit scaled by 'budget.scale', 
+  see 'update_propagation_budget'
+*/
+static void
+set_propagation_limits (Nenofex * nenofex, unsigned int size)
+{
+  ATPGRedundancyRemover *atpg_rr = nenofex->atpg_rr;
+  unsigned int limit = size_propagation_limit (size);
+
+  if (!nenofex->options.opt_budget_static_specified)
+    {
+      double scaled = limit * atpg_rr->budget.scale;
+      limit = scaled < ADAPTIVE_BUDGET_MIN_LIMIT ?
+        ADAPTIVE_BUDGET_MIN_LIMIT : (unsigned int) scaled;
+    }
+
+  atpg_rr->atpg_prop_limit = atpg_rr->global_flow_prop_limit = limit;
+}
+
+
+/*
+- adaptive policy: after each call of optimizations, grow or shrink 
+  propagation budget of subsequent calls
+- budget matters only if a call was cut off: then grow budget if recent 
+  cut off calls were successful and shrink it otherwise
+- success rate: deleted nodes per 1000 propagations, averaged over recent 
+  cut off calls
+- also shrink budget of a cut off call if optimizations took more than 
+  '--opt-time-share' percent of CPU time so far, measured for the calling
+  thread only to keep decisions independent of concurrent instances
+*/
+static void
+update_propagation_budget (Nenofex * nenofex)
+{
+  ATPGRedundancyRemover *atpg_rr = nenofex->atpg_rr;
+
+  double elapsed = solve_cpu_time (nenofex);
+  double call_time = elapsed - atpg_rr->budget.call_start_time;
+  double old_scale = atpg_rr->budget.scale;
+  char *decision = "keep";
+
+  unsigned int props = atpg_rr->global_flow_fwd_prop_cnt +
+    atpg_rr->global_flow_bwd_prop_cnt +
+    atpg_rr->atpg_fwd_prop_cnt + atpg_rr->atpg_bwd_prop_cnt;
+  int deleted = nenofex->stats.deleted_nodes_by_global_flow_redundancy -
+    atpg_rr->budget.call_start_deleted;
+  int cutoff = atpg_rr->global_flow_prop_cutoff || atpg_rr->atpg_prop_cutoff;
+
+  atpg_rr->budget.time += call_time;
+
+  if (cutoff)
+    {
+      atpg_rr->budget.yield =
+        (1 - ADAPTIVE_BUDGET_DECAY) * atpg_rr->budget.yield +
+        ADAPTIVE_BUDGET_DECAY * (deleted * 1000.0 / (props + 1));
+
+      if (elapsed >= ADAPTIVE_BUDGET_MIN_ELAPSED &&
+          atpg_rr->budget.time * 100 >
+          elapsed * nenofex->options.opt_time_share)
+        {
+          atpg_rr->budget.scale /= 2;
+          decision = "shrink (time)";
+        }
+      else if (atpg_rr->budget.yield >= ADAPTIVE_BUDGET_MIN_YIELD)
+        {
+          atpg_rr->budget.scale *= 2;
+          decision = "grow";
+        }
+      else
+        {
+          atpg_rr->budget.scale /= 2;
+          decision = "shrink (yield)";
+        }
     }
+
+  if (atpg_rr->budget.scale < ADAPTIVE_BUDGET_MIN_SCALE)
+    atpg_rr->budget.scale = ADAPTIVE_BUDGET_MIN_SCALE;
+  else if (atpg_rr->budget.scale > ADAPTIVE_BUDGET_MAX_SCALE)
+    atpg_rr->budget.scale = ADAPTIVE_BUDGET_MAX_SCALE;
+
+  if (nenofex->options.show_opt_info_specified)
+    fprintf (stderr,
+             "Budget: %u props, %d deleted nodes, %.3f sec., "
+             "yield %.3f, opt. time %.2f of %.2f sec., %s: "
+             "scale %.4f -> %.4f\n", props, deleted, call_time,
+             atpg_rr->budget.yield, atpg_rr->budget.time, elapsed, decision,
+             old_scale, atpg_rr->budget.scale);
 }
 
 
@@ -3595,11 +4032,11 @@ allocate_atpg_info_pointers (Nenofex * nenofex)
              size);
 
   if (!nenofex->options.propagation_limit_specified)
-    set_propagation_limits (size);
+    set_propagation_limits (nenofex, size);
   else
     {
-      ATPG_PROPAGATION_LIMIT =
-        GLOBAL_FLOW_PROPAGATION_LIMIT = nenofex->options.propagation_limit;
+      atpg_rr->atpg_prop_limit =
+        atpg_rr->global_flow_prop_limit = nenofex->options.propagation_limit;
     }
 
   atpg_rr->byte_size_atpg_info_array = (size + size / 2) * sizeof (ATPGInfo);
@@ -3647,8 +4084,9 @@ mark_affected_variables_by_fault_path_nodes (Nenofex * nenofex)
       assert (!is_literal_node (node));
 
       Node *ch;
-      for (ch = node->child_list.first;
-           ch && is_literal_node (ch); ch = ch->level_link.next)
+      for (ch = node_at (nenofex, node->child_list.first);
+           ch && is_literal_node (ch);
+             ch = node_at (nenofex, ch->level_link.next))
         {
           Var *var = ch->lit->var;
           if (var->exp_costs.lca_object.lca)    /* BUG FIX */
@@ -3660,20 +4098,23 @@ mark_affected_variables_by_fault_path_nodes (Nenofex * nenofex)
 
       /* check whether path node occurs in lca-child-list of some var 
          -> corresponding variables have to be marked for inc-score update */
-      Node *parent = node->parent;
+      Node *parent = node_at (nenofex, node->parent);
 
-      Stack *lca_child_list_occs = node->lca_child_list_occs;
+      Stack *lca_child_list_occs =
+        node_cold (nenofex, node)->lca_child_list_occs;
 
       /* FAILED: possibly because LCAS updated AFTER FLOW/ATPG   
          --assert(!lca_child_list_occs || !count_stack(lca_child_list_occs) || 
-         parent->var_lca_list.first); */
+         node_cold (nenofex, parent)->var_lca_list.first); */
 
       if (lca_child_list_occs && parent && parent->level >= atpg_root_level)
         {
           /* NOT SURE */
           /*
-             assert(!count_stack(lca_child_list_occs) || parent->var_lca_list.first);
-             assert(!count_stack(lca_child_list_occs) || parent->var_lca_list.last);
+             assert(!count_stack(lca_child_list_occs)
+                    || node_cold (nenofex, parent)->var_lca_list.first);
+             assert(!count_stack(lca_child_list_occs)
+                    || node_cold (nenofex, parent)->var_lca_list.last);
            */
 
           void **v_var, **end;
@@ -3760,6 +4201,10 @@ simplify_by_global_flow_and_atpg_main (Nenofex * nenofex)
 
   nenofex->atpg_rr_called = 1;
 
+  atpg_rr->budget.call_start_time = solve_cpu_time (nenofex);
+  atpg_rr->budget.call_start_deleted =
+    nenofex->stats.deleted_nodes_by_global_flow_redundancy;
+
   allocate_atpg_info_pointers (nenofex);
 
   init_subformula_atpg_info (nenofex);
@@ -3872,7 +4317,18 @@ SKIP_ATPG:
 #endif
     }
 
-  reset_atpg_redundancy_remover (atpg_rr);
+  if (!nenofex->options.propagation_limit_specified &&
+      !nenofex->options.opt_budget_static_specified)
+    update_propagation_budget (nenofex);
+
+  /* propagation counts are kept across rounds of this call */
+  if (stats_basic (nenofex))
+    nenofex->stats.opt_propagations +=
+      (unsigned long long) atpg_rr->global_flow_fwd_prop_cnt +
+      atpg_rr->global_flow_bwd_prop_cnt + atpg_rr->atpg_fwd_prop_cnt +
+      atpg_rr->atpg_bwd_prop_cnt;
+
+  reset_atpg_redundancy_remover (nenofex);
   nenofex->atpg_rr_called = 0;
   nenofex->atpg_rr_abort = 0;
   nenofex->atpg_rr_reset_changed_subformula = 0;
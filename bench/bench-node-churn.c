@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+#include "../nenofex_types.h"
+
+/*
+  Node churn as caused by expansions: copy a subtree of 'SUBTREE_SIZE'
+  nodes, then delete a subtree of the same size somewhere else in the
+  graph. Compares plain 'mem_malloc'/'mem_free' against slab allocation.
+
+  usage: bench-node-churn [ <rounds> ]
+*/
+
+#define GRAPH_SIZE 200000
+#define SUBTREE_SIZE 1000
+#define DEFAULT_ROUNDS 2000
+
+static double
+seconds (void)
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double
+churn (int use_slab, unsigned int rounds, size_t * max_bytes)
+{
+  MemManager *mm = memmanager_create ();
+  Node **nodes = calloc (GRAPH_SIZE, sizeof (Node *));
+  unsigned int i, r;
+  srand (1);
+
+  double start = seconds ();
+
+  for (i = 0; i < GRAPH_SIZE; i++)
+    {
+      nodes[i] = use_slab ? mem_slab_malloc (mm, sizeof (Node)) :
+        mem_malloc (mm, sizeof (Node));
+      memset (nodes[i], 0, sizeof (Node));
+    }
+
+  for (r = 0; r < rounds; r++)
+    {
+      unsigned int start_pos = rand () % (GRAPH_SIZE - SUBTREE_SIZE);
+
+      for (i = start_pos; i < start_pos + SUBTREE_SIZE; i++)
+        {
+          if (use_slab)
+            mem_slab_free (mm, nodes[i], sizeof (Node));
+          else
+            mem_free (mm, nodes[i], sizeof (Node));
+        }
+
+      for (i = start_pos; i < start_pos + SUBTREE_SIZE; i++)
+        {
+          nodes[i] = use_slab ? mem_slab_malloc (mm, sizeof (Node)) :
+            mem_malloc (mm, sizeof (Node));
+          memset (nodes[i], 0, sizeof (Node));
+          nodes[i]->id = i;
+        }
+    }
+
+  assert (get_cur_bytes (mm) == GRAPH_SIZE * sizeof (Node));
+
+  if (use_slab)
+    mem_slab_release (mm);
+  else
+    for (i = 0; i < GRAPH_SIZE; i++)
+      mem_free (mm, nodes[i], sizeof (Node));
+
+  double time = seconds () - start;
+
+  assert (get_cur_bytes (mm) == 0);
+  *max_bytes = get_max_bytes (mm);
+
+  free (nodes);
+  memmanager_delete (mm);
+  return time;
+}
+
+int
+main (int argc, char **argv)
+{
+  unsigned int rounds = argc > 1 ? (unsigned int) atoi (argv[1]) : DEFAULT_ROUNDS;
+  size_t malloc_max_bytes, slab_max_bytes;
+
+  double malloc_time = churn (0, rounds, &malloc_max_bytes);
+  double slab_time = churn (1, rounds, &slab_max_bytes);
+
+  /* byte accounting must not depend on the allocator */
+  assert (malloc_max_bytes == slab_max_bytes);
+
+  /* each node is allocated and freed once */
+  double ops = 2.0 * ((double) rounds * SUBTREE_SIZE + GRAPH_SIZE);
+  fprintf (stdout, "node size: %lu bytes, %.0f allocations\n",
+           (unsigned long) sizeof (Node), ops / 2);
+  fprintf (stdout, "malloc: %.3fs (%.2f M ops/s)\n", malloc_time,
+           ops / malloc_time / 1e6);
+  fprintf (stdout, "slab:   %.3fs (%.2f M ops/s)\n", slab_time,
+           ops / slab_time / 1e6);
+  return 0;
+}
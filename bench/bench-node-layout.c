@@ -0,0 +1,336 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+#include "../nenofex_types.h"
+
+/*
+  Traversal cost of the node layout: the hot part of 'Node' fills one
+  cache line, everything else lives in cold records. 'OldNode' replicates
+  the previous layout where all fields were stored in the node itself.
+
+  Both layouts get the same random tree. Nodes are shuffled within
+  windows of 'SCATTER_WINDOW' allocations, like the partly scattered
+  nodes left behind by repeated expansions. Timed per round:
+  - dfs:  collect literals as when collecting depending variables
+  - size: recount subformula sizes bottom-up like 'subformula_size'
+  - copy: copy tree and free the copy like 'copy_formula' and 'free_graph'
+
+  usage: bench-node-layout [ <nodes> [ <rounds> ] ]
+*/
+
+#define DEFAULT_NODES 500000
+#define DEFAULT_ROUNDS 10
+#define NUM_LITS 1000
+#define SCATTER_WINDOW 256
+
+typedef struct OldNode OldNode;
+
+struct OldNode
+{
+  int id;
+  unsigned int level;
+  NodeType type;
+  OldNode *parent;
+  struct
+  {
+    OldNode *next, *prev;
+  } level_link;
+  struct
+  {
+    OldNode *first, *last;
+  } child_list;
+  struct
+  {
+    OldNode *next, *prev;
+  } occ_link;
+  Lit *lit;
+  unsigned int num_children;
+  unsigned int size_subformula;
+  int size_delta;
+  unsigned int size_delta_pos;
+  ATPGInfo *atpg_info;
+  VarLCAList var_lca_list;
+  OldNode **changed_ch_list_pos;
+  OldNode *lca_jump;
+  unsigned long int lca_jump_stamp;
+  Stack *lca_child_list_occs;
+  Stack *pos_in_lca_children;
+  unsigned int mark1:1;
+  unsigned int mark2:1;
+  unsigned int mark3:1;
+};
+
+typedef struct Times Times;
+
+struct Times
+{
+  double dfs, size, copy;
+  unsigned long int check;
+};
+
+static Lit lits[NUM_LITS];
+
+static double
+seconds (void)
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+- same code for both layouts, 'T' is the node type
+- nodes are taken from 'mem_slab_malloc' in locally shuffled order
+*/
+#define DEFINE_LAYOUT(T, prefix)                                            \
+                                                                            \
+static T *                                                                  \
+prefix##_new_node (MemManager * mm)                                         \
+{                                                                           \
+  T *node = mem_slab_malloc (mm, sizeof (T));                               \
+  memset (node, 0, sizeof (T));                                             \
+  return node;                                                              \
+}                                                                           \
+                                                                            \
+static void                                                                 \
+prefix##_add_child (T * parent, T * child)                                  \
+{                                                                           \
+  child->parent = parent;                                                   \
+  child->level = parent->level + 1;                                         \
+  child->level_link.prev = parent->child_list.last;                         \
+  if (parent->child_list.last)                                              \
+    parent->child_list.last->level_link.next = child;                       \
+  else                                                                      \
+    parent->child_list.first = child;                                       \
+  parent->child_list.last = child;                                          \
+  parent->num_children++;                                                   \
+}                                                                           \
+                                                                            \
+static T *                                                                  \
+prefix##_build (MemManager * mm, T ** stack, unsigned int num_nodes)        \
+{                                                                           \
+  T **pool = malloc (num_nodes * sizeof (T *));                             \
+  unsigned int i, next = 0, head = 0, tail = 0;                             \
+                                                                            \
+  for (i = 0; i < num_nodes; i++)                                           \
+    pool[i] = prefix##_new_node (mm);                                       \
+  for (i = num_nodes - 1; i > 0; i--)                                       \
+    {                                                                       \
+      unsigned int j = i - rand () % (i % SCATTER_WINDOW + 1);              \
+      T *tmp = pool[i];                                                     \
+      pool[i] = pool[j];                                                    \
+      pool[j] = tmp;                                                        \
+    }                                                                       \
+                                                                            \
+  T *root = pool[next++];                                                   \
+  root->type = NODE_TYPE_AND;                                               \
+  stack[tail++] = root;                                                     \
+                                                                            \
+  while (head < tail)                                                       \
+    {                                                                       \
+      T *parent = stack[head++];                                            \
+      unsigned int k = 2 + rand () % 4;                                     \
+      for (i = 0; i < k && next < num_nodes; i++)                           \
+        {                                                                   \
+          T *child = pool[next++];                                          \
+          if (rand () % 100 < 45)                                           \
+            {                                                               \
+              child->type = is_and_node (parent) ? NODE_TYPE_OR :           \
+                NODE_TYPE_AND;                                              \
+              stack[tail++] = child;                                        \
+            }                                                               \
+          else                                                              \
+            {                                                               \
+              child->type = NODE_TYPE_LITERAL;                              \
+              child->lit = lits + rand () % NUM_LITS;                       \
+            }                                                               \
+          child->id = next;                                                 \
+          prefix##_add_child (parent, child);                               \
+        }                                                                   \
+      if (!parent->child_list.first)                                        \
+        {                                                                   \
+          parent->type = NODE_TYPE_LITERAL;                                 \
+          parent->lit = lits + rand () % NUM_LITS;                          \
+        }                                                                   \
+    }                                                                       \
+                                                                            \
+  for (i = next; i < num_nodes; i++)                                        \
+    mem_slab_free (mm, pool[i], sizeof (T));                                \
+  free (pool);                                                              \
+  return root;                                                              \
+}                                                                           \
+                                                                            \
+static unsigned long int                                                    \
+prefix##_dfs (T * root, T ** stack)                                         \
+{                                                                           \
+  unsigned long int result = 0;                                             \
+  unsigned int top = 0;                                                     \
+  stack[top++] = root;                                                      \
+                                                                            \
+  while (top)                                                               \
+    {                                                                       \
+      T *cur = stack[--top];                                                \
+      if (is_literal_node (cur))                                            \
+        {                                                                   \
+          if (!cur->lit->negated)                                           \
+            result += cur->level;                                           \
+        }                                                                   \
+      else                                                                  \
+        {                                                                   \
+          T *child;                                                         \
+          for (child = cur->child_list.last; child;                         \
+               child = child->level_link.prev)                              \
+            stack[top++] = child;                                           \
+        }                                                                   \
+    }                                                                       \
+  return result;                                                            \
+}                                                                           \
+                                                                            \
+static unsigned long int                                                    \
+prefix##_size (T * root, T ** stack)                                        \
+{                                                                           \
+  unsigned int top = 0;                                                     \
+  stack[top++] = root;                                                      \
+                                                                            \
+  while (top)                                                               \
+    {                                                                       \
+      T *cur = stack[--top];                                                \
+      if (is_literal_node (cur))                                            \
+        cur->size_subformula = 1;                                           \
+      else if (!cur->mark1)                                                 \
+        {                                                                   \
+          cur->mark1 = 1;                                                   \
+          stack[top++] = cur;                                               \
+          T *child;                                                         \
+          for (child = cur->child_list.last; child;                         \
+               child = child->level_link.prev)                              \
+            stack[top++] = child;                                           \
+        }                                                                   \
+      else                                                                  \
+        {                                                                   \
+          cur->mark1 = 0;                                                   \
+          cur->size_subformula = 1;                                         \
+          T *child;                                                         \
+          for (child = cur->child_list.first; child;                        \
+               child = child->level_link.next)                              \
+            cur->size_subformula += child->size_subformula;                 \
+        }                                                                   \
+    }                                                                       \
+  return root->size_subformula;                                             \
+}                                                                           \
+                                                                            \
+static T *                                                                  \
+prefix##_copy (MemManager * mm, T * node)                                   \
+{                                                                           \
+  T *copy = prefix##_new_node (mm);                                         \
+  copy->type = node->type;                                                  \
+  copy->id = node->id;                                                      \
+  copy->level = node->level;                                                \
+  copy->size_subformula = node->size_subformula;                            \
+  if (is_literal_node (node))                                               \
+    copy->lit = node->lit;                                                  \
+  else                                                                      \
+    {                                                                       \
+      T *child;                                                             \
+      for (child = node->child_list.first; child;                           \
+           child = child->level_link.next)                                  \
+        prefix##_add_child (copy, prefix##_copy (mm, child));               \
+    }                                                                       \
+  return copy;                                                              \
+}                                                                           \
+                                                                            \
+static void                                                                 \
+prefix##_free (MemManager * mm, T * root, T ** stack)                       \
+{                                                                           \
+  unsigned int top = 0;                                                     \
+  stack[top++] = root;                                                      \
+                                                                            \
+  while (top)                                                               \
+    {                                                                       \
+      T *cur = stack[--top];                                                \
+      if (!is_literal_node (cur))                                           \
+        {                                                                   \
+          T *child;                                                         \
+          for (child = cur->child_list.last; child;                         \
+               child = child->level_link.prev)                              \
+            stack[top++] = child;                                           \
+        }                                                                   \
+      mem_slab_free (mm, cur, sizeof (T));                                  \
+    }                                                                       \
+}                                                                           \
+                                                                            \
+static void                                                                 \
+prefix##_run (unsigned int num_nodes, unsigned int rounds, Times * times)   \
+{                                                                           \
+  MemManager *mm = memmanager_create ();                                    \
+  T **stack = malloc (2 * num_nodes * sizeof (T *));                        \
+  unsigned int r;                                                           \
+  double start;                                                             \
+                                                                            \
+  srand (1);                                                                \
+  T *root = prefix##_build (mm, stack, num_nodes);                          \
+  memset (times, 0, sizeof (Times));                                        \
+                                                                            \
+  for (r = 0; r < rounds; r++)                                              \
+    {                                                                       \
+      start = seconds ();                                                   \
+      times->check += prefix##_dfs (root, stack);                           \
+      times->dfs += seconds () - start;                                     \
+                                                                            \
+      start = seconds ();                                                   \
+      times->check += prefix##_size (root, stack);                          \
+      times->size += seconds () - start;                                    \
+                                                                            \
+      start = seconds ();                                                   \
+      T *copy = prefix##_copy (mm, root);                                   \
+      times->check += copy->num_children;                                   \
+      prefix##_free (mm, copy, stack);                                      \
+      times->copy += seconds () - start;                                    \
+    }                                                                       \
+                                                                            \
+  prefix##_free (mm, root, stack);                                          \
+  assert (get_cur_bytes (mm) == 0);                                         \
+  free (stack);                                                             \
+  memmanager_delete (mm);                                                   \
+}
+
+DEFINE_LAYOUT (OldNode, old)
+DEFINE_LAYOUT (Node, new)
+
+static void
+print_times (const char *name, size_t bytes, Times * times)
+{
+  fprintf (stdout, "%s %3lu bytes: dfs %.3fs, size %.3fs, copy %.3fs\n",
+           name, (unsigned long) bytes, times->dfs, times->size,
+           times->copy);
+}
+
+int
+main (int argc, char **argv)
+{
+  unsigned int num_nodes =
+    argc > 1 ? (unsigned int) atoi (argv[1]) : DEFAULT_NODES;
+  unsigned int rounds =
+    argc > 2 ? (unsigned int) atoi (argv[2]) : DEFAULT_ROUNDS;
+  Times old_times, new_times;
+  unsigned int i;
+
+  for (i = 0; i < NUM_LITS; i++)
+    lits[i].negated = i % 2;
+
+  old_run (num_nodes, rounds, &old_times);
+  new_run (num_nodes, rounds, &new_times);
+
+  /* both layouts must have traversed the same tree */
+  assert (old_times.check == new_times.check);
+
+  fprintf (stdout, "%u nodes, %u rounds\n", num_nodes, rounds);
+  print_times ("old", sizeof (OldNode), &old_times);
+  print_times ("new", sizeof (Node), &new_times);
+  fprintf (stdout, "speedup: dfs %.2fx, size %.2fx, copy %.2fx\n",
+           old_times.dfs / new_times.dfs, old_times.size / new_times.size,
+           old_times.copy / new_times.copy);
+  return 0;
+}
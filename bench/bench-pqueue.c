@@ -0,0 +1,232 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+#include <limits.h>
+#include "../nenofex_types.h"
+
+/*
+  Priority queue operations as performed on the variables of a scope:
+  scores of random variables change by small amounts ('update_key'), then
+  all variables are removed in order ('remove_min'). Compares the binary
+  heap of 'Var' pointers used before, which reads scores and positions from
+  the variables, against 'PQueue' keeping scores and positions in arrays.
+
+  usage: bench-pqueue [ <vars> [ <updates> ] ]
+*/
+
+#define DEFAULT_NUM_VARS 100000
+#define DEFAULT_UPDATES 4000000
+#define MAX_DELTA 50
+
+static double
+seconds (void)
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* binary heap of 'Var' pointers as formerly in 'nenofex.c' */
+
+static int
+compare_old (Stack * heap, int pos_a, int pos_b)
+{
+  int a = ((Var *) heap->elems[pos_a])->exp_costs.score;
+  int b = ((Var *) heap->elems[pos_b])->exp_costs.score;
+  return a < b ? -1 : a > b;
+}
+
+static void
+swap_old (Stack * heap, int pos_a, int pos_b)
+{
+  Var *var_a = heap->elems[pos_a], *var_b = heap->elems[pos_b];
+  heap->elems[pos_a] = var_b;
+  var_b->priority_slot = pos_a;
+  heap->elems[pos_b] = var_a;
+  var_a->priority_slot = pos_b;
+}
+
+static void
+up_heap_old (Stack * heap, int pos)
+{
+  while (pos > 0)
+    {
+      int parent = (pos - 1) / 2;
+      if (compare_old (heap, pos, parent) >= 0)
+        break;
+      swap_old (heap, pos, parent);
+      pos = parent;
+    }
+}
+
+static void
+down_heap_old (Stack * heap, int pos)
+{
+  int size = count_stack (heap);
+  for (;;)
+    {
+      int child = 2 * pos + 1;
+      if (child >= size)
+        break;
+      if (child + 1 < size && compare_old (heap, child, child + 1) > 0)
+        child++;
+      if (compare_old (heap, pos, child) <= 0)
+        break;
+      swap_old (heap, pos, child);
+      pos = child;
+    }
+}
+
+static Var *
+remove_min_old (Stack * heap)
+{
+  if (!count_stack (heap))
+    return 0;
+  Var *min_var = heap->elems[0], *last_var = pop_stack (heap);
+  min_var->priority_slot = -1;
+  if (min_var != last_var)
+    {
+      heap->elems[0] = last_var;
+      last_var->priority_slot = 0;
+      down_heap_old (heap, 0);
+    }
+  return min_var;
+}
+
+/* workload */
+
+typedef struct Workload Workload;
+
+struct Workload
+{
+  unsigned int num_vars;
+  unsigned int num_updates;
+  int *init_scores;
+  unsigned int *update_vars;
+  int *update_deltas;
+};
+
+static void
+run (int use_pqueue, Workload * w, double *update_time, double *remove_time,
+     unsigned long long *checksum)
+{
+  MemManager *mm = memmanager_create ();
+  Var **vars = calloc (w->num_vars, sizeof (Var *));
+  Stack *heap = create_stack (mm, 16);
+  PQueue *pqueue = create_pqueue (mm, 16);
+  unsigned int i;
+
+  for (i = 0; i < w->num_vars; i++)
+    {
+      vars[i] = mem_malloc (mm, sizeof (Var));
+      memset (vars[i], 0, sizeof (Var));
+      vars[i]->id = i;
+      vars[i]->exp_costs.score = w->init_scores[i];
+    }
+
+  for (i = 0; i < w->num_vars; i++)
+    {
+      Var *var = vars[i];
+      if (use_pqueue)
+        var->priority_slot =
+          append_pqueue (mm, pqueue, var, var->exp_costs.score);
+      else
+        {
+          push_stack (mm, heap, var);
+          var->priority_slot = count_stack (heap) - 1;
+        }
+    }
+
+  if (use_pqueue)
+    heapify_pqueue (pqueue);
+  else
+    for (i = 0; i < w->num_vars; i++)
+      up_heap_old (heap, i);
+
+  double start = seconds ();
+
+  for (i = 0; i < w->num_updates; i++)
+    {
+      Var *var = vars[w->update_vars[i]];
+      int old_score = var->exp_costs.score;
+      var->exp_costs.score += w->update_deltas[i];
+      if (use_pqueue)
+        update_key_pqueue (pqueue, var->priority_slot, var->exp_costs.score);
+      else if (var->exp_costs.score < old_score)
+        up_heap_old (heap, var->priority_slot);
+      else if (var->exp_costs.score > old_score)
+        down_heap_old (heap, var->priority_slot);
+    }
+
+  *update_time = seconds () - start;
+  start = seconds ();
+
+  Var *var;
+  int last_score = INT_MIN;
+  *checksum = 0;
+  while ((var = use_pqueue ? remove_min_pqueue (pqueue) :
+          remove_min_old (heap)))
+    {
+      assert (var->exp_costs.score >= last_score);
+      last_score = var->exp_costs.score;
+      *checksum = *checksum * 31 + last_score;
+    }
+
+  *remove_time = seconds () - start;
+
+  delete_pqueue (mm, pqueue);
+  delete_stack (mm, heap);
+  for (i = 0; i < w->num_vars; i++)
+    mem_free (mm, vars[i], sizeof (Var));
+  free (vars);
+  memmanager_delete (mm);
+}
+
+int
+main (int argc, char **argv)
+{
+  Workload w;
+  unsigned int i;
+
+  w.num_vars = argc > 1 ? (unsigned int) atoi (argv[1]) : DEFAULT_NUM_VARS;
+  w.num_updates = argc > 2 ? (unsigned int) atoi (argv[2]) : DEFAULT_UPDATES;
+  if (!w.num_vars)
+    w.num_vars = 1;
+
+  srand (1);
+  w.init_scores = calloc (w.num_vars, sizeof (int));
+  w.update_vars = calloc (w.num_updates, sizeof (unsigned int));
+  w.update_deltas = calloc (w.num_updates, sizeof (int));
+  for (i = 0; i < w.num_vars; i++)
+    w.init_scores[i] = rand () % (16 * w.num_vars);
+  for (i = 0; i < w.num_updates; i++)
+    {
+      w.update_vars[i] = rand () % w.num_vars;
+      w.update_deltas[i] = rand () % (2 * MAX_DELTA + 1) - MAX_DELTA;
+    }
+
+  double old_update, old_remove, new_update, new_remove;
+  unsigned long long old_checksum, new_checksum;
+  run (0, &w, &old_update, &old_remove, &old_checksum);
+  run (1, &w, &new_update, &new_remove, &new_checksum);
+
+  /* same sequence of scores removed */
+  assert (old_checksum == new_checksum);
+
+  fprintf (stdout, "%u variables, %u updates\n", w.num_vars, w.num_updates);
+  fprintf (stdout, "binary heap: update_key %.3fs (%.2f M ops/s), "
+           "remove_min %.3fs (%.2f M ops/s)\n",
+           old_update, w.num_updates / old_update / 1e6,
+           old_remove, w.num_vars / old_remove / 1e6);
+  fprintf (stdout, "pqueue:      update_key %.3fs (%.2f M ops/s), "
+           "remove_min %.3fs (%.2f M ops/s)\n",
+           new_update, w.num_updates / new_update / 1e6,
+           new_remove, w.num_vars / new_remove / 1e6);
+
+  free (w.init_scores);
+  free (w.update_vars);
+  free (w.update_deltas);
+  return 0;
+}
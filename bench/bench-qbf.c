@@ -0,0 +1,565 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+#include "../nenofex.h"
+
+/*
+  Parametric QBF families for tracking the performance of expansions and
+  optimizations. Each family is scaled by a single size parameter:
+
+  - random:    prefix 'E A E' with 'size' variables per block, random
+               clauses of 3 to 5 literals, seed derived from 'size'
+  - parity:    'A x E t' where 't_i' is the parity of 'x_1..x_i' and
+               't_size' must be true (false)
+  - counter:   'A e E s,c': 'size'-bit counter incremented in step 'i' iff
+               'e_i', after 2^size - 1 steps it must not be all ones (false)
+  - adder:     'A a,b E w': ripple-carry adders of 'size' bits with two
+               encodings of the carry are equal for all inputs (true)
+  - adder-bug: as 'adder' with a wrong carry at the top bit (false)
+  - ladder:    formulas of Kleine Buening et al. with prefix
+               'E d_0 E d_1 e_1 A x_1 ... E d_size e_size A x_size E y'
+               and 'size' alternations (false)
+
+  For each size a formula is generated, added by the API and solved. A CSV
+  line is printed per formula with time of 'nenofex_solve' (wall clock),
+  peak memory and statistics from 'nenofex_get_stats'. Results of families
+  with known truth value are checked. Options starting with '-' are passed
+  to 'nenofex_configure' of each solver object.
+
+  usage: bench-qbf [ <option> ... ] [ <family> [ <min> <max> [ <step> ] ] ]
+         bench-qbf --dump <family> <size>   (print QDIMACS to 'stdout')
+
+  Without a family all families are run over their default sizes.
+*/
+
+typedef struct Formula Formula;
+
+struct Formula
+{
+  unsigned int num_vars;
+  unsigned int num_scopes, size_scope_types;
+  int *scope_types;             /* 1 if universal */
+  int *scope_of_var;            /* indexed by variable */
+  unsigned int size_scope_of_var;
+  int *lits;                    /* clauses, each terminated by 0 */
+  unsigned int num_lits, size_lits;
+  unsigned int num_clauses;
+};
+
+typedef struct Family Family;
+
+struct Family
+{
+  const char *name;
+  void (*generate) (Formula *, unsigned int);
+  NenofexResult expected;       /* 'NENOFEX_RESULT_UNKNOWN' if not known */
+  unsigned int min, max, step;  /* default sizes */
+};
+
+static double
+seconds (void)
+{
+  struct timespec ts;
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* -------- building formulas -------- */
+
+static int
+new_scope (Formula * f, int universal)
+{
+  if (f->num_scopes == f->size_scope_types)
+    {
+      f->size_scope_types = 2 * f->size_scope_types + 4;
+      f->scope_types = realloc (f->scope_types,
+                                f->size_scope_types * sizeof (int));
+    }
+  f->scope_types[f->num_scopes] = universal;
+  return f->num_scopes++;
+}
+
+static int
+new_var (Formula * f, int scope)
+{
+  assert (scope >= 0 && (unsigned int) scope < f->num_scopes);
+  f->num_vars++;
+  if (f->num_vars >= f->size_scope_of_var)
+    {
+      f->size_scope_of_var = 2 * f->size_scope_of_var + 16;
+      f->scope_of_var = realloc (f->scope_of_var,
+                                 f->size_scope_of_var * sizeof (int));
+    }
+  f->scope_of_var[f->num_vars] = scope;
+  return f->num_vars;
+}
+
+static void
+push_lit (Formula * f, int lit)
+{
+  if (f->num_lits == f->size_lits)
+    {
+      f->size_lits = 2 * f->size_lits + 64;
+      f->lits = realloc (f->lits, f->size_lits * sizeof (int));
+    }
+  f->lits[f->num_lits++] = lit;
+  if (!lit)
+    f->num_clauses++;
+}
+
+static void
+clause (Formula * f, int a, int b, int c)
+{
+  push_lit (f, a);
+  if (b)
+    push_lit (f, b);
+  if (c)
+    push_lit (f, c);
+  push_lit (f, 0);
+}
+
+/*
+- gates: return new variable of 'scope' defined by clauses
+*/
+static int
+and_gate (Formula * f, int scope, int a, int b)
+{
+  int g = new_var (f, scope);
+  clause (f, -g, a, 0);
+  clause (f, -g, b, 0);
+  clause (f, g, -a, -b);
+  return g;
+}
+
+static int
+or_gate (Formula * f, int scope, int a, int b)
+{
+  return -and_gate (f, scope, -a, -b);
+}
+
+static int
+xor_gate (Formula * f, int scope, int a, int b)
+{
+  int g = new_var (f, scope);
+  clause (f, -g, a, b);
+  clause (f, -g, -a, -b);
+  clause (f, g, -a, b);
+  clause (f, g, a, -b);
+  return g;
+}
+
+static void
+equal (Formula * f, int a, int b)
+{
+  clause (f, -a, b, 0);
+  clause (f, a, -b, 0);
+}
+
+/* -------- families -------- */
+
+static unsigned int
+next_rand (unsigned int *seed)
+{
+  *seed = *seed * 1103515245 + 12345;
+  return (*seed >> 16) & 0x7fff;
+}
+
+static void
+gen_random (Formula * f, unsigned int size)
+{
+  int outer = new_scope (f, 0), univ = new_scope (f, 1), inner =
+    new_scope (f, 0);
+  unsigned int seed = size, i, j;
+  int first = f->num_vars + 1;
+
+  for (i = 0; i < size; i++)
+    new_var (f, outer);
+  for (i = 0; i < size; i++)
+    new_var (f, univ);
+  for (i = 0; i < size; i++)
+    new_var (f, inner);
+
+  /* 5/3 clauses per variable, each with an innermost existential */
+  for (i = 0; i < 5 * size; i++)
+    {
+      unsigned int len = 3 + next_rand (&seed) % 3;
+      int lit = first + 2 * size + next_rand (&seed) % size;
+      push_lit (f, next_rand (&seed) % 2 ? lit : -lit);
+      for (j = 1; j < len; j++)
+        {
+          lit = first + next_rand (&seed) % (3 * size);
+          push_lit (f, next_rand (&seed) % 2 ? lit : -lit);
+        }
+      push_lit (f, 0);
+    }
+}
+
+static void
+gen_parity (Formula * f, unsigned int size)
+{
+  int univ = new_scope (f, 1), exist = new_scope (f, 0);
+  int *x = malloc ((size + 1) * sizeof (int));
+  unsigned int i;
+
+  for (i = 1; i <= size; i++)
+    x[i] = new_var (f, univ);
+
+  int t = new_var (f, exist);
+  equal (f, t, x[1]);
+  for (i = 2; i <= size; i++)
+    t = xor_gate (f, exist, t, x[i]);
+  clause (f, t, 0, 0);
+
+  free (x);
+}
+
+static void
+gen_counter (Formula * f, unsigned int size)
+{
+  int univ = new_scope (f, 1), exist = new_scope (f, 0);
+  unsigned int steps = (1u << size) - 1, i, t;
+  int *s = malloc (size * sizeof (int));
+  int *e = malloc (steps * sizeof (int));
+
+  for (t = 0; t < steps; t++)
+    e[t] = new_var (f, univ);
+
+  for (i = 0; i < size; i++)
+    {
+      s[i] = new_var (f, exist);
+      clause (f, -s[i], 0, 0);
+    }
+
+  /* half adders: bit 'i' flips iff carry, carry in of bit 0 is 'e_t' */
+  for (t = 0; t < steps; t++)
+    {
+      int carry = e[t];
+      for (i = 0; i < size; i++)
+        {
+          int next = xor_gate (f, exist, s[i], carry);
+          if (i + 1 < size)
+            carry = and_gate (f, exist, s[i], carry);
+          s[i] = next;
+        }
+    }
+
+  for (i = 0; i < size; i++)
+    push_lit (f, -s[i]);
+  push_lit (f, 0);
+
+  free (s);
+  free (e);
+}
+
+static void
+gen_adder_generic (Formula * f, unsigned int size, int bug)
+{
+  int univ = new_scope (f, 1), exist = new_scope (f, 0);
+  int *a = malloc (size * sizeof (int));
+  int *b = malloc (size * sizeof (int));
+  unsigned int i;
+
+  for (i = 0; i < size; i++)
+    {
+      a[i] = new_var (f, univ);
+      b[i] = new_var (f, univ);
+    }
+
+  /* carry 1: (a & b) | (c & (a ^ b)), carry 2: (a & b) | (a & c) | (b & c) */
+  int c1 = and_gate (f, exist, a[0], b[0]);
+  int c2 = and_gate (f, exist, b[0], a[0]);
+  equal (f, xor_gate (f, exist, a[0], b[0]), xor_gate (f, exist, b[0], a[0]));
+
+  for (i = 1; i < size; i++)
+    {
+      int p = xor_gate (f, exist, a[i], b[i]);
+      int g = and_gate (f, exist, a[i], b[i]);
+      int s1 = xor_gate (f, exist, p, c1);
+      int s2 = xor_gate (f, exist, xor_gate (f, exist, b[i], c2), a[i]);
+      equal (f, s1, s2);
+
+      c1 = or_gate (f, exist, g, and_gate (f, exist, c1, p));
+
+      int ab = and_gate (f, exist, b[i], a[i]);
+      int ac = and_gate (f, exist, a[i], c2);
+      int bc = and_gate (f, exist, b[i], c2);
+      c2 = or_gate (f, exist, ab, ac);
+      /* bug: carry out of top bit misses 'b & c' */
+      if (!bug || i + 1 < size)
+        c2 = or_gate (f, exist, c2, bc);
+    }
+  equal (f, c1, c2);
+
+  free (a);
+  free (b);
+}
+
+static void
+gen_adder (Formula * f, unsigned int size)
+{
+  gen_adder_generic (f, size, 0);
+}
+
+static void
+gen_adder_bug (Formula * f, unsigned int size)
+{
+  gen_adder_generic (f, size, 1);
+}
+
+/*
+- formulas of Kleine Buening, Karpinski and Floegel, hard for Q-resolution
+*/
+static void
+gen_ladder (Formula * f, unsigned int size)
+{
+  int *d = malloc ((size + 1) * sizeof (int));
+  int *e = malloc ((size + 1) * sizeof (int));
+  int *x = malloc ((size + 1) * sizeof (int));
+  int *y = malloc ((size + 1) * sizeof (int));
+  unsigned int i, j;
+
+  d[0] = new_var (f, new_scope (f, 0));
+  for (i = 1; i <= size; i++)
+    {
+      int scope = i == 1 ? f->num_scopes - 1 : new_scope (f, 0);
+      d[i] = new_var (f, scope);
+      e[i] = new_var (f, scope);
+      x[i] = new_var (f, new_scope (f, 1));
+    }
+  int last = new_scope (f, 0);
+  for (i = 1; i <= size; i++)
+    y[i] = new_var (f, last);
+
+  clause (f, -d[0], 0, 0);
+  clause (f, d[0], -d[1], -e[1]);
+  for (i = 1; i < size; i++)
+    {
+      push_lit (f, d[i]);
+      clause (f, x[i], -d[i + 1], -e[i + 1]);
+      push_lit (f, e[i]);
+      clause (f, -x[i], -d[i + 1], -e[i + 1]);
+    }
+  push_lit (f, d[size]);
+  push_lit (f, x[size]);
+  for (j = 1; j <= size; j++)
+    push_lit (f, -y[j]);
+  push_lit (f, 0);
+  push_lit (f, e[size]);
+  push_lit (f, -x[size]);
+  for (j = 1; j <= size; j++)
+    push_lit (f, -y[j]);
+  push_lit (f, 0);
+  for (i = 1; i <= size; i++)
+    {
+      clause (f, x[i], y[i], 0);
+      clause (f, -x[i], y[i], 0);
+    }
+
+  free (d);
+  free (e);
+  free (x);
+  free (y);
+}
+
+static Family families[] = {
+  {"random", gen_random, NENOFEX_RESULT_UNKNOWN, 6, 14, 2},
+  {"parity", gen_parity, NENOFEX_RESULT_UNSAT, 4, 16, 2},
+  {"counter", gen_counter, NENOFEX_RESULT_UNSAT, 2, 4, 1},
+  {"adder", gen_adder, NENOFEX_RESULT_SAT, 2, 8, 2},
+  {"adder-bug", gen_adder_bug, NENOFEX_RESULT_UNSAT, 2, 10, 2},
+  {"ladder", gen_ladder, NENOFEX_RESULT_UNSAT, 25, 200, 25},
+  {0, 0, 0, 0, 0, 0}
+};
+
+/* -------- solving -------- */
+
+static void
+delete_formula (Formula * f)
+{
+  free (f->scope_types);
+  free (f->scope_of_var);
+  free (f->lits);
+}
+
+static void
+dump_formula (Formula * f)
+{
+  unsigned int s, v, i;
+
+  fprintf (stdout, "p cnf %u %u\n", f->num_vars, f->num_clauses);
+  for (s = 0; s < f->num_scopes; s++)
+    {
+      fprintf (stdout, "%c", f->scope_types[s] ? 'a' : 'e');
+      for (v = 1; v <= f->num_vars; v++)
+        if (f->scope_of_var[v] == (int) s)
+          fprintf (stdout, " %u", v);
+      fprintf (stdout, " 0\n");
+    }
+  for (i = 0; i < f->num_lits; i++)
+    fprintf (stdout, f->lits[i] ? "%d " : "%d\n", f->lits[i]);
+}
+
+static void
+add_formula (Nenofex * nenofex, Formula * f)
+{
+  void **lits = malloc ((f->num_vars + 1) * sizeof (void *));
+  unsigned int s, v, i, cnt;
+
+  nenofex_set_up_preamble (nenofex, f->num_vars, f->num_clauses);
+
+  for (s = 0; s < f->num_scopes; s++)
+    {
+      cnt = 0;
+      for (v = 1; v <= f->num_vars; v++)
+        if (f->scope_of_var[v] == (int) s)
+          lits[cnt++] = (void *) (long int) v;
+      if (cnt)
+        nenofex_add_orig_scope (nenofex, lits, cnt,
+                                f->scope_types[s] ? SCOPE_TYPE_UNIVERSAL :
+                                SCOPE_TYPE_EXISTENTIAL);
+    }
+
+  cnt = 0;
+  for (i = 0; i < f->num_lits; i++)
+    {
+      if (f->lits[i])
+        lits[cnt++] = (void *) (long int) f->lits[i];
+      else
+        {
+          nenofex_add_orig_clause (nenofex, lits, cnt);
+          cnt = 0;
+        }
+    }
+
+  free (lits);
+}
+
+static const char *
+result_name (NenofexResult res)
+{
+  return res == NENOFEX_RESULT_SAT ? "TRUE" :
+    res == NENOFEX_RESULT_UNSAT ? "FALSE" : "UNKNOWN";
+}
+
+static void
+run (Family * family, unsigned int size, char **options,
+     unsigned int num_options)
+{
+  Nenofex *nenofex = nenofex_create ();
+  Formula f;
+  NenofexStats stats;
+  unsigned int i;
+
+  for (i = 0; i < num_options; i++)
+    nenofex_configure (nenofex, options[i]);
+
+  memset (&f, 0, sizeof (Formula));
+  family->generate (&f, size);
+  add_formula (nenofex, &f);
+
+  double start = seconds ();
+  NenofexResult res = nenofex_solve (nenofex);
+  double time = seconds () - start;
+  nenofex_get_stats (nenofex, &stats);
+
+  fprintf (stdout, "%s,%u,%u,%u,%s,%.4f,%llu,%llu,%llu,%llu,%llu,%llu,%llu\n",
+           family->name, size, f.num_vars, f.num_clauses, result_name (res),
+           time, stats.max_bytes, stats.expansions,
+           stats.optimizations_called, stats.atpg_tested_faults,
+           stats.atpg_redundant_faults, stats.global_flow_implications,
+           stats.opt_propagations);
+  fflush (stdout);
+
+  if (family->expected != NENOFEX_RESULT_UNKNOWN &&
+      res != NENOFEX_RESULT_UNKNOWN && res != family->expected)
+    {
+      fprintf (stderr, "%s %u: result %s, expected %s\n", family->name, size,
+               result_name (res), result_name (family->expected));
+      abort ();
+    }
+
+  nenofex_delete (nenofex);
+  delete_formula (&f);
+}
+
+static Family *
+find_family (const char *name)
+{
+  Family *family;
+  for (family = families; family->name; family++)
+    if (!strcmp (family->name, name))
+      return family;
+  fprintf (stderr, "Unknown family: %s\n", name);
+  exit (1);
+}
+
+int
+main (int argc, char **argv)
+{
+  char **options = malloc (argc * sizeof (char *));
+  unsigned int num_options = 0, num_args = 0, size;
+  char *args[4];
+  int i, dump = 0;
+  Family *family;
+
+  for (i = 1; i < argc; i++)
+    {
+      if (!strcmp (argv[i], "--dump"))
+        dump = 1;
+      else if (argv[i][0] == '-')
+        options[num_options++] = argv[i];
+      else if (num_args < 4)
+        args[num_args++] = argv[i];
+      else
+        {
+          fprintf (stderr, "Too many arguments\n");
+          exit (1);
+        }
+    }
+
+  if (dump)
+    {
+      Formula f;
+      if (num_args != 2)
+        {
+          fprintf (stderr, "Expecting '--dump <family> <size>'\n");
+          exit (1);
+        }
+      memset (&f, 0, sizeof (Formula));
+      find_family (args[0])->generate (&f, atoi (args[1]));
+      dump_formula (&f);
+      delete_formula (&f);
+      free (options);
+      return 0;
+    }
+
+  fprintf (stdout, "family,size,vars,clauses,result,seconds,max_bytes,"
+           "expansions,optimizations,atpg_tested_faults,"
+           "atpg_redundant_faults,global_flow_implications,"
+           "opt_propagations\n");
+
+  if (num_args == 0)
+    {
+      for (family = families; family->name; family++)
+        for (size = family->min; size <= family->max; size += family->step)
+          run (family, size, options, num_options);
+    }
+  else
+    {
+      family = find_family (args[0]);
+      unsigned int min = num_args > 1 ? atoi (args[1]) : family->min;
+      unsigned int max = num_args > 2 ? atoi (args[2]) : min;
+      unsigned int step = num_args > 3 ? atoi (args[3]) : 1;
+      if (num_args == 1)
+        max = family->max, step = family->step;
+      if (!step)
+        step = 1;
+      for (size = min; size <= max; size += step)
+        run (family, size, options, num_options);
+    }
+
+  free (options);
+  return 0;
+}
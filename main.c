@@ -45,7 +45,9 @@
 "  --version                     print version\n"\
 "  -v				verbose output (default: only QDIMACS output)\n"\
 "  --show-progress		print short summary after each expansion step\n"\
-"  --show-graph-size		print graph size after each expansion step\n\n\n"\
+"  --show-graph-size		print graph size after each expansion step\n"\
+"  --stats=<level>		statistics collected and printed with '-v' where\n"\
+"				  <level> is 'off', 'basic' (default) or 'full'\n\n\n"\
 "SAT Solving:\n"\
 "------------\n\n"\
 "  --no-sat-solving		never call internal SAT-solver even if formula is\n"\
@@ -54,6 +56,9 @@
 "  --dump-cnf			print generated CNF (if any) to 'stdout'\n"\
 "	       			  (may be combined with '--no-sat-solving')\n"\
 "  --sat-solver-dec-limit=<val> non-zero positive SAT solver decision limit (default: no limit)\n"\
+"  --sat-backend=<name>		SAT solver called after expansion phase where <name>\n"\
+"				  is 'picosat' (default) or 'ipasir' if nenofex\n"\
+"				  was built with an IPASIR solver\n"\
 "  --cnf-generator=<cnf-gen>	set NNF-to-CNF generator where <cnf-gen> is either \n"\
 "				  'tseitin' or 'tseitin_revised' (default)\n\n\n"\
 "Expansion:\n"\
@@ -73,6 +78,13 @@
 "				  costs exceed <val> where val is an integer\n\n"\
 "  --abs-graph-size-cutoff=<val> stop expanding if overall graph size exceeds initial\n"\
 "                                  graph size by factor <val>\n"\
+"  --cutoff-rollback		undo expansion exceeding a size cutoff and forward\n"\
+"				  formula before it to the SAT solver if propositional\n"\
+"  --mem-limit=<val>		stop expanding before memory allocated by the solver\n"\
+"				  exceeds <val> MB (memory of SAT solver not included)\n"\
+"  --time-limit=<val>		stop solving after <val> seconds of wall-clock time\n"\
+"  --cpu-time-limit=<val>	stop solving after <val> seconds of CPU time\n"\
+"				  of the calling thread\n"\
 "  --univ-trigger=<val>	       	enable non-inner universal expansion if tree has grown\n"\
 "				  faster than <val> (default: 10) nodes in last exist. expansion\n"\
 "  --univ-delta=<val>	       	increase universal trigger by <val> after \n"\
@@ -82,7 +94,19 @@
 "				  has exactly one positive occurrence and <n> negative \n"\
 "				  ones or vice versa, or variable 'x' has exactly two\n"\
 "				  positive and two negative occurrences -> flatten subgraph\n"\
-"				  rooted at 'split-OR' by multiplying out clauses\n\n\n" \
+"				  rooted at 'split-OR' by multiplying out clauses\n"\
+"  --dedup-sibling-clauses	delete clauses of literals which are identical to\n"\
+"				  a sibling, e.g. copies after universal expansion\n"\
+"  --lazy-scores			update expansion costs of variables affected by an\n"\
+"				  expansion only when they are about to be picked\n"\
+"  --bounded-scores		experimental: skip exact costs of variables whose\n"\
+"				  costs exceed those of the cheapest variable until\n"\
+"				  they may be picked (no measured speed-up yet)\n"\
+"  --score-threads=<val>		compute initial scores of scope variables\n"\
+"				  in <val> threads (default: 1)\n\n\n"
+
+/* separate from 'USAGE' to keep string literals at portable length */
+#define USAGE_OPTIMIZATIONS \
 "Optimizations:\n"\
 "--------------\n\n"\
 "  --show-opt-info		print short info after calls of optimizations\n"\
@@ -93,17 +117,39 @@
 "				  (overruled by '--no-optimizations')\n"\
 "  --no-global-flow		do not optimize by global flow\n"\
 "				  (overruled by '--no-optimizations')\n"\
-"  --propagation-limit=<val>	set hard propagation limit in optimizations (see below)"\
-"\n\n\n"\
+"  --propagation-limit=<val>	set hard propagation limit in optimizations (see below)\n"\
+"  --opt-budget=<policy>		propagation budget of optimizations: 'adaptive'\n"\
+"				  (default) or 'static' (see below)\n"\
+"  --opt-time-share=<val>	adaptive budget: shrink budget if optimizations\n"\
+"				  take more than <val> percent (default: 80) of time"\
+"\n\n\n"
+
+/* separate from 'USAGE' for the same reason */
+#define USAGE_REMARKS \
 "REMARKS:\n\n"\
 "  - For calling the solver on a CNF, you should specify '--full-expansion'\n\n"\
 "  - If '-n=<val>' is specified the solver will - if possible - forward a CNF\n"\
 "      to the internal SAT solver unless '--no-sat-solving' is specified\n\n"\
 "  - Options '--size-cutoff=<val>', '--cost-cutoff=<val>' and '-n <val>' may be combined\n\n"\
+"  - If expanding stops due to a limit, then the formula is forwarded to the SAT solver\n"\
+"      if it is propositional, otherwise the result is unknown\n\n"\
+"  - Options '--time-limit=<val>' and '--cpu-time-limit=<val>' are checked between\n"\
+"      expansions, optimization steps and slices of SAT solving; the result is\n"\
+"      unknown if a limit expires. In contrast, a plain number <val> given as\n"\
+"      argument kills the process by a signal after <val> seconds\n\n"\
+"  - Option '--stats=full' adds counters in inner loops of LCA computations\n"\
+"      and size updates and a full graph traversal after each expansion, which\n"\
+"      slows down solving; '--stats=off' disables the profiler as well\n\n"\
+"  - With '--lazy-scores' a variable is picked once its costs are up to date and\n"\
+"      minimal among the current costs of all variables, some of which may be outdated;\n"\
+"      its costs are therefore not always minimal as without this option\n\n"\
 "  - Option '--propagation-limit=<val>' will set a limit for global flow optimization\n"\
 "      and redundancy removal separately, i.e. both optimizations may perform <val>\n"\
 "      propagations. If this option is omitted (default) then a built-in limit will\n"\
-"      be set depending on the size of the formula subject to optimization\n\n"
+"      be set depending on the size of the formula subject to optimization\n\n"\
+"  - With '--opt-budget=adaptive' the built-in limit is scaled after each call of\n"\
+"      optimizations: up if the limit was hit and recent calls deleted nodes,\n"\
+"      down if they did not or if optimizations exceeded their share of time\n\n"
 
 
 static char *input_filename = 0;
@@ -143,6 +189,8 @@ parse_cmd_line_options (Nenofex *nenofex, int argc, char **argv)
         {
           done = 1;
           fprintf (stdout, USAGE);
+          fprintf (stdout, USAGE_OPTIMIZATIONS);
+          fprintf (stdout, USAGE_REMARKS);
         }
       else if (!strcmp (opt_str, "--version"))
         {
@@ -18,16 +18,61 @@
  along with Nenofex.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#define _POSIX_C_SOURCE 200112L
+
 #include <stdio.h>
 #include <assert.h>
 #include <string.h>
 #include <stdlib.h>
 #include "mem.h"
 
+/* Size-class slab allocator for small, frequently created objects such
+   as nodes of the NNF tree. Objects of one size class are carved out of
+   large chunks and recycled via a free list. Chunks are only returned to
+   the system by 'mem_slab_release' or when the manager is deleted. */
+
+#define MEM_SLAB_ALIGN (sizeof (void *))
+#define MEM_SLAB_MAX_OBJECT_BYTES 512
+#define MEM_SLAB_NUM_CLASSES (MEM_SLAB_MAX_OBJECT_BYTES / MEM_SLAB_ALIGN)
+#define MEM_SLAB_CHUNK_BYTES (64 * 1024)
+/* objects whose size is a multiple of a cache line start on a line */
+#define MEM_SLAB_LINE_BYTES 64
+
+#define mem_slab_class_index(bytes) (((bytes) + MEM_SLAB_ALIGN - 1) / MEM_SLAB_ALIGN - 1)
+#define mem_slab_class_bytes(index) (((index) + 1) * MEM_SLAB_ALIGN)
+
+typedef struct SlabChunk SlabChunk;
+typedef struct SlabObject SlabObject;
+typedef struct SlabClass SlabClass;
+
+struct SlabChunk
+{
+  SlabChunk *next;
+  /* objects follow */
+};
+
+struct SlabObject
+{
+  SlabObject *next;             /* link in free list */
+};
+
+struct SlabClass
+{
+  SlabObject *free_list;
+  char *unused;                 /* never used part of most recent chunk */
+  char *unused_end;
+};
+
 struct MemManager
 {
   size_t cur_bytes;
   size_t max_bytes;
+  size_t limit_bytes;           /* budget polled by clients, 0 if none */
+
+  size_t slab_bytes;            /* part of 'cur_bytes' handed out by slab */
+  size_t slab_chunk_bytes;      /* bytes allocated from system for chunks */
+  SlabChunk *slab_chunks;
+  SlabClass slab_classes[MEM_SLAB_NUM_CLASSES];
 };
 
 static void
@@ -56,6 +101,7 @@ memmanager_delete (MemManager *mm)
 {
   /* Leak check. */
   mem_check (mm);
+  mem_slab_release (mm);
   free (mm);
 }
 
@@ -80,6 +126,30 @@ mem_malloc (MemManager *mm, size_t bytes)
 }
 
 
+/*
+- allocate 'bytes' starting at a multiple of 'alignment', which is a power 
+  of two and a multiple of 'sizeof (void *)'
+- release by 'mem_free'
+*/
+void *
+mem_aligned_malloc (MemManager *mm, size_t bytes, size_t alignment)
+{
+  void *result;
+
+  if (posix_memalign (&result, alignment, bytes))
+    {
+      fprintf (stderr, "ERROR - mem: posix_memalign failed!\n");
+      abort ();
+    }
+  mm->cur_bytes += bytes;
+
+  if (mm->cur_bytes > mm->max_bytes)
+    mm->max_bytes = mm->cur_bytes;
+
+  return result;
+}
+
+
 void *
 mem_realloc (MemManager *mm, void *ptr, size_t old_bytes, size_t new_bytes)
 {
@@ -130,6 +200,123 @@ mem_free (MemManager *mm, void *ptr, size_t bytes)
 }
 
 
+/*
+- allocate object of 'bytes' from size-class slabs
+- objects larger than MEM_SLAB_MAX_OBJECT_BYTES are passed to 'mem_malloc'
+- memory is NOT cleared
+*/
+void *
+mem_slab_malloc (MemManager *mm, size_t bytes)
+{
+  assert (bytes);
+
+  if (bytes > MEM_SLAB_MAX_OBJECT_BYTES)
+    return mem_malloc (mm, bytes);
+
+  SlabClass *class = mm->slab_classes + mem_slab_class_index (bytes);
+  void *result;
+
+  if (class->free_list)
+    {
+      result = class->free_list;
+      class->free_list = class->free_list->next;
+    }
+  else
+    {
+      size_t object_bytes = mem_slab_class_bytes (mem_slab_class_index (bytes));
+
+      if (class->unused + object_bytes > class->unused_end)
+        {                       /* get new chunk; rest of old one is lost */
+          SlabChunk *chunk = (SlabChunk *) malloc (MEM_SLAB_CHUNK_BYTES);
+
+          if (!chunk)
+            {
+              fprintf (stderr, "ERROR - mem: malloc failed!\n");
+              abort ();
+            }
+          chunk->next = mm->slab_chunks;
+          mm->slab_chunks = chunk;
+          mm->slab_chunk_bytes += MEM_SLAB_CHUNK_BYTES;
+
+          class->unused = (char *) (chunk + 1);
+          class->unused_end = (char *) chunk + MEM_SLAB_CHUNK_BYTES;
+
+          if (!(object_bytes % MEM_SLAB_LINE_BYTES))
+            {
+              size_t offset = (size_t) class->unused % MEM_SLAB_LINE_BYTES;
+              if (offset)
+                class->unused += MEM_SLAB_LINE_BYTES - offset;
+            }
+        }
+
+      result = class->unused;
+      class->unused += object_bytes;
+    }
+
+  mm->slab_bytes += bytes;
+  mm->cur_bytes += bytes;
+
+  if (mm->cur_bytes > mm->max_bytes)
+    mm->max_bytes = mm->cur_bytes;
+
+  return result;
+}
+
+
+/*
+- put object back to free list of its size class
+- 'bytes' must be the same as in 'mem_slab_malloc'
+*/
+void
+mem_slab_free (MemManager *mm, void *ptr, size_t bytes)
+{
+  if (!ptr)
+    {
+      fprintf (stderr, "ERROR - mem: free at null pointer!\n");
+      abort ();
+    }
+
+  if (bytes > MEM_SLAB_MAX_OBJECT_BYTES)
+    {
+      mem_free (mm, ptr, bytes);
+      return;
+    }
+
+  SlabClass *class = mm->slab_classes + mem_slab_class_index (bytes);
+  SlabObject *object = (SlabObject *) ptr;
+  object->next = class->free_list;
+  class->free_list = object;
+
+  assert (mm->slab_bytes >= bytes);
+  assert (mm->cur_bytes >= bytes);
+  mm->slab_bytes -= bytes;
+  mm->cur_bytes -= bytes;
+}
+
+
+/*
+- release all slab chunks at once
+- any objects still allocated from slabs become invalid
+*/
+void
+mem_slab_release (MemManager *mm)
+{
+  SlabChunk *chunk, *next;
+  for (chunk = mm->slab_chunks; chunk; chunk = next)
+    {
+      next = chunk->next;
+      free (chunk);
+    }
+  mm->slab_chunks = 0;
+  mm->slab_chunk_bytes = 0;
+  memset (mm->slab_classes, 0, sizeof (mm->slab_classes));
+
+  assert (mm->cur_bytes >= mm->slab_bytes);
+  mm->cur_bytes -= mm->slab_bytes;
+  mm->slab_bytes = 0;
+}
+
+
 size_t
 get_cur_bytes (MemManager *mm)
 {
@@ -137,11 +324,50 @@ get_cur_bytes (MemManager *mm)
 }
 
 
+/*
+- set budget of 'bytes', where 0 means no budget
+- the budget is not enforced by allocation functions: clients poll
+  'mem_limit_exceeded' at points where they are able to stop gracefully
+*/
+void
+mem_set_limit (MemManager *mm, size_t bytes)
+{
+  mm->limit_bytes = bytes;
+}
+
+
+size_t
+get_limit_bytes (MemManager *mm)
+{
+  return mm->limit_bytes;
+}
+
+
+/*
+- check whether allocating 'extra_bytes' in addition to 'cur_bytes'
+  would exceed budget
+*/
+int
+mem_limit_exceeded (MemManager *mm, size_t extra_bytes)
+{
+  return mm->limit_bytes &&
+    (mm->cur_bytes > mm->limit_bytes ||
+     extra_bytes > mm->limit_bytes - mm->cur_bytes);
+}
+
+
 size_t
 get_max_bytes (MemManager *mm)
 {
   return mm->max_bytes;
 }
 
+
+size_t
+get_slab_chunk_bytes (MemManager *mm)
+{
+  return mm->slab_chunk_bytes;
+}
+
 /* --------- END: API FUNCTIONS --------- */
 
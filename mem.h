@@ -33,10 +33,26 @@ void *mem_malloc (MemManager *, size_t);
 
 void mem_free (MemManager *, void *, size_t);
 
+void *mem_aligned_malloc (MemManager *, size_t, size_t);
+
 void *mem_realloc (MemManager *, void *, size_t, size_t);
 
+void *mem_slab_malloc (MemManager *, size_t);
+
+void mem_slab_free (MemManager *, void *, size_t);
+
+void mem_slab_release (MemManager *);
+
 size_t get_cur_bytes (MemManager *);
 
 size_t get_max_bytes (MemManager *);
 
+void mem_set_limit (MemManager *, size_t);
+
+size_t get_limit_bytes (MemManager *);
+
+int mem_limit_exceeded (MemManager *, size_t);
+
+size_t get_slab_chunk_bytes (MemManager *);
+
 #endif /* _MEM_H_ */
@@ -18,6 +18,9 @@
  along with Nenofex.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+/* for 'fileno' and 'mmap' */
+#define _POSIX_C_SOURCE 200112L
+
 #include <stdio.h>
 #include <string.h>
 #include <assert.h>
@@ -26,27 +29,36 @@
 #include <limits.h>
 #include <unistd.h>
 #include <math.h>
+#include <time.h>
 #include <dirent.h>
 #include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
 #include <sys/resource.h>
-#include "../picosat/picosat.h"
+#include <pthread.h>
 #include "nenofex_types.h"
 #include "stack.h"
+#include "pqueue.h"
 #include "mem.h"
 
 /*
-- wrapper-macros for calling internal SAT-solver
+- wrapper-macros for calling SAT solver backend
 */
-#define sat_solver_init(N) ((N)->picosat = picosat_init())
-#define sat_solver_verbosity_mode(N) (picosat_set_verbosity((N)->picosat, 1))
-#define sat_solver_reset(N) (picosat_reset((N)->picosat))
-#define sat_solver_add(N,lit) (picosat_add((N)->picosat,(lit)))
-#define sat_solver_sat(N) (picosat_sat((N)->picosat,(N)->options.sat_solver_dec_limit > 0 ? \
+#define sat_solver_backend(N) ((N)->options.sat_solver_backend)
+#define sat_solver_init(N) ((N)->sat_solver = sat_solver_backend(N)->init())
+#define sat_solver_verbosity_mode(N) (sat_solver_backend(N)->set_verbosity((N)->sat_solver, 1))
+#define sat_solver_reset(N) (sat_solver_backend(N)->reset((N)->sat_solver), \
+                             (N)->sat_solver = 0)
+#define sat_solver_add(N,lit) (sat_solver_backend(N)->add((N)->sat_solver,(lit)))
+#define sat_solver_sat(N) (sat_solver_backend(N)->sat((N)->sat_solver, \
+                                       (N)->options.sat_solver_dec_limit > 0 ? \
                                        (N)->options.sat_solver_dec_limit : -1))
-#define sat_solver_deref(N,lit) (picosat_deref((N)->picosat,lit))
-#define SAT_SOLVER_RESULT_UNKNOWN PICOSAT_UNKNOWN
-#define SAT_SOLVER_RESULT_SATISFIABLE PICOSAT_SATISFIABLE
-#define SAT_SOLVER_RESULT_UNSATISFIABLE PICOSAT_UNSATISFIABLE
+#define sat_solver_deref(N,lit) (sat_solver_backend(N)->deref((N)->sat_solver,lit))
+#define sat_solver_sat_slice(N,limit) (sat_solver_backend(N)->sat((N)->sat_solver, \
+                                       (limit)))
+#define sat_solver_decisions(N) (sat_solver_backend(N)->decisions((N)->sat_solver))
+#define sat_solver_set_terminate(N,terminate) \
+  (sat_solver_backend(N)->set_terminate((N)->sat_solver, (N), (terminate)))
 
 
 /*
@@ -98,6 +110,10 @@
 
 #define ASSERT_ALL_LCA_OCC_POS_INTEGRITY 0
 
+#define ASSERT_DECREASE_SCORE_BOUND 0
+
+#define ASSERT_GRAPH_AFTER_ROLLBACK 0
+
 #else
 
 #define ASSERT_AFTER_EXP_ALL_NON_INNERMOST_SCOPE_VARS_UNINIT 1
@@ -137,6 +153,10 @@
 
 #define ASSERT_ALL_LCA_OCC_POS_INTEGRITY 1
 
+#define ASSERT_DECREASE_SCORE_BOUND 1
+
+#define ASSERT_GRAPH_AFTER_ROLLBACK 1
+
 #endif /* end: full-scale assertion checking */
 
 
@@ -146,13 +166,6 @@
 #define PRINT_INCREMENTAL_COST_UPDATE 0
 
 
-/*
-- compute statistics after each expansion and print to 'stderr'
-- rather expensive (full traversal of graph)
-*/
-#define COMPUTE_GRAPH_STATISTICS 0
-
-
 /*
 - print number of clauses that would be generated by revised tseitin transf.
 - rather expensive!
@@ -165,20 +178,7 @@
 #define ASSERT_PRINT_LIT_STATS_BEFORE_EXP 0
 
 
-/* optional statistics */
-#define COMPUTE_MAX_TREE_SIZE 1
-#if 0
-#define COMPUTE_NUM_DELETED_NODES 1
-#define COMPUTE_NUM_NON_INC_EXPANSIONS_IN_SCORES 1
-#define COMPUTE_NUM_NON_INC_EXPANSIONS 1
-#define COMPUTE_CASES_IN_EXPANSIONS 1
-#define COMPUTE_AVERAGE_UPDATE_MARKED_RATIOS 1
-#define COMPUTE_NUM_UNITS 1
-#define COMPUTE_NUM_UNATES 1
-#define COMPUTE_NUM_TOTAL_CREATED_NODES 1
-#define COMPUTE_LCA_PARENT_VISITS 1
-#endif
-/* END: OPTIONAL STATISTICS */
+/* optional statistics: see 'options.stats_level' */
 
 
 /* 
@@ -196,6 +196,27 @@
 #define APPROXIMATE_UNIV_SCORES 0
 
 
+/* answer LCA queries by jump pointers instead of following parent pointers
+   (pays off only on deep trees, expansion trees rarely exceed a few levels) */
+#define USE_LCA_INDEX 0
+
+
+/* collect size deltas during propagation and push them up in one pass */
+#define DEFER_SIZE_SUBFORMULA_UPDATES 1
+
+
+/* scopes with fewer variables are scored sequentially */
+#define PARALLEL_SCORING_MIN_VARS 32
+
+
+/* deadline: calls of 'deadline_expired' between two reads of clocks */
+#define DEADLINE_POLL_INTERVAL 64
+
+
+/* deadline: decisions per call of SAT solver between two checks */
+#define SAT_SOLVER_DEADLINE_SLICE 2000
+
+
 #define DEFAULT_STACK_SIZE 128
 #define DEFAULT_QUEUE_SIZE 128
 #define DEFAULT_SCOPE_NESTING INT_MAX
@@ -252,13 +273,29 @@
 (((var)->lca_update_mark) || ((var)->inc_score_update_mark) \
    || ((var)->dec_score_update_mark))
 
-#define decrease_score_marked(node) ((node)->mark1)
-#define decrease_score_mark(node) ((node)->mark1 = 1)
-#define decrease_score_unmark(node) ((node)->mark1 = 0)
-
-#define decrease_score_collected_marked(node) ((node)->mark2)
-#define decrease_score_collected_mark(node) ((node)->mark2 = 1)
-#define decrease_score_collected_unmark(node) ((node)->mark2 = 0)
+/* marks are kept in per-thread 'scratch' when scoring in parallel */
+#define DECREASE_SCORE_MARK 1
+#define DECREASE_SCORE_COLLECTED_MARK 2
+
+#define decrease_score_marked(scratch, node) \
+  ((scratch) ? score_scratch_get ((scratch), (node)) & DECREASE_SCORE_MARK \
+   : (node)->mark1)
+#define decrease_score_mark(scratch, node) \
+  ((scratch) ? (*score_scratch_slot ((scratch), (node)) |= DECREASE_SCORE_MARK) \
+   : ((node)->mark1 = 1))
+#define decrease_score_unmark(scratch, node) \
+  ((scratch) ? (*score_scratch_slot ((scratch), (node)) &= ~DECREASE_SCORE_MARK) \
+   : ((node)->mark1 = 0))
+
+#define decrease_score_collected_marked(scratch, node) \
+  ((scratch) ? score_scratch_get ((scratch), (node)) & DECREASE_SCORE_COLLECTED_MARK \
+   : (node)->mark2)
+#define decrease_score_collected_mark(scratch, node) \
+  ((scratch) ? (*score_scratch_slot ((scratch), (node)) |= DECREASE_SCORE_COLLECTED_MARK) \
+   : ((node)->mark2 = 1))
+#define decrease_score_collected_unmark(scratch, node) \
+  ((scratch) ? (*score_scratch_slot ((scratch), (node)) &= ~DECREASE_SCORE_COLLECTED_MARK) \
+   : ((node)->mark2 = 0))
 
 
 /* END: MACROS, CONFIGURATION */
@@ -266,419 +303,338 @@
 
 /* ---------- START: PRIORITY QUEUE ---------- */
 
+/*
+- the priority queue of a scope orders its variables by expansion costs,
+  'priority_slot' of a variable is its slot in the queue (see 'pqueue.h')
+  or -1 if it is not in the queue
+- the queue keeps a copy of 'exp_costs.score' which is refreshed by
+  'update_key' and 'init_order_priority_queue'
+*/
+
 static void
-create_priority_queue (MemManager *mm, Stack ** priority_heap, unsigned int init_capacity)
+add_fast_priority_queue (MemManager *mm, PQueue * priority_heap, Var * var)
 {
-  *priority_heap = create_stack (mm, init_capacity);
-}
+  assert (var->priority_slot == -1);
 
+  var->priority_slot =
+    append_pqueue (mm, priority_heap, var, var->exp_costs.score);
 
-static void
-delete_priority_queue (MemManager *mm, Stack ** priority_heap)
-{
-  delete_stack (mm, *priority_heap);
-  *priority_heap = 0;
+  assert (var->priority_slot >= 0);
 }
 
 
+#ifndef NDEBUG
 static void
-add_fast_priority_queue (MemManager *mm, Stack * priority_heap, Var * var)
+assert_priority_queue_heap_condition (PQueue * priority_heap)
 {
-  assert (var->priority_pos == -1);
+  unsigned int pos, count = count_pqueue (priority_heap);
+  PQueueEntry *heap = priority_heap->heap;
 
-  push_stack (mm, priority_heap, var);
-  var->priority_pos = count_stack (priority_heap) - 1;
+  for (pos = 0; pos < count; pos++)
+    {
+      unsigned int slot = heap[pos].slot;
+      Var *cur_var = priority_heap->elems[slot];
 
-  assert (var->priority_pos >= 0);
-  assert ((unsigned int) var->priority_pos < count_stack (priority_heap));
+      assert (cur_var->priority_slot == (int) slot);
+      assert (priority_heap->pos[slot] == pos);
+      assert (heap[pos].score == cur_var->exp_costs.score);
+      assert (pos == 0 ||
+              heap[(pos - 1) / PQUEUE_ARITY].score <= heap[pos].score);
+    }                           /* end: for */
 }
+#endif
 
 
-static int
-get_left_child_pos (int cur_pos, int size)
+/*
+- refresh scores kept in queue and establish heap condition from scratch
+*/
+static void
+init_order_priority_queue (PQueue * priority_heap)
 {
-  assert (cur_pos >= 0);
-  assert (cur_pos < size);
+  unsigned int pos, count = count_pqueue (priority_heap);
+  PQueueEntry *heap = priority_heap->heap;
 
-  int result;
+  for (pos = 0; pos < count; pos++)
+    {
+      Var *var = priority_heap->elems[heap[pos].slot];
+      heap[pos].score = var->exp_costs.score;
+    }
 
-  result = 2 * cur_pos + 1;
+  heapify_pqueue (priority_heap);
 
-  return result;
+#ifndef NDEBUG
+#if ASSERT_PRIORITY_QUEUE_HEAP_CONDITION
+  assert_priority_queue_heap_condition (priority_heap);
+#endif
+#endif
 }
 
 
-static int
-get_right_child_pos (int cur_pos, int size)
+static void
+delete_elem_priority_queue (PQueue * priority_heap, Var * var)
 {
-  assert (cur_pos >= 0);
-  assert (cur_pos < size);
+  assert (var->priority_slot >= 0);
+  assert (priority_heap->elems[var->priority_slot] == var);
 
-  int result;
+#ifndef NDEBUG
+#if DELETE_ELEM_ASSERT_PRIORITY_QUEUE_HEAP_CONDITION
+  assert_priority_queue_heap_condition (priority_heap);
+#endif
+#endif
 
-  result = 2 * (cur_pos + 1);
+  remove_pqueue (priority_heap, var->priority_slot);
+  var->priority_slot = -1;
 
-  return result;
+#ifndef NDEBUG
+#if DELETE_ELEM_ASSERT_PRIORITY_QUEUE_HEAP_CONDITION
+  assert_priority_queue_heap_condition (priority_heap);
+#endif
+#endif
 }
 
 
-static int
-get_parent_pos (int cur_pos, int size)
+static Var *
+remove_min (PQueue * priority_heap)
 {
-  assert (cur_pos > 0);
-  assert (cur_pos < size);
-
-  int result;
-
-  result = (cur_pos - 1) / 2;
+  Var *min_var = remove_min_pqueue (priority_heap);
 
-  assert (result < size);
+  if (min_var)
+    min_var->priority_slot = -1;
 
-  assert (cur_pos == get_right_child_pos (result, size) ||
-          cur_pos == get_left_child_pos (result, size));
+#ifndef NDEBUG
+#if ASSERT_PRIORITY_QUEUE_HEAP_CONDITION
+  assert_priority_queue_heap_condition (priority_heap);
+#endif
+#endif
 
-  return result;
+  return min_var;
 }
 
 
-#ifndef NDEBUG
-static void
-assert_priority_queue_heap_condition (Stack * priority_heap)
+static Var *
+access_min (PQueue * priority_heap)
 {
-  int size = count_stack (priority_heap);
-
-  void **start = priority_heap->elems;
-
-  int pos, no_children, left_child_pos, right_child_pos;
-  no_children = size / 2;
-
-  for (pos = 0; pos < size; pos++)
-    {
-      Var *cur_var, *left_var, *right_var;
-
-      cur_var = start[pos];
-      assert (cur_var->priority_pos == pos);
-
-      left_child_pos = get_left_child_pos (pos, size);
-      right_child_pos = get_right_child_pos (pos, size);
-
-      if (pos < no_children)
-        {
-          assert (left_child_pos < size);
-
-          left_var = start[left_child_pos];
-
-          if (right_child_pos < size)
-            right_var = start[right_child_pos];
-
-          assert (cur_var->exp_costs.score <= left_var->exp_costs.score);
-          assert (right_child_pos >= size ||
-                  cur_var->exp_costs.score <= right_var->exp_costs.score);
-        }
-      else                      /* has no children */
-        {
-          assert (right_child_pos >= size);
-          assert (left_child_pos >= size);
-        }
-    }                           /* end: for */
-
+  return access_min_pqueue (priority_heap);
 }
-#endif
 
 
 static int
-compare_priority_queue (Stack * priority_heap, int pos_a, int pos_b)
+update_key (PQueue * priority_heap, Var * var)
 {
-  assert (pos_a >= 0);
-  assert ((unsigned int) pos_a < count_stack (priority_heap));
-  assert (pos_b >= 0);
-  assert ((unsigned int) pos_b < count_stack (priority_heap));
-
-  int result;
-
-  void **start = priority_heap->elems;
+  assert (var->priority_slot >= 0);
+  assert (priority_heap->elems[var->priority_slot] == var);
 
-  Var *var_a = start[pos_a];
-  Var *var_b = start[pos_b];
+  int result = update_key_pqueue (priority_heap, var->priority_slot,
+                                  var->exp_costs.score);
 
-  int var_a_score = var_a->exp_costs.score;
-  int var_b_score = var_b->exp_costs.score;
-
-  if (var_a_score < var_b_score)
-    result = -1;
-  else if (var_a_score == var_b_score)
-    result = 0;
-  else
-    result = 1;
+#ifndef NDEBUG
+#if ASSERT_PRIORITY_QUEUE_HEAP_CONDITION
+  if (result)
+    assert_priority_queue_heap_condition (priority_heap);
+#endif
+#endif
 
   return result;
 }
 
+/* ---------- END: PRIORITY QUEUE ---------- */
 
-static void
-swap_priority_queue (Stack * priority_heap, int pos_a, int pos_b)
+static double
+time_stamp (void)
 {
-  assert (pos_a != pos_b);
-  assert ((unsigned int) pos_a < count_stack (priority_heap));
-  assert ((unsigned int) pos_b < count_stack (priority_heap));
-
-  void **a, **b, **start;
-
-  start = priority_heap->elems;
-
-  a = start + pos_a;
-  b = start + pos_b;
-
-  Var *var_a, *var_b;
-
-  var_a = *a;
-  var_b = *b;
-
-  assert (var_a->priority_pos == pos_a);
-  assert (var_b->priority_pos == pos_b);
+  double result = 0;
+  struct rusage usage;
 
-  *a = var_b;
-  var_b->priority_pos = pos_a;
+  if (!getrusage (RUSAGE_SELF, &usage))
+    {
+      result += usage.ru_utime.tv_sec + 1e-6 * usage.ru_utime.tv_usec;
+      result += usage.ru_stime.tv_sec + 1e-6 * usage.ru_stime.tv_usec;
+    }
 
-  *b = var_a;
-  var_a->priority_pos = pos_b;
+  return result;
 }
 
 
-static void
-up_heap (Stack * priority_heap, int cur_pos)
-{
-  int size = count_stack (priority_heap);
-
-  assert (cur_pos < size);
+/* ---------- START: DEADLINE ---------- */
 
-  while (cur_pos > 0)
-    {
-      int parent_pos = get_parent_pos (cur_pos, size);
+/*
+- clocks read for options '--time-limit' and '--cpu-time-limit'
+- CPU time is taken for the calling thread only: instances solved
+  concurrently in other threads do not count
+*/
+static double
+clock_stamp (clockid_t clock)
+{
+  struct timespec ts;
 
-      if (compare_priority_queue (priority_heap, cur_pos, parent_pos) >= 0)
-        break;
+  if (clock_gettime (clock, &ts))
+    return 0;
 
-      swap_priority_queue (priority_heap, cur_pos, parent_pos);
-      cur_pos = parent_pos;
-    }                           /* end: while top not reached */
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
 }
 
 
 static void
-down_heap (Stack * priority_heap, int cur_pos)
+start_deadline (Nenofex * nenofex)
 {
-  int child_pos, left_child_pos, right_child_pos;
-  int size = count_stack (priority_heap);
-
-  assert (cur_pos >= 0);
-  assert (cur_pos < size);
-
-  for (;;)
-    {
-      left_child_pos = get_left_child_pos (cur_pos, size);
-
-      if (left_child_pos >= size)
-        break;                  /* has no left child */
-
-      right_child_pos = get_right_child_pos (cur_pos, size);
-
-      if (right_child_pos < size &&
-          compare_priority_queue (priority_heap, left_child_pos,
-                                  right_child_pos) > 0)
-        child_pos = right_child_pos;
-      else
-        child_pos = left_child_pos;
-
-      if (compare_priority_queue (priority_heap, cur_pos, child_pos) > 0)
-        {
-          swap_priority_queue (priority_heap, cur_pos, child_pos);
-          cur_pos = child_pos;
-        }
-      else
-        break;
-    }                           /* end: for */
+  nenofex->deadline.wall_start = clock_stamp (CLOCK_MONOTONIC);
+  nenofex->deadline.cpu_start = clock_stamp (CLOCK_THREAD_CPUTIME_ID);
+  nenofex->deadline.countdown = 0;
+  nenofex->deadline.expired = 0;
 }
 
 
-static void
-init_order_priority_queue (Stack * priority_heap)
+/*
+- CPU time of the calling thread since 'nenofex_solve' started, does not
+  depend on other instances solved concurrently
+*/
+double
+solve_cpu_time (Nenofex * nenofex)
 {
-  int cur_pos, end_pos = count_stack (priority_heap);
-
-  for (cur_pos = 0; cur_pos < end_pos; cur_pos++)
-    {
-      up_heap (priority_heap, cur_pos);
-    }
-
-#ifndef NDEBUG
-#if ASSERT_PRIORITY_QUEUE_HEAP_CONDITION
-  assert_priority_queue_heap_condition (priority_heap);
-#endif
-#endif
+  return clock_stamp (CLOCK_THREAD_CPUTIME_ID) - nenofex->deadline.cpu_start;
 }
 
 
-static void
-delete_elem_priority_queue (Stack * priority_heap, int elem_pos)
+static int
+has_deadline (Nenofex * nenofex)
 {
-  assert (elem_pos >= 0);
-  assert ((unsigned int) elem_pos < count_stack (priority_heap));
-
-#ifndef NDEBUG
-#if DELETE_ELEM_ASSERT_PRIORITY_QUEUE_HEAP_CONDITION
-  assert_priority_queue_heap_condition (priority_heap);
-#endif
-#endif
-
-  Var *last, *del;
-  void **pos = priority_heap->elems + elem_pos;
-
-  del = *pos;
-  assert (del->priority_pos == elem_pos);
-  del->priority_pos = -1;
-
-  last = pop_stack (priority_heap);
-
-  if (del != last)
-    {
-      *pos = last;
-      last->priority_pos = elem_pos;
-      up_heap (priority_heap, elem_pos);
-      down_heap (priority_heap, elem_pos);
-    }
-
-#ifndef NDEBUG
-#if DELETE_ELEM_ASSERT_PRIORITY_QUEUE_HEAP_CONDITION
-  assert_priority_queue_heap_condition (priority_heap);
-#endif
-#endif
+  return nenofex->options.time_limit || nenofex->options.cpu_time_limit;
 }
 
 
-static Var *
-remove_min (Stack * priority_heap)
+/*
+- polled cooperatively in loops of expansions and optimizations
+- clocks are read only every 'DEADLINE_POLL_INTERVAL' calls unless 'force'
+  is set, once expired the deadline stays expired
+*/
+int
+deadline_expired (Nenofex * nenofex, int force)
 {
-  void **start = priority_heap->elems;
+  if (nenofex->deadline.expired)
+    return 1;
 
-  if (start == priority_heap->top)
+  if (!has_deadline (nenofex))
     return 0;
 
-  Var *min_var, *last_var;
-
-  min_var = *start;
-  min_var->priority_pos = -1;
-
-  last_var = pop_stack (priority_heap);
-
-  assert (last_var != min_var || count_stack (priority_heap) == 0);
-
-  if (min_var == last_var)
-    return min_var;
-
-  *start = last_var;
-  last_var->priority_pos = 0;
-
-  if (count_stack (priority_heap) >= 2)
+  if (!force && nenofex->deadline.countdown)
     {
-      down_heap (priority_heap, 0);
+      nenofex->deadline.countdown--;
+      return 0;
     }
+  nenofex->deadline.countdown = DEADLINE_POLL_INTERVAL;
 
-#ifndef NDEBUG
-#if ASSERT_PRIORITY_QUEUE_HEAP_CONDITION
-  assert_priority_queue_heap_condition (priority_heap);
-#endif
-#endif
+  unsigned int time_limit = nenofex->options.time_limit;
+  unsigned int cpu_time_limit = nenofex->options.cpu_time_limit;
 
-  return min_var;
+  if ((time_limit && clock_stamp (CLOCK_MONOTONIC) -
+       nenofex->deadline.wall_start >= time_limit) ||
+      (cpu_time_limit && clock_stamp (CLOCK_THREAD_CPUTIME_ID) -
+       nenofex->deadline.cpu_start >= cpu_time_limit))
+    nenofex->deadline.expired = 1;
+
+  return nenofex->deadline.expired;
 }
 
 
-static Var *
-access_min (Stack * priority_heap)
+static void
+print_deadline_cutoff (Nenofex * nenofex)
 {
-  void **start = priority_heap->elems;
-
-  if (start == priority_heap->top)
-    return 0;
-  else
-    return *start;
+  if (!nenofex->options.print_short_answer_specified)
+    fprintf (stderr, "\n\tTIME CUTOFF: wall-clock time = %.2f s, "
+             "CPU time = %.2f s\n\n",
+             clock_stamp (CLOCK_MONOTONIC) - nenofex->deadline.wall_start,
+             clock_stamp (CLOCK_THREAD_CPUTIME_ID) -
+             nenofex->deadline.cpu_start);
 }
 
+/* ---------- END: DEADLINE ---------- */
 
-static void
-decrease_key (Stack * priority_heap, Var * var)
-{
-  int cur_pos = var->priority_pos;
 
-  assert (cur_pos >= 0);
-  assert ((unsigned int) cur_pos < count_stack (priority_heap));
-  assert (var == priority_heap->elems[cur_pos]);
+/* ---------- START: PROFILER ---------- */
 
-  up_heap (priority_heap, cur_pos);
-}
+static const char *const phase_names[NENOFEX_NUM_PHASES] = {
+  "parse",
+  "solve",
+  "simplify",
+  "scores",
+  "expand",
+  "copy",
+  "optimize",
+  "global flow",
+  "atpg",
+  "cnf",
+  "sat"
+};
 
 
-static void
-increase_key (Stack * priority_heap, Var * var)
+/*
+- time since last phase change is charged to the innermost entered phase,
+  so nested phases are excluded from enclosing ones
+- one read of the monotonic clock per call, none if statistics are off
+*/
+void
+profile_enter (Nenofex * nenofex, NenofexPhase phase)
 {
-  int cur_pos = var->priority_pos;
+  if (!stats_basic (nenofex))
+    return;
+
+  double now = clock_stamp (CLOCK_MONOTONIC);
+  unsigned int depth = nenofex->profile.depth;
 
-  assert (cur_pos >= 0);
-  assert ((unsigned int) cur_pos < count_stack (priority_heap));
-  assert (var == priority_heap->elems[cur_pos]);
+  assert (depth < PROFILE_MAX_DEPTH);
 
-  down_heap (priority_heap, cur_pos);
+  if (depth)
+    nenofex->profile.seconds[nenofex->profile.stack[depth - 1]] +=
+      now - nenofex->profile.last;
+
+  nenofex->profile.stack[depth] = phase;
+  nenofex->profile.depth = depth + 1;
+  nenofex->profile.calls[phase]++;
+  nenofex->profile.last = now;
 }
 
 
-static int
-update_key (Stack * priority_heap, Var * var, int old_score)
+void
+profile_leave (Nenofex * nenofex, NenofexPhase phase)
 {
-  int result;
-
-  int score = var->exp_costs.score;
+  if (!stats_basic (nenofex))
+    return;
 
-  if (score == old_score)
-    result = 0;
-  else if (score < old_score)
-    {
-      decrease_key (priority_heap, var);
-      result = -1;
-    }
-  else
-    {
-      increase_key (priority_heap, var);
-      result = 1;
-    }
+  double now = clock_stamp (CLOCK_MONOTONIC);
 
-#ifndef NDEBUG
-#if ASSERT_PRIORITY_QUEUE_HEAP_CONDITION
-  if (result)
-    assert_priority_queue_heap_condition (priority_heap);
-#endif
-#endif
+  assert (nenofex->profile.depth);
+  assert (nenofex->profile.stack[nenofex->profile.depth - 1] == phase);
 
-  return result;
+  nenofex->profile.seconds[phase] += now - nenofex->profile.last;
+  nenofex->profile.depth--;
+  nenofex->profile.last = now;
 }
 
-/* ---------- END: PRIORITY QUEUE ---------- */
 
-static double
-time_stamp ()
+static void
+print_profile (Nenofex * nenofex)
 {
-  double result = 0;
-  struct rusage usage;
+  double total = 0;
+  int phase;
 
-  if (!getrusage (RUSAGE_SELF, &usage))
+  for (phase = 0; phase < NENOFEX_NUM_PHASES; phase++)
+    total += nenofex->profile.seconds[phase];
+
+  fprintf (stderr, "\nProfile (wall-clock time without nested phases):\n");
+  for (phase = 0; phase < NENOFEX_NUM_PHASES; phase++)
     {
-      result += usage.ru_utime.tv_sec + 1e-6 * usage.ru_utime.tv_usec;
-      result += usage.ru_stime.tv_sec + 1e-6 * usage.ru_stime.tv_usec;
+      if (!nenofex->profile.calls[phase])
+        continue;
+      fprintf (stderr, "  %-12s %10llu calls %9.3fs %6.2f%%\n",
+               phase_names[phase], nenofex->profile.calls[phase],
+               nenofex->profile.seconds[phase],
+               total > 0 ? 100 * nenofex->profile.seconds[phase] / total : 0);
     }
-
-  return result;
+  fprintf (stderr, "  %-12s %16s %9.3fs\n", "total", "", total);
 }
 
+/* ---------- END: PROFILER ---------- */
+
 
 /*
 - costs of vars on stack 'vars_marked_for_update' will be updated from scratch
@@ -704,9 +660,12 @@ static void init_lca_object (Nenofex * nenofex, LCAObject * lca_object);
 
 static void delete_node (Nenofex * nenofex, Node * node);
 
+static void release_node (Nenofex * nenofex, Node * node);
+
 
 /*
 - delete whole graph
+- nodes are recycled when the graph is rebuilt in incremental mode
 */
 static void
 free_graph (Nenofex * nenofex)
@@ -726,20 +685,20 @@ free_graph (Nenofex * nenofex)
       if (!is_literal_node (cur))
         {
           Node *ch;
-          for (ch = cur->child_list.last; ch; ch = ch->level_link.prev)
+          for (ch = node_at (nenofex, cur->child_list.last); ch;
+               ch = node_at (nenofex, ch->level_link.prev))
             {
               push_stack (mm, stack, ch);
             }
         }
 
-      if (cur->lca_child_list_occs)
+      if (node_cold (nenofex, cur)->lca_child_list_occs)
         {
-          delete_stack (mm, cur->lca_child_list_occs);
-          assert (cur->pos_in_lca_children);
-          delete_stack (mm, cur->pos_in_lca_children);
+          delete_stack (mm, node_cold (nenofex, cur)->lca_child_list_occs);
+          assert (node_cold (nenofex, cur)->pos_in_lca_children);
+          delete_stack (mm, node_cold (nenofex, cur)->pos_in_lca_children);
         }
-
-      mem_free (mm, cur, sizeof (Node));
+      release_node (nenofex, cur);
     }                           /* end: while stack not empty */
 
   delete_stack (mm, stack);
@@ -751,32 +710,136 @@ static void free_lca_children (Nenofex *nenofex, LCAObject * lca_object);
 
 static void delete_scope (Nenofex *nenofex, Scope * scope);
 
-/*
-- create new AND-operator node
-- node ID actually not relevant
-*/
-Node *
-and_node (Nenofex * nenofex)
-{
-  assert (nenofex->next_free_node_id > nenofex->num_orig_vars);
 
-#if COMPUTE_NUM_TOTAL_CREATED_NODES
-  nenofex->stats.num_total_created_nodes++;
-#endif
+/* ---------- START: ALLOCATION OF NODES ---------- */
 
-  size_t num_bytes = sizeof (Node);
-  Node *result = mem_malloc (nenofex->mm, num_bytes);
-  assert (result);
-  memset (result, 0, num_bytes);
+#if NODE_ARENA
 
-  result->type = NODE_TYPE_AND;
-  result->id = nenofex->next_free_node_id++;
+#define DEFAULT_NODE_BLOCKS_SIZE 16
 
-  return result;
+static void
+init_node_arena (Nenofex * nenofex)
+{
+  assert (!nenofex->node_blocks);
+  assert (NODE_BLOCK_SLOTS <= (1u << NODE_BLOCK_SLOT_BITS));
+  nenofex->size_node_blocks = DEFAULT_NODE_BLOCKS_SIZE;
+  nenofex->node_blocks =
+    mem_malloc (nenofex->mm, nenofex->size_node_blocks * sizeof (NodeBlock *));
+  nenofex->num_node_blocks = 0;
+  /* forces allocation of first block */
+  nenofex->next_node_slot = NODE_BLOCK_SLOTS;
+  nenofex->free_node = 0;
 }
 
 
-/*
+static void
+free_node_arena (Nenofex * nenofex)
+{
+  unsigned int i;
+  for (i = 0; i < nenofex->num_node_blocks; i++)
+    mem_free (nenofex->mm, nenofex->node_blocks[i], NODE_BLOCK_BYTES);
+  mem_free (nenofex->mm, nenofex->node_blocks,
+            nenofex->size_node_blocks * sizeof (NodeBlock *));
+  nenofex->node_blocks = 0;
+}
+
+
+static void
+add_node_block (Nenofex * nenofex)
+{
+  if (nenofex->num_node_blocks == nenofex->size_node_blocks)
+    {
+      size_t old_bytes = nenofex->size_node_blocks * sizeof (NodeBlock *);
+      nenofex->size_node_blocks *= 2;
+      nenofex->node_blocks =
+        mem_realloc (nenofex->mm, nenofex->node_blocks, old_bytes,
+                     nenofex->size_node_blocks * sizeof (NodeBlock *));
+    }
+
+  if (nenofex->num_node_blocks ==
+      (UINT32_MAX >> NODE_BLOCK_SLOT_BITS) + 1)
+    {
+      fprintf (stderr, "Node arena exhausted!\n");
+      abort ();
+    }
+
+  NodeBlock *block = mem_aligned_malloc (nenofex->mm, NODE_BLOCK_BYTES,
+                                         NODE_BLOCK_BYTES);
+  block->index = nenofex->num_node_blocks;
+  nenofex->node_blocks[nenofex->num_node_blocks++] = block;
+  /* reference 0 is null */
+  nenofex->next_node_slot = block->index ? 0 : 1;
+}
+
+#endif /* end: if NODE_ARENA */
+
+
+/*
+- return new node with all fields cleared
+*/
+static Node *
+alloc_node (Nenofex * nenofex)
+{
+  Node *result;
+
+#if NODE_ARENA
+  if (nenofex->free_node)
+    {
+      result = node_at (nenofex, nenofex->free_node);
+      nenofex->free_node = result->parent;
+    }
+  else
+    {
+      if (nenofex->next_node_slot == NODE_BLOCK_SLOTS)
+        add_node_block (nenofex);
+      result = nenofex->node_blocks[nenofex->num_node_blocks - 1]->nodes +
+        nenofex->next_node_slot++;
+    }
+#else
+  result = mem_slab_malloc (nenofex->mm, sizeof (Node));
+#endif
+
+  assert (result);
+  memset (result, 0, sizeof (Node));
+  return result;
+}
+
+
+static void
+release_node (Nenofex * nenofex, Node * node)
+{
+#if NODE_ARENA
+  node->parent = nenofex->free_node;
+  nenofex->free_node = node_ref (nenofex, node);
+#else
+  mem_slab_free (nenofex->mm, node, sizeof (Node));
+#endif
+}
+
+/* ---------- END: ALLOCATION OF NODES ---------- */
+
+/*
+- create new AND-operator node
+- node ID actually not relevant
+*/
+Node *
+and_node (Nenofex * nenofex)
+{
+  assert (nenofex->next_free_node_id > nenofex->num_orig_vars);
+
+  if (stats_basic (nenofex))
+    nenofex->stats.num_total_created_nodes++;
+
+  Node *result = alloc_node (nenofex);
+
+  result->type = NODE_TYPE_AND;
+  result->id = nenofex->next_free_node_id++;
+
+  return result;
+}
+
+
+/*
 - create new OR-operator node
 - node ID actually not relevant
 */
@@ -785,14 +848,10 @@ or_node (Nenofex * nenofex)
 {
   assert (nenofex->next_free_node_id > nenofex->num_orig_vars);
 
-#if COMPUTE_NUM_TOTAL_CREATED_NODES
-  nenofex->stats.num_total_created_nodes++;
-#endif
+  if (stats_basic (nenofex))
+    nenofex->stats.num_total_created_nodes++;
 
-  size_t num_bytes = sizeof (Node);
-  Node *result = mem_malloc (nenofex->mm, num_bytes);
-  assert (result);
-  memset (result, 0, num_bytes);
+  Node *result = alloc_node (nenofex);
 
   result->type = NODE_TYPE_OR;
   result->id = nenofex->next_free_node_id++;
@@ -810,14 +869,10 @@ lit_node (Nenofex * nenofex, int lit, Var * var)
 {
   assert (lit);
 
-#if COMPUTE_NUM_TOTAL_CREATED_NODES
-  nenofex->stats.num_total_created_nodes++;
-#endif
+  if (stats_basic (nenofex))
+    nenofex->stats.num_total_created_nodes++;
 
-  size_t num_bytes = sizeof (Node);
-  Node *result = (Node *) mem_malloc (nenofex->mm, num_bytes);
-  assert (result);
-  memset (result, 0, num_bytes);
+  Node *result = alloc_node (nenofex);
 
   result->id = lit;
   result->type = NODE_TYPE_LITERAL;
@@ -830,6 +885,110 @@ lit_node (Nenofex * nenofex, int lit, Var * var)
 }
 
 
+/* ---------- START: COLD PARTS OF NODES ---------- */
+
+#define DEFAULT_NODE_COLDS_SIZE 1024
+
+/*
+- record 0 is shared by all nodes without cold part
+*/
+static void
+init_node_colds (Nenofex * nenofex)
+{
+  assert (!nenofex->node_colds);
+  nenofex->size_node_colds = DEFAULT_NODE_COLDS_SIZE;
+  nenofex->node_colds =
+    mem_malloc (nenofex->mm, nenofex->size_node_colds * sizeof (NodeCold));
+  memset (nenofex->node_colds, 0, sizeof (NodeCold));
+  nenofex->next_node_cold = 1;
+  nenofex->free_node_cold = 0;
+}
+
+
+static void
+free_node_colds (Nenofex * nenofex)
+{
+  mem_free (nenofex->mm, nenofex->node_colds,
+            nenofex->size_node_colds * sizeof (NodeCold));
+  nenofex->node_colds = 0;
+}
+
+
+#ifndef NDEBUG
+static void
+assert_node_cold_zero_record (Nenofex * nenofex)
+{
+  NodeCold zero;
+  memset (&zero, 0, sizeof (NodeCold));
+  assert (!memcmp (nenofex->node_colds, &zero, sizeof (NodeCold)));
+}
+#endif
+
+
+/*
+- return cold part of 'node', allocate it if 'node' has none so far
+- must be called before writing to cold part
+*/
+NodeCold *
+alloc_node_cold (Nenofex * nenofex, Node * node)
+{
+#ifndef NDEBUG
+  assert_node_cold_zero_record (nenofex);
+#endif
+
+  if (node->cold)
+    return node_cold (nenofex, node);
+
+  if (nenofex->free_node_cold)
+    {
+      node->cold = nenofex->free_node_cold;
+      nenofex->free_node_cold = node_cold (nenofex, node)->next_free;
+    }
+  else
+    {
+      if (nenofex->next_node_cold == nenofex->size_node_colds)
+        {
+          size_t old_bytes = nenofex->size_node_colds * sizeof (NodeCold);
+          nenofex->size_node_colds *= 2;
+          nenofex->node_colds =
+            mem_realloc (nenofex->mm, nenofex->node_colds, old_bytes,
+                         nenofex->size_node_colds * sizeof (NodeCold));
+        }
+
+      node->cold = nenofex->next_node_cold++;
+    }
+
+  NodeCold *result = node_cold (nenofex, node);
+  memset (result, 0, sizeof (NodeCold));
+  return result;
+}
+
+
+/*
+- recycle cold part of 'node' which is about to be deleted
+*/
+static void
+free_node_cold (Nenofex * nenofex, Node * node)
+{
+#ifndef NDEBUG
+  assert_node_cold_zero_record (nenofex);
+#endif
+
+  if (!node->cold)
+    return;
+
+  NodeCold *cold = node_cold (nenofex, node);
+  assert (!cold->lca_child_list_occs);
+  assert (!cold->pos_in_lca_children);
+
+  cold->next_free = nenofex->free_node_cold;
+  nenofex->free_node_cold = node->cold;
+  node->cold = 0;
+}
+
+/* ---------- END: COLD PARTS OF NODES ---------- */
+
+
 /*
 - collect possible unates incrementally whenever one occ. list becomes empty
 */
@@ -844,6 +1003,34 @@ collect_variable_as_unate (Nenofex * nenofex, Var * var)
 }
 
 
+/*
+- variable 'var' got its first occurrence ('delta' == 1) or lost its last one 
+  ('delta' == -1)
+- makes checking for existential / universal formula a constant-time operation
+*/
+static void
+count_occ_var (Nenofex * nenofex, Var * var, int delta)
+{
+  Scope *scope = var->scope;
+  assert (scope);
+  assert (delta == 1 || delta == -1);
+  assert (delta == 1 || scope->occ_var_cnt);
+
+  scope->occ_var_cnt += delta;
+
+  if (is_existential_scope (scope))
+    {
+      assert (delta == 1 || nenofex->exist_occ_var_cnt);
+      nenofex->exist_occ_var_cnt += delta;
+    }
+  else
+    {
+      assert (delta == 1 || nenofex->univ_occ_var_cnt);
+      nenofex->univ_occ_var_cnt += delta;
+    }
+}
+
+
 /*
 - set up new variable
 - TO BE CHANGED: variables are collected twice (in scope and on separate stack)
@@ -868,7 +1055,7 @@ init_variable (Nenofex * nenofex, unsigned int abs_lit, Scope * scope)
   nenofex->vars[abs_lit] = var;
 
   var->id = abs_lit;
-  var->priority_pos = -1;
+  var->priority_slot = -1;
   var->lits[0].var = var;
   var->lits[0].negated = 1;
   var->lits[1].var = var;
@@ -910,23 +1097,20 @@ assert_occ_list_integrity (Nenofex * nenofex, Lit * lit)
 {
   Node *node, *prev;
   prev = 0;
-  for (node = lit->occ_list.first; node; node = node->occ_link.next)
+  for (node = lit->occ_list.first; node;
+       node = node_at (nenofex, node->occ_link.next))
     {
       assert (node->lit == lit);
-      assert (node->num_children == 0);
       assert (node->size_subformula == 1);
       assert (is_literal_node (node));
 
-      assert (!node->child_list.first);
-      assert (!node->child_list.last);
-
       assert (nenofex->cur_expanded_var || !node->mark2);
       assert (nenofex->cur_expanded_var || !node->mark2);
 
       assert (node->id);
       assert (node->id == (lit->negated ? -lit->var->id : lit->var->id));
-      assert (!prev || node->occ_link.prev == prev);
-      assert (!prev || prev->occ_link.next == node);
+      assert (!prev || node_at (nenofex, node->occ_link.prev) == prev);
+      assert (!prev || node_at (nenofex, prev->occ_link.next) == node);
       assert (node != lit->occ_list.first || !node->occ_link.prev);
       assert (node != lit->occ_list.last || !node->occ_link.next);
       prev = node;
@@ -980,21 +1164,17 @@ static unsigned int count_children (Nenofex * nenofex, Node * node);
 static void
 assert_child_occ_list_integrity (Nenofex * nenofex, Node * parent)
 {
-  assert (parent->num_children == count_children (nenofex, parent));
-
   assert (parent != nenofex->graph_root || !parent->parent);
   assert (parent->parent || parent == nenofex->graph_root);
 
   /* atpg_info-pointers expected to be cleared properly */
-  assert (nenofex->cur_expanded_var || !parent->atpg_info);
+  assert (nenofex->cur_expanded_var || !node_atpg_info (nenofex, parent));
   assert (nenofex->cur_expanded_var || !parent->mark1);
 
   assert (!parent->mark2);
 
   if (is_literal_node (parent))
     {
-      assert (!parent->child_list.first);
-      assert (!parent->child_list.last);
       assert (parent->lit);
       assert (!parent->lit->var->simp_mark);
       assert (parent->id);
@@ -1011,9 +1191,7 @@ assert_child_occ_list_integrity (Nenofex * nenofex, Node * parent)
   else
     {
       assert (parent->id > 0);
-      assert (!parent->lit);
-      assert (!parent->occ_link.next);
-      assert (!parent->occ_link.prev);
+      assert (parent->num_children == count_children (nenofex, parent));
       assert ((unsigned int) parent->id > nenofex->num_orig_vars);
       assert (is_or_node (parent) || is_and_node (parent));
 
@@ -1025,28 +1203,33 @@ assert_child_occ_list_integrity (Nenofex * nenofex, Node * parent)
       else
         {
           assert (parent->child_list.last);
-          assert (parent->child_list.first != parent->child_list.last);
+          assert (node_at (nenofex, parent->child_list.first) !=
+                  node_at (nenofex, parent->child_list.last));
 
           int op_ch_found = 0;
           Node *ch, *prev;
           prev = 0;
-          for (ch = parent->child_list.first; ch; ch = ch->level_link.next)
+          for (ch = node_at (nenofex, parent->child_list.first); ch;
+               ch = node_at (nenofex, ch->level_link.next))
             {
               op_ch_found = (op_ch_found || !is_literal_node (ch));
 
               assert (!op_ch_found || !is_literal_node (ch));
 
               /* atpg_info->pointers expected to be cleared properly */
-              assert (nenofex->cur_expanded_var || !ch->atpg_info);
+              assert (nenofex->cur_expanded_var
+                      || !node_atpg_info (nenofex, ch));
               assert (nenofex->cur_expanded_var || !ch->mark1);
 
-              assert (!prev || ch->level_link.prev == prev);
-              assert (!prev || prev->level_link.next == ch);
-              assert (ch->parent->type != ch->type);
-              assert (ch->parent == parent);
+              assert (!prev || node_at (nenofex, ch->level_link.prev) == prev);
+              assert (!prev || node_at (nenofex, prev->level_link.next) == ch);
+              assert (node_at (nenofex, ch->parent)->type != ch->type);
+              assert (node_at (nenofex, ch->parent) == parent);
               assert (ch->level == parent->level + 1);
-              assert (ch != parent->child_list.first || !ch->level_link.prev);
-              assert (ch != parent->child_list.last || !ch->level_link.next);
+              assert (ch != node_at (nenofex, parent->child_list.first)
+                      || !ch->level_link.prev);
+              assert (ch != node_at (nenofex, parent->child_list.last)
+                      || !ch->level_link.next);
               prev = ch;
             }
         }
@@ -1070,8 +1253,8 @@ assert_all_child_occ_lists_integrity (Nenofex * nenofex)
       if (!is_literal_node (cur))
         {
           Node *child;
-          for (child = cur->child_list.last; child;
-               child = child->level_link.prev)
+          for (child = node_at (nenofex, cur->child_list.last); child;
+               child = node_at (nenofex, child->level_link.prev))
             {
               push_stack (nenofex->mm, stack, child);
             }
@@ -1098,8 +1281,8 @@ find_node_by_id (Nenofex *nenofex, Node * root, int id)
       if (!is_literal_node (cur))
         {
           Node *child;
-          for (child = cur->child_list.last; child;
-               child = child->level_link.prev)
+          for (child = node_at (nenofex, cur->child_list.last); child;
+               child = node_at (nenofex, child->level_link.prev))
             push_stack (nenofex->mm, stack, (void *) child);
         }
     }                           /* end: while */
@@ -1124,8 +1307,8 @@ find_node_by_address (Nenofex *nenofex, Node * root, Node * node)
       if (!is_literal_node (cur))
         {
           Node *child;
-          for (child = cur->child_list.last; child;
-               child = child->level_link.prev)
+          for (child = node_at (nenofex, cur->child_list.last); child;
+               child = node_at (nenofex, child->level_link.prev))
             push_stack (nenofex->mm, stack, (void *) child);
         }
     }                           /* end: while */
@@ -1169,9 +1352,10 @@ simplify_one_level (Nenofex * nenofex, Node * root)
   Stack *marked = create_stack (nenofex->mm, DEFAULT_STACK_SIZE);
 
   Node *ch, *next;
-  for (ch = root->child_list.first; ch && (is_literal_node (ch)); ch = next)
+  for (ch = node_at (nenofex, root->child_list.first);
+       ch && (is_literal_node (ch)); ch = next)
     {
-      next = ch->level_link.next;
+      next = node_at (nenofex, ch->level_link.next);
 
       Lit *lit = ch->lit;
       assert (lit);
@@ -1286,8 +1470,8 @@ print_graph_by_traversal (Nenofex *nenofex, Node * root)
           unsigned int old_cnt = count_stack (stack);
 
           Node *child;
-          for (child = cur->child_list.last; child;
-               child = child->level_link.prev)
+          for (child = node_at (nenofex, cur->child_list.last); child;
+               child = node_at (nenofex, child->level_link.prev))
             {
               push_stack (nenofex->mm, stack, (void *) child);
               assert (*(stack->top - 1) == child);
@@ -1328,15 +1512,17 @@ unlink_node_from_occ_list (Nenofex * nenofex, Node * node)
 
   if (node->occ_link.prev)
     {
-      node->occ_link.prev->occ_link.next = node->occ_link.next;
+      node_at (nenofex, node->occ_link.prev)->occ_link.next =
+        node->occ_link.next;
 
       if (node->occ_link.next)
-        node->occ_link.next->occ_link.prev = node->occ_link.prev;
+        node_at (nenofex, node->occ_link.next)->occ_link.prev =
+          node->occ_link.prev;
       else
         {                       /* node == last */
           assert (node == node->lit->occ_list.last);
 
-          node->lit->occ_list.last = node->occ_link.prev;
+          node->lit->occ_list.last = node_at (nenofex, node->occ_link.prev);
 
           assert (!node->lit->occ_list.last->occ_link.next);
         }
@@ -1345,11 +1531,12 @@ unlink_node_from_occ_list (Nenofex * nenofex, Node * node)
     {                           /* node == first */
       assert (node == node->lit->occ_list.first);
 
-      node->lit->occ_list.first = node->occ_link.next;
+      node->lit->occ_list.first = node_at (nenofex, node->occ_link.next);
 
       if (node->occ_link.next)
         {
-          node->occ_link.next->occ_link.prev = node->occ_link.prev;
+          node_at (nenofex, node->occ_link.next)->occ_link.prev =
+            node->occ_link.prev;
 
           assert (!node->lit->occ_list.first->occ_link.prev);
         }
@@ -1373,6 +1560,8 @@ unlink_node_from_occ_list (Nenofex * nenofex, Node * node)
   if (node->lit->occ_cnt == 0)
     {
       collect_variable_as_unate (nenofex, node->lit->var);
+      if (!variable_has_occs (node->lit->var))
+        count_occ_var (nenofex, node->lit->var, -1);
     }
 #ifndef NDEBUG
   else if (node->lit->occ_cnt == 1)
@@ -1389,6 +1578,8 @@ unlink_node_from_occ_list (Nenofex * nenofex, Node * node)
 }
 
 
+static void invalidate_lca_index (Nenofex * nenofex, Node * root);
+
 /* 
 - unlink node from child-list
 */
@@ -1397,6 +1588,8 @@ unlink_node (Nenofex * nenofex, Node * node)
 {
   assert (node);
 
+  invalidate_lca_index (nenofex, node);
+
   if (!node->parent)
     {                           /* should NOT be called on graph_root */
       assert (node == nenofex->graph_root);
@@ -1404,49 +1597,66 @@ unlink_node (Nenofex * nenofex, Node * node)
     }
 
   assert (node->parent);
-  assert (node->parent->child_list.first);
-  assert (node->parent->child_list.last);
+  assert (node_at (nenofex, node->parent)->child_list.first);
+  assert (node_at (nenofex, node->parent)->child_list.last);
 
   if (node->level_link.prev)
     {
-      node->level_link.prev->level_link.next = node->level_link.next;
+      node_at (nenofex, node->level_link.prev)->level_link.next =
+        node->level_link.next;
 
       if (node->level_link.next)
-        node->level_link.next->level_link.prev = node->level_link.prev;
+        node_at (nenofex, node->level_link.next)->level_link.prev =
+          node->level_link.prev;
       else
         {                       /* node == last */
-          assert (node == node->parent->child_list.last);
+          assert (node ==
+                  node_at (nenofex,
+                           node_at (nenofex, node->parent)->child_list.last));
 
-          node->parent->child_list.last = node->level_link.prev;
+          node_at (nenofex, node->parent)->child_list.last =
+            node->level_link.prev;
 
-          assert (!node->parent->child_list.last->level_link.next);
+          assert (!node_at (nenofex,
+                            node_at (nenofex, node->parent)->child_list.last)->
+                  level_link.next);
         }
     }
   else
     {                           /* node == first */
-      assert (node == node->parent->child_list.first);
+      assert (node ==
+              node_at (nenofex,
+                       node_at (nenofex, node->parent)->child_list.first));
 
-      node->parent->child_list.first = node->level_link.next;
+      node_at (nenofex, node->parent)->child_list.first =
+        node->level_link.next;
 
       if (node->level_link.next)
         {
-          node->level_link.next->level_link.prev = node->level_link.prev;
+          node_at (nenofex, node->level_link.next)->level_link.prev =
+            node->level_link.prev;
 
-          assert (!node->parent->child_list.first->level_link.prev);
+          assert (!node_at (nenofex,
+                            node_at (nenofex,
+                                     node->parent)->child_list.first)->
+                  level_link.prev);
         }
       else
         {                       /* node == first == last */
 
-          assert (node == node->parent->child_list.last);
+          assert (node ==
+                  node_at (nenofex,
+                           node_at (nenofex, node->parent)->child_list.last));
 
-          node->parent->child_list.last = node->parent->child_list.first;
+          node_at (nenofex, node->parent)->child_list.last =
+            node_at (nenofex, node->parent)->child_list.first;
 
-          assert (!node->parent->child_list.first);
-          assert (!node->parent->child_list.last);
+          assert (!node_at (nenofex, node->parent)->child_list.first);
+          assert (!node_at (nenofex, node->parent)->child_list.last);
         }
     }
 
-  node->parent->num_children--;
+  node_at (nenofex, node->parent)->num_children--;
   node->parent = node->level_link.next = node->level_link.prev = 0;
 }
 
@@ -1460,6 +1670,8 @@ merge_parent_update_level (Nenofex *nenofex, Node * root, unsigned const int del
   assert (!is_literal_node (root));
   assert (delta == 1 || delta == 2);
 
+  invalidate_lca_index (nenofex, root);
+
   Stack *stack = create_stack (nenofex->mm, DEFAULT_STACK_SIZE);
   push_stack (nenofex->mm, stack, root);
 
@@ -1471,8 +1683,8 @@ merge_parent_update_level (Nenofex *nenofex, Node * root, unsigned const int del
       if (!is_literal_node (cur))
         {
           Node *child;
-          for (child = cur->child_list.last; child;
-               child = child->level_link.prev)
+          for (child = node_at (nenofex, cur->child_list.last); child;
+               child = node_at (nenofex, child->level_link.prev))
             push_stack (nenofex->mm, stack, child);
         }
     }                           /* end: while */
@@ -1481,6 +1693,150 @@ merge_parent_update_level (Nenofex *nenofex, Node * root, unsigned const int del
 }
 
 
+/* START: DEFERRED SIZE UPDATES */
+
+/*
+- while deferred, 'update_size_subformula' only records the delta at 'root'
+- the true size of a node is its 'size_subformula' plus all pending deltas
+  in its subformula: this is preserved when subformulae are relinked or
+  deleted as a whole, hence no flush is needed before such operations
+- a node deleted while its successors are kept must pass its delta on
+  to the node taking over the successors (see 'merge_parent')
+*/
+static void
+record_size_subformula_delta (Nenofex * nenofex, Node * node, const int delta)
+{
+  NodeCold *cold = alloc_node_cold (nenofex, node);
+
+  if (!cold->size_delta_pos)
+    {
+      push_stack (nenofex->mm, nenofex->size_delta_nodes, node);
+      cold->size_delta_pos = count_stack (nenofex->size_delta_nodes);
+    }
+
+  cold->size_delta += delta;
+}
+
+
+static void
+discard_size_subformula_delta (Nenofex * nenofex, Node * node)
+{
+  NodeCold *cold = node_cold (nenofex, node);
+
+  if (cold->size_delta_pos)
+    {
+      assert (nenofex->size_delta_nodes->elems[cold->size_delta_pos - 1] ==
+              node);
+      nenofex->size_delta_nodes->elems[cold->size_delta_pos - 1] = 0;
+      cold->size_delta_pos = 0;
+      cold->size_delta = 0;
+    }
+}
+
+
+/*
+- 'node' will be deleted, but its successors are now below 'target'
+*/
+static void
+move_size_subformula_delta (Nenofex * nenofex, Node * node, Node * target)
+{
+  if (node_cold (nenofex, node)->size_delta)
+    record_size_subformula_delta (nenofex, target,
+                                  node_cold (nenofex, node)->size_delta);
+
+  discard_size_subformula_delta (nenofex, node);
+}
+
+
+static int
+compare_nodes_by_level_descending (const void *p1, const void *p2)
+{
+  const Node *n1 = *(Node **) p1;
+  const Node *n2 = *(Node **) p2;
+
+  return n1->level < n2->level ? 1 : (n1->level > n2->level ? -1 : 0);
+}
+
+
+static void
+defer_size_subformula_updates (Nenofex * nenofex)
+{
+  assert (!nenofex->size_updates_deferred);
+  assert (!count_stack (nenofex->size_delta_nodes));
+
+#if DEFER_SIZE_SUBFORMULA_UPDATES
+  nenofex->size_updates_deferred = 1;
+#endif
+}
+
+
+/*
+- adds ancestors of nodes with deltas, then visits nodes bottom-up such that
+  every node on the union of paths to the root is updated exactly once
+*/
+static void
+flush_size_subformula_updates (Nenofex * nenofex)
+{
+  Stack *stack = nenofex->size_delta_nodes;
+  unsigned int i, cnt;
+
+  nenofex->size_updates_deferred = 0;
+
+  for (i = 0; i < count_stack (stack); i++)
+    {                           /* 'stack' grows while iterating */
+      Node *node = stack->elems[i];
+      if (node && node->parent
+          && !node_cold (nenofex,
+                         node_at (nenofex, node->parent))->size_delta_pos)
+        record_size_subformula_delta (nenofex, node_at (nenofex, node->parent),
+                                      0);
+    }
+
+  cnt = 0;
+  for (i = 0; i < count_stack (stack); i++)
+    {                           /* remove entries of deleted nodes */
+      if (stack->elems[i])
+        stack->elems[cnt++] = stack->elems[i];
+    }
+  stack->top = stack->elems + cnt;
+
+  qsort (stack->elems, cnt, sizeof (Node *),
+         compare_nodes_by_level_descending);
+
+  if (stats_full (nenofex))
+    nenofex->stats.num_total_size_update_visits += cnt;
+
+  for (i = 0; i < cnt; i++)
+    {
+      Node *node = stack->elems[i];
+      NodeCold *cold = node_cold (nenofex, node);
+      assert (cold->size_delta_pos);
+
+      if (cold->size_delta)
+        {
+          node->size_subformula += cold->size_delta;
+          assert ((int) node->size_subformula > 0);
+
+          if (node->parent)
+            {
+              assert (node_cold (nenofex,
+                                 node_at (nenofex, node->parent))->
+                      size_delta_pos);
+              node_cold (nenofex, node_at (nenofex, node->parent))->
+                size_delta += cold->size_delta;
+            }
+        }
+
+      cold->size_delta = 0;
+      cold->size_delta_pos = 0;
+    }
+
+  reset_stack (stack);
+}
+
+/* END: DEFERRED SIZE UPDATES */
+
+
 /* 
 - starts at 'root' and goes up via parent-pointers until graph root is reached
 - updates sizes of each node on path by adding 'delta' 
@@ -1492,13 +1848,28 @@ update_size_subformula (Nenofex * nenofex, Node * root, const int delta)
   assert (root);
   assert (delta);
 
+  if (stats_full (nenofex))
+    nenofex->stats.num_total_size_update_plain_visits += root->level + 1;
+
+#if DEFER_SIZE_SUBFORMULA_UPDATES
+  if (nenofex->size_updates_deferred)
+    {
+      record_size_subformula_delta (nenofex, root, delta);
+      return;
+    }
+#endif
+
+  /* visits path from 'root' up to graph root */
+  if (stats_full (nenofex))
+    nenofex->stats.num_total_size_update_visits += root->level + 1;
+
   Node *cur = root;
   do
     {
       cur->size_subformula += delta;
       assert ((int) cur->size_subformula > 0);
     }
-  while ((cur = cur->parent));
+  while ((cur = node_at (nenofex, cur->parent)));
 }
 
 
@@ -1519,9 +1890,11 @@ atpg_mark_nodes_for_testing_again (Nenofex * nenofex, Node * root)
   if (root == nenofex->changed_subformula.lca)
     {
       if (!node_taken_from_fault_queue (root))
-        root->atpg_info->next_atpg_test_node_mark = inverted_cur_mark;
+        node_atpg_info (nenofex, root)->next_atpg_test_node_mark =
+          inverted_cur_mark;
       else
-        root->atpg_info->cur_atpg_test_node_mark = inverted_cur_mark;
+        node_atpg_info (nenofex, root)->cur_atpg_test_node_mark =
+          inverted_cur_mark;
 
       Node **ch, *child;
       for (ch = nenofex->changed_subformula.children; (child = *ch); ch++)
@@ -1534,15 +1907,17 @@ atpg_mark_nodes_for_testing_again (Nenofex * nenofex, Node * root)
   while ((cur = pop_stack (stack)))
     {
       if (!node_taken_from_fault_queue (cur))
-        cur->atpg_info->next_atpg_test_node_mark = inverted_cur_mark;
+        node_atpg_info (nenofex, cur)->next_atpg_test_node_mark =
+          inverted_cur_mark;
       else
-        cur->atpg_info->cur_atpg_test_node_mark = inverted_cur_mark;
+        node_atpg_info (nenofex, cur)->cur_atpg_test_node_mark =
+          inverted_cur_mark;
 
       if (!is_literal_node (cur))
         {
           Node *child;
-          for (child = cur->child_list.last; child;
-               child = child->level_link.prev)
+          for (child = node_at (nenofex, cur->child_list.last); child;
+               child = node_at (nenofex, child->level_link.prev))
             push_stack (nenofex->mm, stack, child);
         }
     }                           /* end: while stack not empty */
@@ -1553,7 +1928,7 @@ atpg_mark_nodes_for_testing_again (Nenofex * nenofex, Node * root)
 #endif /* end if RESTRICT_ATPG_FAULT_NODE_SET */
 
 
-static void unlink_variable_from_lca_list (Var * var);
+static void unlink_variable_from_lca_list (Nenofex * nenofex, Var * var);
 
 
 static void
@@ -1568,13 +1943,14 @@ reset_lca_object (Nenofex * nenofex, Var * var, LCAObject * lca_object,
 static void
 delete_lca_reset_and_mark_variables (Nenofex * nenofex, Node * var_lca)
 {
-  assert (var_lca->var_lca_list.first);
+  assert (node_cold (nenofex, var_lca)->var_lca_list.first);
 
   Var *var, *next;
-  for (var = var_lca->var_lca_list.first; var; var = next)
+  for (var = node_cold (nenofex, var_lca)->var_lca_list.first; var;
+       var = next)
     {
       next = var->same_lca_link.next;
-      unlink_variable_from_lca_list (var);
+      unlink_variable_from_lca_list (nenofex, var);
       reset_lca_object (nenofex, var, &var->exp_costs.lca_object, 1);
       /* NOTE: in this case, can we fully clean lca-child-list-occs? */
 
@@ -1594,10 +1970,10 @@ static void
 delete_node_remove_from_lca_child_lists (Nenofex * nenofex, Node * parent,
                                          Node * node)
 {
-  assert (parent->var_lca_list.first);
+  assert (node_cold (nenofex, parent)->var_lca_list.first);
   assert (node);
 
-  Stack *occs = node->lca_child_list_occs;
+  Stack *occs = node_cold (nenofex, node)->lca_child_list_occs;
   /*FAILED, but can happen   --assert(lca_child_list_occs); */
 
   /* NOTE: above assertion failed because during relinking 
@@ -1614,12 +1990,13 @@ delete_node_remove_from_lca_child_lists (Nenofex * nenofex, Node * parent,
   for (v_var = occs->elems; v_var != occs->top;)
 #else
   for (v_var = occs->elems;
-       (occs = node->lca_child_list_occs) && v_var != occs->top;)
+       (occs = node_cold (nenofex, node)->lca_child_list_occs)
+         && v_var != occs->top;)
 #endif
     {                           /* function 'reset_lca_object' will move 'top' towards 'elems' */
       Var *var = *v_var;
 
-      unlink_variable_from_lca_list (var);
+      unlink_variable_from_lca_list (nenofex, var);
       reset_lca_object (nenofex, var, &var->exp_costs.lca_object, 1);
 
       lca_update_mark (var);
@@ -1629,8 +2006,8 @@ delete_node_remove_from_lca_child_lists (Nenofex * nenofex, Node * parent,
     }                           /* end: for all vars where 'node' occurs in LCA-child-list */
 
 #if DELETE_EMPTY_STACKS_IN_NODES
-  assert (!node->lca_child_list_occs);
-  assert (!node->pos_in_lca_children);
+  assert (!node_cold (nenofex, node)->lca_child_list_occs);
+  assert (!node_cold (nenofex, node)->pos_in_lca_children);
 #endif
 }
 
@@ -1651,7 +2028,9 @@ static void assert_pos_in_changed_ch_list (Nenofex * nenofex);
 static void
 delete_node (Nenofex * nenofex, Node * node)
 {
-  Stack *occs = node->lca_child_list_occs;
+  discard_size_subformula_delta (nenofex, node);
+
+  Stack *occs = node_cold (nenofex, node)->lca_child_list_occs;
 
   if (occs)
     {
@@ -1661,12 +2040,13 @@ delete_node (Nenofex * nenofex, Node * node)
       for (v_var = occs->elems; v_var != occs->top;)
 #else
       for (v_var = occs->elems;
-           (occs = node->lca_child_list_occs) && v_var != occs->top;)
+           (occs = node_cold (nenofex, node)->lca_child_list_occs)
+             && v_var != occs->top;)
 #endif
         {                       /* function 'reset_lca_object' will move 'top' towards 'elems' */
           Var *var = *v_var;
 
-          unlink_variable_from_lca_list (var);
+          unlink_variable_from_lca_list (nenofex, var);
           reset_lca_object (nenofex, var, &var->exp_costs.lca_object, 1);
 
           lca_update_mark (var);
@@ -1677,20 +2057,24 @@ delete_node (Nenofex * nenofex, Node * node)
       /* end: same code */
 
 #if !DELETE_EMPTY_STACKS_IN_NODES
+      NodeCold *cold = node_cold (nenofex, node);
       delete_stack (occs);
-      assert (node->pos_in_lca_children);
-      delete_stack (node->pos_in_lca_children);
+      cold->lca_child_list_occs = 0;
+      assert (cold->pos_in_lca_children);
+      delete_stack (cold->pos_in_lca_children);
+      cold->pos_in_lca_children = 0;
 #else
-      assert (!node->lca_child_list_occs);
-      assert (!node->pos_in_lca_children);
+      assert (!node_cold (nenofex, node)->lca_child_list_occs);
+      assert (!node_cold (nenofex, node)->pos_in_lca_children);
 #endif
     }
   else
     {
-      assert (!node->pos_in_lca_children);
+      assert (!node_cold (nenofex, node)->pos_in_lca_children);
     }
 
-  mem_free (nenofex->mm, node, sizeof (Node));
+  free_node_cold (nenofex, node);
+  release_node (nenofex, node);
 }
 
 
@@ -1707,9 +2091,10 @@ merge_parent (Nenofex * nenofex, Node * parent)
 {
   assert (parent);
   assert (!is_literal_node (parent));
-  assert (parent->child_list.first == parent->child_list.last);
-  assert (!parent->child_list.first->level_link.prev);
-  assert (!parent->child_list.first->level_link.next);
+  assert (node_at (nenofex, parent->child_list.first) ==
+          node_at (nenofex, parent->child_list.last));
+  assert (!node_at (nenofex, parent->child_list.first)->level_link.prev);
+  assert (!node_at (nenofex, parent->child_list.first)->level_link.next);
 
 #if RESTRICT_ATPG_FAULT_NODE_SET
   unsigned int mark_nodes_for_testing_again = 0;
@@ -1723,8 +2108,9 @@ merge_parent (Nenofex * nenofex, Node * parent)
       assert (!parent->level_link.next);
       assert (!parent->level_link.prev);
 
-      if (parent->atpg_info)
-        mark_fault_node_as_deleted (parent->atpg_info->fault_node);
+      if (node_atpg_info (nenofex, parent))
+        mark_fault_node_as_deleted (node_atpg_info (nenofex,
+                                                    parent)->fault_node);
 
       if (parent == changed_subformula->lca &&
           !nenofex->atpg_rr_reset_changed_subformula)
@@ -1740,15 +2126,17 @@ merge_parent (Nenofex * nenofex, Node * parent)
 
           /* if 'changed' would become a single literal, then do nothing */
 
-          if (!is_literal_node (parent->child_list.first))
+          if (!is_literal_node (node_at (nenofex, parent->child_list.first)))
             {
               nenofex->atpg_rr_abort = 0;
 
-              changed_subformula->lca = parent->child_list.first;
+              changed_subformula->lca =
+                node_at (nenofex, parent->child_list.first);
 
               Node *child;
-              for (child = changed_subformula->lca->child_list.first;
-                   child; child = child->level_link.next)
+              for (child = node_at (nenofex,
+                                    changed_subformula->lca->child_list.first);
+                   child; child = node_at (nenofex, child->level_link.next))
                 add_changed_lca_child (nenofex, child);
 
 #ifndef NDEBUG
@@ -1771,38 +2159,43 @@ merge_parent (Nenofex * nenofex, Node * parent)
           reset_changed_lca_object (nenofex);
         }
 
-      nenofex->graph_root = parent->child_list.first;
+      nenofex->graph_root = node_at (nenofex, parent->child_list.first);
       assert (nenofex->graph_root->parent);
       nenofex->graph_root->parent = 0;
+      invalidate_lca_index (nenofex, nenofex->graph_root);
 
-      if (!is_literal_node (parent->child_list.first))
-        merge_parent_update_level (nenofex, parent->child_list.first, 1);
+      if (!is_literal_node (node_at (nenofex, parent->child_list.first)))
+        merge_parent_update_level (nenofex,
+                                   node_at (nenofex, parent->child_list.first),
+                                   1);
       else
         nenofex->graph_root->level = 0;
 
-      if (parent->var_lca_list.first)
+      if (node_cold (nenofex, parent)->var_lca_list.first)
         {
-          assert (parent->var_lca_list.last);
+          assert (node_cold (nenofex, parent)->var_lca_list.last);
           delete_lca_reset_and_mark_variables (nenofex, parent);
         }
 
-#if COMPUTE_NUM_DELETED_NODES
-      nenofex->stats.total_deleted_nodes++;
+      if (stats_basic (nenofex))
+        nenofex->stats.total_deleted_nodes++;
+      /* also read by adaptive propagation budget */
       if (nenofex->atpg_rr_called)
         nenofex->stats.deleted_nodes_by_global_flow_redundancy++;
-#endif
 
       delete_node (nenofex, parent);
       return;
     }
 
   /* grandparent has more than one child */
-  assert (parent->parent->child_list.first !=
-          parent->parent->child_list.last);
+  assert (node_at (nenofex,
+                   node_at (nenofex, parent->parent)->child_list.first) !=
+          node_at (nenofex,
+                   node_at (nenofex, parent->parent)->child_list.last));
 
   /* unlink remaining child (or its children) and add to grandparent's ch-list */
-  Node *sub_parent = parent->child_list.first;
-  unlink_node (nenofex, parent->child_list.first);
+  Node *sub_parent = node_at (nenofex, parent->child_list.first);
+  unlink_node (nenofex, node_at (nenofex, parent->child_list.first));
 
   assert (!parent->child_list.first);
   assert (!parent->child_list.last);
@@ -1840,10 +2233,11 @@ merge_parent (Nenofex * nenofex, Node * parent)
             {
               assert (nenofex->atpg_rr_abort);
               assert (nenofex->atpg_rr_called);
-              changed_subformula->lca = parent->parent; /* move LCA in order to mark vars later */
+              /* move LCA in order to mark vars later */
+              changed_subformula->lca = node_at (nenofex, parent->parent);
             }
         }
-      else if (parent->parent == changed_subformula->lca)
+      else if (node_at (nenofex, parent->parent) == changed_subformula->lca)
         {                       /* remove 'parent', add 'sub_parent' to changed-child list */
           assert (!nenofex->atpg_rr_reset_changed_subformula);
 
@@ -1862,21 +2256,28 @@ merge_parent (Nenofex * nenofex, Node * parent)
       else if (sub_parent == changed_subformula->lca)
         assert (0);             /* sub_parent is literal -> not allowed */
 
-      add_node_to_child_list (nenofex, parent->parent, sub_parent);     /* sets level */
+      add_node_to_child_list (nenofex, node_at (nenofex, parent->parent),
+                              sub_parent); /* sets level */
       assert (sub_parent->occ_link.next ||
-              sub_parent->occ_link.prev
+              node_at (nenofex, sub_parent->occ_link.prev)
               || sub_parent == sub_parent->lit->occ_list.first);
 
       lit_copied = 1;
 
-      if (parent->atpg_info)
+      if (node_atpg_info (nenofex, parent))
         {
           assert (nenofex->atpg_rr_called);
-          mark_fault_node_as_deleted (parent->atpg_info->fault_node);
+          mark_fault_node_as_deleted (node_atpg_info (nenofex,
+                                                      parent)->fault_node);
 
-          if (parent->parent->atpg_info && parent->parent->atpg_info->atpg_ch)
-            push_stack (nenofex->mm, parent->parent->atpg_info->atpg_ch,
-                        sub_parent->atpg_info->fault_node);
+          if (node_atpg_info (nenofex, node_at (nenofex, parent->parent))
+              && node_atpg_info (nenofex,
+                                 node_at (nenofex, parent->parent))->atpg_ch)
+            push_stack (nenofex->mm,
+                        node_atpg_info (nenofex,
+                                        node_at (nenofex,
+                                                 parent->parent))->atpg_ch,
+                        node_atpg_info (nenofex, sub_parent)->fault_node);
         }
     }
   else                          /* sub_parent is operator node */
@@ -1906,46 +2307,51 @@ merge_parent (Nenofex * nenofex, Node * parent)
             {
               assert (nenofex->atpg_rr_called);
               assert (nenofex->atpg_rr_abort);
-              changed_subformula->lca = parent->parent;
+              changed_subformula->lca = node_at (nenofex, parent->parent);
             }
         }
-      else if (parent->parent == changed_subformula->lca)
+      else if (node_at (nenofex, parent->parent) == changed_subformula->lca)
         {                       /* relink sub_parent's children */
           assert (!nenofex->atpg_rr_reset_changed_subformula);
           remove_changed_lca_child (nenofex, parent);
         }
 
-      if (parent->atpg_info)
+      if (node_atpg_info (nenofex, parent))
         {
           assert (nenofex->atpg_rr_called);
-          mark_fault_node_as_deleted (parent->atpg_info->fault_node);
+          mark_fault_node_as_deleted (node_atpg_info (nenofex,
+                                                      parent)->fault_node);
         }
 
-      if (sub_parent->atpg_info)
+      if (node_atpg_info (nenofex, sub_parent))
         {
           assert (nenofex->atpg_rr_called);
-          mark_fault_node_as_deleted (sub_parent->atpg_info->fault_node);
+          mark_fault_node_as_deleted (node_atpg_info
+                                      (nenofex, sub_parent)->fault_node);
         }
 
-      assert (sub_parent->type == parent->parent->type);
-      assert (sub_parent->child_list.first != sub_parent->child_list.last);
+      assert (sub_parent->type == node_at (nenofex, parent->parent)->type);
+      assert (node_at (nenofex, sub_parent->child_list.first) !=
+              node_at (nenofex, sub_parent->child_list.last));
 
       Node *child, *next;
-      for (child = sub_parent->child_list.first; child; child = next)
+      for (child = node_at (nenofex, sub_parent->child_list.first); child;
+           child = next)
         {
-          next = child->level_link.next;
+          next = node_at (nenofex, child->level_link.next);
 
           if (!is_literal_node (child))
             merge_parent_update_level (nenofex, child, 2);
 
           unlink_node (nenofex, child);
-          add_node_to_child_list (nenofex, parent->parent, child);      /* levels are set */
+          add_node_to_child_list (nenofex, node_at (nenofex, parent->parent),
+                                  child); /* levels are set */
 
           /* TODO: can handle literals early */
           if (is_literal_node (child))
             {
               assert (child->occ_link.next ||
-                      child->occ_link.prev
+                      node_at (nenofex, child->occ_link.prev)
                       || child == child->lit->occ_list.first);
               lit_copied = 1;
 
@@ -1964,19 +2370,25 @@ merge_parent (Nenofex * nenofex, Node * parent)
             }                   /* end: is literal */
 
 #ifndef NDEBUG
-          if (parent->parent->atpg_info)
+          if (node_atpg_info (nenofex, node_at (nenofex, parent->parent)))
             assert (nenofex->atpg_rr_called);
 #endif
 
           /* push children on watcher stack */
-          if (parent->parent->atpg_info && parent->parent->atpg_info->atpg_ch)
-            push_stack (nenofex->mm, parent->parent->atpg_info->atpg_ch,
-                        child->atpg_info->fault_node);
+          if (node_atpg_info (nenofex, node_at (nenofex, parent->parent))
+              && node_atpg_info (nenofex,
+                                 node_at (nenofex, parent->parent))->atpg_ch)
+            push_stack (nenofex->mm,
+                        node_atpg_info (nenofex,
+                                        node_at (nenofex,
+                                                 parent->parent))->atpg_ch,
+                        node_atpg_info (nenofex, child)->fault_node);
 
           /* NOTE: simplify check by setting lca to parent->parent first in all cases ? */
           if (!nenofex->atpg_rr_reset_changed_subformula &&
               (parent == changed_subformula->lca
-               || parent->parent == changed_subformula->lca))
+               || node_at (nenofex, parent->parent) ==
+                 changed_subformula->lca))
             add_changed_lca_child (nenofex, child);
         }                       /* end: for all children */
 
@@ -1984,7 +2396,7 @@ merge_parent (Nenofex * nenofex, Node * parent)
           (sub_parent == changed_subformula->lca
            || parent == changed_subformula->lca))
         {
-          changed_subformula->lca = parent->parent;
+          changed_subformula->lca = node_at (nenofex, parent->parent);
 #ifndef NDEBUG
 #if ASSERT_POS_IN_CHANGED_CH_LIST
           assert_pos_in_changed_ch_list (nenofex);
@@ -1996,58 +2408,60 @@ merge_parent (Nenofex * nenofex, Node * parent)
                   changed_subformula->num_children);
         }
 
-      if (sub_parent->var_lca_list.first)
+      if (node_cold (nenofex, sub_parent)->var_lca_list.first)
         {
-          assert (sub_parent->var_lca_list.last);
+          assert (node_cold (nenofex, sub_parent)->var_lca_list.last);
           delete_lca_reset_and_mark_variables (nenofex, sub_parent);
         }
 
-#if COMPUTE_NUM_DELETED_NODES
-      nenofex->stats.total_deleted_nodes++;
+      if (stats_basic (nenofex))
+        nenofex->stats.total_deleted_nodes++;
+      /* also read by adaptive propagation budget */
       if (nenofex->atpg_rr_called)
         nenofex->stats.deleted_nodes_by_global_flow_redundancy++;
-#endif
 
+      move_size_subformula_delta (nenofex, sub_parent,
+                                  node_at (nenofex, parent->parent));
       delete_node (nenofex, sub_parent);
     }                           /* end: sub_parent is operator node */
 
   /* unlink parent */
-  Node *parent_parent = parent->parent;
+  Node *parent_parent = node_at (nenofex, parent->parent);
   unlink_node (nenofex, parent);
 
   /* need to update watchers if parent->parent will not be reset afterwards */
-  if (parent_parent->atpg_info)
+  if (node_atpg_info (nenofex, parent_parent))
     {
       assert (nenofex->atpg_rr_called);
-      collect_assigned_node (nenofex->atpg_rr, parent_parent);
+      collect_assigned_node (nenofex, parent_parent);
 
-      if (parent_parent->atpg_info->atpg_ch)
-        parent_parent->atpg_info->clean_up_watcher_list = 1;
+      if (node_atpg_info (nenofex, parent_parent)->atpg_ch)
+        node_atpg_info (nenofex, parent_parent)->clean_up_watcher_list = 1;
     }
 
-  if (parent->var_lca_list.first)
+  if (node_cold (nenofex, parent)->var_lca_list.first)
     {
-      assert (parent->var_lca_list.last);
+      assert (node_cold (nenofex, parent)->var_lca_list.last);
       delete_lca_reset_and_mark_variables (nenofex, parent);
     }
 
 
-  if (parent_parent->var_lca_list.first)
+  if (node_cold (nenofex, parent_parent)->var_lca_list.first)
     {
-      assert (parent_parent->var_lca_list.last);
+      assert (node_cold (nenofex, parent_parent)->var_lca_list.last);
       delete_node_remove_from_lca_child_lists (nenofex, parent_parent,
                                                parent);
     }
 
-#if COMPUTE_NUM_DELETED_NODES
-  nenofex->stats.total_deleted_nodes++;
+  if (stats_basic (nenofex))
+    nenofex->stats.total_deleted_nodes++;
   if (nenofex->atpg_rr_called)
     nenofex->stats.deleted_nodes_by_global_flow_redundancy++;
-#endif
 
   if (parent == nenofex->existential_split_or)
     nenofex->existential_split_or = 0;
 
+  move_size_subformula_delta (nenofex, parent, parent_parent);
   delete_node (nenofex, parent);
 
 
@@ -2070,6 +2484,20 @@ merge_parent (Nenofex * nenofex, Node * parent)
 }
 
 
+/*
+- nodes are counted while freed: 'size_subformula' of the deleted root may
+  still include deltas pending in its subformula (see 'DEFERRED SIZE UPDATES')
+*/
+static void
+count_deleted_nodes (Nenofex * nenofex, const unsigned int num_deleted)
+{
+  if (stats_basic (nenofex))
+    nenofex->stats.total_deleted_nodes += num_deleted;
+  if (nenofex->atpg_rr_called)
+    nenofex->stats.deleted_nodes_by_global_flow_redundancy += num_deleted;
+}
+
+
 /* 
 - unlinks the subformula rooted at 'root' from its parent's child-list 
 - recursively frees all nodes; merge nodes if parent has 1 child left after del.
@@ -2079,14 +2507,7 @@ merge_parent (Nenofex * nenofex, Node * parent)
 void
 remove_and_free_subformula (Nenofex * nenofex, Node * root)
 {
-#if COMPUTE_NUM_DELETED_NODES
-  nenofex->stats.total_deleted_nodes += root->size_subformula;
-  if (nenofex->atpg_rr_called)
-    nenofex->stats.deleted_nodes_by_global_flow_redundancy +=
-      root->size_subformula;
-#endif
-
-  Node *parent = root->parent;
+  Node *parent = node_at (nenofex, root->parent);
   LCAObject *changed_subformula = &(nenofex->changed_subformula);
 
   assert (!nenofex->changed_subformula.lca ||
@@ -2126,11 +2547,12 @@ remove_and_free_subformula (Nenofex * nenofex, Node * root)
   assert (parent->child_list.first);
   assert (parent->child_list.last);
 
-  if (parent->child_list.first == parent->child_list.last)
+  if (node_at (nenofex, parent->child_list.first) ==
+      node_at (nenofex, parent->child_list.last))
     {
       update_size_delta++;
 
-      if (!is_literal_node (parent->child_list.first))
+      if (!is_literal_node (node_at (nenofex, parent->child_list.first)))
         update_size_delta++;
 
       update_size_subformula (nenofex, parent, -update_size_delta);
@@ -2140,7 +2562,7 @@ remove_and_free_subformula (Nenofex * nenofex, Node * root)
     {
       update_size_subformula (nenofex, parent, -update_size_delta);
 
-      if (root->changed_ch_list_pos)
+      if (node_cold (nenofex, root)->changed_ch_list_pos)
         {                       /* must remove 'root' from changed-child list */
           assert (parent == changed_subformula->lca);
           remove_changed_lca_child (nenofex, root);
@@ -2153,7 +2575,7 @@ remove_and_free_subformula (Nenofex * nenofex, Node * root)
 
               /* 'parent' remains in graph, but must be excluded from testing */
               if (nenofex->atpg_rr_called)
-                parent->atpg_info->fault_node->skip = 1;
+                node_atpg_info (nenofex, parent)->fault_node->skip = 1;
 
               Node *remaining_child = *changed_subformula->children;
 
@@ -2163,8 +2585,9 @@ remove_and_free_subformula (Nenofex * nenofex, Node * root)
                 {
                   changed_subformula->lca = remaining_child;
                   Node *ch;
-                  for (ch = remaining_child->child_list.first; ch;
-                       ch = ch->level_link.next)
+                  for (ch = node_at (nenofex,
+                                     remaining_child->child_list.first); ch;
+                       ch = node_at (nenofex, ch->level_link.next))
                     add_changed_lca_child (nenofex, ch);
 
 #ifndef NDEBUG
@@ -2187,21 +2610,21 @@ remove_and_free_subformula (Nenofex * nenofex, Node * root)
             }                   /* end: only one child remaining */
         }                       /* end: 'root' is child of 'changed-subformula' */
 
-      if (parent->var_lca_list.first)
+      if (node_cold (nenofex, parent)->var_lca_list.first)
         {                       /* 'root' possibly occurs in lca-ch list of a variable 
                                    -> must initialize such variables from scratch */
-          assert (parent->var_lca_list.last);
+          assert (node_cold (nenofex, parent)->var_lca_list.last);
           delete_node_remove_from_lca_child_lists (nenofex, parent, root);
         }                       /* end: parent is lca of a variable */
 
       /* need to update watchers if parent will not be reset afterwards */
-      if (parent->atpg_info)
+      if (node_atpg_info (nenofex, parent))
         {
           assert (nenofex->atpg_rr_called);
-          collect_assigned_node (nenofex->atpg_rr, parent);
+          collect_assigned_node (nenofex, parent);
 
-          if (parent->atpg_info->atpg_ch)
-            parent->atpg_info->clean_up_watcher_list = 1;
+          if (node_atpg_info (nenofex, parent)->atpg_ch)
+            node_atpg_info (nenofex, parent)->clean_up_watcher_list = 1;
         }
     }                           /* end: no merging necessary */
 
@@ -2226,15 +2649,17 @@ remove_and_free_subformula (Nenofex * nenofex, Node * root)
         assert (0);
 #endif
 
-      if (root->atpg_info)
-        mark_fault_node_as_deleted (root->atpg_info->fault_node);
+      if (node_atpg_info (nenofex, root))
+        mark_fault_node_as_deleted (node_atpg_info (nenofex,
+                                                    root)->fault_node);
 
-      if (root->var_lca_list.first)
+      if (node_cold (nenofex, root)->var_lca_list.first)
         {                       /* CONJECTURE: should never occur if unates eliminated until saturation */
           Var *var = root->lit->var;
 
-          assert (root->var_lca_list.first == root->var_lca_list.last);
-          assert (root->var_lca_list.first == var);
+          assert (node_cold (nenofex, root)->var_lca_list.first ==
+                  node_cold (nenofex, root)->var_lca_list.last);
+          assert (node_cold (nenofex, root)->var_lca_list.first == var);
           /* var has exactly one occ */
           assert (!var->lits[0].occ_list.first ||
                   var->lits[0].occ_list.first == var->lits[0].occ_list.last);
@@ -2245,12 +2670,13 @@ remove_and_free_subformula (Nenofex * nenofex, Node * root)
           assert (!var->lits[1].occ_list.first
                   || !var->lits[0].occ_list.first);
 
-          unlink_variable_from_lca_list (var);
+          unlink_variable_from_lca_list (nenofex, var);
           reset_lca_object (nenofex, var,
                             &root->lit->var->exp_costs.lca_object, 1);
         }
 
       delete_node (nenofex, root);
+      count_deleted_nodes (nenofex, 1);
       return;
     }                           /* end: root is literal */
 
@@ -2259,9 +2685,11 @@ FREE_GRAPH:;
   Stack *stack = create_stack (nenofex->mm, DEFAULT_STACK_SIZE);
   push_stack (nenofex->mm, stack, root);
 
+  unsigned int num_deleted = 0;
   Node *cur;
   while ((cur = pop_stack (stack)))
     {
+      num_deleted++;
       if (is_literal_node (cur))
         {
           unlink_node_from_occ_list (nenofex, cur);
@@ -2276,16 +2704,18 @@ FREE_GRAPH:;
               collect_variable_for_update (nenofex, var);
             }
 
-          if (cur->atpg_info)
-            mark_fault_node_as_deleted (cur->atpg_info->fault_node);
+          if (node_atpg_info (nenofex, cur))
+            mark_fault_node_as_deleted (node_atpg_info (nenofex,
+                                                        cur)->fault_node);
 
-          if (cur->var_lca_list.first)
+          if (node_cold (nenofex, cur)->var_lca_list.first)
             {                   /* CONJECTURE: should never occur if unates eliminated until saturation */
-              assert (cur->var_lca_list.first == cur->var_lca_list.last);
-              assert (cur->var_lca_list.first == var);
+              assert (node_cold (nenofex, cur)->var_lca_list.first ==
+                      node_cold (nenofex, cur)->var_lca_list.last);
+              assert (node_cold (nenofex, cur)->var_lca_list.first == var);
               assert (var->exp_costs.lca_object.lca);
 
-              unlink_variable_from_lca_list (var);
+              unlink_variable_from_lca_list (nenofex, var);
               reset_lca_object (nenofex, var, &var->exp_costs.lca_object, 1);
             }
 
@@ -2294,22 +2724,25 @@ FREE_GRAPH:;
       else                      /* 'cur' is operator node */
         {
           Node *ch;
-          for (ch = cur->child_list.last; ch; ch = ch->level_link.prev)
+          for (ch = node_at (nenofex, cur->child_list.last); ch;
+               ch = node_at (nenofex, ch->level_link.prev))
             {
               push_stack (nenofex->mm, stack, ch);
             }
 
-          if (cur->atpg_info)
-            mark_fault_node_as_deleted (cur->atpg_info->fault_node);
+          if (node_atpg_info (nenofex, cur))
+            mark_fault_node_as_deleted (node_atpg_info (nenofex,
+                                                        cur)->fault_node);
 
-          if (cur->var_lca_list.first)
+          if (node_cold (nenofex, cur)->var_lca_list.first)
             {
-              assert (cur->var_lca_list.last);
+              assert (node_cold (nenofex, cur)->var_lca_list.last);
               Var *var, *next;
-              for (var = cur->var_lca_list.first; var; var = next)
+              for (var = node_cold (nenofex, cur)->var_lca_list.first; var;
+                   var = next)
                 {
                   next = var->same_lca_link.next;
-                  unlink_variable_from_lca_list (var);
+                  unlink_variable_from_lca_list (nenofex, var);
                   reset_lca_object (nenofex, var, &var->exp_costs.lca_object,
                                     1);
                   /* NOTE: in this case, need NOT clean lca-child-list-occs? */
@@ -2320,6 +2753,7 @@ FREE_GRAPH:;
         }                       /* end: 'cur' is operator node */
     }                           /* end: while stack not empty */
   delete_stack (nenofex->mm, stack);
+  count_deleted_nodes (nenofex, num_deleted);
 
   if (!parent && !nenofex->distributivity_deleting_redundancies)
     {
@@ -2471,12 +2905,13 @@ assert_all_lca_occ_pos_integrity (Nenofex * nenofex)
               unsigned long int vpos_in_occs =
                 (unsigned long int) *(var->pos_in_lca_child_list_occs->elems +
                                       child_pos);
+              NodeCold *cold = node_cold (nenofex, child);
               assert (var ==
-                      (Var *) * (child->lca_child_list_occs->elems +
+                      (Var *) * (cold->lca_child_list_occs->elems +
                                  vpos_in_occs));
               assert (child_pos ==
-                      (unsigned long int) *(child->pos_in_lca_children->
-                                            elems + vpos_in_occs));
+                      (unsigned long int) *(cold->pos_in_lca_children->elems
+                                            + vpos_in_occs));
             }
         }
     }
@@ -2488,8 +2923,10 @@ static void
 remove_lca_child_list_occ (Nenofex * nenofex, Node * child,
                            unsigned long int child_pos, Var * var)
 {
-  Stack *child_lca_child_list_occs = child->lca_child_list_occs;
-  Stack *child_pos_in_lca_children = child->pos_in_lca_children;
+  Stack *child_lca_child_list_occs =
+    node_cold (nenofex, child)->lca_child_list_occs;
+  Stack *child_pos_in_lca_children =
+    node_cold (nenofex, child)->pos_in_lca_children;
 #ifndef NDEBUG
   Node **var_lca_children = var->exp_costs.lca_object.children;
 #endif
@@ -2552,9 +2989,9 @@ remove_lca_child_list_occ (Nenofex * nenofex, Node * child,
   else if (child_lca_child_list_occs->top == child_lca_child_list_occs->elems)
     {                           /* both stacks are empty -> delete */
       delete_stack (nenofex->mm, child_lca_child_list_occs);
-      child->lca_child_list_occs = 0;
+      alloc_node_cold (nenofex, child)->lca_child_list_occs = 0;
       delete_stack (nenofex->mm, child_pos_in_lca_children);
-      child->pos_in_lca_children = 0;
+      alloc_node_cold (nenofex, child)->pos_in_lca_children = 0;
     }
 
 #endif
@@ -2593,32 +3030,220 @@ reset_lca_object (Nenofex * nenofex, Var * var, LCAObject * lca_object,
 }
 
 
-/* 
-- find root of smallest subformula which contains both node 'a' and node 'b'
-- collects root's children which contain a,b (since 'root' is n-ary)
+/* START: LCA INDEX */
+
+/*
+- jump pointers as in skew-binary random access lists: jumps of nodes on the
+  same level end on the same level and every ancestor of a node is reached
+  in a logarithmic number of steps
+- jump of a node only depends on its ancestors; jump pointers are computed
+  lazily for all nodes without jump on the path to the root, hence nodes
+  with jump pointers are closed under ancestors
 */
-static void
-find_lca_and_children (Nenofex * nenofex, Node * a, Node * b,
-                       LCAObject * lca_object)
+static Node *
+lca_jump (Nenofex * nenofex, Node * node)
 {
-  assert (a || b);
-  assert (!lca_object->lca || lca_object->lca == a || lca_object->lca == b);
-
-#if COMPUTE_LCA_PARENT_VISITS
-  nenofex->stats.num_total_lca_algo_calls++;
+#if !USE_LCA_INDEX
+  return node_at (nenofex, node->parent) ? node_at (nenofex, node->parent)
+    : node;
 #endif
 
-  if (!a)
-    {
-      lca_object->lca = b;
-      return;
-    }
+  if (node_cold (nenofex, node)->lca_jump)
+    return node_cold (nenofex, node)->lca_jump;
 
-  if (!b || a == b)
-    {
-      lca_object->lca = a;
-      return;
-    }
+  Stack *stack = nenofex->lca_index_stack;
+  assert (!count_stack (stack));
+
+  Node *cur;
+  for (cur = node; cur && !node_cold (nenofex, cur)->lca_jump;
+       cur = node_at (nenofex, cur->parent))
+    push_stack (nenofex->mm, stack, cur);
+
+  unsigned int updates = count_stack (stack);
+
+  while ((cur = pop_stack (stack)))
+    {                           /* top-down: ancestors already up to date */
+      Node *parent = node_at (nenofex, cur->parent);
+      NodeCold *cold = alloc_node_cold (nenofex, cur);
+
+      if (!parent)
+        cold->lca_jump = cur;
+      else
+        {
+          assert (node_cold (nenofex, parent)->lca_jump);
+          assert (cur->level == parent->level + 1);
+
+          Node *jump = node_cold (nenofex, parent)->lca_jump;
+          Node *jump_jump = node_cold (nenofex, jump)->lca_jump;
+
+          if (parent->level - jump->level == jump->level - jump_jump->level)
+            cold->lca_jump = jump_jump;
+          else
+            cold->lca_jump = parent;
+        }
+    }
+
+  if (stats_full (nenofex))
+    nenofex->stats.num_total_lca_jump_updates += updates;
+
+  return node_cold (nenofex, node)->lca_jump;
+}
+
+
+/*
+- must be called on every change of the parent pointer of 'root' or of
+  levels in the subformula rooted at 'root'
+- only jumps of nodes under 'root' depend on the change; descending stops at
+  nodes without jump since none of their descendants has one
+*/
+static void
+invalidate_lca_index (Nenofex * nenofex, Node * root)
+{
+  if (!node_cold (nenofex, root)->lca_jump)
+    return;
+
+  Stack *stack = nenofex->lca_index_stack;
+  assert (!count_stack (stack));
+  push_stack (nenofex->mm, stack, root);
+
+  unsigned int invalidations = 0;
+
+  Node *cur;
+  while ((cur = pop_stack (stack)))
+    {
+      assert (node_cold (nenofex, cur)->lca_jump);
+      node_cold (nenofex, cur)->lca_jump = 0;
+      invalidations++;
+
+      if (!is_literal_node (cur))
+        {
+          Node *child;
+          for (child = node_at (nenofex, cur->child_list.first); child;
+               child = node_at (nenofex, child->level_link.next))
+            if (node_cold (nenofex, child)->lca_jump)
+              push_stack (nenofex->mm, stack, child);
+        }
+    }
+
+  if (stats_full (nenofex))
+    nenofex->stats.num_total_lca_jump_invalidations += invalidations;
+}
+
+
+/*
+- returns ancestor of 'node' on level 'level'
+*/
+static Node *
+lca_level_ancestor (Nenofex * nenofex, Node * node, unsigned const int level)
+{
+  assert (node->level >= level);
+
+  unsigned int visits = 0;
+
+  while (node->level > level)
+    {
+      visits++;
+      Node *jump = lca_jump (nenofex, node);
+      node = jump->level >= level ? jump : node_at (nenofex, node->parent);
+    }
+
+  if (stats_full (nenofex))
+    nenofex->stats.num_total_lca_parent_visits += visits;
+
+  return node;
+}
+
+
+/*
+- returns LCA of 'low_node' and 'high_node' where 'low_node' is not above
+  'high_node'
+- '*low_child' ('*high_child') is set to child of LCA on path to 'low_node' 
+  ('high_node') or to null if node is LCA itself
+*/
+static Node *
+lca_index_query (Nenofex * nenofex, Node * low_node, Node * high_node,
+                 Node ** low_child, Node ** high_child)
+{
+  assert (low_node->level >= high_node->level);
+
+  unsigned const int low_level = low_node->level;
+  unsigned const int high_level = high_node->level;
+  unsigned int visits = 0;
+
+  *low_child = *high_child = 0;
+
+  if (low_node->level > high_node->level)
+    {                           /* level-balancing */
+      *low_child = lca_level_ancestor (nenofex, low_node, high_node->level + 1);
+      low_node = node_at (nenofex, (*low_child)->parent);
+    }
+
+  if (low_node != high_node)
+    {                           /* move up in parallel until parents are equal */
+      while (node_at (nenofex, low_node->parent) !=
+             node_at (nenofex, high_node->parent))
+        {
+          visits += 2;
+          Node *low_jump = lca_jump (nenofex, low_node);
+          Node *high_jump = lca_jump (nenofex, high_node);
+
+          if (low_jump != high_jump)
+            {
+              low_node = low_jump;
+              high_node = high_jump;
+            }
+          else
+            {
+              low_node = node_at (nenofex, low_node->parent);
+              high_node = node_at (nenofex, high_node->parent);
+            }
+          assert (low_node->level == high_node->level);
+        }
+
+      assert (low_node->parent);
+      *low_child = low_node;
+      *high_child = high_node;
+      low_node = node_at (nenofex, low_node->parent);
+    }
+
+  if (stats_full (nenofex))
+    {
+      nenofex->stats.num_total_lca_parent_visits += visits;
+      nenofex->stats.num_total_lca_plain_parent_visits +=
+        (low_level - high_level) + 2 * (high_level - low_node->level);
+    }
+
+  return low_node;
+}
+
+/* END: LCA INDEX */
+
+
+/* 
+- find root of smallest subformula which contains both node 'a' and node 'b'
+- collects root's children which contain a,b (since 'root' is n-ary)
+*/
+static void
+find_lca_and_children (Nenofex * nenofex, Node * a, Node * b,
+                       LCAObject * lca_object)
+{
+  assert (a || b);
+  assert (!lca_object->lca || lca_object->lca == a || lca_object->lca == b);
+
+  if (stats_full (nenofex))
+    nenofex->stats.num_total_lca_algo_calls++;
+
+  if (!a)
+    {
+      lca_object->lca = b;
+      return;
+    }
+
+  if (!b || a == b)
+    {
+      lca_object->lca = a;
+      return;
+    }
 
 #ifndef NDEBUG
   if (a != b)
@@ -2628,9 +3253,7 @@ find_lca_and_children (Nenofex * nenofex, Node * a, Node * b,
     }
 #endif
 
-  Node *high_node, *low_node, *high_node_prev, *low_node_prev;
-
-  low_node_prev = 0;
+  Node *high_node, *low_node, *high_node_prev, *low_node_prev, *lca;
 
   if (a->level >= b->level)
     {
@@ -2643,18 +3266,10 @@ find_lca_and_children (Nenofex * nenofex, Node * a, Node * b,
       low_node = b;
     }
 
-  unsigned const int high_node_level = high_node->level;
-
-  while (high_node_level < low_node->level)
-    {
-#if COMPUTE_LCA_PARENT_VISITS
-      nenofex->stats.num_total_lca_parent_visits++;
-#endif
-      low_node_prev = low_node;
-      low_node = low_node->parent;
-    }
+  lca = lca_index_query (nenofex, low_node, high_node, &low_node_prev,
+                         &high_node_prev);
 
-  if (high_node == low_node)
+  if (lca == high_node)
     {
       if (!lca_child_marked (low_node_prev)
           && !is_literal_node (low_node_prev))
@@ -2666,24 +3281,7 @@ find_lca_and_children (Nenofex * nenofex, Node * a, Node * b,
         add_lca_child (nenofex, lca_object, low_node_prev);
     }
   else
-    {                           /* high != low -> move up successively in parallel */
-      do
-        {
-#if COMPUTE_LCA_PARENT_VISITS
-          nenofex->stats.num_total_lca_parent_visits += 2;
-#endif
-          low_node_prev = low_node;
-          low_node = low_node->parent;
-
-          high_node_prev = high_node;
-          high_node = high_node->parent;
-
-          assert (high_node);
-          assert (low_node);
-        }
-      while (high_node != low_node);
-      assert (high_node);
-
+    {                           /* high != lca -> both children are new */
       /* clear and add both children */
       clear_lca_children (lca_object);
 
@@ -2703,7 +3301,7 @@ find_lca_and_children (Nenofex * nenofex, Node * a, Node * b,
 
     }
 
-  lca_object->lca = high_node;
+  lca_object->lca = lca;
 }
 
 
@@ -2712,11 +3310,11 @@ find_lca_and_children (Nenofex * nenofex, Node * a, Node * b,
 - used in assertion checking only 
 */
 static Node *
-node_has_child (Node * node, Node * child)
+node_has_child (Nenofex * nenofex, Node * node, Node * child)
 {
   Node *cur;
-  for (cur = node->child_list.first;
-       cur && cur != child; cur = cur->level_link.next)
+  for (cur = node_at (nenofex, node->child_list.first);
+       cur && cur != child; cur = node_at (nenofex, cur->level_link.next))
     ;
   return cur;
 }
@@ -2747,14 +3345,15 @@ assert_lca_object_integrity (Nenofex * nenofex,
       if (!is_literal_node ((*cur_p)))
         assert (lca_child_marked (*cur_p));
 
-      assert (node_has_child (lca_object->lca, *cur_p));
+      assert (node_has_child (nenofex, lca_object->lca, *cur_p));
       assert (find_node_by_id (nenofex, *cur_p, var->id)
               || find_node_by_id (nenofex, *cur_p, -var->id));
     }
 
   Node *cur;
   /* all occs of a vars must be contained in subformula of some child of lca */
-  for (cur = var->lits[0].occ_list.first; cur; cur = (cur)->occ_link.next)
+  for (cur = var->lits[0].occ_list.first; cur;
+       cur = node_at (nenofex, (cur)->occ_link.next))
     {
       Node **child, *found;
       found = 0;
@@ -2764,7 +3363,8 @@ assert_lca_object_integrity (Nenofex * nenofex,
         }
       assert (found);
     }
-  for (cur = var->lits[1].occ_list.first; cur; cur = (cur)->occ_link.next)
+  for (cur = var->lits[1].occ_list.first; cur;
+       cur = node_at (nenofex, (cur)->occ_link.next))
     {
       Node **child, *found;
       found = 0;
@@ -2810,24 +3410,25 @@ add_variable_to_lca_list (Nenofex * nenofex, Var * var)
   assert (!var->same_lca_link.prev);
   assert (!var->same_lca_link.next);
 
-  if (!lca->var_lca_list.first)
+  VarLCAList *list = &(alloc_node_cold (nenofex, lca)->var_lca_list);
+
+  if (!list->first)
     {                           /* add to empty list */
-      assert (!lca->var_lca_list.last);
+      assert (!list->last);
 
-      lca->var_lca_list.first = lca->var_lca_list.last = var;
+      list->first = list->last = var;
     }
   else                          /* append */
     {
-      assert (lca->var_lca_list.last);
-      assert (lca->var_lca_list.first == lca->var_lca_list.last ||
-              lca->var_lca_list.last->same_lca_link.prev);
-      assert (lca->var_lca_list.first != lca->var_lca_list.last ||
-              !lca->var_lca_list.last->same_lca_link.prev);
-      assert (!lca->var_lca_list.last->same_lca_link.next);
+      assert (list->last);
+      assert (list->first == list->last || list->last->same_lca_link.prev);
+      assert (list->first != list->last
+              || !list->last->same_lca_link.prev);
+      assert (!list->last->same_lca_link.next);
 
-      lca->var_lca_list.last->same_lca_link.next = var;
-      var->same_lca_link.prev = lca->var_lca_list.last;
-      lca->var_lca_list.last = var;
+      list->last->same_lca_link.next = var;
+      var->same_lca_link.prev = list->last;
+      list->last = var;
     }
 }
 
@@ -2837,15 +3438,18 @@ add_variable_to_lca_list (Nenofex * nenofex, Var * var)
 - unlink a variable from LCA-list of its LCA
 */
 static void
-unlink_variable_from_lca_list (Var * var)
+unlink_variable_from_lca_list (Nenofex * nenofex, Var * var)
 {
   Node *lca = var->exp_costs.lca_object.lca;
 
   assert (lca);
-  assert (var != lca->var_lca_list.first || !var->same_lca_link.prev);
-  assert (var == lca->var_lca_list.first || var->same_lca_link.prev);
-  assert (var != lca->var_lca_list.last || !var->same_lca_link.next);
-  assert (var == lca->var_lca_list.last || var->same_lca_link.next);
+  assert (lca->cold);
+  NodeCold *cold = node_cold (nenofex, lca);
+
+  assert (var != cold->var_lca_list.first || !var->same_lca_link.prev);
+  assert (var == cold->var_lca_list.first || var->same_lca_link.prev);
+  assert (var != cold->var_lca_list.last || !var->same_lca_link.next);
+  assert (var == cold->var_lca_list.last || var->same_lca_link.next);
 
   if (var->same_lca_link.prev)
     {
@@ -2859,19 +3463,19 @@ unlink_variable_from_lca_list (Var * var)
         }
       else
         {                       /* var == last */
-          assert (var == lca->var_lca_list.last);
+          assert (var == cold->var_lca_list.last);
 
-          lca->var_lca_list.last = var->same_lca_link.prev;
+          cold->var_lca_list.last = var->same_lca_link.prev;
           var->same_lca_link.prev = 0;
 
-          assert (!lca->var_lca_list.last->same_lca_link.next);
+          assert (!cold->var_lca_list.last->same_lca_link.next);
         }
     }
   else
     {                           /* var == first */
-      assert (var == lca->var_lca_list.first);
+      assert (var == cold->var_lca_list.first);
 
-      lca->var_lca_list.first = var->same_lca_link.next;
+      cold->var_lca_list.first = var->same_lca_link.next;
 
       if (var->same_lca_link.next)
         {
@@ -2879,16 +3483,16 @@ unlink_variable_from_lca_list (Var * var)
             var->same_lca_link.prev;
           var->same_lca_link.next = 0;
 
-          assert (!lca->var_lca_list.first->same_lca_link.prev);
+          assert (!cold->var_lca_list.first->same_lca_link.prev);
         }
       else
         {                       /* var == first == last */
-          assert (var == lca->var_lca_list.last);
+          assert (var == cold->var_lca_list.last);
 
-          lca->var_lca_list.last = lca->var_lca_list.first;
+          cold->var_lca_list.last = cold->var_lca_list.first;
 
-          assert (!lca->var_lca_list.first);
-          assert (!lca->var_lca_list.last);
+          assert (!cold->var_lca_list.first);
+          assert (!cold->var_lca_list.last);
         }
     }
 
@@ -2915,16 +3519,19 @@ add_variable_to_lca_child_list_occs_of_nodes (Nenofex * nenofex,
   Node **ch, *child;
   for (ch = lca_object->children; (child = *ch); ch++, child_pos++)
     {
-      Stack *child_lca_child_list_occs = child->lca_child_list_occs;
-      Stack *child_pos_in_lca_children = child->pos_in_lca_children;
+      Stack *child_lca_child_list_occs =
+        node_cold (nenofex, child)->lca_child_list_occs;
+      Stack *child_pos_in_lca_children =
+        node_cold (nenofex, child)->pos_in_lca_children;
 
       if (!child_lca_child_list_occs)
         {                       /* TODO: adapt initial stack size? */
           assert (!child_pos_in_lca_children);
-          child->lca_child_list_occs =
-            child_lca_child_list_occs = create_stack (nenofex->mm, DEFAULT_STACK_SIZE);
-          child->pos_in_lca_children =
-            child_pos_in_lca_children = create_stack (nenofex->mm, DEFAULT_STACK_SIZE);
+          NodeCold *cold = alloc_node_cold (nenofex, child);
+          cold->lca_child_list_occs = child_lca_child_list_occs =
+            create_stack (nenofex->mm, DEFAULT_STACK_SIZE);
+          cold->pos_in_lca_children = child_pos_in_lca_children =
+            create_stack (nenofex->mm, DEFAULT_STACK_SIZE);
         }
       assert (child_pos_in_lca_children);
 
@@ -2938,8 +3545,8 @@ add_variable_to_lca_child_list_occs_of_nodes (Nenofex * nenofex,
       push_stack (nenofex->mm, child_lca_child_list_occs, var);
       push_stack (nenofex->mm, child_pos_in_lca_children, (void *) child_pos);
 
-      assert (count_stack (child->lca_child_list_occs) ==
-              count_stack (child->pos_in_lca_children));
+      assert (count_stack (child_lca_child_list_occs) ==
+              count_stack (child_pos_in_lca_children));
     }                           /* end: for all LCA-children */
 
   assert (lca_object->num_children ==
@@ -2981,12 +3588,14 @@ find_variable_lca_and_children (Nenofex * nenofex, Var * var,
 
   Node *cur;
 
-  for (cur = var->lits[0].occ_list.first; cur; cur = cur->occ_link.next)
+  for (cur = var->lits[0].occ_list.first; cur;
+       cur = node_at (nenofex, cur->occ_link.next))
     {                           /* neg. occ's */
       find_lca_and_children (nenofex, lca_object->lca, cur, lca_object);
     }
 
-  for (cur = var->lits[1].occ_list.first; cur; cur = cur->occ_link.next)
+  for (cur = var->lits[1].occ_list.first; cur;
+       cur = node_at (nenofex, cur->occ_link.next))
     {                           /* pos. occ's */
       find_lca_and_children (nenofex, lca_object->lca, cur, lca_object);
     }
@@ -3101,8 +3710,8 @@ collect_innermost_depending_existential_variables (Nenofex *nenofex,
         }
       else                      /* op-node */
         {
-          for (child = cur->child_list.last; child;
-               child = child->level_link.prev)
+          for (child = node_at (nenofex, cur->child_list.last); child;
+               child = node_at (nenofex, child->level_link.prev))
             {
               if (!dependency_visit_marked (child))
                 push_stack (nenofex->mm, stack, child);
@@ -3166,9 +3775,8 @@ compute_universal_lca_by_unification (Nenofex * nenofex,
 {
   assert (&universal_var->exp_costs.lca_object == universal_lca_object);
 
-#if COMPUTE_LCA_PARENT_VISITS
-  nenofex->stats.num_total_lca_algo_calls++;
-#endif
+  if (stats_full (nenofex))
+    nenofex->stats.num_total_lca_algo_calls++;
 
   Node *universal_lca = universal_lca_object->lca;
   Node *existential_lca = existential_lca_object->lca;
@@ -3183,9 +3791,7 @@ compute_universal_lca_by_unification (Nenofex * nenofex,
       return;
     }
 
-  Node *high_node, *low_node, *high_node_prev, *low_node_prev;
-
-  low_node_prev = 0;
+  Node *high_node, *low_node, *high_node_prev, *low_node_prev, *lca;
 
   if (universal_lca->level >= existential_lca->level)
     {
@@ -3198,18 +3804,10 @@ compute_universal_lca_by_unification (Nenofex * nenofex,
       low_node = existential_lca;
     }
 
-  unsigned const int high_node_level = high_node->level;
-
-  while (high_node_level < low_node->level)
-    {                           /* check if high_node is reachable from low_node via parent-pointers */
-#if COMPUTE_LCA_PARENT_VISITS
-      nenofex->stats.num_total_lca_parent_visits++;
-#endif
-      low_node_prev = low_node;
-      low_node = low_node->parent;
-    }
+  lca = lca_index_query (nenofex, low_node, high_node, &low_node_prev,
+                         &high_node_prev);
 
-  if (high_node == low_node)
+  if (lca == high_node)
     {                           /* check whether low_node is successor of an lca-child of 
                                    high_node or only of an "ordinary" child */
 
@@ -3231,7 +3829,7 @@ compute_universal_lca_by_unification (Nenofex * nenofex,
 
           /* must reset temporary univ. LCA-object and assign exist. LCA-object */
           unmark_universal_lca_children (universal_lca_object);
-          unlink_variable_from_lca_list (universal_var);
+          unlink_variable_from_lca_list (nenofex, universal_var);
           reset_lca_object (nenofex, universal_var, universal_lca_object, 0);
 
           Node **ch, *child;
@@ -3255,31 +3853,13 @@ compute_universal_lca_by_unification (Nenofex * nenofex,
 
     }
   else
-    {                           /* need to find 'lca(universal_lca, existential_lca)' by 
-                                   following parent-pointers in parallel */
-
-      do
-        {
-#if COMPUTE_LCA_PARENT_VISITS
-          nenofex->stats.num_total_lca_parent_visits += 2;
-#endif
-          low_node_prev = low_node;
-          low_node = low_node->parent;
-
-          high_node_prev = high_node;
-          high_node = high_node->parent;
-
-          assert (high_node);
-          assert (low_node);
-        }
-      while (high_node != low_node);
-      assert (high_node);
+    {                           /* 'lca(universal_lca, existential_lca)' is new LCA */
 
       unmark_universal_lca_children (universal_lca_object);
-      unlink_variable_from_lca_list (universal_var);
+      unlink_variable_from_lca_list (nenofex, universal_var);
       reset_lca_object (nenofex, universal_var, universal_lca_object, 0);
 
-      universal_lca_object->lca = high_node;
+      universal_lca_object->lca = lca;
 
       assert (!universal_lca_child_marked (low_node_prev));
       mark_universal_lca_child (low_node_prev);
@@ -3336,8 +3916,8 @@ assert_universal_lca_computation_graph_and_vars (Nenofex * nenofex)
       if (!is_literal_node (cur))
         {
           Node *child;
-          for (child = cur->child_list.last; child;
-               child = child->level_link.prev)
+          for (child = node_at (nenofex, cur->child_list.last); child;
+               child = node_at (nenofex, child->level_link.prev))
             push_stack (nenofex->mm, stack, child);
         }
     }                           /* end: while stack not empty */
@@ -3348,9 +3928,9 @@ assert_universal_lca_computation_graph_and_vars (Nenofex * nenofex)
 #endif /* end: ifndef NDEBUG */
 
 
-static void
+static int
 init_variable_scores (Nenofex * nenofex, Var * var,
-                      const int update_key_priority_queue);
+                      const int update_key_priority_queue, const int best);
 
 
 /* only a minor optimization */
@@ -3413,7 +3993,7 @@ find_non_innermost_universal_lca_and_children (Nenofex * nenofex,
             }
           else if (lca_update_marked (depending_var))
             {                   /* reset + compute lca of depending var. */
-              unlink_variable_from_lca_list (depending_var);
+              unlink_variable_from_lca_list (nenofex, depending_var);
               reset_lca_object (nenofex, depending_var,
                                 existential_lca_object, 1);
               find_variable_lca_and_children (nenofex, depending_var,
@@ -3486,7 +4066,8 @@ count_children (Nenofex * nenofex, Node * node)
     return result;
 
   Node *child;
-  for (child = node->child_list.first; child; child = child->level_link.next)
+  for (child = node_at (nenofex, node->child_list.first); child;
+       child = node_at (nenofex, child->level_link.next))
     result++;
 
   return result;
@@ -3561,7 +4142,6 @@ assert_copy_equals (Nenofex * nenofex, Node * original, Node * copy)
       assert (cur2);
       assert (cur1->type == cur2->type);
       assert (cur1->level == cur2->level);
-      assert (cur1->num_children == cur2->num_children);
       assert (cur1->size_subformula == cur2->size_subformula);
 
       if (is_literal_node (cur1))
@@ -3571,17 +4151,18 @@ assert_copy_equals (Nenofex * nenofex, Node * original, Node * copy)
       else
         {
           assert (cur1->id == cur2->id);
+          assert (cur1->num_children == cur2->num_children);
           Node *child;
           unsigned int cnt1, cnt2;
           cnt1 = cnt2 = 0;
-          for (child = cur1->child_list.last; child;
-               child = child->level_link.prev)
+          for (child = node_at (nenofex, cur1->child_list.last); child;
+               child = node_at (nenofex, child->level_link.prev))
             {
               push_stack (nenofex->mm, stack1, (void *) child);
               cnt1++;
             }
-          for (child = cur2->child_list.last; child;
-               child = child->level_link.prev)
+          for (child = node_at (nenofex, cur2->child_list.last); child;
+               child = node_at (nenofex, child->level_link.prev))
             {
               push_stack (nenofex->mm, stack2, (void *) child);
               cnt2++;
@@ -3618,6 +4199,8 @@ copy_formula (Nenofex * nenofex, Node * root)
   Stack *copy_stack = create_stack (nenofex->mm, DEFAULT_STACK_SIZE);        /* copied nodes */
   Node *result;
 
+  profile_enter (nenofex, NENOFEX_PHASE_COPY);
+
   push_stack (nenofex->mm, node_stack, root);
 
   Node *cur;
@@ -3637,8 +4220,8 @@ copy_formula (Nenofex * nenofex, Node * root)
               push_stack (nenofex->mm, node_stack, cur);
 
               Node *child;
-              for (child = cur->child_list.last; child;
-                   child = child->level_link.prev)
+              for (child = node_at (nenofex, cur->child_list.last); child;
+                   child = node_at (nenofex, child->level_link.prev))
                 {
                   push_stack (nenofex->mm, node_stack, child);
                 }
@@ -3649,7 +4232,8 @@ copy_formula (Nenofex * nenofex, Node * root)
               result = copy_node (nenofex, cur);
 
               assert (!result->child_list.first);
-              assert (result->child_list.first == result->child_list.last);
+              assert (node_at (nenofex, result->child_list.first) ==
+                      node_at (nenofex, result->child_list.last));
 
               Node *child = pop_stack (copy_stack);
               add_node_to_child_list (nenofex, result, child);
@@ -3664,7 +4248,9 @@ copy_formula (Nenofex * nenofex, Node * root)
                 {
                   child = pop_stack (copy_stack);
                   add_node_to_child_list_before (nenofex,
-                                                 result->child_list.first,
+                                                 node_at (nenofex,
+                                                          result->
+                                                          child_list.first),
                                                  child);
 
                   if (is_literal_node (child))
@@ -3699,6 +4285,8 @@ copy_formula (Nenofex * nenofex, Node * root)
 #endif
 #endif
 
+  profile_leave (nenofex, NENOFEX_PHASE_COPY);
+
   return result;
 }
 
@@ -3716,6 +4304,8 @@ copy_formula_mark_propagation (Nenofex * nenofex, Node * root,
   Stack *copy_stack = create_stack (nenofex->mm, DEFAULT_STACK_SIZE);        /* copied nodes */
   Node *result;
 
+  profile_enter (nenofex, NENOFEX_PHASE_COPY);
+
   push_stack (nenofex->mm, node_stack, root);
 
   Node *cur;
@@ -3749,8 +4339,8 @@ copy_formula_mark_propagation (Nenofex * nenofex, Node * root,
               push_stack (nenofex->mm, node_stack, cur);
 
               Node *child;
-              for (child = cur->child_list.last; child;
-                   child = child->level_link.prev)
+              for (child = node_at (nenofex, cur->child_list.last); child;
+                   child = node_at (nenofex, child->level_link.prev))
                 {
                   push_stack (nenofex->mm, node_stack, child);
                 }
@@ -3761,7 +4351,8 @@ copy_formula_mark_propagation (Nenofex * nenofex, Node * root,
               result = copy_node (nenofex, cur);
 
               assert (!result->child_list.first);
-              assert (result->child_list.first == result->child_list.last);
+              assert (node_at (nenofex, result->child_list.first) ==
+                      node_at (nenofex, result->child_list.last));
 
               Node *child = pop_stack (copy_stack);
               add_node_to_child_list (nenofex, result, child);
@@ -3776,7 +4367,9 @@ copy_formula_mark_propagation (Nenofex * nenofex, Node * root,
                 {
                   child = pop_stack (copy_stack);
                   add_node_to_child_list_before (nenofex,
-                                                 result->child_list.first,
+                                                 node_at (nenofex,
+                                                          result->
+                                                          child_list.first),
                                                  child);
 
                   if (is_literal_node (child))
@@ -3811,6 +4404,8 @@ copy_formula_mark_propagation (Nenofex * nenofex, Node * root,
 #endif
 #endif
 
+  profile_leave (nenofex, NENOFEX_PHASE_COPY);
+
   return result;
 }
 
@@ -3824,18 +4419,20 @@ update_level (Nenofex * nenofex, Node * root)
   assert (root);
   assert (root->parent);
 
+  invalidate_lca_index (nenofex, root);
+
   Stack *stack = create_stack (nenofex->mm, DEFAULT_STACK_SIZE);
   push_stack (nenofex->mm, stack, root);
 
   Node *cur;
   while ((cur = pop_stack (stack)))
     {
-      cur->level = cur->parent->level + 1;
+      cur->level = node_at (nenofex, cur->parent)->level + 1;
       if (!is_literal_node (cur))
         {
           Node *child;
-          for (child = cur->child_list.last; child;
-               child = child->level_link.prev)
+          for (child = node_at (nenofex, cur->child_list.last); child;
+               child = node_at (nenofex, child->level_link.prev))
             push_stack (nenofex->mm, stack, child);
         }
     }                           /* end: while */
@@ -3852,11 +4449,8 @@ update_level (Nenofex * nenofex, Node * root)
 static void
 assert_expand_node_integrity (Nenofex * nenofex, Node * parent)
 {
-  assert (parent->num_children == count_children (nenofex, parent));
-
   if (is_literal_node (parent))
     {
-      assert (!parent->child_list.last);
       assert (parent->lit);
       assert (parent->id);
       assert (parent->lit->negated || parent->id > 0);
@@ -3871,7 +4465,7 @@ assert_expand_node_integrity (Nenofex * nenofex, Node * parent)
   else
     {
       assert (parent->id > 0);
-      assert (!parent->lit);
+      assert (parent->num_children == count_children (nenofex, parent));
       assert ((unsigned int) parent->id > nenofex->num_orig_vars);
       assert (is_or_node (parent) || is_and_node (parent));
       if (!parent->child_list.first)
@@ -3884,15 +4478,18 @@ assert_expand_node_integrity (Nenofex * nenofex, Node * parent)
           assert (parent->child_list.last);
           Node *ch, *prev;
           prev = 0;
-          for (ch = parent->child_list.first; ch; ch = ch->level_link.next)
+          for (ch = node_at (nenofex, parent->child_list.first); ch;
+               ch = node_at (nenofex, ch->level_link.next))
             {
-              assert (!prev || ch->level_link.prev == prev);
-              assert (!prev || prev->level_link.next == ch);
-              assert (ch->parent->type != ch->type);
-              assert (ch->parent == parent);
+              assert (!prev || node_at (nenofex, ch->level_link.prev) == prev);
+              assert (!prev || node_at (nenofex, prev->level_link.next) == ch);
+              assert (node_at (nenofex, ch->parent)->type != ch->type);
+              assert (node_at (nenofex, ch->parent) == parent);
               assert (ch->level == parent->level + 1);
-              assert (ch != parent->child_list.first || !ch->level_link.prev);
-              assert (ch != parent->child_list.last || !ch->level_link.next);
+              assert (ch != node_at (nenofex, parent->child_list.first)
+                      || !ch->level_link.prev);
+              assert (ch != node_at (nenofex, parent->child_list.last)
+                      || !ch->level_link.next);
               prev = ch;
             }
         }
@@ -3917,8 +4514,8 @@ assert_expand_graph_integrity (Nenofex * nenofex)
       if (!is_literal_node (cur))
         {
           Node *child;
-          for (child = cur->child_list.last; child;
-               child = child->level_link.prev)
+          for (child = node_at (nenofex, cur->child_list.last); child;
+               child = node_at (nenofex, child->level_link.prev))
             {
               push_stack (nenofex->mm, stack, child);
             }
@@ -3945,7 +4542,7 @@ propagate_truth (Nenofex * nenofex, Node * occ)
       return;
     }
 
-  Node *occ_parent = occ->parent;
+  Node *occ_parent = node_at (nenofex, occ->parent);
 
   if (is_or_node (occ_parent))
     {
@@ -3983,7 +4580,7 @@ propagate_falsity (Nenofex * nenofex, Node * occ)
       return;
     }
 
-  Node *occ_parent = occ->parent;
+  Node *occ_parent = node_at (nenofex, occ->parent);
 
   if (is_and_node (occ_parent))
     {
@@ -4063,7 +4660,8 @@ subformula_size (Nenofex * nenofex, Node * root)
       if (!is_literal_node (cur))
         {
           Node *ch;
-          for (ch = cur->child_list.last; ch; ch = ch->level_link.prev)
+          for (ch = node_at (nenofex, cur->child_list.last); ch;
+               ch = node_at (nenofex, ch->level_link.prev))
             {
               push_stack (nenofex->mm, stack, ch);
             }
@@ -4135,7 +4733,7 @@ mark_affected_scope_variables_for_cost_update (Nenofex * nenofex,
   assert (exp_root);
 
   Node *prev = exp_root;
-  Node *cur = exp_root->parent;
+  Node *cur = node_at (nenofex, exp_root->parent);
 
   /* if cur has no parent at beginning (i.e. is at root), 
      then if there is a var that has lca == cur, 
@@ -4144,18 +4742,21 @@ mark_affected_scope_variables_for_cost_update (Nenofex * nenofex,
 
   while (cur)
     {
-      Stack *lca_child_list_occs = prev->lca_child_list_occs;
+      Stack *lca_child_list_occs =
+        node_cold (nenofex, prev)->lca_child_list_occs;
 
       /* FAILED: possibly same reason as in ATPG    
          --assert(!lca_child_list_occs || !count_stack(lca_child_list_occs) || 
-         cur->var_lca_list.first); */
+         node_cold (nenofex, cur)->var_lca_list.first); */
 
       if (lca_child_list_occs)
         {
           /* NOT SURE */
           /*
-             assert(!count_stack(lca_child_list_occs) || cur->var_lca_list.first);
-             assert(!count_stack(lca_child_list_occs) || cur->var_lca_list.last);
+             assert(!count_stack(lca_child_list_occs)
+                    || node_cold (nenofex, cur)->var_lca_list.first);
+             assert(!count_stack(lca_child_list_occs)
+                    || node_cold (nenofex, cur)->var_lca_list.last);
            */
 
           void **v_var, **end;
@@ -4174,8 +4775,9 @@ mark_affected_scope_variables_for_cost_update (Nenofex * nenofex,
 
       /* search for lits at path node -> vars have to be marked for dec-score update */
       Node *ch;
-      for (ch = prev->child_list.first;
-           ch && is_literal_node (ch); ch = ch->level_link.next)
+      for (ch = node_at (nenofex, prev->child_list.first);
+           ch && is_literal_node (ch);
+             ch = node_at (nenofex, ch->level_link.next))
         {
           Var *var = ch->lit->var;
           if (var->exp_costs.lca_object.lca)    /* BUG FIX */
@@ -4186,13 +4788,14 @@ mark_affected_scope_variables_for_cost_update (Nenofex * nenofex,
         }                       /* end: for all literals */
 
       prev = cur;
-      cur = cur->parent;
+      cur = node_at (nenofex, cur->parent);
     }                           /* end: while root of graph not checked */
 
   /* search for lits at path node -> vars have to be marked for dec-score update */
   Node *ch;
-  for (ch = prev->child_list.first; ch && is_literal_node (ch);
-       ch = ch->level_link.next)
+  for (ch = node_at (nenofex, prev->child_list.first);
+       ch && is_literal_node (ch);
+       ch = node_at (nenofex, ch->level_link.next))
     {
       Var *var = ch->lit->var;
       if (var->exp_costs.lca_object.lca)        /* BUG FIX */
@@ -4260,7 +4863,8 @@ mark_occs_propagation_var_cost_update (Nenofex * nenofex, Var * var,
       else
         {
           Node *ch;
-          for (ch = cur->child_list.last; ch; ch = ch->level_link.prev)
+          for (ch = node_at (nenofex, cur->child_list.last); ch;
+               ch = node_at (nenofex, ch->level_link.prev))
             push_stack (nenofex->mm, stack, ch);
         }
     }                           /* end: while stack not empty */
@@ -4285,7 +4889,7 @@ set_pos_in_changed_child_list (Nenofex * nenofex)
   Node **ch, *child;
   for (ch = nenofex->changed_subformula.children; (child = *ch); ch++)
     {
-      child->changed_ch_list_pos = ch;
+      alloc_node_cold (nenofex, child)->changed_ch_list_pos = ch;
     }
 }
 
@@ -4300,7 +4904,7 @@ assert_pos_in_changed_ch_list (Nenofex * nenofex)
   Node **ch, *child;
   for (ch = nenofex->changed_subformula.children; (child = *ch); ch++)
     {
-      assert (child->changed_ch_list_pos == ch);
+      assert (node_cold (nenofex, child)->changed_ch_list_pos == ch);
     }
 }
 #endif /* end ifndef NDEBUG */
@@ -4349,7 +4953,7 @@ assign_changed_subformula (Nenofex * nenofex, LCAObject * lca_object)
 
       for (ch = lca_object->children; (child = *ch); ch++)
         {                       /* add nodes and set position */
-          child->changed_ch_list_pos = pos++;
+          alloc_node_cold (nenofex, child)->changed_ch_list_pos = pos++;
           add_lca_child (nenofex, changed_subformula, child);
         }                       /* end: for */
 
@@ -4393,7 +4997,7 @@ unify_changed_lca_children (Nenofex * nenofex, LCAObject * lca_object)
     {
       for (ch = lca_object->children; (child = *ch); ch++)
         {                       /* add children if not already contained */
-          if (!child->changed_ch_list_pos)
+          if (!node_cold (nenofex, child)->changed_ch_list_pos)
             add_lca_child (nenofex, changed_subformula, child);
         }                       /* end: for */
 
@@ -4405,9 +5009,9 @@ unify_changed_lca_children (Nenofex * nenofex, LCAObject * lca_object)
 
       for (ch = lca_object->children; (child = *ch); ch++)
         {                       /* add children if not already contained */
-          if (!child->changed_ch_list_pos)
+          if (!node_cold (nenofex, child)->changed_ch_list_pos)
             {
-              child->changed_ch_list_pos = pos++;
+              alloc_node_cold (nenofex, child)->changed_ch_list_pos = pos++;
               add_lca_child (nenofex, changed_subformula, child);
             }
         }                       /* end: for */
@@ -4424,7 +5028,7 @@ unify_changed_lca_children (Nenofex * nenofex, LCAObject * lca_object)
 static void
 remove_changed_lca_child (Nenofex * nenofex, Node * node)
 {
-  Node **pos = node->changed_ch_list_pos;
+  Node **pos = node_cold (nenofex, node)->changed_ch_list_pos;
   LCAObject *changed_subformula = &(nenofex->changed_subformula);
 
   assert (pos);
@@ -4461,12 +5065,13 @@ remove_changed_lca_child (Nenofex * nenofex, Node * node)
   changed_subformula->num_children--;
   changed_subformula->top_p--;  /* last element overwrites the one to be deleted */
 
-  (*pos)->changed_ch_list_pos = 0;      /* reset pointer of node to be removed */
+  /* reset pointer of node to be removed */
+  alloc_node_cold (nenofex, (*pos))->changed_ch_list_pos = 0;
 
   if (pos != changed_subformula->top_p)
     {                           /* average case; else, simply cut off last element */
       *pos = *changed_subformula->top_p;
-      (*pos)->changed_ch_list_pos = pos;
+      alloc_node_cold (nenofex, (*pos))->changed_ch_list_pos = pos;
     }
 
   *changed_subformula->top_p = 0;
@@ -4485,10 +5090,10 @@ static void
 replace_changed_lca_child (Nenofex * nenofex, Node * old_node,
                            Node * new_node)
 {
-  Node **old_pos = old_node->changed_ch_list_pos;
+  Node **old_pos = node_cold (nenofex, old_node)->changed_ch_list_pos;
   LCAObject *changed_subformula = &(nenofex->changed_subformula);
 
-  assert (!new_node->changed_ch_list_pos);
+  assert (!node_cold (nenofex, new_node)->changed_ch_list_pos);
   assert (old_pos);
 
   assert (changed_subformula->num_children <
@@ -4500,10 +5105,11 @@ replace_changed_lca_child (Nenofex * nenofex, Node * old_node,
           (unsigned int) (changed_subformula->top_p -
                           changed_subformula->children));
 
-  old_node->changed_ch_list_pos = 0;    /* reset pointer of old node */
+  /* reset pointer of old node */
+  alloc_node_cold (nenofex, old_node)->changed_ch_list_pos = 0;
 
   *old_pos = new_node;
-  new_node->changed_ch_list_pos = old_pos;
+  alloc_node_cold (nenofex, new_node)->changed_ch_list_pos = old_pos;
 
 #ifndef NDEBUG
 #if ASSERT_POS_IN_CHANGED_CH_LIST
@@ -4525,7 +5131,7 @@ add_changed_lca_child (Nenofex * nenofex, Node * node)
     changed_subformula->num_children ==
     changed_subformula->size_children - 1 ? 1 : 0;
 
-  assert (!node->changed_ch_list_pos);
+  assert (!node_cold (nenofex, node)->changed_ch_list_pos);
 
 #ifndef NDEBUG
   unsigned int old_size = changed_subformula->size_children;
@@ -4536,9 +5142,11 @@ add_changed_lca_child (Nenofex * nenofex, Node * node)
   if (realloc_called)
     set_pos_in_changed_child_list (nenofex);
   else
-    node->changed_ch_list_pos = changed_subformula->top_p - 1;
+    alloc_node_cold (nenofex, node)->changed_ch_list_pos =
+      changed_subformula->top_p - 1;
 
-  assert (node->changed_ch_list_pos == changed_subformula->top_p - 1);
+  assert (node_cold (nenofex, node)->changed_ch_list_pos ==
+          changed_subformula->top_p - 1);
 
 #ifndef NDEBUG
   assert (!realloc_called || old_size != changed_subformula->size_children);
@@ -4560,9 +5168,9 @@ reset_changed_lca_object (Nenofex * nenofex)
   Node **ch, *child;
   for (ch = lca_object->children; (child = *ch); ch++)
     {
-      assert (child->changed_ch_list_pos == ch);
+      assert (node_cold (nenofex, child)->changed_ch_list_pos == ch);
 
-      child->changed_ch_list_pos = 0;
+      alloc_node_cold (nenofex, child)->changed_ch_list_pos = 0;
       *ch = 0;
     }
 
@@ -4577,6 +5185,9 @@ update_changed_subformula (Nenofex * nenofex, LCAObject * lca_object)
 {
   LCAObject *changed_subformula = &(nenofex->changed_subformula);
 
+  if (stats_full (nenofex))
+    nenofex->stats.num_total_lca_algo_calls++;
+
   Node *changed_lca_cur = changed_subformula->lca;
   Node *changed_lca_new = lca_object->lca;
 
@@ -4589,9 +5200,7 @@ update_changed_subformula (Nenofex * nenofex, LCAObject * lca_object)
       return;
     }
 
-  Node *high_node, *low_node, *high_node_prev, *low_node_prev;
-
-  low_node_prev = 0;
+  Node *high_node, *low_node, *high_node_prev, *low_node_prev, *lca;
 
   if (changed_lca_cur->level >= changed_lca_new->level)
     {
@@ -4604,22 +5213,16 @@ update_changed_subformula (Nenofex * nenofex, LCAObject * lca_object)
       low_node = changed_lca_new;
     }
 
-  unsigned const int high_node_level = high_node->level;
-
-  while (high_node_level < low_node->level)
-    {                           /* level-balancing -> check if high_node is reachable 
-                                   from low_nide via parent-pointers */
-      low_node_prev = low_node;
-      low_node = low_node->parent;
-    }
+  lca = lca_index_query (nenofex, low_node, high_node, &low_node_prev,
+                         &high_node_prev);
 
-  if (high_node == low_node)
+  if (lca == high_node)
     {                           /* check whether low_node is successor of an lca-child of 
                                    high node or only of an "ordinary" child */
 
       if (high_node == changed_lca_cur)
         {
-          if (low_node_prev->changed_ch_list_pos)
+          if (node_cold (nenofex, low_node_prev)->changed_ch_list_pos)
             {                   /* nothing to be done: 'changed_lca_new' contained in 'changed_lca_cur' */
               ;
             }
@@ -4635,29 +5238,14 @@ update_changed_subformula (Nenofex * nenofex, LCAObject * lca_object)
           changed_subformula->lca = 0;
           assign_changed_subformula (nenofex, lca_object);
 
-          if (!low_node_prev->changed_ch_list_pos)
+          if (!node_cold (nenofex, low_node_prev)->changed_ch_list_pos)
             add_changed_lca_child (nenofex, low_node_prev);
 
         }                       /* end: high_node == changed_lca_new */
 
     }
   else
-    {                           /* need to find 'lca(changed_cur, changed_new)' by 
-                                   following parent-pointers in parallel */
-
-      do
-        {
-          low_node_prev = low_node;
-          low_node = low_node->parent;
-
-          high_node_prev = high_node;
-          high_node = high_node->parent;
-
-          assert (high_node);
-          assert (low_node);
-        }
-      while (high_node != low_node);
-      assert (high_node);
+    {                           /* 'lca(changed_cur, changed_new)' is new LCA */
 
       reset_changed_lca_object (nenofex);
 
@@ -4668,12 +5256,14 @@ update_changed_subformula (Nenofex * nenofex, LCAObject * lca_object)
       unsigned int old_size = changed_subformula->size_children;
 #endif
 
-      changed_subformula->lca = high_node;
+      changed_subformula->lca = lca;
 
-      low_node_prev->changed_ch_list_pos = changed_subformula->top_p;
+      alloc_node_cold (nenofex, low_node_prev)->changed_ch_list_pos =
+        changed_subformula->top_p;
       add_lca_child (nenofex, changed_subformula, low_node_prev);
 
-      high_node_prev->changed_ch_list_pos = changed_subformula->top_p;
+      alloc_node_cold (nenofex, high_node_prev)->changed_ch_list_pos =
+        changed_subformula->top_p;
       add_lca_child (nenofex, changed_subformula, high_node_prev);
 
 #ifndef NDEBUG
@@ -4802,8 +5392,8 @@ apply_distributivity_of_or_over_and (Nenofex * nenofex, Node * node1,
         {
           assert (is_or_node (node1));
           Node *child1;
-          for (child1 = node1->child_list.first;
-               child1; child1 = child1->level_link.next)
+          for (child1 = node_at (nenofex, node1->child_list.first);
+               child1; child1 = node_at (nenofex, child1->level_link.next))
             {
               assert (is_literal_node (child1) || is_and_node (child1));
               copy = copy_formula (nenofex, child1);
@@ -4825,8 +5415,8 @@ apply_distributivity_of_or_over_and (Nenofex * nenofex, Node * node1,
       /* add children of node2 to result_or; ignore double literals, 
          abort if trivial clause is generated */
       Node *child2;
-      for (child2 = node2->child_list.first; child2;
-           child2 = child2->level_link.next)
+      for (child2 = node_at (nenofex, node2->child_list.first); child2;
+           child2 = node_at (nenofex, child2->level_link.next))
         {                       /* check for redundancies before adding */
           if (is_literal_node (child2))
             {
@@ -4874,9 +5464,9 @@ apply_distributivity_of_or_over_and (Nenofex * nenofex, Node * node1,
 
       /* unmark all variables */
       Node *clean_ch;
-      for (clean_ch = result_or->child_list.first;
+      for (clean_ch = node_at (nenofex, result_or->child_list.first);
            clean_ch && is_literal_node (clean_ch);
-           clean_ch = clean_ch->level_link.next)
+           clean_ch = node_at (nenofex, clean_ch->level_link.next))
         {
           assert (distributivity_var_marked (clean_ch->lit->var));
           distributivity_var_unmark (clean_ch->lit->var);
@@ -4886,8 +5476,10 @@ apply_distributivity_of_or_over_and (Nenofex * nenofex, Node * node1,
         {                       /* special case */
           if (child2)
             {                   /* trivial clause: loop exited early -> clean up */
-              Node *single_child = result_or->child_list.first;
-              unlink_node (nenofex, result_or->child_list.first);
+              Node *single_child =
+                node_at (nenofex, result_or->child_list.first);
+              unlink_node (nenofex,
+                           node_at (nenofex, result_or->child_list.first));
               assert (!single_child->parent);
               assert (is_literal_node (single_child));
               delete_node (nenofex, result_or);
@@ -4897,8 +5489,10 @@ apply_distributivity_of_or_over_and (Nenofex * nenofex, Node * node1,
             }
           else                  /* return single child as result */
             {                   /* CONJECTURE: this case should never occur */
-              Node *single_child = result_or->child_list.first;
-              unlink_node (nenofex, result_or->child_list.first);
+              Node *single_child =
+                node_at (nenofex, result_or->child_list.first);
+              unlink_node (nenofex,
+                           node_at (nenofex, result_or->child_list.first));
               assert (is_literal_node (single_child));
               delete_node (nenofex, result_or);
               result_or = single_child;
@@ -4930,26 +5524,30 @@ flatten_by_ands_at_split_or (Nenofex * nenofex,
                              LCAObject * changed_subformula_new)
 {
   Node *split_or = nenofex->existential_split_or;
-  Node *split_or_parent = split_or->parent;
+  Node *split_or_parent = node_at (nenofex, split_or->parent);
 
   assert (split_or->parent);
   assert (split_or->num_children == 2);
-  assert (is_and_node (split_or->child_list.last));
-  assert (is_and_node (split_or->child_list.first));
-  assert (split_or->child_list.first->level_link.next ==
-          split_or->child_list.last);
+  assert (is_and_node (node_at (nenofex, split_or->child_list.last)));
+  assert (is_and_node (node_at (nenofex, split_or->child_list.first)));
+  assert (node_at (nenofex,
+                   node_at (nenofex,
+                            split_or->child_list.first)->level_link.next) ==
+          node_at (nenofex, split_or->child_list.last));
 
   int total_size_added = 0;
   Node *disjunction;            /* partial result when distributing OR over AND */
-  Node *first_and_child2 = split_or->child_list.last->child_list.first;
+  Node *first_and = node_at (nenofex, split_or->child_list.first);
+  Node *second_and = node_at (nenofex, split_or->child_list.last);
+  Node *first_and_child2 = node_at (nenofex, second_and->child_list.first);
 
   Node *and_child1, *and_child2;
-  for (and_child1 = split_or->child_list.first->child_list.first;
-       and_child1; and_child1 = and_child1->level_link.next)
+  for (and_child1 = node_at (nenofex, first_and->child_list.first);
+       and_child1; and_child1 = node_at (nenofex, and_child1->level_link.next))
     {
       assert (is_literal_node (and_child1) || is_or_node (and_child1));
-      for (and_child2 = first_and_child2;
-           and_child2; and_child2 = and_child2->level_link.next)
+      for (and_child2 = first_and_child2; and_child2;
+           and_child2 = node_at (nenofex, and_child2->level_link.next))
         {
           assert (is_literal_node (and_child2) || is_or_node (and_child2));
           disjunction =
@@ -4982,19 +5580,20 @@ flatten_by_literals_at_split_or (Nenofex * nenofex, Node * scratch_node,
                                  LCAObject * changed_subformula_new)
 {
   Node *split_or = nenofex->existential_split_or;
-  Node *split_or_parent = split_or->parent;
+  Node *split_or_parent = node_at (nenofex, split_or->parent);
 
   assert (split_or->parent);
-  assert (is_and_node (split_or->child_list.last));
-  assert (!is_and_node (split_or->child_list.first));
+  assert (is_and_node (node_at (nenofex, split_or->child_list.last)));
+  assert (!is_and_node (node_at (nenofex, split_or->child_list.first)));
 
   int total_size_added = 0;
 
   Node *disjunction;            /* partial result when distributing OR over AND */
 
   Node *and_child;
-  for (and_child = split_or->child_list.last->child_list.first;
-       and_child; and_child = and_child->level_link.next)
+  Node *split_and = node_at (nenofex, split_or->child_list.last);
+  for (and_child = node_at (nenofex, split_and->child_list.first);
+       and_child; and_child = node_at (nenofex, and_child->level_link.next))
     {
       assert (is_literal_node (and_child) || is_or_node (and_child));
       disjunction =
@@ -5026,9 +5625,10 @@ post_expansion_flattening (Nenofex * nenofex,
   Node *split_or = nenofex->existential_split_or;
   Node *split_or_first_child = 0;
 
-  if (is_and_node (split_or->child_list.last))
+  if (is_and_node (node_at (nenofex, split_or->child_list.last)))
     {
-      if (is_and_node ((split_or_first_child = split_or->child_list.first)))
+      split_or_first_child = node_at (nenofex, split_or->child_list.first);
+      if (is_and_node (split_or_first_child))
         {
           assert (split_or->num_children == 2);
           nenofex->cnt_post_expansion_flattenings++;
@@ -5041,14 +5641,15 @@ post_expansion_flattening (Nenofex * nenofex,
           assert (is_literal_node (split_or_first_child));
           Node *scratch = 0;
 
-          if (is_literal_node (split_or_first_child->level_link.next))
+          if (is_literal_node
+              (node_at (nenofex, split_or_first_child->level_link.next)))
             {
               scratch = or_node (nenofex);
 
               Node *child;
               for (child = split_or_first_child;
                    child && is_literal_node (child);
-                   child = child->level_link.next)
+                   child = node_at (nenofex, child->level_link.next))
                 {
                   Node *lit_copy = copy_formula (nenofex, child);
                   add_node_to_child_list (nenofex, scratch, lit_copy);
@@ -5056,9 +5657,12 @@ post_expansion_flattening (Nenofex * nenofex,
             }                   /* end: more than one literal */
           else
             {                   /* only one literal at split-or */
-              assert (is_and_node (split_or_first_child->level_link.next));
-              assert (split_or_first_child->level_link.next ==
-                      split_or->child_list.last);
+              assert (is_and_node
+                      (node_at (nenofex,
+                                split_or_first_child->level_link.next)));
+              assert (node_at (nenofex,
+                               split_or_first_child->level_link.next) ==
+                      node_at (nenofex, split_or->child_list.last));
               scratch = split_or_first_child;
             }
 
@@ -5080,8 +5684,8 @@ post_expansion_flattening (Nenofex * nenofex,
   else
     {
       Node *child;
-      for (child = split_or->child_list.first;
-           child; child = child->level_link.next)
+      for (child = node_at (nenofex, split_or->child_list.first);
+           child; child = node_at (nenofex, child->level_link.next))
         {
           assert (is_literal_node (child));
         }
@@ -5123,8 +5727,8 @@ post_expansion_flattening_check_for_cnf_form (Nenofex *nenofex, Node * split_or)
       if (!is_literal_node (cur))
         {
           Node *child;
-          for (child = cur->child_list.first; child;
-               child = child->level_link.next)
+          for (child = node_at (nenofex, cur->child_list.first); child;
+               child = node_at (nenofex, child->level_link.next))
             {
               push_stack (nenofex->mm, stack, child);
             }
@@ -5197,10 +5801,8 @@ expand_existential_variable (Nenofex * nenofex, Var * var)
   assert (!contained_lit || contained_lit->lit->var == var);
   Node *preemptive_occ = 0;
 
-#if COMPUTE_NUM_NON_INC_EXPANSIONS
-  if (contained_lit)
+  if (stats_basic (nenofex) && contained_lit)
     nenofex->stats.num_non_inc_expansions++;
-#endif
 
   /* used in for post-expansion flattening */
   int set_existential_split_or = 0;
@@ -5254,9 +5856,8 @@ expand_existential_variable (Nenofex * nenofex, Var * var)
       if (type == NODE_TYPE_OR)
         {                       /* CASE 1.1 */
 
-#if COMPUTE_CASES_IN_EXPANSIONS
-          nenofex->stats.num_exp_case_E_OR_ALL++;
-#endif
+          if (stats_basic (nenofex))
+            nenofex->stats.num_exp_case_E_OR_ALL++;
 
           if (!contained_lit)
             {
@@ -5296,9 +5897,8 @@ expand_existential_variable (Nenofex * nenofex, Var * var)
       else if (type == NODE_TYPE_AND)
         {                       /* CASE 1.2 */
 
-#if COMPUTE_CASES_IN_EXPANSIONS
-          nenofex->stats.num_exp_case_E_AND_ALL++;
-#endif
+          if (stats_basic (nenofex))
+            nenofex->stats.num_exp_case_E_AND_ALL++;
 
           if (contained_lit)
             {
@@ -5333,9 +5933,10 @@ expand_existential_variable (Nenofex * nenofex, Var * var)
           else                  /* average case */
             {
               assert (lca_object_lca->parent);
-              assert (is_or_node (lca_object_lca->parent));
+              assert (is_or_node (node_at (nenofex, lca_object_lca->parent)));
 
-              changed_subformula_new.lca = lca_object_lca->parent;
+              changed_subformula_new.lca =
+                node_at (nenofex, lca_object_lca->parent);
 
               Node *copy =
                 copy_formula_mark_propagation (nenofex, lca_object_lca, var);
@@ -5343,9 +5944,13 @@ expand_existential_variable (Nenofex * nenofex, Var * var)
               add_lca_child (nenofex, &changed_subformula_new, lca_object_lca);
               add_lca_child (nenofex, &changed_subformula_new, copy);
 
-              add_node_to_child_list (nenofex, lca_object_lca->parent, copy);
+              add_node_to_child_list (nenofex,
+                                      node_at (nenofex,
+                                               lca_object_lca->parent), copy);
 
-              update_size_subformula (nenofex, lca_object_lca->parent,
+              update_size_subformula (nenofex,
+                                      node_at (nenofex,
+                                               lca_object_lca->parent),
                                       lca_object_lca->size_subformula);
 
               assert (!is_literal_node (copy));
@@ -5363,14 +5968,14 @@ expand_existential_variable (Nenofex * nenofex, Var * var)
               if (!lca_object_lca->lit->negated)
                 truth_propagation_mark (lca_object_lca);
             }
-          else if (is_or_node (lca_object_lca->parent))
+          else if (is_or_node (node_at (nenofex, lca_object_lca->parent)))
             {
               if (!lca_object_lca->lit->negated)
                 truth_propagation_mark (lca_object_lca);
             }
           else                  /* AND */
             {
-              assert (is_and_node (lca_object_lca->parent));
+              assert (is_and_node (node_at (nenofex, lca_object_lca->parent)));
 
               if (!lca_object_lca->lit->negated)
                 truth_propagation_mark (lca_object_lca);
@@ -5384,9 +5989,8 @@ expand_existential_variable (Nenofex * nenofex, Var * var)
       if (type == NODE_TYPE_OR)
         {                       /* CASE 2.1 */
 
-#if COMPUTE_CASES_IN_EXPANSIONS
-          nenofex->stats.num_exp_case_E_OR_SUBSET++;
-#endif
+          if (stats_basic (nenofex))
+            nenofex->stats.num_exp_case_E_OR_SUBSET++;
 
           if (!contained_lit)
             {
@@ -5425,9 +6029,8 @@ expand_existential_variable (Nenofex * nenofex, Var * var)
       else if (type == NODE_TYPE_AND)
         {                       /* CASE 2.2 */
 
-#if COMPUTE_CASES_IN_EXPANSIONS
-          nenofex->stats.num_exp_case_E_AND_SUBSET++;
-#endif
+          if (stats_basic (nenofex))
+            nenofex->stats.num_exp_case_E_AND_SUBSET++;
 
           if (contained_lit)
             {
@@ -5470,7 +6073,7 @@ expand_existential_variable (Nenofex * nenofex, Var * var)
 
                   /* BUG - FIX */
                   if (changed_subformula->lca == lca_object_lca
-                      && child->changed_ch_list_pos)
+                      && node_cold (nenofex, child)->changed_ch_list_pos)
                     remove_changed_lca_child (nenofex, child);
 
                   add_node_to_child_list (nenofex, new_and, child);
@@ -5480,7 +6083,7 @@ expand_existential_variable (Nenofex * nenofex, Var * var)
                   if (is_literal_node ((child)))
                     {
                       assert ((child)->occ_link.next ||
-                              (child)->occ_link.prev
+                              node_at (nenofex, (child)->occ_link.prev)
                               || (child) == (child)->lit->occ_list.first);
                     }
 #endif
@@ -5517,7 +6120,8 @@ expand_existential_variable (Nenofex * nenofex, Var * var)
               add_lca_child (nenofex, &changed_subformula_new, copy_and);
 
               split_or->size_subformula += 2 * copy_and->size_subformula;
-              update_size_subformula (nenofex, split_or->parent,
+              update_size_subformula (nenofex,
+                                      node_at (nenofex, split_or->parent),
                                       1 + copy_and->size_subformula + 1);
 
               if (!set_existential_split_or ||
@@ -5562,16 +6166,20 @@ expand_existential_variable (Nenofex * nenofex, Var * var)
 
   assert (!nenofex->atpg_rr_called);
 
+  defer_size_subformula_updates (nenofex);
+
   if (!preemptive_occ)
     propagate_literals (nenofex, var);  /* graph should be fully reduced and cleaned up */
   else
     {
       assert (contained_lit == preemptive_occ);
       assert (preemptive_occ->parent);
-      assert (is_or_node (preemptive_occ->parent));
+      assert (is_or_node (node_at (nenofex, preemptive_occ->parent)));
       propagate_truth (nenofex, preemptive_occ);
     }
 
+  flush_size_subformula_updates (nenofex);
+
 #ifndef NDEBUG
 #if ASSERT_SIZES_IN_EXPANSION
   unsigned int size_after_exp_after_prop =
@@ -5596,7 +6204,7 @@ expand_existential_variable (Nenofex * nenofex, Var * var)
 
   if (lca_object->lca)
     {
-      unlink_variable_from_lca_list (var);
+      unlink_variable_from_lca_list (nenofex, var);
       reset_lca_object (nenofex, var, lca_object, 1);
     }
 
@@ -5617,7 +6225,8 @@ expand_existential_variable (Nenofex * nenofex, Var * var)
       assert (nenofex->options.post_expansion_flattening_specified);
 
       post_expansion_flattening_reset_changed_new (&changed_subformula_new);
-      changed_subformula_new.lca = nenofex->existential_split_or->parent;
+      changed_subformula_new.lca =
+        node_at (nenofex, nenofex->existential_split_or->parent);
 
       post_expansion_flattening (nenofex, &changed_subformula_new);
 
@@ -5636,8 +6245,9 @@ expand_existential_variable (Nenofex * nenofex, Var * var)
             {
               changed_subformula_new.lca = remaining_child;
               Node *child;
-              for (child = remaining_child->child_list.first;
-                   child; child = child->level_link.next)
+              for (child = node_at (nenofex,
+                                    remaining_child->child_list.first);
+                   child; child = node_at (nenofex, child->level_link.next))
                 {
                   add_lca_child (nenofex, &changed_subformula_new, child);
                 }
@@ -5730,9 +6340,8 @@ expand_universal_variable (Nenofex * nenofex, Var * var)
       if (type == NODE_TYPE_AND)
         {                       /* CASE 1.1 */
 
-#if COMPUTE_CASES_IN_EXPANSIONS
-          nenofex->stats.num_exp_case_A_AND_ALL++;
-#endif
+          if (stats_basic (nenofex))
+            nenofex->stats.num_exp_case_A_AND_ALL++;
 
           /* append copy of children */
           if (!contained_lit)
@@ -5768,9 +6377,8 @@ expand_universal_variable (Nenofex * nenofex, Var * var)
       else if (type == NODE_TYPE_OR)
         {                       /* CASE 1.2 */
 
-#if COMPUTE_CASES_IN_EXPANSIONS
-          nenofex->stats.num_exp_case_A_OR_ALL++;
-#endif
+          if (stats_basic (nenofex))
+            nenofex->stats.num_exp_case_A_OR_ALL++;
 
           if (contained_lit)
             {
@@ -5805,9 +6413,10 @@ expand_universal_variable (Nenofex * nenofex, Var * var)
           else                  /* average case */
             {
               assert (lca_object_lca->parent);
-              assert (is_and_node (lca_object_lca->parent));
+              assert (is_and_node (node_at (nenofex, lca_object_lca->parent)));
 
-              changed_subformula_new.lca = lca_object_lca->parent;
+              changed_subformula_new.lca =
+                node_at (nenofex, lca_object_lca->parent);
 
               Node *copy =
                 copy_formula_mark_propagation (nenofex, lca_object_lca, var);
@@ -5815,9 +6424,13 @@ expand_universal_variable (Nenofex * nenofex, Var * var)
               add_lca_child (nenofex, &changed_subformula_new, lca_object_lca);
               add_lca_child (nenofex, &changed_subformula_new, copy);
 
-              add_node_to_child_list (nenofex, lca_object_lca->parent, copy);
+              add_node_to_child_list (nenofex,
+                                      node_at (nenofex,
+                                               lca_object_lca->parent), copy);
 
-              update_size_subformula (nenofex, lca_object_lca->parent,
+              update_size_subformula (nenofex,
+                                      node_at (nenofex,
+                                               lca_object_lca->parent),
                                       lca_object_lca->size_subformula);
 
               assert (!is_literal_node (copy));
@@ -5835,14 +6448,14 @@ expand_universal_variable (Nenofex * nenofex, Var * var)
               if (lca_object_lca->lit->negated)
                 truth_propagation_mark (lca_object_lca);
             }
-          else if (is_and_node (lca_object_lca->parent))
+          else if (is_and_node (node_at (nenofex, lca_object_lca->parent)))
             {
               if (lca_object_lca->lit->negated)
                 truth_propagation_mark (lca_object_lca);
             }
           else                  /* OR */
             {
-              assert (is_or_node (lca_object_lca->parent));
+              assert (is_or_node (node_at (nenofex, lca_object_lca->parent)));
 
               if (lca_object_lca->lit->negated)
                 truth_propagation_mark (lca_object_lca);
@@ -5856,9 +6469,8 @@ expand_universal_variable (Nenofex * nenofex, Var * var)
       if (type == NODE_TYPE_AND)
         {                       /* CASE 2.1 */
 
-#if COMPUTE_CASES_IN_EXPANSIONS
-          nenofex->stats.num_exp_case_A_AND_SUBSET++;
-#endif
+          if (stats_basic (nenofex))
+            nenofex->stats.num_exp_case_A_AND_SUBSET++;
 
           if (!contained_lit)
             {
@@ -5895,9 +6507,8 @@ expand_universal_variable (Nenofex * nenofex, Var * var)
       else if (type == NODE_TYPE_OR)
         {                       /* CASE 2.2 */
 
-#if COMPUTE_CASES_IN_EXPANSIONS
-          nenofex->stats.num_exp_case_A_OR_SUBSET++;
-#endif
+          if (stats_basic (nenofex))
+            nenofex->stats.num_exp_case_A_OR_SUBSET++;
 
           if (contained_lit)
             {
@@ -5937,7 +6548,7 @@ expand_universal_variable (Nenofex * nenofex, Var * var)
 
                   /* BUG - FIX */
                   if (changed_subformula->lca == lca_object_lca
-                      && (child)->changed_ch_list_pos)
+                      && node_cold (nenofex, (child))->changed_ch_list_pos)
                     remove_changed_lca_child (nenofex, child);
 
                   add_node_to_child_list (nenofex, new_or, child);
@@ -5947,7 +6558,7 @@ expand_universal_variable (Nenofex * nenofex, Var * var)
                   if (is_literal_node ((child)))
                     {
                       assert ((child)->occ_link.next ||
-                              (child)->occ_link.prev
+                              node_at (nenofex, (child)->occ_link.prev)
                               || (child) == (child)->lit->occ_list.first);
                     }
 #endif
@@ -5985,7 +6596,8 @@ expand_universal_variable (Nenofex * nenofex, Var * var)
               add_lca_child (nenofex, &changed_subformula_new, copy_or);
 
               split_and->size_subformula += 2 * copy_or->size_subformula;
-              update_size_subformula (nenofex, split_and->parent,
+              update_size_subformula (nenofex,
+                                      node_at (nenofex, split_and->parent),
                                       1 + copy_or->size_subformula + 1);
 
               assign_or_update_changed_subformula (&changed_subformula_new);
@@ -6019,16 +6631,20 @@ expand_universal_variable (Nenofex * nenofex, Var * var)
 
   assert (!nenofex->atpg_rr_called);
 
+  defer_size_subformula_updates (nenofex);
+
   if (!preemptive_occ)
     propagate_literals (nenofex, var);  /* graph should be fully reduced and cleaned up */
   else
     {
       assert (contained_lit == preemptive_occ);
       assert (preemptive_occ->parent);
-      assert (is_and_node (preemptive_occ->parent));
+      assert (is_and_node (node_at (nenofex, preemptive_occ->parent)));
       propagate_falsity (nenofex, preemptive_occ);
     }
 
+  flush_size_subformula_updates (nenofex);
+
 #ifndef NDEBUG
 #if ASSERT_SIZES_IN_EXPANSION
   unsigned int size_after_exp_after_prop =
@@ -6053,7 +6669,7 @@ expand_universal_variable (Nenofex * nenofex, Var * var)
 
   if (lca_object->lca)
     {
-      unlink_variable_from_lca_list (var);
+      unlink_variable_from_lca_list (nenofex, var);
       reset_lca_object (nenofex, var, lca_object, 1);
     }
 
@@ -6099,10 +6715,12 @@ expand_universal_variable (Nenofex * nenofex, Var * var)
 /* 
 - determines number of nodes to be created when expanding variable 'var'
 - type of LCA and type of var influence this value (8 cases)
+- non-incremental expansions are counted in 'num_non_inc', which is
+  thread-local in parallel scoring
 */
 static unsigned int
 expansion_increase_score (Nenofex * nenofex, Var * var,
-                          LCAObject * lca_object)
+                          LCAObject * lca_object, int *num_non_inc)
 {
   assert (lca_object->lca);
   unsigned int inc_score = 0;
@@ -6130,9 +6748,8 @@ expansion_increase_score (Nenofex * nenofex, Var * var,
   if (lca_children_contain_lit (var, lca_object) || is_literal_node (lca))
     {
       assert (inc_score == 0);
-#if COMPUTE_NUM_NON_INC_EXPANSIONS_IN_SCORES
-      nenofex->stats.num_non_inc_expansions_in_scores++;
-#endif
+      if (stats_full (nenofex))
+        (*num_non_inc)++;
       return inc_score;
     }
 
@@ -6228,24 +6845,161 @@ expansion_increase_score (Nenofex * nenofex, Var * var,
 }
 
 
+/* START: SCORING SCRATCH */
+
+/*
+- node marks of decrease score computation if scoring in parallel: 
+  open addressing on node addresses, one table per thread
+*/
+typedef struct ScoreScratch ScoreScratch;
+
+struct ScoreScratch
+{
+  MemManager *mm;
+  Node **nodes;
+  unsigned char *marks;
+  unsigned int size;            /* power of two */
+  unsigned int count;
+};
+
+#define SCORE_SCRATCH_INIT_SIZE 1024
+
+
+static unsigned int
+score_scratch_pos (ScoreScratch * scratch, Node * node)
+{
+  unsigned long int key = (unsigned long int) node;
+  key ^= key >> 16;
+  key *= 2654435761UL;
+  unsigned int pos = (key ^ (key >> 16)) & (scratch->size - 1);
+
+  Node *cur;
+  while ((cur = scratch->nodes[pos]) && cur != node)
+    pos = (pos + 1) & (scratch->size - 1);
+
+  return pos;
+}
+
+
+static void
+score_scratch_resize (ScoreScratch * scratch, unsigned int size)
+{
+  Node **old_nodes = scratch->nodes;
+  unsigned char *old_marks = scratch->marks;
+  unsigned int old_size = scratch->size, i;
+
+  scratch->size = size;
+  scratch->nodes = mem_malloc (scratch->mm, size * sizeof (Node *));
+  scratch->marks = mem_malloc (scratch->mm, size);
+  memset (scratch->nodes, 0, size * sizeof (Node *));
+
+  for (i = 0; i < old_size; i++)
+    {
+      if (old_nodes[i])
+        {
+          unsigned int pos = score_scratch_pos (scratch, old_nodes[i]);
+          scratch->nodes[pos] = old_nodes[i];
+          scratch->marks[pos] = old_marks[i];
+        }
+    }
+
+  if (old_nodes)
+    {
+      mem_free (scratch->mm, old_nodes, old_size * sizeof (Node *));
+      mem_free (scratch->mm, old_marks, old_size);
+    }
+}
+
+
+static void
+init_score_scratch (ScoreScratch * scratch, MemManager * mm)
+{
+  memset (scratch, 0, sizeof (ScoreScratch));
+  scratch->mm = mm;
+  score_scratch_resize (scratch, SCORE_SCRATCH_INIT_SIZE);
+}
+
+
+static void
+free_score_scratch (ScoreScratch * scratch)
+{
+  mem_free (scratch->mm, scratch->nodes, scratch->size * sizeof (Node *));
+  mem_free (scratch->mm, scratch->marks, scratch->size);
+}
+
+
+static unsigned char
+score_scratch_get (ScoreScratch * scratch, Node * node)
+{
+  unsigned int pos = score_scratch_pos (scratch, node);
+  return scratch->nodes[pos] ? scratch->marks[pos] : 0;
+}
+
+
+static unsigned char *
+score_scratch_slot (ScoreScratch * scratch, Node * node)
+{
+  if (2 * (scratch->count + 1) > scratch->size)
+    score_scratch_resize (scratch, 2 * scratch->size);
+
+  unsigned int pos = score_scratch_pos (scratch, node);
+
+  if (!scratch->nodes[pos])
+    {
+      scratch->nodes[pos] = node;
+      scratch->marks[pos] = 0;
+      scratch->count++;
+    }
+
+  return scratch->marks + pos;
+}
+
+
+/*
+- forget all marks; table shrinks again if it became much larger than needed
+*/
+static void
+reset_score_scratch (ScoreScratch * scratch)
+{
+  if (!scratch->count)
+    return;
+
+  if (scratch->size > SCORE_SCRATCH_INIT_SIZE &&
+      scratch->size > 16 * scratch->count)
+    {
+      free_score_scratch (scratch);
+      scratch->nodes = 0;
+      scratch->size = 0;
+      score_scratch_resize (scratch, SCORE_SCRATCH_INIT_SIZE);
+    }
+  else
+    memset (scratch->nodes, 0, scratch->size * sizeof (Node *));
+
+  scratch->count = 0;
+}
+
+/* END: SCORING SCRATCH */
+
+
 /*
 - count nodes that will be deleted when setting variable to false
 */
 static void
 decrease_score_propagate_falsity (Nenofex * nenofex, Node * occ,
-                                  LCAObject * lca_object)
+                                  LCAObject * lca_object,
+                                  ScoreScratch * scratch)
 {
   assert (occ);
   assert (is_literal_node (occ));
 
   if (occ == nenofex->graph_root)
     {
-      assert (!decrease_score_marked (occ));
-      decrease_score_mark (occ);
+      assert (!decrease_score_marked (scratch, occ));
+      decrease_score_mark (scratch, occ);
       return;
     }
 
-  Node *occ_parent = occ->parent;
+  Node *occ_parent = node_at (nenofex, occ->parent);
   assert (occ_parent);
 
   Node *lca_object_lca = lca_object->lca;
@@ -6256,7 +7010,7 @@ decrease_score_propagate_falsity (Nenofex * nenofex, Node * occ,
         {
           if (occ_parent == lca_object_lca)
             {
-              assert (!decrease_score_marked (occ_parent));
+              assert (!decrease_score_marked (scratch, occ_parent));
             }
           else if (occ == lca_object_lca)
             {
@@ -6264,17 +7018,17 @@ decrease_score_propagate_falsity (Nenofex * nenofex, Node * occ,
             }
           else
             {
-              decrease_score_mark (occ_parent);
+              decrease_score_mark (scratch, occ_parent);
             }
         }                       /* end: existential var. */
       else
         {
-          decrease_score_mark (occ_parent);
+          decrease_score_mark (scratch, occ_parent);
         }
     }
   else                          /* parent is OR */
     {
-      decrease_score_mark (occ);
+      decrease_score_mark (scratch, occ);
     }
 }
 
@@ -6284,19 +7038,20 @@ decrease_score_propagate_falsity (Nenofex * nenofex, Node * occ,
 */
 static void
 decrease_score_propagate_truth (Nenofex * nenofex, Node * occ,
-                                LCAObject * lca_object)
+                                LCAObject * lca_object,
+                                ScoreScratch * scratch)
 {
   assert (occ);
   assert (is_literal_node (occ));
 
   if (occ == nenofex->graph_root)
     {
-      assert (!decrease_score_marked (occ));
-      decrease_score_mark (occ);
+      assert (!decrease_score_marked (scratch, occ));
+      decrease_score_mark (scratch, occ);
       return;
     }
 
-  Node *occ_parent = occ->parent;
+  Node *occ_parent = node_at (nenofex, occ->parent);
   assert (occ_parent);
 
   Node *lca_object_lca = lca_object->lca;
@@ -6307,7 +7062,7 @@ decrease_score_propagate_truth (Nenofex * nenofex, Node * occ,
         {
           if (occ_parent == lca_object_lca)
             {
-              assert (!decrease_score_marked (occ_parent));
+              assert (!decrease_score_marked (scratch, occ_parent));
             }
           else if (occ == lca_object_lca)
             {
@@ -6315,17 +7070,17 @@ decrease_score_propagate_truth (Nenofex * nenofex, Node * occ,
             }
           else
             {
-              decrease_score_mark (occ_parent);
+              decrease_score_mark (scratch, occ_parent);
             }
         }                       /* end: universal vars */
       else
         {
-          decrease_score_mark (occ_parent);
+          decrease_score_mark (scratch, occ_parent);
         }
     }
   else                          /* parent is AND */
     {
-      decrease_score_mark (occ);
+      decrease_score_mark (scratch, occ);
     }
 }
 
@@ -6337,7 +7092,8 @@ decrease_score_propagate_truth (Nenofex * nenofex, Node * occ,
 - pessimistic score; might lose more by parent-merging or 1-l-simp
 */
 static unsigned int
-decrease_score_count_deleted (Nenofex * nenofex, Var * var)
+decrease_score_count_deleted (Nenofex * nenofex, Var * var,
+                              ScoreScratch * scratch)
 {
   unsigned int num_deleted = 0;
 
@@ -6345,70 +7101,73 @@ decrease_score_count_deleted (Nenofex * nenofex, Var * var)
   Node *var_lca = var->exp_costs.lca_object.lca;
   assert (var_lca);
 
-  Stack *collected_nodes = create_stack (nenofex->mm, DEFAULT_STACK_SIZE);
+  MemManager *mm = scratch ? scratch->mm : nenofex->mm;
+  Stack *collected_nodes = create_stack (mm, DEFAULT_STACK_SIZE);
 
   Node *occ;
 
 AGAIN:
 
-  for (occ = lit->occ_list.first; occ; occ = occ->occ_link.next)
+  for (occ = lit->occ_list.first; occ;
+       occ = node_at (nenofex, occ->occ_link.next))
     {
       Node *cur, *highest_marked;
 
       cur = occ;
       assert (is_literal_node (cur));
 
-      if (!decrease_score_marked (cur))
+      if (!decrease_score_marked (scratch, cur))
         {
-          cur = cur->parent;
+          cur = node_at (nenofex, cur->parent);
           if (!cur)             /* special case: only one occ which is at root */
             {
               assert (0);
             }
-          else if (!decrease_score_marked (cur))
+          else if (!decrease_score_marked (scratch, cur))
             {                   /* parent already unmarked -> there is a collected node on path up to root */
               continue;
             }
         }                       /* end: if occ not marked */
-      assert ((is_literal_node (cur) && decrease_score_marked (cur)) ||
-              (!is_literal_node (cur) && decrease_score_marked (cur)));
+      assert ((is_literal_node (cur) && decrease_score_marked (scratch, cur)) ||
+              (!is_literal_node (cur) && decrease_score_marked (scratch, cur)));
 
       highest_marked = cur;
-      cur = cur->parent;
+      cur = node_at (nenofex, cur->parent);
 
       unsigned const int lowest_level =
-        var_lca->parent ? var_lca->parent->level : var_lca->level;
+        node_at (nenofex, var_lca->parent)
+          ? node_at (nenofex, var_lca->parent)->level : var_lca->level;
 
       int found_collected = 0;
       while (cur && cur->level >= lowest_level) /* NOTE: strengthen loop condition ? */
         {
           assert (!is_literal_node (cur));
 
-          if (decrease_score_marked (cur))
+          if (decrease_score_marked (scratch, cur))
             {
-              assert (!decrease_score_collected_marked (cur));
-              decrease_score_unmark (highest_marked);
+              assert (!decrease_score_collected_marked (scratch, cur));
+              decrease_score_unmark (scratch, highest_marked);
               highest_marked = cur;
             }
-          else if (decrease_score_collected_marked (cur))
+          else if (decrease_score_collected_marked (scratch, cur))
             {
               found_collected = 1;
               break;
             }
 
-          cur = cur->parent;
+          cur = node_at (nenofex, cur->parent);
         }                       /* end: while */
 
       if (found_collected)
         {
-          decrease_score_unmark (highest_marked);
+          decrease_score_unmark (scratch, highest_marked);
         }
       else
         {
-          decrease_score_unmark (highest_marked);
-          assert (!decrease_score_collected_marked (highest_marked));
-          decrease_score_collected_mark (highest_marked);
-          push_stack (nenofex->mm, collected_nodes, highest_marked);
+          decrease_score_unmark (scratch, highest_marked);
+          assert (!decrease_score_collected_marked (scratch, highest_marked));
+          decrease_score_collected_mark (scratch, highest_marked);
+          push_stack (mm, collected_nodes, highest_marked);
         }
     }                           /* end: for all occurrences */
 
@@ -6422,44 +7181,106 @@ AGAIN:
   Node *collected_node;
   while ((collected_node = pop_stack (collected_nodes)))
     {
-      assert (decrease_score_collected_marked (collected_node));
-      decrease_score_collected_unmark (collected_node);
+      assert (decrease_score_collected_marked (scratch, collected_node));
+      decrease_score_collected_unmark (scratch, collected_node);
       num_deleted += collected_node->size_subformula;
     }                           /* end: while */
 
-  delete_stack (nenofex->mm, collected_nodes);
+  delete_stack (mm, collected_nodes);
 
   return num_deleted;
 }
 
 
 /*
-- determine how many nodes will be deleted if expanding var and propagating literals
-- TODO: REVISION NECESSARY (cases of non-increasing expansions properly captured?)
+- upper bound of decrease score without visiting the graph
+- an occurrence marks itself or its parent, and nodes counted by
+  'decrease_score_count_deleted' are disjoint marked nodes
+- occurrence is propagated once as true and once as false: marks parent
+  in one case and itself in the other one
+- stops as soon as bound exceeds 'limit'
 */
-
-#define REVISION 1
-
 static unsigned int
-expansion_decrease_score (Nenofex * nenofex, Var * var,
-                          LCAObject * lca_object)
+decrease_score_upper_bound (Nenofex * nenofex, Var * var,
+                            const unsigned int limit)
 {
-  unsigned int dec_score = 0;
+  unsigned int bound = 0;
 
-  Node *occ;
-  Lit *lit = var->lits;
-  assert (lit->negated);
+  Lit *lit;
+  for (lit = var->lits; lit <= var->lits + 1; lit++)
+    {
+      Node *occ;
+      for (occ = lit->occ_list.first; occ;
+           occ = node_at (nenofex, occ->occ_link.next))
+        {
+          Node *parent = node_at (nenofex, occ->parent);
+          bound += parent ? parent->size_subformula + 1 : 2;
 
-  Node *contained_lit = lca_children_contain_lit (var, lca_object);
-  assert (!contained_lit || contained_lit->lit->var == var);
+          if (bound > limit)
+            return bound;
+        }
+    }
 
-  assert (!contained_lit || !is_literal_node (lca_object->lca));
+  return bound;
+}
 
-  if (contained_lit || is_literal_node (lca_object->lca))
-    {
 
-#if !REVISION
-      if ((contained_lit && !contained_lit->lit->negated) ||
+/*
+- with '--bounded-scores': if costs of 'var' exceed 'best' whatever the
+  decrease score is, then set decrease score to its upper bound
+- costs are only a lower bound then and have to be computed exactly
+  before variable may be picked
+- returns 1 if decrease score has been bounded
+*/
+static int
+bound_decrease_score (Nenofex * nenofex, Var * var, const int best)
+{
+  if (!nenofex->options.bounded_scores_specified)
+    return 0;
+
+  /* need 'inc_score - bound > best' */
+  long long int limit = (long long int) var->exp_costs.inc_score - best - 1;
+  if (limit < 0)
+    return 0;
+  if (limit > INT_MAX)
+    limit = INT_MAX;
+
+  unsigned int bound = decrease_score_upper_bound (nenofex, var, limit);
+  if (bound > limit)
+    return 0;
+
+  var->exp_costs.dec_score = bound;
+  return 1;
+}
+
+
+/*
+- determine how many nodes will be deleted if expanding var and propagating literals
+- TODO: REVISION NECESSARY (cases of non-increasing expansions properly captured?)
+*/
+
+#define REVISION 1
+
+static unsigned int
+expansion_decrease_score (Nenofex * nenofex, Var * var,
+                          LCAObject * lca_object, ScoreScratch * scratch)
+{
+  unsigned int dec_score = 0;
+
+  Node *occ;
+  Lit *lit = var->lits;
+  assert (lit->negated);
+
+  Node *contained_lit = lca_children_contain_lit (var, lca_object);
+  assert (!contained_lit || contained_lit->lit->var == var);
+
+  assert (!contained_lit || !is_literal_node (lca_object->lca));
+
+  if (contained_lit || is_literal_node (lca_object->lca))
+    {
+
+#if !REVISION
+      if ((contained_lit && !contained_lit->lit->negated) ||
           (!contained_lit && !lca_object->lca->lit->negated))
         {
           goto TRUTH_PROPAGATION;
@@ -6486,19 +7307,21 @@ expansion_decrease_score (Nenofex * nenofex, Var * var,
     }
 
   /* for all neg. occs: pretend to propagate falsity and count node decrease */
-  for (occ = lit->occ_list.first; occ; occ = occ->occ_link.next)
+  for (occ = lit->occ_list.first; occ;
+       occ = node_at (nenofex, occ->occ_link.next))
     {
-      decrease_score_propagate_truth (nenofex, occ, lca_object);
+      decrease_score_propagate_truth (nenofex, occ, lca_object, scratch);
     }
   lit = var->lits + 1;
   assert (!lit->negated);
   /* similarly for all positve occurrences */
-  for (occ = lit->occ_list.first; occ; occ = occ->occ_link.next)
+  for (occ = lit->occ_list.first; occ;
+       occ = node_at (nenofex, occ->occ_link.next))
     {
-      decrease_score_propagate_falsity (nenofex, occ, lca_object);
+      decrease_score_propagate_falsity (nenofex, occ, lca_object, scratch);
     }
 
-  dec_score += decrease_score_count_deleted (nenofex, var);
+  dec_score += decrease_score_count_deleted (nenofex, var, scratch);
 
   if (contained_lit || is_literal_node (lca_object->lca))
     {
@@ -6533,32 +7356,40 @@ TRUTH_PROPAGATION:
 
 #ifndef NDEBUG
 #if ASSERT_GRAPH_BETWEEN_DEC_SCORE
-  assert_all_child_occ_lists_integrity (nenofex);
-  assert_all_occ_lists_integrity (nenofex);
+  if (!scratch)
+    {                           /* not thread-safe */
+      assert_all_child_occ_lists_integrity (nenofex);
+      assert_all_occ_lists_integrity (nenofex);
+    }
 #endif
 #endif
 
   lit = var->lits;
   /* for all neg. occs: pretend to propagate truth and count node decrease */
-  for (occ = lit->occ_list.first; occ; occ = occ->occ_link.next)
+  for (occ = lit->occ_list.first; occ;
+       occ = node_at (nenofex, occ->occ_link.next))
     {
-      decrease_score_propagate_falsity (nenofex, occ, lca_object);
+      decrease_score_propagate_falsity (nenofex, occ, lca_object, scratch);
     }
   lit = var->lits + 1;
   /* similarly for all positve occurrences */
-  for (occ = lit->occ_list.first; occ; occ = occ->occ_link.next)
+  for (occ = lit->occ_list.first; occ;
+       occ = node_at (nenofex, occ->occ_link.next))
     {
-      decrease_score_propagate_truth (nenofex, occ, lca_object);
+      decrease_score_propagate_truth (nenofex, occ, lca_object, scratch);
     }
 
-  dec_score += decrease_score_count_deleted (nenofex, var);
+  dec_score += decrease_score_count_deleted (nenofex, var, scratch);
 
 FINISHED:
 
 #ifndef NDEBUG
 #if ASSERT_GRAPH_AFTER_DEC_SCORE
-  assert_all_child_occ_lists_integrity (nenofex);
-  assert_all_occ_lists_integrity (nenofex);
+  if (!scratch)
+    {                           /* not thread-safe */
+      assert_all_child_occ_lists_integrity (nenofex);
+      assert_all_occ_lists_integrity (nenofex);
+    }
 #endif
 #endif
 
@@ -6567,68 +7398,104 @@ FINISHED:
 
 
 /* 
-- compute LCA and scores for variable according to marks set
+- compute LCA of variable from scratch
 */
 static void
+init_variable_lca (Nenofex * nenofex, Var * var)
+{
+  assert (lca_update_marked (var));
+  assert (variable_has_occs (var));
+
+  if (var->exp_costs.lca_object.lca)
+    {
+      assert (node_cold (nenofex,
+                         var->exp_costs.lca_object.lca)->var_lca_list.first);
+      assert (node_cold (nenofex,
+                         var->exp_costs.lca_object.lca)->var_lca_list.last);
+
+      unlink_variable_from_lca_list (nenofex, var);
+      reset_lca_object (nenofex, var, &var->exp_costs.lca_object, 1);
+    }
+
+  if (is_universal_scope (var->scope) && nenofex->next_scope &&
+      var->scope == *nenofex->next_scope && nenofex->cur_scope &&
+      is_existential_scope (*nenofex->cur_scope))
+    {
+      find_non_innermost_universal_lca_and_children (nenofex, var);
+    }
+  else
+    {
+      find_variable_lca_and_children (nenofex, var,
+                                      &var->exp_costs.lca_object, 1);
+    }
+
+#ifndef NDEBUG
+#if ASSERT_INIT_VAR_SCORES_ALL_UNMARKED
+  assert_all_lca_children_unmarked (&var->exp_costs.lca_object);
+#endif
+#endif
+}
+
+
+/* 
+- compute LCA and scores for variable according to marks set
+- decrease score may be bounded if costs exceed 'best', see
+  'bound_decrease_score'; pass 'INT_MAX' for exact costs
+- returns 1 if decrease score has been bounded
+*/
+static int
 init_variable_scores (Nenofex * nenofex, Var * var,
-                      const int update_key_priority_queue)
+                      const int update_key_priority_queue, const int best)
 {
+  int bounded = 0;
+
   if (!variable_has_occs (var))
     {
-      return;
+      return bounded;
     }
 
-  int old_score = var->exp_costs.score;
-
   /*assert(variable_has_occs(var)); */
 
   assert (!lca_update_marked (var) ||
           (inc_score_update_marked (var) && dec_score_update_marked (var)));
 
   if (lca_update_marked (var))
-    {
-      if (var->exp_costs.lca_object.lca)
-        {
-          assert (var->exp_costs.lca_object.lca->var_lca_list.first);
-          assert (var->exp_costs.lca_object.lca->var_lca_list.last);
+    init_variable_lca (nenofex, var);
 
-          unlink_variable_from_lca_list (var);
-          reset_lca_object (nenofex, var, &var->exp_costs.lca_object, 1);
-        }
+  if (inc_score_update_marked (var))
+    var->exp_costs.inc_score =
+      expansion_increase_score (nenofex, var, &var->exp_costs.lca_object,
+                                &nenofex->stats.
+                                num_non_inc_expansions_in_scores);
 
-      if (is_universal_scope (var->scope) && nenofex->next_scope &&
-          var->scope == *nenofex->next_scope && nenofex->cur_scope &&
-          is_existential_scope (*nenofex->cur_scope))
-        {
-          find_non_innermost_universal_lca_and_children (nenofex, var);
-        }
-      else
-        {
-          find_variable_lca_and_children (nenofex, var,
-                                          &var->exp_costs.lca_object, 1);
-        }
+  if (dec_score_update_marked (var))
+    {
+      bounded = bound_decrease_score (nenofex, var, best);
+      if (!bounded)
+        var->exp_costs.dec_score =
+          expansion_decrease_score (nenofex, var, &var->exp_costs.lca_object,
+                                    0);
+      else if (stats_basic (nenofex))
+        nenofex->stats.bounded_dec_scores++;
 
 #ifndef NDEBUG
-#if ASSERT_INIT_VAR_SCORES_ALL_UNMARKED
-      assert_all_lca_children_unmarked (&var->exp_costs.lca_object);
+#if ASSERT_DECREASE_SCORE_BOUND
+      if (bounded)
+        assert (expansion_decrease_score (nenofex, var,
+                                          &var->exp_costs.lca_object, 0)
+                <= var->exp_costs.dec_score);
 #endif
 #endif
-    }                           /* end: variable marked for lca update */
-
-  if (inc_score_update_marked (var))
-    var->exp_costs.inc_score =
-      expansion_increase_score (nenofex, var, &var->exp_costs.lca_object);
-
-  if (dec_score_update_marked (var))
-    var->exp_costs.dec_score =
-      expansion_decrease_score (nenofex, var, &var->exp_costs.lca_object);
+    }
 
   if (inc_score_update_marked (var) || dec_score_update_marked (var))
     var->exp_costs.score =
       var->exp_costs.inc_score - var->exp_costs.dec_score;
 
   if (update_key_priority_queue)
-    update_key (var->scope->priority_heap, var, old_score);
+    update_key (var->scope->priority_heap, var);
+
+  return bounded;
 }
 
 
@@ -6650,6 +7517,9 @@ add_lit_node_to_occurrence_list (Nenofex * nenofex, Node * new_occ)
 #endif
 
   Lit *lit = new_occ->lit;
+
+  if (!variable_has_occs (lit->var))
+    count_occ_var (nenofex, lit->var, 1);
   assert (lit);
 
   if (!lit->occ_list.first)
@@ -6662,8 +7532,8 @@ add_lit_node_to_occurrence_list (Nenofex * nenofex, Node * new_occ)
     {                           /* append */
       assert (lit->occ_list.last);
 
-      lit->occ_list.last->occ_link.next = new_occ;
-      new_occ->occ_link.prev = lit->occ_list.last;
+      lit->occ_list.last->occ_link.next = node_ref (nenofex, new_occ);
+      new_occ->occ_link.prev = node_ref (nenofex, lit->occ_list.last);
       lit->occ_list.last = new_occ;
 
       assert (!new_occ->occ_link.next);
@@ -6693,7 +7563,8 @@ add_lit_node_to_child_list (Nenofex * nenofex, Node * parent,
   assert (parent->num_children >= 1);
   assert (is_literal_node (lit_child));
 
-  add_node_to_child_list_before (nenofex, parent->child_list.first,
+  add_node_to_child_list_before (nenofex,
+                                 node_at (nenofex, parent->child_list.first),
                                  lit_child);
 }
 
@@ -6707,6 +7578,8 @@ add_node_to_child_list (Nenofex * nenofex, Node * parent, Node * new_child)
   assert (!new_child->level_link.prev);
   assert (!is_literal_node (parent));
 
+  invalidate_lca_index (nenofex, new_child);
+
   /* introduced convention that literals are stored first in child list */
   if (is_literal_node (new_child) && parent->child_list.first)
     {                           /* parent has at least 1 child */
@@ -6718,20 +7591,22 @@ add_node_to_child_list (Nenofex * nenofex, Node * parent, Node * new_child)
     {                           /* 'new_child' is the first child in list */
       assert (!parent->child_list.last);
 
-      parent->child_list.first = parent->child_list.last = new_child;
-      new_child->parent = parent;
+      parent->child_list.first = parent->child_list.last =
+        node_ref (nenofex, new_child);
+      new_child->parent = node_ref (nenofex, parent);
       new_child->level = parent->level + 1;
       parent->num_children++;
     }
   else
     {                           /* append 'new_child' to list */
       assert (parent->child_list.last);
-      assert (!parent->child_list.last->level_link.next);
+      assert (!node_at (nenofex, parent->child_list.last)->level_link.next);
 
-      parent->child_list.last->level_link.next = new_child;
+      node_at (nenofex, parent->child_list.last)->level_link.next =
+        node_ref (nenofex, new_child);
       new_child->level_link.prev = parent->child_list.last;
-      parent->child_list.last = new_child;
-      new_child->parent = parent;
+      parent->child_list.last = node_ref (nenofex, new_child);
+      new_child->parent = node_ref (nenofex, parent);
       new_child->level = parent->level + 1;
       parent->num_children++;
     }
@@ -6746,7 +7621,7 @@ static void
 add_node_to_child_list_before (Nenofex * nenofex, Node * child,
                                Node * new_child)
 {
-  Node *parent = child->parent;
+  Node *parent = node_at (nenofex, child->parent);
 
   assert (child);
   assert (parent);
@@ -6755,12 +7630,15 @@ add_node_to_child_list_before (Nenofex * nenofex, Node * child,
   assert (!new_child->level_link.prev);
   assert (!is_literal_node (parent));
 
+  invalidate_lca_index (nenofex, new_child);
+
   if (!parent->child_list.first)
     {                           /* 'new_child' is the first child in list */
       assert (!parent->child_list.last);
 
-      parent->child_list.first = parent->child_list.last = new_child;
-      new_child->parent = parent;
+      parent->child_list.first = parent->child_list.last =
+        node_ref (nenofex, new_child);
+      new_child->parent = node_ref (nenofex, parent);
       new_child->level = parent->level + 1;
 
       assert (!new_child->level_link.next);
@@ -6768,26 +7646,27 @@ add_node_to_child_list_before (Nenofex * nenofex, Node * child,
   else
     {                           /* insert 'new_child' to list */
       assert (parent->child_list.last);
-      assert (!parent->child_list.last->level_link.next);
+      assert (!node_at (nenofex, parent->child_list.last)->level_link.next);
 
-      new_child->level_link.next = child;
+      new_child->level_link.next = node_ref (nenofex, child);
       new_child->level_link.prev = child->level_link.prev;
-      child->level_link.prev = new_child;
+      child->level_link.prev = node_ref (nenofex, new_child);
 
       if (new_child->level_link.prev)
         {                       /* standard case */
-          assert (child != parent->child_list.first);
+          assert (child != node_at (nenofex, parent->child_list.first));
 
-          new_child->level_link.prev->level_link.next = new_child;
+          node_at (nenofex, new_child->level_link.prev)->level_link.next =
+            node_ref (nenofex, new_child);
         }
       else
         {                       /* prepending */
-          assert (child == parent->child_list.first);
+          assert (child == node_at (nenofex, parent->child_list.first));
 
-          parent->child_list.first = new_child;
+          parent->child_list.first = node_ref (nenofex, new_child);
         }
 
-      new_child->parent = parent;
+      new_child->parent = node_ref (nenofex, parent);
       new_child->level = parent->level + 1;
     }
   parent->num_children++;
@@ -6819,7 +7698,7 @@ static void
 delete_scope (Nenofex * nenofex, Scope * scope)
 {
   delete_stack (nenofex->mm, scope->vars);
-  delete_priority_queue (nenofex->mm, &scope->priority_heap);
+  delete_pqueue (nenofex->mm, scope->priority_heap);
   mem_free (nenofex->mm, scope, sizeof (Scope));
 }
 
@@ -6833,7 +7712,7 @@ new_scope (Nenofex * nenofex)
   memset (result, 0, bytes);
 
   result->vars = create_stack (nenofex->mm, DEFAULT_STACK_SIZE);
-  create_priority_queue (nenofex->mm, &result->priority_heap, DEFAULT_STACK_SIZE);
+  result->priority_heap = create_pqueue (nenofex->mm, DEFAULT_STACK_SIZE);
 
   return result;
 }
@@ -6862,13 +7741,90 @@ add_default_scope (Nenofex * nenofex)
 
 static int is_unsigned_string (char *str);
 
+/*
+- with '--lazy-scores': scores of variables still marked for update are
+  stale, update them at the top of the priority queue until the minimum
+  is up to date; a variable moves down if its score has increased
+- with '--bounded-scores': same for variables whose decrease score has
+  been bounded, their scores are lower bounds
+*/
+static void
+update_stale_min_cost_vars (Nenofex * nenofex, Scope * scope)
+{
+  if (!nenofex->options.lazy_scores_specified
+      && !nenofex->options.bounded_scores_specified)
+    return;
+
+  Var *var = access_min (scope->priority_heap);
+  if (!var || !cost_update_marked (var))
+    return;
+
+  profile_enter (nenofex, NENOFEX_PHASE_SCORES);
+
+  do
+    {
+      init_variable_scores (nenofex, var, 1, INT_MAX);
+
+      lca_update_unmark (var);
+      inc_score_update_unmark (var);
+      dec_score_update_unmark (var);
+
+      if (nenofex->options.lazy_scores_specified && stats_basic (nenofex))
+        nenofex->stats.lazy_score_updates++;
+    }
+  while ((var = access_min (scope->priority_heap))
+         && cost_update_marked (var));
+
+  profile_leave (nenofex, NENOFEX_PHASE_SCORES);
+}
+
+
+/*
+- with '--lazy-scores': update all stale variables of 'scope'
+- LCAs of non-innermost universal variables are computed from the LCAs of
+  depending existential variables, which must be up to date then
+*/
+static void
+update_all_stale_scope_vars (Nenofex * nenofex, Scope * scope)
+{
+  if (!nenofex->options.lazy_scores_specified)
+    return;
+
+  profile_enter (nenofex, NENOFEX_PHASE_SCORES);
+
+  void **v_var, **end;
+  end = scope->vars->top;
+
+  for (v_var = scope->vars->elems; v_var < end; v_var++)
+    {
+      Var *var = *v_var;
+
+      if (!cost_update_marked (var))
+        continue;
+
+      init_variable_scores (nenofex, var, var->priority_slot != -1, INT_MAX);
+
+      lca_update_unmark (var);
+      inc_score_update_unmark (var);
+      dec_score_update_unmark (var);
+
+      if (stats_basic (nenofex))
+        nenofex->stats.lazy_score_updates++;
+    }
+
+  profile_leave (nenofex, NENOFEX_PHASE_SCORES);
+}
+
+
 static Var *
 find_min_cost_var_in_scope (Nenofex * nenofex, Scope * scope)
 {
   assert (!count_stack (nenofex->vars_marked_for_update));
 
   Var *min_cost_var = 0;
-  Stack *scope_priority_heap = scope->priority_heap;
+  PQueue *scope_priority_heap = scope->priority_heap;
+
+  update_stale_min_cost_vars (nenofex, scope);
 
   while ((min_cost_var = remove_min (scope_priority_heap)))
     {
@@ -6880,7 +7836,7 @@ find_min_cost_var_in_scope (Nenofex * nenofex, Scope * scope)
         }
     }
 
-  nenofex->num_cur_remaining_scope_vars = count_stack (scope_priority_heap);
+  nenofex->num_cur_remaining_scope_vars = count_pqueue (scope_priority_heap);
 
   return min_cost_var;
 }
@@ -6895,7 +7851,9 @@ peek_min_cost_var_in_scope (Nenofex * nenofex, Scope * scope)
   assert (!count_stack (nenofex->vars_marked_for_update));
 
   Var *min_cost_var = 0;
-  Stack *scope_priority_heap = scope->priority_heap;
+  PQueue *scope_priority_heap = scope->priority_heap;
+
+  update_stale_min_cost_vars (nenofex, scope);
 
   while ((min_cost_var = access_min (scope_priority_heap)))
     {
@@ -6927,21 +7885,23 @@ assert_all_subformula_sizes (Nenofex * nenofex)
       if (is_literal_node (cur))
         {
           assert (cur->size_subformula == 1);
-          cur->test_size_subformula = 1;
+          alloc_node_cold (nenofex, cur)->test_size_subformula = 1;
         }
       else
         {
           if (size_subformula_marked (cur))
             {
+              NodeCold *cold = alloc_node_cold (nenofex, cur);
               size_subformula_unmark (cur);
-              cur->test_size_subformula = 1;
+              cold->test_size_subformula = 1;
 
               Node *child;
-              for (child = cur->child_list.first; child;
-                   child = child->level_link.next)
-                cur->test_size_subformula += child->test_size_subformula;
+              for (child = node_at (nenofex, cur->child_list.first); child;
+                   child = node_at (nenofex, child->level_link.next))
+                cold->test_size_subformula +=
+                  node_cold (nenofex, child)->test_size_subformula;
 
-              assert (cur->test_size_subformula == cur->size_subformula);
+              assert (cold->test_size_subformula == cur->size_subformula);
             }
           else                  /* recalculate sizes of children first */
             {
@@ -6949,8 +7909,8 @@ assert_all_subformula_sizes (Nenofex * nenofex)
               push_stack (nenofex->mm, stack, cur);
 
               Node *child;
-              for (child = cur->child_list.last; child;
-                   child = child->level_link.prev)
+              for (child = node_at (nenofex, cur->child_list.last); child;
+                   child = node_at (nenofex, child->level_link.prev))
                 push_stack (nenofex->mm, stack, child);
             }
         }                       /* end: op-node */
@@ -6962,12 +7922,13 @@ assert_all_subformula_sizes (Nenofex * nenofex)
 #endif /* end ifndef NDEBUG */
 
 
+#ifndef NDEBUG
 /* 
 - checks if there are any universally quantified variables left
-- TODO: refinements
+- full scan for checking scope counters
 */
 static int
-is_formula_existential (Nenofex * nenofex)
+is_formula_existential_full_scan (Nenofex * nenofex)
 {
   int result = 1;
 
@@ -7001,10 +7962,10 @@ is_formula_existential (Nenofex * nenofex)
 
 /* 
 - checks if there are any existentially quantified variables left
-- TODO: refinements
+- full scan for checking scope counters
 */
 static int
-is_formula_universal (Nenofex * nenofex)
+is_formula_universal_full_scan (Nenofex * nenofex)
 {
   int result = 1;
 
@@ -7034,6 +7995,31 @@ is_formula_universal (Nenofex * nenofex)
 
   return result;
 }
+#endif /* end ifndef NDEBUG */
+
+
+/* 
+- checks if there are any universally quantified variables left
+*/
+static int
+is_formula_existential (Nenofex * nenofex)
+{
+  int result = (nenofex->univ_occ_var_cnt == 0);
+  assert (result == is_formula_existential_full_scan (nenofex));
+  return result;
+}
+
+
+/* 
+- checks if there are any existentially quantified variables left
+*/
+static int
+is_formula_universal (Nenofex * nenofex)
+{
+  int result = (nenofex->exist_occ_var_cnt == 0);
+  assert (result == is_formula_universal_full_scan (nenofex));
+  return result;
+}
 
 
 /* 
@@ -7053,7 +8039,8 @@ reset_all_node_ids (Nenofex * nenofex)
       if (!is_literal_node (cur))
         {
           Node *ch;
-          for (ch = cur->child_list.last; ch; ch = ch->level_link.prev)
+          for (ch = node_at (nenofex, cur->child_list.last); ch;
+               ch = node_at (nenofex, ch->level_link.prev))
             push_stack (nenofex->mm, stack, ch);
         }
     }
@@ -7064,13 +8051,13 @@ reset_all_node_ids (Nenofex * nenofex)
 
 /* NNF-TO-CNF CONVERSION */
 
-/* ------- START: STANDARD TSEITIN TRANSFORMATION ------- */
-
+/*
+- variables get IDs 1..n in order of scopes, operator nodes get IDs 
+  starting from 'tseitin_first_op_node_id'
+*/
 static void
-nnf_to_cnf_standard_tseitin_assign_node_ids (Nenofex * nenofex)
+nnf_to_cnf_tseitin_assign_var_ids (Nenofex * nenofex)
 {
-  reset_all_node_ids (nenofex);
-
   nenofex->tseitin_next_id = 1;
 
   void **v_scope, **scope_end;
@@ -7092,6 +8079,49 @@ nnf_to_cnf_standard_tseitin_assign_node_ids (Nenofex * nenofex)
     }                           /* end: for all scopes */
 
   nenofex->tseitin_first_op_node_id = nenofex->tseitin_next_id;
+}
+
+
+/*
+- for streaming encoders which do not store IDs at literal nodes
+- operator nodes must have been assigned an ID before
+*/
+static int
+tseitin_node_id (Nenofex * nenofex, Node * node)
+{
+  if (is_literal_node (node))
+    {
+      Lit *lit = node->lit;
+      assert (lit->var->id > 0);
+      assert (lit->var->id < nenofex->tseitin_first_op_node_id);
+      return lit->negated ? -lit->var->id : lit->var->id;
+    }
+
+  assert (node->id >= nenofex->tseitin_first_op_node_id);
+  assert (node->id < nenofex->tseitin_next_id);
+  return node->id;
+}
+
+
+/*
+- assigns next ID to operator node and schedules it for encoding
+*/
+static void
+tseitin_push_op_node (Nenofex * nenofex, Stack * stack, Node * node)
+{
+  assert (!is_literal_node (node));
+  node->id = nenofex->tseitin_next_id++;
+  push_stack (nenofex->mm, stack, node);
+}
+
+/* ------- START: STANDARD TSEITIN TRANSFORMATION ------- */
+
+static void
+nnf_to_cnf_standard_tseitin_assign_node_ids (Nenofex * nenofex)
+{
+  reset_all_node_ids (nenofex);
+
+  nnf_to_cnf_tseitin_assign_var_ids (nenofex);
 
   /* traverse graph and assign IDs */
 
@@ -7113,8 +8143,8 @@ nnf_to_cnf_standard_tseitin_assign_node_ids (Nenofex * nenofex)
           cur->id = nenofex->tseitin_next_id++;
 
           Node *child;
-          for (child = cur->child_list.last; child;
-               child = child->level_link.prev)
+          for (child = node_at (nenofex, cur->child_list.last); child;
+               child = node_at (nenofex, child->level_link.prev))
             push_stack (nenofex->mm, stack, child);
         }
     }                           /* end: while stack not empty */
@@ -7150,8 +8180,8 @@ nnf_to_cnf_standard_tseitin_count_clauses (Nenofex * nenofex, int qnnf)
           clause_cnt += cur->num_children + 1;
 
           Node *child;
-          for (child = cur->child_list.last; child;
-               child = child->level_link.prev)
+          for (child = node_at (nenofex, cur->child_list.last); child;
+               child = node_at (nenofex, child->level_link.prev))
             push_stack (nenofex->mm, stack, child);
         }
     }                           /* end: while stack not empty */
@@ -7252,15 +8282,15 @@ nnf_to_cnf_standard_tseitin_dump (Nenofex * nenofex, FILE * out, int qnnf)
           assert (cur->id > 0);
 
           Node *child;
-          for (child = cur->child_list.first; child;
-               child = child->level_link.next)
+          for (child = node_at (nenofex, cur->child_list.first); child;
+               child = node_at (nenofex, child->level_link.next))
             {
               assert (child->id);
               fprintf (out, "%d %d 0\n", -cur->id, child->id);
             }
 
-          for (child = cur->child_list.first; child;
-               child = child->level_link.next)
+          for (child = node_at (nenofex, cur->child_list.first); child;
+               child = node_at (nenofex, child->level_link.next))
             {
               assert (child->id);
               fprintf (out, "%d ", -child->id);
@@ -7268,8 +8298,8 @@ nnf_to_cnf_standard_tseitin_dump (Nenofex * nenofex, FILE * out, int qnnf)
           fprintf (out, "%d 0\n", cur->id);
 
           /* TODO: pushing children could be done in loop before */
-          for (child = cur->child_list.last; child;
-               child = child->level_link.prev)
+          for (child = node_at (nenofex, cur->child_list.last); child;
+               child = node_at (nenofex, child->level_link.prev))
             push_stack (nenofex->mm, stack, child);
         }
       else if (is_or_node (cur))
@@ -7278,24 +8308,24 @@ nnf_to_cnf_standard_tseitin_dump (Nenofex * nenofex, FILE * out, int qnnf)
 
           Node *child;
           fprintf (out, "%d ", -cur->id);
-          for (child = cur->child_list.first; child;
-               child = child->level_link.next)
+          for (child = node_at (nenofex, cur->child_list.first); child;
+               child = node_at (nenofex, child->level_link.next))
             {
               assert (child->id);
               fprintf (out, "%d ", child->id);
             }
           fprintf (out, "0\n");
 
-          for (child = cur->child_list.first; child;
-               child = child->level_link.next)
+          for (child = node_at (nenofex, cur->child_list.first); child;
+               child = node_at (nenofex, child->level_link.next))
             {
               assert (child->id);
               fprintf (out, "%d %d 0\n", cur->id, -child->id);
             }
 
           /* TODO: pushing children could be done in loop before */
-          for (child = cur->child_list.last; child;
-               child = child->level_link.prev)
+          for (child = node_at (nenofex, cur->child_list.last); child;
+               child = node_at (nenofex, child->level_link.prev))
             push_stack (nenofex->mm, stack, child);
         }
     }                           /* end: while stack not empty */
@@ -7305,10 +8335,13 @@ nnf_to_cnf_standard_tseitin_dump (Nenofex * nenofex, FILE * out, int qnnf)
 
 
 /* 
-- assumes that IDs have been assigned to nodes
-- same code like in dumping but CNF is forwarded to internal SAT solver
+- streaming encoder: operator nodes get IDs when they are scheduled, 
+  their clauses are forwarded to internal SAT solver as soon as they 
+  are visited, i.e. graph is traversed only once
+- variables must have been assigned IDs before
+- returns number of forwarded clauses
 */
-static void
+static int
 nnf_to_cnf_standard_tseitin_forward (Nenofex * nenofex)
 {
   assert (nenofex->graph_root);
@@ -7323,79 +8356,73 @@ nnf_to_cnf_standard_tseitin_forward (Nenofex * nenofex)
   assert (!nenofex->sat_solver_tautology_mode
           || is_formula_universal (nenofex));
 
-  assert (nenofex->graph_root->id);
+  int clause_cnt = 1;           /* output at root */
+
+  Stack *stack = create_stack (nenofex->mm, DEFAULT_STACK_SIZE);
+
+  if (!is_literal_node (nenofex->graph_root))
+    tseitin_push_op_node (nenofex, stack, nenofex->graph_root);
 
-  int output = nenofex->sat_solver_tautology_mode ?
-    -nenofex->graph_root->id : nenofex->graph_root->id;
+  int root_id = tseitin_node_id (nenofex, nenofex->graph_root);
+  int output = nenofex->sat_solver_tautology_mode ? -root_id : root_id;
   sat_solver_add (nenofex, output);
   sat_solver_add (nenofex, 0);
 
-  Stack *stack = create_stack (nenofex->mm, DEFAULT_STACK_SIZE);
-  push_stack (nenofex->mm, stack, nenofex->graph_root);
-
   Node *cur;
   while ((cur = pop_stack (stack)))
     {
-      if (is_and_node (cur))
+      assert (!is_literal_node (cur));
+      int cur_id = tseitin_node_id (nenofex, cur);
+
+      Node *child;
+      for (child = node_at (nenofex, cur->child_list.last); child;
+           child = node_at (nenofex, child->level_link.prev))
         {
-          assert (cur->id > 0);
+          if (!is_literal_node (child))
+            tseitin_push_op_node (nenofex, stack, child);
+        }
 
-          Node *child;
-          for (child = cur->child_list.first; child;
-               child = child->level_link.next)
+      clause_cnt += cur->num_children + 1;
+
+      if (is_and_node (cur))
+        {
+          for (child = node_at (nenofex, cur->child_list.first); child;
+               child = node_at (nenofex, child->level_link.next))
             {
-              assert (child->id);
-              sat_solver_add (nenofex, -cur->id);
-              sat_solver_add (nenofex, child->id);
+              sat_solver_add (nenofex, -cur_id);
+              sat_solver_add (nenofex, tseitin_node_id (nenofex, child));
               sat_solver_add (nenofex, 0);
             }
 
-          for (child = cur->child_list.first; child;
-               child = child->level_link.next)
-            {
-              assert (child->id);
-              sat_solver_add (nenofex, -child->id);
-            }
-          sat_solver_add (nenofex, cur->id);
+          for (child = node_at (nenofex, cur->child_list.first); child;
+               child = node_at (nenofex, child->level_link.next))
+            sat_solver_add (nenofex, -tseitin_node_id (nenofex, child));
+          sat_solver_add (nenofex, cur_id);
           sat_solver_add (nenofex, 0);
-
-          /* TODO: pushing children could be done in loop before */
-          for (child = cur->child_list.last; child;
-               child = child->level_link.prev)
-            push_stack (nenofex->mm, stack, child);
         }
-      else if (is_or_node (cur))
+      else
         {
-          assert (cur->id > 0);
+          assert (is_or_node (cur));
 
-          Node *child;
-          sat_solver_add (nenofex, -cur->id);
-          for (child = cur->child_list.first; child;
-               child = child->level_link.next)
-            {
-              assert (child->id);
-              sat_solver_add (nenofex, child->id);
-            }
+          sat_solver_add (nenofex, -cur_id);
+          for (child = node_at (nenofex, cur->child_list.first); child;
+               child = node_at (nenofex, child->level_link.next))
+            sat_solver_add (nenofex, tseitin_node_id (nenofex, child));
           sat_solver_add (nenofex, 0);
 
-          for (child = cur->child_list.first; child;
-               child = child->level_link.next)
+          for (child = node_at (nenofex, cur->child_list.first); child;
+               child = node_at (nenofex, child->level_link.next))
             {
-              assert (child->id);
-
-              sat_solver_add (nenofex, cur->id);
-              sat_solver_add (nenofex, -child->id);
+              sat_solver_add (nenofex, cur_id);
+              sat_solver_add (nenofex, -tseitin_node_id (nenofex, child));
               sat_solver_add (nenofex, 0);
             }
-
-          /* TODO: pushing children could be done in loop before */
-          for (child = cur->child_list.last; child;
-               child = child->level_link.prev)
-            push_stack (nenofex->mm, stack, child);
         }
     }                           /* end: while stack not empty */
 
   delete_stack (nenofex->mm, stack);
+
+  return clause_cnt;
 }
 
 /* ------- END: STANDARD TSEITIN TRANSFORMATION ------- */
@@ -7408,27 +8435,7 @@ nnf_to_cnf_tseitin_revised_assign_node_ids (Nenofex * nenofex)
 {
   reset_all_node_ids (nenofex);
 
-  nenofex->tseitin_next_id = 1;
-
-  void **v_scope, **scope_end;
-  scope_end = nenofex->scopes->top;
-  for (v_scope = nenofex->scopes->elems; v_scope < scope_end; v_scope++)
-    {
-      Scope *scope = *v_scope;
-      void **v_var, **var_end;
-      var_end = scope->vars->top;
-      for (v_var = scope->vars->elems; v_var < var_end; v_var++)
-        {
-          Var *var = *v_var;
-          if (variable_has_occs (var))
-            {
-              assert (!var->eliminated);
-              var->id = nenofex->tseitin_next_id++;
-            }
-        }                       /* end: for all vars in scope */
-    }                           /* end: for all scopes */
-
-  nenofex->tseitin_first_op_node_id = nenofex->tseitin_next_id;
+  nnf_to_cnf_tseitin_assign_var_ids (nenofex);
 
   /* traverse graph and assign IDs */
 
@@ -7446,8 +8453,8 @@ nnf_to_cnf_tseitin_revised_assign_node_ids (Nenofex * nenofex)
       if (nenofex->sat_solver_tautology_mode)
         {
           Node *child;
-          for (child = nenofex->graph_root->child_list.last;
-               child; child = child->level_link.prev)
+          for (child = node_at (nenofex, nenofex->graph_root->child_list.last);
+               child; child = node_at (nenofex, child->level_link.prev))
             {
               assert (!is_and_node (child));
               if (!is_literal_node (child))
@@ -7464,15 +8471,16 @@ nnf_to_cnf_tseitin_revised_assign_node_ids (Nenofex * nenofex)
       else                      /* sat-mode */
         {
           Node *child;
-          for (child = nenofex->graph_root->child_list.last;
-               child; child = child->level_link.prev)
+          for (child = node_at (nenofex, nenofex->graph_root->child_list.last);
+               child; child = node_at (nenofex, child->level_link.prev))
             {
               if (!is_literal_node (child))
                 {
                   Node *child_child;
-                  for (child_child = child->child_list.last;
+                  for (child_child = node_at (nenofex, child->child_list.last);
                        child_child;
-                       child_child = child_child->level_link.prev)
+                       child_child =
+                         node_at (nenofex, child_child->level_link.prev))
                     {
                       if (!is_literal_node (child_child))
                         {
@@ -7504,8 +8512,8 @@ nnf_to_cnf_tseitin_revised_assign_node_ids (Nenofex * nenofex)
       if (!nenofex->sat_solver_tautology_mode)
         {
           Node *child;
-          for (child = nenofex->graph_root->child_list.last;
-               child; child = child->level_link.prev)
+          for (child = node_at (nenofex, nenofex->graph_root->child_list.last);
+               child; child = node_at (nenofex, child->level_link.prev))
             {
               assert (!is_or_node (child));
               if (!is_literal_node (child))
@@ -7522,15 +8530,16 @@ nnf_to_cnf_tseitin_revised_assign_node_ids (Nenofex * nenofex)
       else                      /* sat mode */
         {
           Node *child;
-          for (child = nenofex->graph_root->child_list.last;
-               child; child = child->level_link.prev)
+          for (child = node_at (nenofex, nenofex->graph_root->child_list.last);
+               child; child = node_at (nenofex, child->level_link.prev))
             {
               if (!is_literal_node (child))
                 {
                   Node *child_child;
-                  for (child_child = child->child_list.last;
+                  for (child_child = node_at (nenofex, child->child_list.last);
                        child_child;
-                       child_child = child_child->level_link.prev)
+                       child_child =
+                         node_at (nenofex, child_child->level_link.prev))
                     {
                       if (!is_literal_node (child_child))
                         {
@@ -7570,14 +8579,16 @@ nnf_to_cnf_tseitin_revised_assign_node_ids (Nenofex * nenofex)
       cur->id = nenofex->tseitin_next_id++;
 
       Node *child;
-      for (child = cur->child_list.last; child;
-           child = child->level_link.prev)
+      for (child = node_at (nenofex, cur->child_list.last); child;
+           child = node_at (nenofex, child->level_link.prev))
         {
           if (!is_literal_node (child))
             {
               Node *child_child;
-              for (child_child = child->child_list.last;
-                   child_child; child_child = child_child->level_link.prev)
+              for (child_child = node_at (nenofex, child->child_list.last);
+                   child_child;
+                     child_child =
+                     node_at (nenofex, child_child->level_link.prev))
                 {
                   if (!is_literal_node (child_child))
                     {
@@ -7645,8 +8656,8 @@ nnf_to_cnf_tseitin_revised_count_clauses (Nenofex * nenofex)
         {
           clause_cnt++;         /* one clause for top AND */
           Node *child;
-          for (child = nenofex->graph_root->child_list.last;
-               child; child = child->level_link.prev)
+          for (child = node_at (nenofex, nenofex->graph_root->child_list.last);
+               child; child = node_at (nenofex, child->level_link.prev))
             {
               assert (!is_and_node (child));
               if (!is_literal_node (child))
@@ -7662,8 +8673,8 @@ nnf_to_cnf_tseitin_revised_count_clauses (Nenofex * nenofex)
         {
           clause_cnt++;         /* one clause for top-OR */
           Node *child;
-          for (child = nenofex->graph_root->child_list.last;
-               child; child = child->level_link.prev)
+          for (child = node_at (nenofex, nenofex->graph_root->child_list.last);
+               child; child = node_at (nenofex, child->level_link.prev))
             {
               assert (!is_or_node (child));
               if (!is_literal_node (child))
@@ -7686,14 +8697,16 @@ nnf_to_cnf_tseitin_revised_count_clauses (Nenofex * nenofex)
       clause_cnt += cur->num_children;
 
       Node *child;
-      for (child = cur->child_list.last; child;
-           child = child->level_link.prev)
+      for (child = node_at (nenofex, cur->child_list.last); child;
+           child = node_at (nenofex, child->level_link.prev))
         {
           if (!is_literal_node (child))
             {
               Node *child_child;
-              for (child_child = child->child_list.last;
-                   child_child; child_child = child_child->level_link.prev)
+              for (child_child = node_at (nenofex, child->child_list.last);
+                   child_child;
+                     child_child =
+                     node_at (nenofex, child_child->level_link.prev))
                 {
                   if (!is_literal_node (child_child))
                     {
@@ -7736,8 +8749,8 @@ nnf_to_cnf_tseitin_revised_top_truth_dump (Nenofex * nenofex, FILE * out)
   if (is_and_node (nenofex->graph_root))
     {
       Node *child;
-      for (child = nenofex->graph_root->child_list.last;
-           child; child = child->level_link.prev)
+      for (child = node_at (nenofex, nenofex->graph_root->child_list.last);
+           child; child = node_at (nenofex, child->level_link.prev))
         {                       /* each 'child' generates a clause where child's children make up set of literals */
           if (is_literal_node (child))
             {
@@ -7747,8 +8760,10 @@ nnf_to_cnf_tseitin_revised_top_truth_dump (Nenofex * nenofex, FILE * out)
           else                  /* OR */
             {
               Node *child_child;
-              for (child_child = child->child_list.last;
-                   child_child; child_child = child_child->level_link.prev)
+              for (child_child = node_at (nenofex, child->child_list.last);
+                   child_child;
+                     child_child =
+                     node_at (nenofex, child_child->level_link.prev))
                 {
                   assert (child_child->id);
                   fprintf (out, "%d ", child_child->id);
@@ -7762,8 +8777,8 @@ nnf_to_cnf_tseitin_revised_top_truth_dump (Nenofex * nenofex, FILE * out)
   else                          /* root is OR */
     {
       Node *child;
-      for (child = nenofex->graph_root->child_list.last;
-           child; child = child->level_link.prev)
+      for (child = node_at (nenofex, nenofex->graph_root->child_list.last);
+           child; child = node_at (nenofex, child->level_link.prev))
         {
           assert (child->id);
           fprintf (out, "%d ", child->id);      /* print top-or constraint */
@@ -7781,8 +8796,8 @@ nnf_to_cnf_tseitin_revised_top_truth_dump (Nenofex * nenofex, FILE * out)
       assert (cur->id);
 
       Node *child;
-      for (child = cur->child_list.last; child;
-           child = child->level_link.prev)
+      for (child = node_at (nenofex, cur->child_list.last); child;
+           child = node_at (nenofex, child->level_link.prev))
         {                       /* each 'child' generates a clause where child's children make up set of literals */
           fprintf (out, "%d ", -cur->id);
           if (is_literal_node (child))
@@ -7793,8 +8808,10 @@ nnf_to_cnf_tseitin_revised_top_truth_dump (Nenofex * nenofex, FILE * out)
           else                  /* OR */
             {
               Node *child_child;
-              for (child_child = child->child_list.last;
-                   child_child; child_child = child_child->level_link.prev)
+              for (child_child = node_at (nenofex, child->child_list.last);
+                   child_child;
+                     child_child =
+                     node_at (nenofex, child_child->level_link.prev))
                 {
                   assert (child_child->id);
                   fprintf (out, "%d ", child_child->id);
@@ -7812,9 +8829,13 @@ nnf_to_cnf_tseitin_revised_top_truth_dump (Nenofex * nenofex, FILE * out)
 
 
 /*
-- same code as in dumping but now forward to internal sat solver
+- sat mode
+- streaming version of the dump: nodes which are encoded by a 
+  tseitin variable get IDs when they are scheduled
+- variables must have been assigned IDs before
+- returns number of forwarded clauses
 */
-static void
+static int
 nnf_to_cnf_tseitin_revised_top_truth_forward (Nenofex * nenofex)
 {
   assert (nenofex->graph_root);
@@ -7823,52 +8844,53 @@ nnf_to_cnf_tseitin_revised_top_truth_forward (Nenofex * nenofex)
 
   if (is_literal_node (nenofex->graph_root))
     {
-      assert (nenofex->graph_root->id);
-      sat_solver_add (nenofex, nenofex->graph_root->id);
+      sat_solver_add (nenofex,
+                      tseitin_node_id (nenofex, nenofex->graph_root));
       sat_solver_add (nenofex, 0);
-      return;
+      return 1;
     }
 
+  int clause_cnt = 0;
+
   Stack *stack = create_stack (nenofex->mm, DEFAULT_STACK_SIZE);
 
   if (is_and_node (nenofex->graph_root))
     {
       Node *child;
-      for (child = nenofex->graph_root->child_list.last;
-           child; child = child->level_link.prev)
+      for (child = node_at (nenofex, nenofex->graph_root->child_list.last);
+           child; child = node_at (nenofex, child->level_link.prev))
         {                       /* each 'child' generates a clause where child's children make up set of literals */
+          clause_cnt++;
           if (is_literal_node (child))
-            {
-              assert (child->id);
-              sat_solver_add (nenofex, child->id);
-              sat_solver_add (nenofex, 0);
-            }
+            sat_solver_add (nenofex, tseitin_node_id (nenofex, child));
           else                  /* OR */
             {
               Node *child_child;
-              for (child_child = child->child_list.last;
-                   child_child; child_child = child_child->level_link.prev)
+              for (child_child = node_at (nenofex, child->child_list.last);
+                   child_child;
+                     child_child =
+                     node_at (nenofex, child_child->level_link.prev))
                 {
-                  assert (child_child->id);
-                  sat_solver_add (nenofex, child_child->id);
                   if (!is_literal_node (child_child))
-                    push_stack (nenofex->mm, stack, child_child);
+                    tseitin_push_op_node (nenofex, stack, child_child);
+                  sat_solver_add (nenofex,
+                                  tseitin_node_id (nenofex, child_child));
                 }               /* end: for all child's children */
-              sat_solver_add (nenofex, 0);
             }
+          sat_solver_add (nenofex, 0);
         }                       /* end: for AND's children */
     }
   else                          /* root is OR */
     {
+      clause_cnt++;
       Node *child;
-      for (child = nenofex->graph_root->child_list.last;
-           child; child = child->level_link.prev)
+      for (child = node_at (nenofex, nenofex->graph_root->child_list.last);
+           child; child = node_at (nenofex, child->level_link.prev))
         {
-          assert (child->id);
-          sat_solver_add (nenofex, child->id);
           assert (!is_or_node (child));
           if (!is_literal_node (child))
-            push_stack (nenofex->mm, stack, child);
+            tseitin_push_op_node (nenofex, stack, child);
+          sat_solver_add (nenofex, tseitin_node_id (nenofex, child));
         }
       sat_solver_add (nenofex, 0);
     }
@@ -7877,37 +8899,39 @@ nnf_to_cnf_tseitin_revised_top_truth_forward (Nenofex * nenofex)
   while ((cur = pop_stack (stack)))
     {
       assert (is_and_node (cur));
-      assert (cur->id);
+      int cur_id = tseitin_node_id (nenofex, cur);
+
+      clause_cnt += cur->num_children;
 
       Node *child;
-      for (child = cur->child_list.last; child;
-           child = child->level_link.prev)
+      for (child = node_at (nenofex, cur->child_list.last); child;
+           child = node_at (nenofex, child->level_link.prev))
         {                       /* each 'child' generates a clause where child's children make up set of literals */
-          sat_solver_add (nenofex, -cur->id);
+          sat_solver_add (nenofex, -cur_id);
           if (is_literal_node (child))
-            {
-              assert (child->id);
-              sat_solver_add (nenofex, child->id);
-              sat_solver_add (nenofex, 0);
-            }
+            sat_solver_add (nenofex, tseitin_node_id (nenofex, child));
           else                  /* OR */
             {
               Node *child_child;
-              for (child_child = child->child_list.last;
-                   child_child; child_child = child_child->level_link.prev)
+              for (child_child = node_at (nenofex, child->child_list.last);
+                   child_child;
+                     child_child =
+                     node_at (nenofex, child_child->level_link.prev))
                 {
-                  assert (child_child->id);
-                  sat_solver_add (nenofex, child_child->id);
                   if (!is_literal_node (child_child))
-                    push_stack (nenofex->mm, stack, child_child);
+                    tseitin_push_op_node (nenofex, stack, child_child);
+                  sat_solver_add (nenofex,
+                                  tseitin_node_id (nenofex, child_child));
                 }               /* end: for all child's children */
-              sat_solver_add (nenofex, 0);
             }
+          sat_solver_add (nenofex, 0);
         }                       /* end: for AND's children */
 
     }                           /* end: while stack not empty */
 
   delete_stack (nenofex->mm, stack);
+
+  return clause_cnt;
 }
 
 
@@ -7936,8 +8960,8 @@ nnf_to_cnf_tseitin_revised_top_falsity_dump (Nenofex * nenofex, FILE * out)
   if (is_or_node (nenofex->graph_root))
     {
       Node *child;
-      for (child = nenofex->graph_root->child_list.last;
-           child; child = child->level_link.prev)
+      for (child = node_at (nenofex, nenofex->graph_root->child_list.last);
+           child; child = node_at (nenofex, child->level_link.prev))
         {                       /* each 'child' generates a clause where child's children make up set of literals */
           if (is_literal_node (child))
             {
@@ -7947,8 +8971,10 @@ nnf_to_cnf_tseitin_revised_top_falsity_dump (Nenofex * nenofex, FILE * out)
           else                  /* AND */
             {
               Node *child_child;
-              for (child_child = child->child_list.last;
-                   child_child; child_child = child_child->level_link.prev)
+              for (child_child = node_at (nenofex, child->child_list.last);
+                   child_child;
+                     child_child =
+                     node_at (nenofex, child_child->level_link.prev))
                 {
                   assert (child_child->id);
                   fprintf (out, "%d ", -child_child->id);
@@ -7962,8 +8988,8 @@ nnf_to_cnf_tseitin_revised_top_falsity_dump (Nenofex * nenofex, FILE * out)
   else                          /* root is AND */
     {
       Node *child;
-      for (child = nenofex->graph_root->child_list.last;
-           child; child = child->level_link.prev)
+      for (child = node_at (nenofex, nenofex->graph_root->child_list.last);
+           child; child = node_at (nenofex, child->level_link.prev))
         {
           assert (child->id);
           fprintf (out, "%d ", -child->id);     /* print top-and constraint */
@@ -7981,8 +9007,8 @@ nnf_to_cnf_tseitin_revised_top_falsity_dump (Nenofex * nenofex, FILE * out)
       assert (cur->id);
 
       Node *child;
-      for (child = cur->child_list.last; child;
-           child = child->level_link.prev)
+      for (child = node_at (nenofex, cur->child_list.last); child;
+           child = node_at (nenofex, child->level_link.prev))
         {                       /* each 'child' generates a clause where child's children make up set of literals */
           fprintf (out, "%d ", cur->id);
           if (is_literal_node (child))
@@ -7993,8 +9019,10 @@ nnf_to_cnf_tseitin_revised_top_falsity_dump (Nenofex * nenofex, FILE * out)
           else                  /* AND */
             {
               Node *child_child;
-              for (child_child = child->child_list.last;
-                   child_child; child_child = child_child->level_link.prev)
+              for (child_child = node_at (nenofex, child->child_list.last);
+                   child_child;
+                     child_child =
+                     node_at (nenofex, child_child->level_link.prev))
                 {
                   assert (child_child->id);
                   fprintf (out, "%d ", -child_child->id);
@@ -8012,9 +9040,13 @@ nnf_to_cnf_tseitin_revised_top_falsity_dump (Nenofex * nenofex, FILE * out)
 
 
 /*
-- same code as in dumping but now forward to internal sat solver
+- tautology mode
+- streaming version of the dump: nodes which are encoded by a 
+  tseitin variable get IDs when they are scheduled
+- variables must have been assigned IDs before
+- returns number of forwarded clauses
 */
-static void
+static int
 nnf_to_cnf_tseitin_revised_top_falsity_forward (Nenofex * nenofex)
 {
   assert (nenofex->graph_root);
@@ -8023,52 +9055,53 @@ nnf_to_cnf_tseitin_revised_top_falsity_forward (Nenofex * nenofex)
 
   if (is_literal_node (nenofex->graph_root))
     {
-      assert (nenofex->graph_root->id);
-      sat_solver_add (nenofex, -nenofex->graph_root->id);
+      sat_solver_add (nenofex,
+                      -tseitin_node_id (nenofex, nenofex->graph_root));
       sat_solver_add (nenofex, 0);
-      return;
+      return 1;
     }
 
+  int clause_cnt = 0;
+
   Stack *stack = create_stack (nenofex->mm, DEFAULT_STACK_SIZE);
 
   if (is_or_node (nenofex->graph_root))
     {
       Node *child;
-      for (child = nenofex->graph_root->child_list.last; child;
-           child = child->level_link.prev)
+      for (child = node_at (nenofex, nenofex->graph_root->child_list.last);
+           child; child = node_at (nenofex, child->level_link.prev))
         {                       /* each 'child' generates a clause where child's children make up set of literals */
+          clause_cnt++;
           if (is_literal_node (child))
-            {
-              assert (child->id);
-              sat_solver_add (nenofex, -child->id);
-              sat_solver_add (nenofex, 0);
-            }
+            sat_solver_add (nenofex, -tseitin_node_id (nenofex, child));
           else                  /* AND */
             {
               Node *child_child;
-              for (child_child = child->child_list.last;
-                   child_child; child_child = child_child->level_link.prev)
+              for (child_child = node_at (nenofex, child->child_list.last);
+                   child_child;
+                     child_child =
+                     node_at (nenofex, child_child->level_link.prev))
                 {
-                  assert (child_child->id);
-                  sat_solver_add (nenofex, -child_child->id);
                   if (!is_literal_node (child_child))
-                    push_stack (nenofex->mm, stack, child_child);
+                    tseitin_push_op_node (nenofex, stack, child_child);
+                  sat_solver_add (nenofex,
+                                  -tseitin_node_id (nenofex, child_child));
                 }               /* end: for all child's children */
-              sat_solver_add (nenofex, 0);
             }
-        }                       /* end: for AND's children */
+          sat_solver_add (nenofex, 0);
+        }                       /* end: for OR's children */
     }
   else                          /* root is AND */
     {
+      clause_cnt++;
       Node *child;
-      for (child = nenofex->graph_root->child_list.last;
-           child; child = child->level_link.prev)
+      for (child = node_at (nenofex, nenofex->graph_root->child_list.last);
+           child; child = node_at (nenofex, child->level_link.prev))
         {
-          assert (child->id);
-          sat_solver_add (nenofex, -child->id);
           assert (!is_and_node (child));
           if (!is_literal_node (child))
-            push_stack (nenofex->mm, stack, child);
+            tseitin_push_op_node (nenofex, stack, child);
+          sat_solver_add (nenofex, -tseitin_node_id (nenofex, child));
         }
       sat_solver_add (nenofex, 0);
     }
@@ -8077,37 +9110,39 @@ nnf_to_cnf_tseitin_revised_top_falsity_forward (Nenofex * nenofex)
   while ((cur = pop_stack (stack)))
     {
       assert (is_or_node (cur));
-      assert (cur->id);
+      int cur_id = tseitin_node_id (nenofex, cur);
+
+      clause_cnt += cur->num_children;
 
       Node *child;
-      for (child = cur->child_list.last; child;
-           child = child->level_link.prev)
+      for (child = node_at (nenofex, cur->child_list.last); child;
+           child = node_at (nenofex, child->level_link.prev))
         {                       /* each 'child' generates a clause where child's children make up set of literals */
-          sat_solver_add (nenofex, cur->id);
+          sat_solver_add (nenofex, cur_id);
           if (is_literal_node (child))
-            {
-              assert (child->id);
-              sat_solver_add (nenofex, -child->id);
-              sat_solver_add (nenofex, 0);
-            }
+            sat_solver_add (nenofex, -tseitin_node_id (nenofex, child));
           else                  /* AND */
             {
               Node *child_child;
-              for (child_child = child->child_list.last;
-                   child_child; child_child = child_child->level_link.prev)
+              for (child_child = node_at (nenofex, child->child_list.last);
+                   child_child;
+                     child_child =
+                     node_at (nenofex, child_child->level_link.prev))
                 {
-                  assert (child_child->id);
-                  sat_solver_add (nenofex, -child_child->id);
                   if (!is_literal_node (child_child))
-                    push_stack (nenofex->mm, stack, child_child);
+                    tseitin_push_op_node (nenofex, stack, child_child);
+                  sat_solver_add (nenofex,
+                                  -tseitin_node_id (nenofex, child_child));
                 }               /* end: for all child's children */
-              sat_solver_add (nenofex, 0);
             }
-        }                       /* end: for AND's children */
+          sat_solver_add (nenofex, 0);
+        }                       /* end: for OR's children */
 
     }                           /* end: while stack not empty */
 
   delete_stack (nenofex->mm, stack);
+
+  return clause_cnt;
 }
 
 /* ------- END: REVISED TSEITIN TRANSFORMATION ------- */
@@ -8122,6 +9157,8 @@ quantified_nnf_to_cnf_dump (Nenofex * nenofex, FILE * out)
   int num_clauses = 0, num_vars = 0, num_remaining_vars = 0,
     num_remaining_exist_vars = 0, num_remaining_univ_vars = 0;
 
+  profile_enter (nenofex, NENOFEX_PHASE_CNF);
+
   /* Use standard-tseitin encoding. */
   nnf_to_cnf_standard_tseitin_assign_node_ids (nenofex);
   num_clauses = nnf_to_cnf_standard_tseitin_count_clauses (nenofex, 1);
@@ -8131,6 +9168,8 @@ quantified_nnf_to_cnf_dump (Nenofex * nenofex, FILE * out)
   fprintf (stderr, "  tseitin variables: %d\n", num_vars);
   fprintf (stderr, "  tseitin clauses: %d\n", num_clauses);
   nnf_to_cnf_standard_tseitin_dump (nenofex, out, 1);
+
+  profile_leave (nenofex, NENOFEX_PHASE_CNF);
 }
 
 
@@ -8140,6 +9179,8 @@ nnf_to_cnf_dump (Nenofex * nenofex, FILE * out)
   int num_clauses = 0, num_vars = 0, num_remaining_vars = 0,
     num_remaining_exist_vars = 0, num_remaining_univ_vars = 0;
 
+  profile_enter (nenofex, NENOFEX_PHASE_CNF);
+
   if (nenofex->options.cnf_generator_tseitin_revised_specified)
     {
       nnf_to_cnf_tseitin_revised_assign_node_ids (nenofex);
@@ -8174,30 +9215,47 @@ nnf_to_cnf_dump (Nenofex * nenofex, FILE * out)
       else
         nnf_to_cnf_standard_tseitin_dump (nenofex, out, 0);
     }
+
+  profile_leave (nenofex, NENOFEX_PHASE_CNF);
 }
 
 
+/*
+- single pass: node IDs are assigned while clauses are forwarded
+- clauses are not counted in advance, only dumping needs a header
+*/
 static void
 nnf_to_cnf_forward (Nenofex * nenofex)
 {
-  int num_clauses = 0, num_vars = 0, num_remaining_vars = 0,
-    num_remaining_exist_vars = 0, num_remaining_univ_vars = 0;
+  int num_clauses = 0, num_vars = 0;
 
-  if (nenofex->options.cnf_generator_tseitin_revised_specified)
+  profile_enter (nenofex, NENOFEX_PHASE_CNF);
+
+  nnf_to_cnf_tseitin_assign_var_ids (nenofex);
+
+  if (nenofex->sat_solver_tautology_mode)
     {
-      nnf_to_cnf_tseitin_revised_assign_node_ids (nenofex);
-      num_clauses = nnf_to_cnf_tseitin_revised_count_clauses (nenofex);
+      if (nenofex->options.cnf_generator_tseitin_revised_specified)
+        num_clauses = nnf_to_cnf_tseitin_revised_top_falsity_forward (nenofex);
+      else
+        num_clauses = nnf_to_cnf_standard_tseitin_forward (nenofex);
     }
   else
     {
-      nnf_to_cnf_standard_tseitin_assign_node_ids (nenofex);
-      num_clauses = nnf_to_cnf_standard_tseitin_count_clauses (nenofex, 0);
+      if (nenofex->options.cnf_generator_tseitin_revised_specified)
+        num_clauses = nnf_to_cnf_tseitin_revised_top_truth_forward (nenofex);
+      else
+        num_clauses = nnf_to_cnf_standard_tseitin_forward (nenofex);
     }
 
+  assert (num_clauses ==
+          (nenofex->options.cnf_generator_tseitin_revised_specified ?
+           nnf_to_cnf_tseitin_revised_count_clauses (nenofex) :
+           nnf_to_cnf_standard_tseitin_count_clauses (nenofex, 0)));
+
+  profile_leave (nenofex, NENOFEX_PHASE_CNF);
+
   num_vars = nenofex->tseitin_next_id - 1;
-  num_remaining_exist_vars = count_variables (nenofex, 1);
-  num_remaining_univ_vars = count_variables (nenofex, 0);
-  num_remaining_vars = num_remaining_exist_vars + num_remaining_univ_vars;
 
   if (!nenofex->options.print_short_answer_specified)
     {
@@ -8205,21 +9263,6 @@ nnf_to_cnf_forward (Nenofex * nenofex)
       fprintf (stderr, "  tseitin variables: %d\n", num_vars);
       fprintf (stderr, "  tseitin clauses: %d\n", num_clauses);
     }
-
-  if (nenofex->sat_solver_tautology_mode)
-    {
-      if (nenofex->options.cnf_generator_tseitin_revised_specified)
-        nnf_to_cnf_tseitin_revised_top_falsity_forward (nenofex);
-      else
-        nnf_to_cnf_standard_tseitin_forward (nenofex);
-    }
-  else
-    {
-      if (nenofex->options.cnf_generator_tseitin_revised_specified)
-        nnf_to_cnf_tseitin_revised_top_truth_forward (nenofex);
-      else
-        nnf_to_cnf_standard_tseitin_forward (nenofex);
-    }
 }
 
 
@@ -8357,9 +9400,15 @@ set_default_cmd_line_options (Nenofex * nenofex)
   nenofex->options.opt_subgraph_limit_specified = 1;
   nenofex->options.opt_subgraph_limit = 500;
 
+  nenofex->options.opt_time_share = 80;
+
   nenofex->options.univ_trigger = 10;
   nenofex->options.univ_trigger_delta = 10;
 
+  nenofex->options.score_threads = 1;
+  nenofex->options.stats_level = NENOFEX_STATS_BASIC;
+  nenofex->options.sat_solver_backend = default_sat_solver_backend ();
+
   nenofex->options.print_short_answer_specified = 1;
 }
 
@@ -8416,8 +9465,8 @@ simplify_mark_lca_variables_for_update (Nenofex * nenofex, Var * var,
         }
       else                      /* visit children */
         {
-          for (child = node->child_list.first; child;
-               child = child->level_link.next)
+          for (child = node_at (nenofex, node->child_list.first); child;
+               child = node_at (nenofex, child->level_link.next))
             push_stack (nenofex->mm, node_stack, child);
         }
     }                           /* end: while stack not empty */
@@ -8432,9 +9481,8 @@ simplify_eliminate_unate (Nenofex * nenofex, Var * var)
 {
   assert (variable_has_occs (var));
 
-#if COMPUTE_NUM_UNATES
-  nenofex->stats.num_unates++;
-#endif
+  if (stats_basic (nenofex))
+    nenofex->stats.num_unates++;
 
 #ifndef NDEBUG
   if (!var->lits[0].occ_list.first)     /* has no neg. occurrences */
@@ -8485,6 +9533,9 @@ simplify_eliminate_unates (Nenofex * nenofex)
 
   int found = 0;
 
+  profile_enter (nenofex, NENOFEX_PHASE_SIMPLIFY);
+  defer_size_subformula_updates (nenofex);
+
   Var *var;
   while ((var = pop_stack (nenofex->unates)))
     {
@@ -8501,15 +9552,14 @@ simplify_eliminate_unates (Nenofex * nenofex)
 
           if ((var)->exp_costs.lca_object.lca)
             {
-              unlink_variable_from_lca_list (var);
+              unlink_variable_from_lca_list (nenofex, var);
               reset_lca_object (nenofex, var, &(var)->exp_costs.lca_object,
                                 1);
             }
 
-          if (var->priority_pos != -1)
+          if (var->priority_slot != -1)
             {
-              delete_elem_priority_queue (var->scope->priority_heap,
-                                          var->priority_pos);
+              delete_elem_priority_queue (var->scope->priority_heap, var);
             }
 
           continue;
@@ -8533,7 +9583,7 @@ simplify_eliminate_unates (Nenofex * nenofex)
             {                   /* re-initialize variable's LCA */
               if ((var)->exp_costs.lca_object.lca)
                 {
-                  unlink_variable_from_lca_list (var);
+                  unlink_variable_from_lca_list (nenofex, var);
                   reset_lca_object (nenofex, var,
                                     &(var)->exp_costs.lca_object, 1);
                 }
@@ -8559,6 +9609,9 @@ simplify_eliminate_unates (Nenofex * nenofex)
 
   assert (!node_stack);
 
+  flush_size_subformula_updates (nenofex);
+  profile_leave (nenofex, NENOFEX_PHASE_SIMPLIFY);
+
   return found;
 }
 
@@ -8594,11 +9647,14 @@ simplify_eliminate_units (Nenofex * nenofex)
   if (!is_and_node (nenofex_graph_root))
     return found;
 
+  profile_enter (nenofex, NENOFEX_PHASE_SIMPLIFY);
+  defer_size_subformula_updates (nenofex);
+
   unsigned int exist_cnt;
 
   exist_cnt = 0;
 
-  Node *literal = nenofex_graph_root->child_list.first;
+  Node *literal = node_at (nenofex, nenofex_graph_root->child_list.first);
   assert (literal);
 
   if (is_literal_node (literal))
@@ -8606,9 +9662,8 @@ simplify_eliminate_units (Nenofex * nenofex)
 
   while (literal && is_literal_node (literal))
     {
-#if COMPUTE_NUM_UNITS
-      nenofex->stats.num_units++;
-#endif
+      if (stats_basic (nenofex))
+        nenofex->stats.num_units++;
 
       found = 1;
       Lit *literal_lit = literal->lit;
@@ -8619,7 +9674,7 @@ simplify_eliminate_units (Nenofex * nenofex)
         {                       /* re-initialize variable's LCA */
           if ((var)->exp_costs.lca_object.lca)
             {
-              unlink_variable_from_lca_list (var);
+              unlink_variable_from_lca_list (nenofex, var);
               reset_lca_object (nenofex, var, &(var)->exp_costs.lca_object,
                                 1);
             }
@@ -8686,8 +9741,8 @@ simplify_eliminate_units (Nenofex * nenofex)
         }
 
       literal = (nenofex_graph_root = nenofex->graph_root)
-        && is_and_node (nenofex_graph_root) ? nenofex_graph_root->child_list.
-        first : 0;
+        && is_and_node (nenofex_graph_root) ?
+        node_at (nenofex, nenofex_graph_root->child_list.first) : 0;
     }                           /* end: while unit literals present */
 
   if (nenofex->options.show_progress_specified && exist_cnt)
@@ -8699,6 +9754,9 @@ simplify_eliminate_units (Nenofex * nenofex)
       delete_stack (nenofex->mm, node_stack);
     }
 
+  flush_size_subformula_updates (nenofex);
+  profile_leave (nenofex, NENOFEX_PHASE_SIMPLIFY);
+
   return found;
 }
 
@@ -8747,11 +9805,12 @@ reduce_optimization_subgraph_on_demand (Nenofex * nenofex)
 
     AGAIN:
 
-      first_child = max_size_child->child_list.first;
+      first_child = node_at (nenofex, max_size_child->child_list.first);
       max_size_child = 0;
       max_size = 0;
 
-      for (child = first_child; child; child = child->level_link.next)
+      for (child = first_child; child;
+           child = node_at (nenofex, child->level_link.next))
         {
           unsigned int child_size_subformula = child->size_subformula;
 
@@ -8775,17 +9834,23 @@ reduce_optimization_subgraph_on_demand (Nenofex * nenofex)
   unsigned int reduced_size = max_size_child->size_subformula;
 
 #if MAXIMIZE_REDUCED
-  nenofex->changed_subformula.lca = max_size_child->parent;
+  nenofex->changed_subformula.lca = node_at (nenofex, max_size_child->parent);
   reduced_size++;
   add_changed_lca_child (nenofex, max_size_child);
 
-  child = max_size_child->level_link.next;
+  child = node_at (nenofex, max_size_child->level_link.next);
   if (!child)
-    child = max_size_child->parent->child_list.first;
+    child =
+      node_at (nenofex,
+               node_at (nenofex, max_size_child->parent)->child_list.first);
 
   for (; child != max_size_child;
-       child = (child->level_link.next ? child->level_link.next :
-                max_size_child->parent->child_list.first))
+       child =
+         (node_at (nenofex, child->level_link.next)
+          ? node_at (nenofex, child->level_link.next) :
+                node_at (nenofex,
+                         node_at (nenofex,
+                                  max_size_child->parent)->child_list.first)))
     {
       if (reduced_size + child->size_subformula <= size_limit)
         {
@@ -8804,8 +9869,8 @@ reduce_optimization_subgraph_on_demand (Nenofex * nenofex)
     {
       nenofex->changed_subformula.lca = max_size_child;
 
-      for (child = max_size_child->child_list.first;
-           child; child = child->level_link.next)
+      for (child = node_at (nenofex, max_size_child->child_list.first);
+           child; child = node_at (nenofex, child->level_link.next))
         add_changed_lca_child (nenofex, child);
     }
 #ifndef NDEBUG
@@ -8820,6 +9885,213 @@ reduce_optimization_subgraph_on_demand (Nenofex * nenofex)
 }
 
 
+/* START: DUPLICATE SIBLING CLAUSES */
+
+typedef struct HashedClause HashedClause;
+
+struct HashedClause
+{
+  unsigned int hash;
+  Node *node;
+};
+
+
+/* by convention, literals are stored first in child-lists */
+#define is_literal_only_node(node) \
+  (!is_literal_node (node) \
+   && is_literal_node (node_at (nenofex, (node)->child_list.last)))
+
+
+/*
+- hash value depends on type and the set of literals only, 
+  not on the order of literals
+*/
+static unsigned int
+literal_only_node_hash (Nenofex * nenofex, Node * node)
+{
+  unsigned int hash = node->type * 0x9e3779b1u + node->num_children;
+
+  Node *ch;
+  for (ch = node_at (nenofex, node->child_list.first); ch;
+       ch = node_at (nenofex, ch->level_link.next))
+    {
+      unsigned int code = (2 * ch->lit->var->id + ch->lit->negated) *
+        0x9e3779b1u;
+      hash += code ^ (code >> 15);
+    }
+
+  return hash;
+}
+
+
+static int
+literal_only_nodes_equal (Nenofex * nenofex, Node * node1, Node * node2)
+{
+  if (node1->type != node2->type
+      || node1->num_children != node2->num_children)
+    return 0;
+
+  Node *ch;
+  for (ch = node_at (nenofex, node1->child_list.first); ch;
+       ch = node_at (nenofex, ch->level_link.next))
+    {
+      assert (!simplify_var_marked (ch->lit->var));
+      if (ch->lit->negated)
+        simplify_var_neg_mark (ch->lit->var);
+      else
+        simplify_var_pos_mark (ch->lit->var);
+    }
+
+  int result = 1;
+  for (ch = node_at (nenofex, node2->child_list.first); result && ch;
+       ch = node_at (nenofex, ch->level_link.next))
+    {
+      if (ch->lit->negated)
+        result = simplify_var_neg_marked (ch->lit->var);
+      else
+        result = simplify_var_pos_marked (ch->lit->var);
+    }
+
+  for (ch = node_at (nenofex, node1->child_list.first); ch;
+       ch = node_at (nenofex, ch->level_link.next))
+    simplify_var_unmark (ch->lit->var);
+
+  return result;
+}
+
+
+static int
+compare_hashed_clauses (const void *p1, const void *p2)
+{
+  const HashedClause *c1 = p1;
+  const HashedClause *c2 = p2;
+
+  return c1->hash < c2->hash ? -1 : (c1->hash > c2->hash ? 1 : 0);
+}
+
+
+/*
+- with '--dedup-sibling-clauses': delete clauses (and cubes) of literals in
+  'changed-subformula' which are identical to a sibling, being redundant by
+  idempotence; duplicates are found by hashing, nodes are never shared
+- such siblings occur after copies have been flattened into a common parent, 
+  e.g. after universal expansion 
+- deleting a sibling which would merge the parent is postponed to the end: 
+  merging may simplify and delete other nodes 
+- returns number of deleted nodes
+*/
+static int
+delete_duplicate_sibling_clauses (Nenofex * nenofex)
+{
+  Node *root = nenofex->changed_subformula.lca;
+
+  if (!root)
+    return 0;
+
+  assert (!is_literal_node (root));
+  assert (!nenofex->atpg_rr_called);
+
+  profile_enter (nenofex, NENOFEX_PHASE_SIMPLIFY);
+
+  Stack *stack = create_stack (nenofex->mm, DEFAULT_STACK_SIZE);
+  unsigned int size_table = 0;
+  HashedClause *table = 0;
+  Node *merge_node = 0;
+  int deleted = 0;
+
+  push_stack (nenofex->mm, stack, root);
+
+  Node *cur;
+  while (!merge_node && (cur = pop_stack (stack)))
+    {
+      unsigned int cnt = 0;
+
+      Node *ch;
+      for (ch = node_at (nenofex, cur->child_list.first); ch;
+           ch = node_at (nenofex, ch->level_link.next))
+        {
+          if (is_literal_node (ch))
+            continue;
+          else if (is_literal_only_node (ch))
+            cnt++;
+          else
+            push_stack (nenofex->mm, stack, ch);
+        }
+
+      if (cnt < 2)
+        continue;
+
+      if (cnt > size_table)
+        {
+          table = mem_realloc (nenofex->mm, table,
+                               size_table * sizeof (HashedClause),
+                               cnt * sizeof (HashedClause));
+          size_table = cnt;
+        }
+
+      HashedClause *p = table;
+      for (ch = node_at (nenofex, cur->child_list.first); ch;
+           ch = node_at (nenofex, ch->level_link.next))
+        {
+          if (!is_literal_node (ch) && is_literal_only_node (ch))
+            {
+              p->hash = literal_only_node_hash (nenofex, ch);
+              p->node = ch;
+              p++;
+            }
+        }
+      assert (p == table + cnt);
+
+      qsort (table, cnt, sizeof (HashedClause), compare_hashed_clauses);
+
+      HashedClause *c1, *c2, *end = table + cnt;
+      for (c1 = table; !merge_node && c1 < end; c1++)
+        {
+          if (!c1->node)
+            continue;
+
+          for (c2 = c1 + 1; c2 < end && c2->hash == c1->hash; c2++)
+            {
+              if (!c2->node
+                  || !literal_only_nodes_equal (nenofex, c1->node, c2->node))
+                continue;
+
+              nenofex->cnt_dedup_sibling_clauses++;
+              nenofex->cnt_dedup_sibling_nodes +=
+                c2->node->size_subformula;
+              deleted += c2->node->size_subformula;
+
+              if (cur->num_children == 2)
+                {               /* 'cur' has to be merged after deletion */
+                  merge_node = c2->node;
+                  break;
+                }
+
+              remove_and_free_subformula (nenofex, c2->node);
+              c2->node = 0;
+            }
+        }
+    }                           /* end: while stack not empty */
+
+  if (table)
+    mem_free (nenofex->mm, table, size_table * sizeof (HashedClause));
+  delete_stack (nenofex->mm, stack);
+
+  if (merge_node)
+    remove_and_free_subformula (nenofex, merge_node);
+
+  if (deleted && nenofex->options.show_progress_specified)
+    fprintf (stderr, "Duplicate sibling clauses: %d nodes deleted\n\n",
+             deleted);
+
+  profile_leave (nenofex, NENOFEX_PHASE_SIMPLIFY);
+
+  return deleted;
+}
+
+/* END: DUPLICATE SIBLING CLAUSES */
+
+
 static int
 simplify_by_global_flow_and_atpg (Nenofex * nenofex)
 {
@@ -8835,7 +10107,14 @@ simplify_by_global_flow_and_atpg (Nenofex * nenofex)
             return 0;
         }
 
+      profile_enter (nenofex, NENOFEX_PHASE_OPTIMIZE);
+
+      /* sizes of 'changed-subformula' are read before any update */
+      defer_size_subformula_updates (nenofex);
       graph_modified = simplify_by_global_flow_and_atpg_main (nenofex);
+      flush_size_subformula_updates (nenofex);
+
+      profile_leave (nenofex, NENOFEX_PHASE_OPTIMIZE);
     }
 
   return graph_modified;
@@ -8962,7 +10241,8 @@ compute_graph_statistics (Nenofex * nenofex)
 
               Node *ch;
               unsigned int cur_lit_cnt = 0;
-              for (ch = cur->child_list.last; ch; ch = ch->level_link.prev)
+              for (ch = node_at (nenofex, cur->child_list.last); ch;
+                   ch = node_at (nenofex, ch->level_link.prev))
                 {
                   if (is_literal_node (ch))
                     {
@@ -8990,7 +10270,8 @@ compute_graph_statistics (Nenofex * nenofex)
 
               Node *ch;
               unsigned int cur_lit_cnt = 0;
-              for (ch = cur->child_list.last; ch; ch = ch->level_link.prev)
+              for (ch = node_at (nenofex, cur->child_list.last); ch;
+                   ch = node_at (nenofex, ch->level_link.prev))
                 {
                   if (is_literal_node (ch))
                     {
@@ -9137,7 +10418,7 @@ approximate_univ_scope_variable_scores (Nenofex * nenofex, Scope * scope)
   inc_score_update_mark (min_lit_var);
   dec_score_update_mark (min_lit_var);
 
-  init_variable_scores (nenofex, min_lit_var, 0);
+  init_variable_scores (nenofex, min_lit_var, 0, INT_MAX);
 
   lca_update_unmark (min_lit_var);
   inc_score_update_unmark (min_lit_var);
@@ -9156,40 +10437,208 @@ approximate_univ_scope_variable_scores (Nenofex * nenofex, Scope * scope)
 }
 #endif
 
+/* START: PARALLEL SCORING */
+
+typedef struct ScoringThread ScoringThread;
+
+struct ScoringThread
+{
+  Nenofex *nenofex;
+  Scope *scope;
+  unsigned int id;
+  unsigned int num_threads;
+  /* cheapest exact costs found by any thread for '--bounded-scores' */
+  int *best;
+  /* counted per thread, added to stats after join */
+  unsigned long long bounded_dec_scores;
+  int non_inc_expansions_in_scores;
+};
+
+
 /*
-- initialize all variables in a scope from scratch
-- priority order has to be established manually afetrwards by calling 'init_order'
+- computes increase and decrease scores of every 'num_threads'-th variable
+  of scope where LCAs are already up to date
+- graph is read only: node marks are kept in scratch, 
+  memory is allocated from a thread-local memory manager
 */
-static void
-init_all_scope_variable_scores (Nenofex * nenofex, Scope * scope)
+static void *
+score_scope_variables (void *arg)
 {
-#if APPROXIMATE_UNIV_SCORES
-  if (nenofex->consider_univ_exp && nenofex->cur_scope
-      && is_existential_scope (*nenofex->cur_scope) && nenofex->next_scope
-      && is_universal_scope (*nenofex->next_scope))
-    {
-      approximate_univ_scope_variable_scores (nenofex, scope);
-      return;
-    }
-#endif
+  ScoringThread *thread = arg;
+  Nenofex *nenofex = thread->nenofex;
+  MemManager *mm = memmanager_create ();
+  ScoreScratch scratch;
+  init_score_scratch (&scratch, mm);
 
-  void **v_var, **end;
-  end = scope->vars->top;
+  Var **vars = (Var **) thread->scope->vars->elems;
+  unsigned int i, num_vars = count_stack (thread->scope->vars);
 
-  for (v_var = scope->vars->elems; v_var < end; v_var++)
+  for (i = thread->id; i < num_vars; i += thread->num_threads)
     {
-      Var *var = *v_var;
+      Var *var = vars[i];
 
-      lca_update_mark (var);
-      inc_score_update_mark (var);
-      dec_score_update_mark (var);
+      if (!variable_has_occs (var))
+        continue;
 
-      init_variable_scores (nenofex, var, 0);
+      var->exp_costs.inc_score =
+        expansion_increase_score (nenofex, var, &var->exp_costs.lca_object,
+                                  &thread->non_inc_expansions_in_scores);
 
+      /* any exact costs are a valid bound, ordering does not matter */
+      int best = __atomic_load_n (thread->best, __ATOMIC_RELAXED);
+
+      if (bound_decrease_score (nenofex, var, best))
+        {                       /* variable is owned by this thread */
+          dec_score_update_mark (var);
+          thread->bounded_dec_scores++;
+        }
+      else
+        {
+          var->exp_costs.dec_score =
+            expansion_decrease_score (nenofex, var,
+                                      &var->exp_costs.lca_object, &scratch);
+          reset_score_scratch (&scratch);
+        }
+
+      var->exp_costs.score =
+        var->exp_costs.inc_score - var->exp_costs.dec_score;
+
+      while (!dec_score_update_marked (var) && var->exp_costs.score < best
+             && !__atomic_compare_exchange_n (thread->best, &best,
+                                              var->exp_costs.score, 1,
+                                              __ATOMIC_RELAXED,
+                                              __ATOMIC_RELAXED))
+        ;
+    }
+
+  free_score_scratch (&scratch);
+  memmanager_delete (mm);
+
+  return 0;
+}
+
+
+/*
+- LCA computation links variables into lists at nodes, hence sequential
+- calling thread takes part in scoring; if a thread cannot be created
+  its share is scored by the calling thread 
+*/
+static void
+init_all_scope_variable_scores_parallel (Nenofex * nenofex, Scope * scope)
+{
+  unsigned const int num_threads = nenofex->options.score_threads;
+  ScoringThread *threads =
+    mem_malloc (nenofex->mm, num_threads * sizeof (ScoringThread));
+  pthread_t *thread_ids =
+    mem_malloc (nenofex->mm, num_threads * sizeof (pthread_t));
+
+  void **v_var, **end;
+  end = scope->vars->top;
+
+  for (v_var = scope->vars->elems; v_var < end; v_var++)
+    {
+      Var *var = *v_var;
+
+      lca_update_mark (var);
+
+      if (variable_has_occs (var))
+        init_variable_lca (nenofex, var);
+
+      /* scores are computed below in any case */
       lca_update_unmark (var);
       inc_score_update_unmark (var);
       dec_score_update_unmark (var);
-    }                           /* end: for all vars in scope */
+    }
+
+  unsigned int i, num_started;
+  int best = INT_MAX;
+  for (i = 0; i < num_threads; i++)
+    {
+      threads[i].nenofex = nenofex;
+      threads[i].scope = scope;
+      threads[i].id = i;
+      threads[i].num_threads = num_threads;
+      threads[i].best = &best;
+      threads[i].bounded_dec_scores = 0;
+      threads[i].non_inc_expansions_in_scores = 0;
+    }
+
+  for (num_started = 1; num_started < num_threads; num_started++)
+    {
+      if (pthread_create (thread_ids + num_started, 0, score_scope_variables,
+                          threads + num_started))
+        break;
+    }
+
+  score_scope_variables (threads);
+  for (i = num_started; i < num_threads; i++)
+    score_scope_variables (threads + i);
+
+  for (i = 1; i < num_started; i++)
+    pthread_join (thread_ids[i], 0);
+
+  if (stats_basic (nenofex))
+    for (i = 0; i < num_threads; i++)
+      {
+        nenofex->stats.bounded_dec_scores += threads[i].bounded_dec_scores;
+        nenofex->stats.num_non_inc_expansions_in_scores +=
+          threads[i].non_inc_expansions_in_scores;
+      }
+
+  mem_free (nenofex->mm, threads, num_threads * sizeof (ScoringThread));
+  mem_free (nenofex->mm, thread_ids, num_threads * sizeof (pthread_t));
+}
+
+/* END: PARALLEL SCORING */
+
+
+/*
+- initialize all variables in a scope from scratch
+- priority order has to be established manually afterwards by calling 'init_order'
+*/
+static void
+init_all_scope_variable_scores (Nenofex * nenofex, Scope * scope)
+{
+  profile_enter (nenofex, NENOFEX_PHASE_SCORES);
+
+#if APPROXIMATE_UNIV_SCORES
+  if (nenofex->consider_univ_exp && nenofex->cur_scope
+      && is_existential_scope (*nenofex->cur_scope) && nenofex->next_scope
+      && is_universal_scope (*nenofex->next_scope))
+    approximate_univ_scope_variable_scores (nenofex, scope);
+  else
+#endif
+  if (nenofex->options.score_threads > 1 &&
+      count_stack (scope->vars) >= PARALLEL_SCORING_MIN_VARS)
+    init_all_scope_variable_scores_parallel (nenofex, scope);
+  else
+    {
+      void **v_var, **end;
+      end = scope->vars->top;
+      int best = INT_MAX;
+
+      for (v_var = scope->vars->elems; v_var < end; v_var++)
+        {
+          Var *var = *v_var;
+
+          lca_update_mark (var);
+          inc_score_update_mark (var);
+          dec_score_update_mark (var);
+
+          int bounded = init_variable_scores (nenofex, var, 0, best);
+
+          lca_update_unmark (var);
+          inc_score_update_unmark (var);
+          if (!bounded)
+            dec_score_update_unmark (var);
+
+          if (!bounded && variable_has_occs (var)
+              && var->exp_costs.score < best)
+            best = var->exp_costs.score;
+        }                       /* end: for all vars in scope */
+    }
+
+  profile_leave (nenofex, NENOFEX_PHASE_SCORES);
 }
 
 
@@ -9210,17 +10659,20 @@ find_min_cost_universal_var_in_next_scope (Nenofex * nenofex,
     {                           /* NOTE: rather expensive */
       if (nenofex->options.show_progress_specified)
         fprintf (stderr, "Initializing non-innermost universal scope...\n");
+      update_all_stale_scope_vars (nenofex, *nenofex->cur_scope);
       init_all_scope_variable_scores (nenofex, universal_scope);
       init_order_priority_queue (universal_scope->priority_heap);
     }
 
+  update_stale_min_cost_vars (nenofex, universal_scope);
+
   if (nenofex->options.show_progress_specified)
     fprintf (stderr, "\thas total %d variables, remaining %d\n",
              count_stack (universal_scope->vars),
-             count_stack (universal_scope->priority_heap));
+             count_pqueue (universal_scope->priority_heap));
 
   Var *min_cost_var = 0;
-  Stack *scope_priority_heap = universal_scope->priority_heap;
+  PQueue *scope_priority_heap = universal_scope->priority_heap;
 
   while ((min_cost_var = remove_min (scope_priority_heap)))
     {
@@ -9232,7 +10684,7 @@ find_min_cost_universal_var_in_next_scope (Nenofex * nenofex,
         }
     }
 
-  nenofex->num_cur_remaining_scope_vars = count_stack (scope_priority_heap);
+  nenofex->num_cur_remaining_scope_vars = count_pqueue (scope_priority_heap);
 
   if (min_cost_var && nenofex->options.show_progress_specified)
     fprintf (stderr, "\tfound non-innermost univ. var %d with cost %d\n",
@@ -9258,12 +10710,15 @@ peek_min_cost_universal_var_in_next_scope (Nenofex * nenofex,
     {                           /* NOTE: rather expensive */
       if (nenofex->options.show_progress_specified)
         fprintf (stderr, "Initializing non-innermost universal scope...\n");
+      update_all_stale_scope_vars (nenofex, *nenofex->cur_scope);
       init_all_scope_variable_scores (nenofex, universal_scope);
       init_order_priority_queue (universal_scope->priority_heap);
     }
 
+  update_stale_min_cost_vars (nenofex, universal_scope);
+
   Var *min_cost_var = 0;
-  Stack *scope_priority_heap = universal_scope->priority_heap;
+  PQueue *scope_priority_heap = universal_scope->priority_heap;
 
   while ((min_cost_var = access_min (scope_priority_heap)))
     {
@@ -9293,7 +10748,7 @@ copy_and_add_depending_variable (Nenofex * nenofex, Var * depending_var)
   init_lca_object (nenofex, &(var_copy->exp_costs.lca_object));
 
   var_copy->id = depending_var->id;     /* var-IDs do not matter at all */
-  var_copy->priority_pos = -1;
+  var_copy->priority_slot = -1;
   var_copy->lits[0].var = var_copy;
   var_copy->lits[0].negated = 1;
   var_copy->lits[1].var = var_copy;
@@ -9382,20 +10837,48 @@ prepare_non_innermost_universal_expansion (Nenofex * nenofex,
 }
 
 
+/*
+- with '--lazy-scores': empty the stack of collected variables but keep
+  their update marks, see 'update_stale_min_cost_vars'
+*/
+static void
+collected_variables_defer_scores (Nenofex * nenofex)
+{
+  Var *update_var;
+  while ((update_var = pop_stack (nenofex->vars_marked_for_update)))
+    {
+      assert (update_var->collected_for_update);
+      assert (update_var->scope == *nenofex->cur_scope);
+
+      update_var->collected_for_update = 0;
+
+      if (stats_basic (nenofex) && cost_update_marked (update_var))
+        nenofex->stats.lazy_deferred_updates++;
+    }
+}
+
+
 /*
 - compute scores of variables which have been collected for update
 */
 static void
 collected_variables_update_scores (Nenofex * nenofex)
 {
-#if (PRINT_INCREMENTAL_COST_UPDATE || COMPUTE_AVERAGE_UPDATE_MARKED_RATIOS)
+  const int count_marked = PRINT_INCREMENTAL_COST_UPDATE
+    || stats_full (nenofex);
   unsigned int cnt_update_lca = 0;
   unsigned int cnt_update_inc_score = 0;
   unsigned int cnt_update_dec_score = 0;
-#endif
 
   Stack *collected_variables = nenofex->vars_marked_for_update;
 
+  profile_enter (nenofex, NENOFEX_PHASE_SCORES);
+
+  /* cheapest exact costs for '--bounded-scores' */
+  Var *min_var = access_min ((*nenofex->cur_scope)->priority_heap);
+  int best = min_var && !cost_update_marked (min_var) ?
+    min_var->exp_costs.score : INT_MAX;
+
   Var *update_var;
   while ((update_var = pop_stack (collected_variables)))
     {
@@ -9403,59 +10886,69 @@ collected_variables_update_scores (Nenofex * nenofex)
       assert (update_var->scope == *nenofex->cur_scope);
 
       update_var->collected_for_update = 0;
+      int bounded = 0;
 
       if (!cost_update_marked (update_var))
         continue;
 
       if (variable_has_occs (update_var))
         {                       /* update */
-          init_variable_scores (nenofex, update_var, 1);
+          bounded = init_variable_scores (nenofex, update_var, 1, best);
 
-#if (PRINT_INCREMENTAL_COST_UPDATE || COMPUTE_AVERAGE_UPDATE_MARKED_RATIOS)
-          if (lca_update_marked (update_var))
-            cnt_update_lca++;
-          if (inc_score_update_marked (update_var))
-            cnt_update_inc_score++;
-          if (dec_score_update_marked (update_var))
-            cnt_update_dec_score++;
-#endif
+          if (!bounded && update_var->exp_costs.score < best)
+            best = update_var->exp_costs.score;
+
+          if (count_marked)
+            {
+              if (lca_update_marked (update_var))
+                cnt_update_lca++;
+              if (inc_score_update_marked (update_var))
+                cnt_update_inc_score++;
+              if (dec_score_update_marked (update_var))
+                cnt_update_dec_score++;
+            }
         }
 
       lca_update_unmark (update_var);
       inc_score_update_unmark (update_var);
-      dec_score_update_unmark (update_var);
+      if (!bounded)
+        dec_score_update_unmark (update_var);
     }                           /* end: for all marked variables */
 
 #if PRINT_INCREMENTAL_COST_UPDATE
   fprintf (stderr,
            "Found %d vars lca-marked from %d vars remaining in scope\n",
            cnt_update_lca,
-           count_stack ((*nenofex->cur_scope)->priority_heap));
+           count_pqueue ((*nenofex->cur_scope)->priority_heap));
   fprintf (stderr,
            "Found %d vars inc_score-marked from %d vars remaining in scope\n",
            cnt_update_inc_score,
-           count_stack ((*nenofex->cur_scope)->priority_heap));
+           count_pqueue ((*nenofex->cur_scope)->priority_heap));
   fprintf (stderr,
            "Found %d vars dec_score-marked from %d vars remaining in scope\n",
            cnt_update_dec_score,
-           count_stack ((*nenofex->cur_scope)->priority_heap));
+           count_pqueue ((*nenofex->cur_scope)->priority_heap));
 #endif
 
-#if COMPUTE_AVERAGE_UPDATE_MARKED_RATIOS
-  unsigned int remaining = count_stack ((*nenofex->cur_scope)->priority_heap);
-  nenofex->stats.sum_remaining += remaining;
-  if (remaining == 0)
-    remaining = 1;
-  nenofex->stats.sum_lca_marked += cnt_update_lca;
-  nenofex->stats.sum_inc_marked += cnt_update_inc_score;
-  nenofex->stats.sum_dec_marked += cnt_update_dec_score;
-  nenofex->stats.sum_ratio_lca_marked_in_scope_vars +=
-    ((double) cnt_update_lca / remaining);
-  nenofex->stats.sum_ratio_inc_marked_in_scope_vars +=
-    ((double) cnt_update_inc_score / remaining);
-  nenofex->stats.sum_ratio_dec_marked_in_scope_vars +=
-    ((double) cnt_update_dec_score / remaining);
-#endif
+  if (stats_full (nenofex))
+    {
+      unsigned int remaining =
+        count_pqueue ((*nenofex->cur_scope)->priority_heap);
+      nenofex->stats.sum_remaining += remaining;
+      if (remaining == 0)
+        remaining = 1;
+      nenofex->stats.sum_lca_marked += cnt_update_lca;
+      nenofex->stats.sum_inc_marked += cnt_update_inc_score;
+      nenofex->stats.sum_dec_marked += cnt_update_dec_score;
+      nenofex->stats.sum_ratio_lca_marked_in_scope_vars +=
+        ((double) cnt_update_lca / remaining);
+      nenofex->stats.sum_ratio_inc_marked_in_scope_vars +=
+        ((double) cnt_update_inc_score / remaining);
+      nenofex->stats.sum_ratio_dec_marked_in_scope_vars +=
+        ((double) cnt_update_dec_score / remaining);
+    }
+
+  profile_leave (nenofex, NENOFEX_PHASE_SCORES);
 }
 
 
@@ -9502,6 +10995,8 @@ AGAIN:
 
   next_scope->remaining_var_cnt += cur_scope->remaining_var_cnt;
   cur_scope->remaining_var_cnt = 0;
+  next_scope->occ_var_cnt += cur_scope->occ_var_cnt;
+  cur_scope->occ_var_cnt = 0;
 
   Var *var;
   while ((var = pop_stack (cur_scope_vars)))
@@ -9510,11 +11005,11 @@ AGAIN:
 
       if (var->exp_costs.lca_object.lca)
         {
-          unlink_variable_from_lca_list (var);
+          unlink_variable_from_lca_list (nenofex, var);
           reset_lca_object (nenofex, var, &(var)->exp_costs.lca_object, 1);
         }
 
-      var->priority_pos = -1;
+      var->priority_slot = -1;
       push_stack (nenofex->mm, next_scope_vars, var);
       var->scope = next_scope;
 
@@ -9522,7 +11017,7 @@ AGAIN:
         add_fast_priority_queue (nenofex->mm, next_scope->priority_heap, var);
     }                           /* end: for all variables in 'cur_scope' */
 
-  reset_stack (cur_scope->priority_heap);
+  reset_pqueue (cur_scope->priority_heap);
   cur_scope->is_empty = 1;
 
   /* initialize 'next_scope' from scratch */
@@ -9553,7 +11048,10 @@ pick_variable_for_expansion (Nenofex * nenofex)
   assert (!nenofex->next_scope ||
           (*nenofex->next_scope)->type != (*nenofex->cur_scope)->type);
 
-  collected_variables_update_scores (nenofex);
+  if (nenofex->options.lazy_scores_specified)
+    collected_variables_defer_scores (nenofex);
+  else
+    collected_variables_update_scores (nenofex);
 
   assert (!nenofex->consider_univ_exp || nenofex->next_scope);
   assert (!nenofex->consider_univ_exp || !nenofex->next_scope ||
@@ -9704,11 +11202,11 @@ assert_all_scopes_free_of_no_occ_vars (Nenofex * nenofex)
   for (v_scope = nenofex->scopes->elems; v_scope < scope_end; v_scope++)
     {
       Scope *scope = *v_scope;
-      void **v_var, **var_end;
-      var_end = scope->priority_heap->top;
-      for (v_var = scope->priority_heap->elems; v_var < var_end; v_var++)
+      PQueue *priority_heap = scope->priority_heap;
+      unsigned int pos;
+      for (pos = 0; pos < count_pqueue (priority_heap); pos++)
         {
-          Var *var = *v_var;
+          Var *var = priority_heap->elems[priority_heap->heap[pos].slot];
           assert (variable_has_occs (var));
         }                       /* end: for all vars in scope */
     }                           /* end: for all scopes */
@@ -9745,12 +11243,12 @@ print_lit_stats_before_exp (Nenofex * nenofex, Var * var)
   Lit *lit = var->lits;
   Node *lit_node;
   for (lit_node = lit->occ_list.first; lit_node;
-       lit_node = lit_node->occ_link.next)
+       lit_node = node_at (nenofex, lit_node->occ_link.next))
     neg_lit_count++;
 
   lit++;
   for (lit_node = lit->occ_list.first; lit_node;
-       lit_node = lit_node->occ_link.next)
+       lit_node = node_at (nenofex, lit_node->occ_link.next))
     pos_lit_count++;
 
   /* Estimate how many nodes could be shared. This is done by detecting 
@@ -9771,8 +11269,8 @@ print_lit_stats_before_exp (Nenofex * nenofex, Var * var)
       while ((childp = pop_stack (stack)))
         {
           assert (!childp->mark1);
-          for (childp = childp->child_list.first; childp;
-               childp = childp->level_link.next)
+          for (childp = node_at (nenofex, childp->child_list.first); childp;
+               childp = node_at (nenofex, childp->level_link.next))
             push_stack (nenofex->mm, stack, childp);
         }
     }
@@ -9784,26 +11282,26 @@ print_lit_stats_before_exp (Nenofex * nenofex, Var * var)
   /* Mark ancestors of literals up to LCA. */
   lit = var->lits;
   for (lit_node = lit->occ_list.first; lit_node;
-       lit_node = lit_node->occ_link.next)
+       lit_node = node_at (nenofex, lit_node->occ_link.next))
     {
       tmp = lit_node;
       do
         {
           tmp->mark1 = 1;
-          tmp = tmp->parent;
+          tmp = node_at (nenofex, tmp->parent);
         }
       while (tmp && tmp->level >= lcaobj->lca->level);
     }
 
   lit++;
   for (lit_node = lit->occ_list.first; lit_node;
-       lit_node = lit_node->occ_link.next)
+       lit_node = node_at (nenofex, lit_node->occ_link.next))
     {
       tmp = lit_node;
       do
         {
           tmp->mark1 = 1;
-          tmp = tmp->parent;
+          tmp = node_at (nenofex, tmp->parent);
         }
       while (tmp && tmp->level >= lcaobj->lca->level);
     }
@@ -9826,8 +11324,8 @@ print_lit_stats_before_exp (Nenofex * nenofex, Var * var)
       else
         {
           childp->mark1 = 0;
-          for (childp = childp->child_list.first; childp;
-               childp = childp->level_link.next)
+          for (childp = node_at (nenofex, childp->child_list.first); childp;
+               childp = node_at (nenofex, childp->level_link.next))
             push_stack (nenofex->mm, stack, childp);
         }
     }
@@ -9844,8 +11342,8 @@ print_lit_stats_before_exp (Nenofex * nenofex, Var * var)
       while ((childp = pop_stack (stack)))
         {
           assert (!childp->mark1);
-          for (childp = childp->child_list.first; childp;
-               childp = childp->level_link.next)
+          for (childp = node_at (nenofex, childp->child_list.first); childp;
+               childp = node_at (nenofex, childp->level_link.next))
             push_stack (stack, childp);
         }
     }
@@ -9874,6 +11372,195 @@ print_lit_stats_before_exp (Nenofex * nenofex, Var * var)
 }
 
 
+/*
+- predict bytes allocated when expanding 'var'
+- expansion creates 'inc_score' nodes before simplifying
+- 'growth_bytes' and 'growth_nodes' accumulate bytes and nodes added by 
+  previous expansions which increased the graph: their ratio also covers
+  cold parts, LCA children and growing tables
+*/
+static size_t
+predict_expansion_bytes (Nenofex * nenofex, Var * var,
+                         size_t growth_bytes, size_t growth_nodes)
+{
+  size_t bytes_per_node = 2 * sizeof (Node);
+  if (growth_nodes)
+    bytes_per_node = growth_bytes / growth_nodes;
+  if (bytes_per_node < sizeof (Node))
+    bytes_per_node = sizeof (Node);
+
+  return (size_t) var->exp_costs.inc_score * bytes_per_node;
+}
+
+
+/* ---------- START: ROLLBACK OF EXPANSIONS ---------- */
+
+/*
+- whether a graph of 'size' nodes after an expansion exceeds a limit 
+  checked after expansions in 'expansion_phase'
+- 'size_before' is the size before the expansion
+*/
+static int
+exceeds_size_cutoff (Nenofex * nenofex, long long size_before,
+                     long long size)
+{
+  if (nenofex->options.size_cutoff_relative_specified &&
+      size > size_before * (1 + nenofex->options.size_cutoff))
+    return 1;
+
+  if (nenofex->options.size_cutoff_absolute_specified &&
+      size > size_before + nenofex->options.size_cutoff)
+    return 1;
+
+  if (nenofex->options.abs_graph_size_cutoff > 0 &&
+      size > nenofex->options.abs_graph_size_cutoff * nenofex->init_graph_size)
+    return 1;
+
+  return 0;
+}
+
+
+/*
+- save graph to 'saved' in preorder: operator nodes as type, number of
+  children and size, literals as 'NODE_TYPE_LITERAL' and literal
+- literal children follow their parent in reverse order since they are
+  inserted at the front of child lists when restored
+*/
+static void
+save_graph_for_rollback (Nenofex * nenofex, Stack * saved)
+{
+  MemManager *mm = nenofex->mm;
+  Stack *stack = create_stack (mm, DEFAULT_STACK_SIZE);
+
+  assert (nenofex->graph_root);
+  reset_stack (saved);
+  push_stack (mm, stack, nenofex->graph_root);
+
+  Node *cur;
+  while ((cur = pop_stack (stack)))
+    {
+      if (is_literal_node (cur))
+        {                       /* graph is a single literal */
+          push_stack (mm, saved, (void *) NODE_TYPE_LITERAL);
+          push_stack (mm, saved, cur->lit);
+          continue;
+        }
+
+      push_stack (mm, saved, (void *) (long) cur->type);
+      push_stack (mm, saved, (void *) (long) cur->num_children);
+      push_stack (mm, saved, (void *) (long) cur->size_subformula);
+
+      Node *ch;
+      for (ch = node_at (nenofex, cur->child_list.last); ch;
+           ch = node_at (nenofex, ch->level_link.prev))
+        {
+          if (is_literal_node (ch))
+            {
+              push_stack (mm, saved, (void *) NODE_TYPE_LITERAL);
+              push_stack (mm, saved, ch->lit);
+            }
+          else
+            push_stack (mm, stack, ch);
+        }
+    }
+
+  delete_stack (mm, stack);
+}
+
+
+/*
+- replace graph by the one saved by 'save_graph_for_rollback'
+- variables keep their scopes, the caller stops expanding since
+  scores, priority queues and variable counts are not restored
+*/
+static void
+restore_graph_from_rollback (Nenofex * nenofex, Stack * saved)
+{
+  MemManager *mm = nenofex->mm;
+
+  reset_changed_lca_object (nenofex);
+  if (nenofex->graph_root)
+    remove_and_free_subformula (nenofex, nenofex->graph_root);
+  assert (!nenofex->graph_root);
+
+  /* pairs of operator node and its number of children */
+  Stack *parents = create_stack (mm, DEFAULT_STACK_SIZE);
+
+  void **entry = saved->elems;
+  while (entry < saved->top)
+    {
+      NodeType type = (NodeType) (long) *entry++;
+      unsigned int num_children = 0;
+      Node *node;
+
+      if (type == NODE_TYPE_LITERAL)
+        {
+          Lit *lit = *entry++;
+          Var *var = lit->var;
+          node = lit_node (nenofex, lit->negated ? -var->id : var->id, var);
+          node->size_subformula = 1;
+          var->eliminated = 0;
+        }
+      else
+        {
+          node = type == NODE_TYPE_AND ? and_node (nenofex) :
+            or_node (nenofex);
+          num_children = (long) *entry++;
+          node->size_subformula = (long) *entry++;
+        }
+
+      if (count_stack (parents))
+        {
+          Node *parent = parents->top[-2];
+          add_node_to_child_list (nenofex, parent, node);
+          if (parent->num_children == (long) parents->top[-1])
+            {
+              pop_stack (parents);
+              pop_stack (parents);
+            }
+        }
+      else
+        {
+          assert (!nenofex->graph_root);
+          nenofex->graph_root = node;
+        }
+
+      if (is_literal_node (node))
+        add_lit_node_to_occurrence_list (nenofex, node);
+      else
+        {
+          assert (num_children >= 2);
+          push_stack (mm, parents, node);
+          push_stack (mm, parents, (void *) (long) num_children);
+        }
+    }
+
+  assert (!count_stack (parents));
+  delete_stack (mm, parents);
+
+#ifndef NDEBUG
+#if ASSERT_GRAPH_AFTER_ROLLBACK
+  do
+    {
+      Stack *check = create_stack (mm, DEFAULT_STACK_SIZE);
+      save_graph_for_rollback (nenofex, check);
+      assert (count_stack (check) == count_stack (saved));
+      void **a, **b;
+      for (a = check->elems, b = saved->elems; a < check->top; a++, b++)
+        assert (*a == *b);
+      delete_stack (mm, check);
+      assert_all_child_occ_lists_integrity (nenofex);
+      assert_all_occ_lists_integrity (nenofex);
+      assert_all_subformula_sizes (nenofex);
+    }
+  while (0);
+#endif
+#endif
+}
+
+/* ---------- END: ROLLBACK OF EXPANSIONS ---------- */
+
+
 /*
 - core function: eliminate vars from innermost scope based on expansion costs
 - abort according to specified options or if result is known
@@ -9964,6 +11651,14 @@ expansion_phase (Nenofex * nenofex)
      before next expansion). */
   unsigned int cutoff_occurred = 0;
 
+  /* memory added by expansions, see 'predict_expansion_bytes' */
+  size_t bytes_before_expansion = 0;
+  size_t growth_bytes = 0, growth_nodes = 0;
+
+  /* graph before an expansion which may exceed a size cutoff */
+  Stack *rollback_graph = 0;
+  int rollback_saved = 0;
+
   nenofex->cur_expansions = 0;
   while (nenofex->result == NENOFEX_RESULT_UNKNOWN && ((full && !limit) || (full && limit && nenofex->cur_expansions < nenofex->options.num_expansions) || (!full && !limit && !nenofex->is_existential && !nenofex->is_universal) ||   /* std. case */
                                                        (!full && limit
@@ -9983,23 +11678,22 @@ expansion_phase (Nenofex * nenofex)
                    nenofex->graph_root->size_subformula);
         }
 
-#if COMPUTE_MAX_TREE_SIZE
-      if (nenofex->graph_root)
+      if (stats_basic (nenofex) && nenofex->graph_root)
         {
           unsigned int cur_size = nenofex->graph_root->size_subformula;
           if (cur_size > nenofex->stats.max_tree_size)
             nenofex->stats.max_tree_size = cur_size;
         }
-#endif
 
 #if PRINT_CLAUSE_COUNT
       int clause_count = nnf_to_cnf_tseitin_revised_count_clauses (nenofex);
       fprintf (stderr, "Clause Count = %d\n\n", clause_count);
 #endif
 
-#if COMPUTE_GRAPH_STATISTICS
-      compute_graph_statistics (nenofex);
-#endif
+      /* full traversal of graph, printed to 'stderr' */
+      if (stats_full (nenofex)
+          && !nenofex->options.print_short_answer_specified)
+        compute_graph_statistics (nenofex);
 
       assert (!nenofex->changed_subformula.lca ||
               !is_literal_node (nenofex->changed_subformula.lca));
@@ -10034,6 +11728,10 @@ expansion_phase (Nenofex * nenofex)
           continue;
         }
 
+      if (nenofex->options.dedup_sibling_clauses_specified &&
+          delete_duplicate_sibling_clauses (nenofex))
+        continue;
+
 #ifndef NDEBUG
 #if ASSERT_SCOPE_VAR_CNT
       assert_all_scope_variable_counts (nenofex);
@@ -10077,7 +11775,7 @@ expansion_phase (Nenofex * nenofex)
 #endif
 #endif
 
-      /* check if formula is exist. / univ. - NOTE: this could be done incrementally */
+      /* check if formula is exist. / univ. */
       if (!full && nenofex->result == NENOFEX_RESULT_UNKNOWN)
         {
           nenofex->is_existential = is_formula_existential (nenofex);
@@ -10140,6 +11838,32 @@ expansion_phase (Nenofex * nenofex)
             }
         }                       /* end: cost_cutoff specified */
 
+      /* check if memory limit would be exceeded by expansion */
+      if (get_limit_bytes (nenofex->mm))
+        {
+          size_t predicted_bytes =
+            predict_expansion_bytes (nenofex, var, growth_bytes,
+                                     growth_nodes);
+          if (mem_limit_exceeded (nenofex->mm, predicted_bytes))
+            {
+              if (!nenofex->options.print_short_answer_specified)
+                fprintf (stderr,
+                         "\n\tMEMORY CUTOFF: limit = %lu MB, "
+                         "allocated = %lu MB, predicted = %lu MB\n\n",
+                         (unsigned long) (get_limit_bytes (nenofex->mm) >> 20),
+                         (unsigned long) (get_cur_bytes (nenofex->mm) >> 20),
+                         (unsigned long) (predicted_bytes >> 20));
+              break;
+            }
+        }
+
+      /* check if deadline expired */
+      if (deadline_expired (nenofex, 1))
+        {
+          print_deadline_cutoff (nenofex);
+          break;
+        }
+
       if (nenofex->options.show_progress_specified)
         {
           if ((*nenofex->cur_scope)->nesting != DEFAULT_SCOPE_NESTING)
@@ -10163,6 +11887,23 @@ expansion_phase (Nenofex * nenofex)
             }
         }
 
+      /* score bounds size after expansion: save graph only if a cutoff
+         may occur and the formula before could go to the SAT solver */
+      rollback_saved = 0;
+      if (nenofex->options.cutoff_rollback_specified &&
+          nenofex->graph_root && is_formula_existential (nenofex) &&
+          exceeds_size_cutoff (nenofex, size_before_expansion,
+                               (long long) size_before_expansion +
+                               var->exp_costs.score))
+        {
+          if (!rollback_graph)
+            rollback_graph = create_stack (nenofex->mm, DEFAULT_STACK_SIZE);
+          save_graph_for_rollback (nenofex, rollback_graph);
+          rollback_saved = 1;
+          if (stats_basic (nenofex))
+            nenofex->stats.rollback_snapshots++;
+        }
+
       mark_affected_scope_variables_for_cost_update (nenofex,
                                                      var->exp_costs.
                                                      lca_object.lca);
@@ -10172,14 +11913,20 @@ expansion_phase (Nenofex * nenofex)
         print_lit_stats_before_exp (nenofex, var);
 #endif
 
+      bytes_before_expansion = get_cur_bytes (nenofex->mm);
+
       if (is_existential_scope (var->scope))
         {
           assert (!non_inner_univ_exp);
+          profile_enter (nenofex, NENOFEX_PHASE_EXPAND);
           expand_existential_variable (nenofex, var);
+          profile_leave (nenofex, NENOFEX_PHASE_EXPAND);
         }
       else
         {
+          profile_enter (nenofex, NENOFEX_PHASE_EXPAND);
           expand_universal_variable (nenofex, var);
+          profile_leave (nenofex, NENOFEX_PHASE_EXPAND);
           if (non_inner_univ_exp && nenofex->options.univ_trigger_abs)
             {
               int new_trigger = nenofex->graph_root->size_subformula +
@@ -10202,6 +11949,13 @@ expansion_phase (Nenofex * nenofex)
         size_after_expansion = 0;
       size_increase = size_after_expansion - size_before_expansion;
 
+      if (size_increase > 0
+          && get_cur_bytes (nenofex->mm) > bytes_before_expansion)
+        {
+          growth_nodes += size_increase;
+          growth_bytes += get_cur_bytes (nenofex->mm) - bytes_before_expansion;
+        }
+
       if (nenofex->next_scope &&
           is_existential_scope (var->scope) &&
           ((!nenofex->options.univ_trigger_abs
@@ -10286,6 +12040,34 @@ expansion_phase (Nenofex * nenofex)
             }
         }
 
+      /* memory limit exceeded in spite of prediction */
+      if (!cutoff_occurred && mem_limit_exceeded (nenofex->mm, 0))
+        {
+          if (!nenofex->options.print_short_answer_specified)
+            fprintf (stderr,
+                     "\n\tMEMORY CUTOFF: limit = %lu MB, "
+                     "allocated = %lu MB\n\n",
+                     (unsigned long) (get_limit_bytes (nenofex->mm) >> 20),
+                     (unsigned long) (get_cur_bytes (nenofex->mm) >> 20));
+          cutoff_occurred = 1;
+        }
+
+      /* restored graph was simplified before the expansion, hence
+         exit loop immediately */
+      if (cutoff_occurred && rollback_saved)
+        {
+          restore_graph_from_rollback (nenofex, rollback_graph);
+          nenofex->cur_expansions--;
+          if (stats_basic (nenofex))
+            nenofex->stats.rollbacks++;
+          if (!nenofex->options.print_short_answer_specified)
+            fprintf (stderr,
+                     "\n\tROLLBACK: expansion of var %d undone, "
+                     "size = %d\n\n", var->id,
+                     nenofex->graph_root->size_subformula);
+          break;
+        }
+
 #ifndef NDEBUG
 #if ASSERT_AFTER_EXP_ALL_NON_INNERMOST_SCOPE_VARS_UNINIT
       assert_all_non_innermost_scope_vars_uninitialized (nenofex,
@@ -10295,25 +12077,102 @@ expansion_phase (Nenofex * nenofex)
 
     }                           /* end: elimination-while */
 
+  if (rollback_graph)
+    delete_stack (nenofex->mm, rollback_graph);
+
   nenofex->expansion_phase_end_time = time_stamp ();
 }
 
 
-static void
-sat_solving_phase (Nenofex * nenofex)
+/*
+- terminate callback of SAT solver backends
+*/
+static int
+sat_solver_deadline_expired (void *nenofex)
 {
-  int dump = nenofex->options.dump_cnf_specified;
-  int forward = !nenofex->options.no_sat_solving_specified;
-  assert (dump || forward);
+  return deadline_expired ((Nenofex *) nenofex, 0);
+}
 
-  if (nenofex->result == NENOFEX_RESULT_UNKNOWN
-      && !nenofex->sat_solver_tautology_mode)
+
+/*
+- without deadline: one call of SAT solver with decision limit (if any)
+- otherwise: calls with at most 'SAT_SOLVER_DEADLINE_SLICE' decisions each
+  until solved, deadline expired or decision limit reached
+- backends ignoring decision limits (IPASIR) are called once and
+  interrupted by the terminate callback when the deadline expires
+*/
+static int
+run_sat_solver (Nenofex * nenofex)
+{
+  int sat_res = SAT_SOLVER_RESULT_UNKNOWN;
+
+  profile_enter (nenofex, NENOFEX_PHASE_SAT);
+
+  if (!has_deadline (nenofex))
     {
-      assert (is_formula_existential (nenofex));
+      sat_res = sat_solver_sat (nenofex);
+      profile_leave (nenofex, NENOFEX_PHASE_SAT);
+      return sat_res;
+    }
 
-      if (forward)
-        {
-          sat_solver_init (nenofex);
+  sat_solver_set_terminate (nenofex, sat_solver_deadline_expired);
+
+  int dec_limit = nenofex->options.sat_solver_dec_limit;
+  unsigned long long start_decisions = sat_solver_decisions (nenofex);
+
+  while (!deadline_expired (nenofex, 1))
+    {
+      int slice = SAT_SOLVER_DEADLINE_SLICE;
+
+      if (dec_limit > 0)
+        {
+          unsigned long long used =
+            sat_solver_decisions (nenofex) - start_decisions;
+          if (used >= (unsigned long long) dec_limit)
+            break;
+          if ((unsigned long long) slice > dec_limit - used)
+            slice = dec_limit - used;
+        }
+
+      sat_res = sat_solver_sat_slice (nenofex, slice);
+
+      if (sat_res != SAT_SOLVER_RESULT_UNKNOWN)
+        break;
+    }
+
+  profile_leave (nenofex, NENOFEX_PHASE_SAT);
+
+  return sat_res;
+}
+
+
+static void
+print_sat_solver_unknown (Nenofex * nenofex)
+{
+  if (nenofex->deadline.expired)
+    print_deadline_cutoff (nenofex);
+  else if (!nenofex->options.print_short_answer_specified)
+    fprintf (stderr,
+             "\n\tSAT solver result unknown due to decision limit %u\n\n",
+             nenofex->options.sat_solver_dec_limit);
+}
+
+
+static void
+sat_solving_phase (Nenofex * nenofex)
+{
+  int dump = nenofex->options.dump_cnf_specified;
+  int forward = !nenofex->options.no_sat_solving_specified;
+  assert (dump || forward);
+
+  if (nenofex->result == NENOFEX_RESULT_UNKNOWN
+      && !nenofex->sat_solver_tautology_mode)
+    {
+      assert (is_formula_existential (nenofex));
+
+      if (forward)
+        {
+          sat_solver_init (nenofex);
           if (nenofex->options.verbose_sat_solving_specified)
             sat_solver_verbosity_mode (nenofex);
           nnf_to_cnf_forward (nenofex);
@@ -10324,16 +12183,11 @@ sat_solving_phase (Nenofex * nenofex)
 
       if (forward)
         {
-          int sat_res = sat_solver_sat (nenofex);
+          int sat_res = run_sat_solver (nenofex);
 
           if (sat_res == SAT_SOLVER_RESULT_UNKNOWN)
-            {
-              if (!nenofex->options.print_short_answer_specified)
-                fprintf (stderr,
-                         "\n\tSAT solver result unknown due to decision limit %u\n\n",
-                         nenofex->options.sat_solver_dec_limit);
-            }
-          nenofex->stats.sat_solver_decisions = picosat_decisions (nenofex->picosat);
+            print_sat_solver_unknown (nenofex);
+          nenofex->stats.sat_solver_decisions = sat_solver_decisions (nenofex);
 
           nenofex->result = sat_res;
 
@@ -10367,13 +12221,11 @@ sat_solving_phase (Nenofex * nenofex)
 
       if (forward)
         {
-          int sat_res = sat_solver_sat (nenofex);
+          int sat_res = run_sat_solver (nenofex);
 
           if (sat_res == SAT_SOLVER_RESULT_UNKNOWN)
-            fprintf (stderr,
-                     "\n\tSAT solver result unknown due to decision limit %u\n\n",
-                     nenofex->options.sat_solver_dec_limit);
-          nenofex->stats.sat_solver_decisions = picosat_decisions (nenofex->picosat);
+            print_sat_solver_unknown (nenofex);
+          nenofex->stats.sat_solver_decisions = sat_solver_decisions (nenofex);
 
           /* Handle unknown SAT solver result, may happen due to decision limit. */
           if (sat_res != SAT_SOLVER_RESULT_UNKNOWN)
@@ -10463,46 +12315,42 @@ print_statistics_after_expansion (Nenofex * nenofex)
 
   fprintf (stderr, "\nAfter expansion phase:\n");
   fprintf (stderr, "  tree size: %d\n", graph_size);
-#if COMPUTE_MAX_TREE_SIZE
-  fprintf (stderr, "  max. tree size: %d\n", nenofex->stats.max_tree_size);
-#endif
-#if COMPUTE_NUM_UNITS
-  fprintf (stderr, "  units: %d\n", nenofex->stats.num_units);
-#endif
-#if COMPUTE_NUM_UNATES
-  fprintf (stderr, "  unates: %d\n", nenofex->stats.num_unates);
-#endif
+  if (stats_basic (nenofex))
+    {
+      fprintf (stderr, "  max. tree size: %d\n",
+               nenofex->stats.max_tree_size);
+      fprintf (stderr, "  units: %d\n", nenofex->stats.num_units);
+      fprintf (stderr, "  unates: %d\n", nenofex->stats.num_unates);
+    }
   fprintf (stderr, "  expansions: %d\n", nenofex->cur_expansions);
-#if COMPUTE_CASES_IN_EXPANSIONS
-  fprintf (stderr, "    case [E,OR,=]: %d\n",
-           nenofex->stats.num_exp_case_E_OR_ALL);
-  fprintf (stderr, "    case [E,OR,<]: %d\n",
-           nenofex->stats.num_exp_case_E_OR_SUBSET);
-  fprintf (stderr, "    case [E,AND,=]: %d\n",
-           nenofex->stats.num_exp_case_E_AND_ALL);
-  fprintf (stderr, "    case [E,AND,<]: %d\n",
-           nenofex->stats.num_exp_case_E_AND_SUBSET);
-  fprintf (stderr, "    case [A,AND,=]: %d\n",
-           nenofex->stats.num_exp_case_A_AND_ALL);
-  fprintf (stderr, "    case [A,AND,<]: %d\n",
-           nenofex->stats.num_exp_case_A_AND_SUBSET);
-  fprintf (stderr, "    case [A,OR,=]: %d\n",
-           nenofex->stats.num_exp_case_A_OR_ALL);
-  fprintf (stderr, "    case [A,OR,<]: %d\n",
-           nenofex->stats.num_exp_case_A_OR_SUBSET);
-#endif
-#if COMPUTE_NUM_NON_INC_EXPANSIONS_IN_SCORES
-  fprintf (stderr, "  possible non-inc. expansions: %d\n",
-           nenofex->stats.num_non_inc_expansions_in_scores);
-#endif
-#if COMPUTE_NUM_NON_INC_EXPANSIONS
-  fprintf (stderr, "  actual non-inc. expansions: %d\n",
-           nenofex->stats.num_non_inc_expansions);
-#endif
+  if (stats_basic (nenofex))
+    {
+      fprintf (stderr, "    case [E,OR,=]: %d\n",
+               nenofex->stats.num_exp_case_E_OR_ALL);
+      fprintf (stderr, "    case [E,OR,<]: %d\n",
+               nenofex->stats.num_exp_case_E_OR_SUBSET);
+      fprintf (stderr, "    case [E,AND,=]: %d\n",
+               nenofex->stats.num_exp_case_E_AND_ALL);
+      fprintf (stderr, "    case [E,AND,<]: %d\n",
+               nenofex->stats.num_exp_case_E_AND_SUBSET);
+      fprintf (stderr, "    case [A,AND,=]: %d\n",
+               nenofex->stats.num_exp_case_A_AND_ALL);
+      fprintf (stderr, "    case [A,AND,<]: %d\n",
+               nenofex->stats.num_exp_case_A_AND_SUBSET);
+      fprintf (stderr, "    case [A,OR,=]: %d\n",
+               nenofex->stats.num_exp_case_A_OR_ALL);
+      fprintf (stderr, "    case [A,OR,<]: %d\n",
+               nenofex->stats.num_exp_case_A_OR_SUBSET);
+    }
+  if (stats_full (nenofex))
+    fprintf (stderr, "  possible non-inc. expansions: %d\n",
+             nenofex->stats.num_non_inc_expansions_in_scores);
+  if (stats_basic (nenofex))
+    fprintf (stderr, "  actual non-inc. expansions: %d\n",
+             nenofex->stats.num_non_inc_expansions);
   fprintf (stderr, "  expansion time: %.2fs\n",
            nenofex->expansion_phase_end_time - nenofex->start_time);
-#if COMPUTE_AVERAGE_UPDATE_MARKED_RATIOS
-  if (nenofex->cur_expansions)
+  if (stats_full (nenofex) && nenofex->cur_expansions)
     {
       fprintf (stderr, "  avg. ratio lca-marked / remaining scope vars: %f\n",
                nenofex->stats.sum_ratio_lca_marked_in_scope_vars /
@@ -10526,39 +12374,84 @@ print_statistics_after_expansion (Nenofex * nenofex)
                (double) nenofex->stats.sum_dec_marked /
                nenofex->cur_expansions);
     }
-#endif
-#if COMPUTE_LCA_PARENT_VISITS
-  if (nenofex->stats.num_total_lca_algo_calls)
-    fprintf (stderr,
-             "  avg. parent visits in LCA computation: %f (total %d calls)\n",
-             (double) nenofex->stats.num_total_lca_parent_visits /
-             nenofex->stats.num_total_lca_algo_calls,
-             nenofex->stats.num_total_lca_algo_calls);
-#endif
+  if (stats_full (nenofex) && nenofex->stats.num_total_lca_algo_calls)
+    {
+      fprintf (stderr,
+               "  avg. parent visits in LCA computation: %f "
+               "(total %lld calls)\n",
+               (double) nenofex->stats.num_total_lca_parent_visits /
+               nenofex->stats.num_total_lca_algo_calls,
+               nenofex->stats.num_total_lca_algo_calls);
+      fprintf (stderr,
+               "  avg. steps maintaining LCA index: %f "
+               "(jump updates: %lld, invalidations: %lld)\n",
+               (double) (nenofex->stats.num_total_lca_jump_updates +
+                         nenofex->stats.num_total_lca_jump_invalidations) /
+               nenofex->stats.num_total_lca_algo_calls,
+               nenofex->stats.num_total_lca_jump_updates,
+               nenofex->stats.num_total_lca_jump_invalidations);
+      fprintf (stderr,
+               "  avg. parent visits without LCA index: %f\n",
+               (double) nenofex->stats.num_total_lca_plain_parent_visits /
+               nenofex->stats.num_total_lca_algo_calls);
+    }
+  if (stats_full (nenofex))
+    fprintf (stderr, "  nodes visited by size updates: %lld (eager: %lld)\n",
+             nenofex->stats.num_total_size_update_visits,
+             nenofex->stats.num_total_size_update_plain_visits);
   fprintf (stderr, "  optimizations called: %d\n",
            nenofex->performed_optimizations);
   fprintf (stderr, "  optimizations succeeded: %d\n",
            nenofex->successful_optimizations);
   fprintf (stderr, "  first successful optimizations after %d expansions\n",
            nenofex->first_successful_opt);
+  if (stats_basic (nenofex) && nenofex->performed_optimizations)
+    {
+      fprintf (stderr, "    ATPG: %llu faults tested, %llu redundant, "
+               "%llu detected by simulation\n",
+               nenofex->stats.atpg_tested_faults,
+               nenofex->stats.atpg_redundant_faults,
+               nenofex->stats.atpg_sim_detected_faults);
+      fprintf (stderr, "    global flow: %llu nodes tested, "
+               "%llu implications\n",
+               nenofex->stats.global_flow_tested_nodes,
+               nenofex->stats.global_flow_implications);
+      fprintf (stderr, "    propagations: %llu\n",
+               nenofex->stats.opt_propagations);
+    }
   if (nenofex->options.post_expansion_flattening_specified)
     fprintf (stderr, "  post-expansion flattening applied: %d\n",
              nenofex->cnt_post_expansion_flattenings);
+  if (nenofex->options.dedup_sibling_clauses_specified)
+    fprintf (stderr,
+             "  duplicate sibling clauses: %d clauses, %d nodes deleted\n",
+             nenofex->cnt_dedup_sibling_clauses,
+             nenofex->cnt_dedup_sibling_nodes);
+  if (nenofex->options.lazy_scores_specified && stats_basic (nenofex))
+    fprintf (stderr, "  lazy scores: %llu updates deferred, %llu done\n",
+             nenofex->stats.lazy_deferred_updates,
+             nenofex->stats.lazy_score_updates);
+  if (nenofex->options.bounded_scores_specified && stats_basic (nenofex))
+    fprintf (stderr, "  bounded scores: %llu decrease scores skipped\n",
+             nenofex->stats.bounded_dec_scores);
+  if (nenofex->options.cutoff_rollback_specified && stats_basic (nenofex))
+    fprintf (stderr, "  cutoff rollback: %llu graphs saved, "
+             "%llu expansions undone\n",
+             nenofex->stats.rollback_snapshots, nenofex->stats.rollbacks);
   fprintf (stderr, "  remaining orig. variables: %d (E: %d, A: %d)\n",
            num_exist_vars + num_univ_vars, num_exist_vars, num_univ_vars);
-#if COMPUTE_NUM_TOTAL_CREATED_NODES
-  fprintf (stderr, "  total created nodes: %d\n",
-           nenofex->stats.num_total_created_nodes);
-#endif
-
-#if COMPUTE_NUM_DELETED_NODES
-  fprintf (stderr,
-           "  total deleted nodes: %d with %.3f%% (%d) in optimizations\n",
-           nenofex->stats.total_deleted_nodes,
-           nenofex->stats.deleted_nodes_by_global_flow_redundancy /
-           (float) nenofex->stats.total_deleted_nodes * 100,
-           nenofex->stats.deleted_nodes_by_global_flow_redundancy);
-#endif
+  if (stats_basic (nenofex))
+    {
+      fprintf (stderr, "  total created nodes: %d\n",
+               nenofex->stats.num_total_created_nodes);
+      fprintf (stderr,
+               "  total deleted nodes: %d with %.3f%% (%d) in optimizations\n",
+               nenofex->stats.total_deleted_nodes,
+               nenofex->stats.total_deleted_nodes ?
+               nenofex->stats.deleted_nodes_by_global_flow_redundancy /
+               (float) nenofex->stats.total_deleted_nodes * 100 : 0.0,
+               nenofex->stats.deleted_nodes_by_global_flow_redundancy);
+    }
 }
 
 static void
@@ -10572,60 +12465,556 @@ post_formula_addition_simplified (Nenofex *nenofex)
   if (nenofex->graph_root->num_children == 1)
     {                           /* only one clause parsed -> becomes new graph root */
       assert (nenofex->graph_root->child_list.first);
-      assert (nenofex->graph_root->child_list.first ==
-              nenofex->graph_root->child_list.last);
+      assert (node_at (nenofex, nenofex->graph_root->child_list.first) ==
+              node_at (nenofex, nenofex->graph_root->child_list.last));
 
-      Node *clause = nenofex->graph_root->child_list.first;
+      Node *clause = node_at (nenofex, nenofex->graph_root->child_list.first);
       unlink_node (nenofex, clause);
       delete_node (nenofex, nenofex->graph_root);
       nenofex->graph_root = clause;
 
+      invalidate_lca_index (nenofex, clause);
       clause->level = 0;
 
-      if (!is_literal_node (clause))
-        {
-          Node *child;
-          for (child = clause->child_list.first; child;
-               child = child->level_link.next)
-            child->level = 1;
-        }
+      if (!is_literal_node (clause))
+        {
+          Node *child;
+          for (child = node_at (nenofex, clause->child_list.first); child;
+               child = node_at (nenofex, child->level_link.next))
+            child->level = 1;
+        }
+
+      nenofex->first_added_clause = nenofex->second_added_clause = 0; /* need not simplify afterwards */
+    }                           /* end: root had only one clause */
+
+  /* simplify first two clauses */
+  assert (is_literal_node (nenofex->graph_root)
+          || nenofex->graph_root->num_children >= 2);
+
+  if (nenofex->first_added_clause && !is_literal_node (nenofex->first_added_clause))  /* if is not unit */
+    {
+      simplify_one_level (nenofex, nenofex->first_added_clause);
+      if (nenofex->graph_root && is_or_node (nenofex->graph_root))      /* only 1 non-unit left */
+        simplify_one_level (nenofex, nenofex->graph_root);
+      else if (nenofex->graph_root && !is_literal_node (nenofex->second_added_clause)) /* if not unit */
+        simplify_one_level (nenofex, nenofex->second_added_clause);
+    }
+  else if (nenofex->first_added_clause)        /* first is unit, check second */
+    {
+      if (nenofex->second_added_clause && !is_literal_node (nenofex->second_added_clause))    /* if not unit */
+        simplify_one_level (nenofex, nenofex->second_added_clause);
+    }
+
+  /* NOTE: unit elimination is performed -> actually need no 1-l-simp */
+  if (nenofex->graph_root && !is_literal_node (nenofex->graph_root))
+    simplify_one_level (nenofex, nenofex->graph_root);
+}
+
+static void
+post_formula_addition_cleanup (Nenofex *nenofex)
+{
+  if (nenofex->vars)
+    {
+      mem_free (nenofex->mm, nenofex->vars, (nenofex->num_orig_vars + 1) * sizeof (Var *));
+      nenofex->vars = (Var **) 0;
+    }
+}
+
+/* --------- START: PARSE BUFFER --------- */
+
+/*
+- input of 'nenofex_parse' is either mapped into memory as a whole 
+  (regular files) or read in large blocks (pipes, stdin)
+*/
+#define PARSE_BUFFER_READ_BYTES (1 << 20)
+
+typedef struct ParseBuffer ParseBuffer;
+
+struct ParseBuffer
+{
+  const char *pos;
+  const char *end;
+  FILE *file;                   /* null if input is mapped */
+  char *mapped;
+  size_t mapped_bytes;
+  char *buf;                    /* for block-wise reading */
+  size_t total_bytes;
+};
+
+#define parse_buffer_peek(pb) ((pb)->pos < (pb)->end ? *(pb)->pos : parse_buffer_refill (pb))
+#define parse_buffer_skip(pb) ((pb)->pos++)
+
+
+/*
+- returns EOF if no more input, otherwise first character of new block
+*/
+static int
+parse_buffer_refill (ParseBuffer * pb)
+{
+  if (!pb->file)
+    return EOF;
+
+  size_t bytes = fread (pb->buf, 1, PARSE_BUFFER_READ_BYTES, pb->file);
+  pb->total_bytes += bytes;
+  pb->pos = pb->buf;
+  pb->end = pb->buf + bytes;
+
+  return bytes ? *pb->pos : EOF;
+}
+
+
+static void
+init_parse_buffer (Nenofex * nenofex, ParseBuffer * pb, FILE * input_file)
+{
+  memset (pb, 0, sizeof (ParseBuffer));
+
+  struct stat st;
+  long int offset = ftell (input_file);
+
+  if (offset >= 0 && !fstat (fileno (input_file), &st) && S_ISREG (st.st_mode)
+      && st.st_size > offset)
+    {
+      void *mapped = mmap (0, st.st_size, PROT_READ, MAP_PRIVATE,
+                           fileno (input_file), 0);
+      if (mapped != MAP_FAILED)
+        {
+          pb->mapped = (char *) mapped;
+          pb->mapped_bytes = st.st_size;
+          pb->pos = pb->mapped + offset;
+          pb->end = pb->mapped + pb->mapped_bytes;
+          pb->total_bytes = pb->mapped_bytes - offset;
+          return;
+        }
+    }
+
+  /* fall back to reading in blocks */
+  pb->file = input_file;
+  pb->buf = (char *) mem_malloc (nenofex->mm, PARSE_BUFFER_READ_BYTES);
+}
+
+
+static void
+free_parse_buffer (Nenofex * nenofex, ParseBuffer * pb)
+{
+  if (pb->mapped)
+    munmap (pb->mapped, pb->mapped_bytes);
+  if (pb->buf)
+    mem_free (nenofex->mm, pb->buf, PARSE_BUFFER_READ_BYTES);
+}
+
+
+/*
+- skip until end of line (including newline)
+*/
+static void
+parse_buffer_skip_line (ParseBuffer * pb)
+{
+  while (parse_buffer_peek (pb) != EOF)
+    {
+      const char *nl = memchr (pb->pos, '\n', pb->end - pb->pos);
+      if (nl)
+        {
+          pb->pos = nl + 1;
+          return;
+        }
+      pb->pos = pb->end;
+    }
+}
+
+
+/*
+- scan a (possibly negative) integer at current position
+- returns zero iff no digits found or value does not fit 'int'
+*/
+static int
+parse_buffer_scan_int (ParseBuffer * pb, long int *val)
+{
+  int negative = 0, digits = 0;
+  long int result = 0;
+  int c = parse_buffer_peek (pb);
+
+  if (c == '-')
+    {
+      negative = 1;
+      parse_buffer_skip (pb);
+      c = parse_buffer_peek (pb);
+    }
+
+  while (c >= '0' && c <= '9')
+    {
+      result = 10 * result + (c - '0');
+      if (result > INT_MAX)
+        return 0;
+      digits++;
+      parse_buffer_skip (pb);
+      c = parse_buffer_peek (pb);
+    }
+
+  *val = negative ? -result : result;
+  return digits;
+}
+
+
+/*
+- scan unsigned integer after optional white space (preamble)
+*/
+static int
+parse_buffer_scan_unsigned (ParseBuffer * pb, long int *val)
+{
+  int c;
+  while ((c = parse_buffer_peek (pb)) != EOF && isspace (c))
+    parse_buffer_skip (pb);
+
+  if (c == '-' || !parse_buffer_scan_int (pb, val))
+    return 0;
+
+  c = parse_buffer_peek (pb);
+  return c == EOF || isspace (c);
+}
+
+/* --------- END: PARSE BUFFER --------- */
+
+/*
+- set up everything except memory manager, options and snapshot
+*/
+static void
+init_solver_state (Nenofex * nenofex)
+{
+  MemManager *mm = nenofex->mm;
+
+  nenofex->start_time = time_stamp ();
+
+  nenofex->scopes = create_stack (mm, DEFAULT_STACK_SIZE);
+  nenofex->unates = create_stack (mm, DEFAULT_STACK_SIZE);
+  nenofex->depending_vars = create_stack (mm, DEFAULT_STACK_SIZE);
+  nenofex->vars_marked_for_update = create_stack (mm, DEFAULT_STACK_SIZE);
+  nenofex->atpg_rr = create_atpg_redundancy_remover (mm);
+  nenofex->lca_index_stack = create_stack (mm, DEFAULT_STACK_SIZE);
+  nenofex->size_delta_nodes = create_stack (mm, DEFAULT_STACK_SIZE);
+  init_node_colds (nenofex);
+#if NODE_ARENA
+  init_node_arena (nenofex);
+#endif
+
+  init_lca_object (nenofex, &(nenofex->changed_subformula));
+
+  add_default_scope (nenofex);
+}
+
+/*
+- counterpart of 'init_solver_state', also releases graph and variables
+*/
+static void
+free_solver_state (Nenofex * nenofex)
+{
+  MemManager *mm = nenofex->mm;
+  free_graph (nenofex);
+
+  free_lca_children (nenofex, &(nenofex->changed_subformula));
+
+  Scope *scope;
+  while ((scope = pop_stack (nenofex->scopes)))
+    {
+      Var *var;
+      while ((var = pop_stack (scope->vars)))
+        {
+          delete_stack (mm, var->pos_in_lca_child_list_occs);
+          free_lca_children (nenofex, &(var->exp_costs.lca_object));
+          assert (!var->subformula_pos_occs);
+          assert (!var->subformula_neg_occs);
+          mem_free (mm, var, sizeof (Var));
+        }
+      delete_scope (nenofex, scope);
+    }
+  delete_stack (mm, nenofex->scopes);
+
+  delete_stack (mm, nenofex->unates);
+  delete_stack (mm, nenofex->vars_marked_for_update);
+  delete_stack (mm, nenofex->depending_vars);
+  delete_stack (mm, nenofex->lca_index_stack);
+  delete_stack (mm, nenofex->size_delta_nodes);
+
+  free_atpg_redundancy_remover (nenofex->atpg_rr);
+  free_node_colds (nenofex);
+#if NODE_ARENA
+  free_node_arena (nenofex);
+#endif
+}
+
+/* --------- START: SNAPSHOT --------- */
+
+static void
+delete_snapshot (Nenofex * nenofex)
+{
+  if (!nenofex->snapshot.prefix)
+    return;
+  delete_stack (nenofex->mm, nenofex->snapshot.prefix);
+  delete_stack (nenofex->mm, nenofex->snapshot.graph);
+  delete_stack (nenofex->mm, nenofex->snapshot.clauses);
+  delete_stack (nenofex->mm, nenofex->snapshot.assumptions);
+  memset (&nenofex->snapshot, 0, sizeof (nenofex->snapshot));
+}
+
+
+/*
+- prefix is recorded only while the formula is added by the API
+*/
+#define snapshot_recording(nenofex) \
+  ((nenofex)->options.incremental_specified \
+   && !(nenofex)->snapshot.replaying)
+
+
+static void
+snapshot_record (Nenofex * nenofex, Stack * stack, void **lits,
+                 unsigned int lit_cnt)
+{
+  unsigned int i;
+  for (i = 0; i < lit_cnt; i++)
+    push_stack (nenofex->mm, stack, lits[i]);
+  push_stack (nenofex->mm, stack, (void *) 0);
+}
+
+
+/*
+- all literals of the prefix are checked when recorded, this function
+  checks clauses added after solving and assumptions
+*/
+static void
+snapshot_check_lits (Nenofex * nenofex, void **lits, unsigned int lit_cnt)
+{
+  unsigned int i;
+  for (i = 0; i < lit_cnt; i++)
+    {
+      long int lit = (long int) lits[i];
+      if (lit == 0 || (unsigned long int) (lit < 0 ? -lit : lit) >
+          nenofex->num_orig_vars)
+        {
+          fprintf (stderr, "Literal out of bounds!\n");
+          exit (1);
+        }
+    }
+}
+
+
+/*
+- save simplified graph unless it is up to date, must be called before
+  'post_formula_addition_cleanup' and before expansions start
+- literals are stored as signed variable IDs since variables are freed
+  when the graph is rebuilt
+*/
+static void
+take_snapshot (Nenofex * nenofex)
+{
+  if (!nenofex->empty_clause_added && nenofex->num_added_clauses)
+    post_formula_addition_simplified (nenofex);
+
+  if (nenofex->snapshot.saved)
+    return;
+  nenofex->snapshot.saved = 1;
+
+  Stack *graph = nenofex->snapshot.graph;
+  reset_stack (graph);
+
+  if (nenofex->empty_clause_added
+      || nenofex->result == NENOFEX_RESULT_UNSAT)
+    nenofex->snapshot.unsat = 1;
+  else if (nenofex->num_added_clauses && nenofex->graph_root)
+    {
+      save_graph_for_rollback (nenofex, graph);
+      void **entry = graph->elems;
+      while (entry < graph->top)
+        {
+          if ((NodeType) (long) *entry++ != NODE_TYPE_LITERAL)
+            {
+              entry += 2;
+              continue;
+            }
+          Lit *lit = *entry;
+          long int id = lit->var->id;
+          *entry++ = (void *) (lit->negated ? -id : id);
+        }
+    }
+}
+
+
+/*
+- assign variables in graph as given by assumptions of next call only
+- for a universal variable this differs from adding a unit clause
+*/
+static void
+apply_assumptions (Nenofex * nenofex)
+{
+  MemManager *mm = nenofex->mm;
+  Stack *assumptions = nenofex->snapshot.assumptions;
+  unsigned int num_vars = nenofex->num_orig_vars;
+
+  if (!count_stack (assumptions))
+    return;
+
+  /* value of variable: 1 (true), -1 (false) or 0 (not assumed) */
+  signed char *values = mem_malloc (mm, num_vars + 1);
+  memset (values, 0, num_vars + 1);
+  int conflict = 0;
+
+  void **elem;
+  for (elem = assumptions->elems; elem < assumptions->top; elem++)
+    {
+      long int lit = (long int) *elem;
+      long int var = lit < 0 ? -lit : lit;
+      signed char value = lit < 0 ? -1 : 1;
+      if (values[var] == -value)
+        conflict = 1;
+      values[var] = value;
+    }
+  reset_stack (assumptions);
+
+  if (conflict)
+    {                           /* as if the empty clause was added */
+      nenofex->empty_clause_added = 1;
+      nenofex->num_added_clauses++;
+    }
+  else if (!nenofex->empty_clause_added && nenofex->num_added_clauses
+           && nenofex->result == NENOFEX_RESULT_UNKNOWN)
+    {
+      unsigned int id;
+      for (id = 1; id <= num_vars && nenofex->graph_root; id++)
+        {
+          Var *var = nenofex->vars[id];
+          if (!values[id] || !var)
+            continue;
+
+          Lit *true_lit = var->lits + (values[id] > 0);
+          Lit *false_lit = var->lits + (values[id] < 0);
+          Node *occ;
+
+          while (nenofex->graph_root && (occ = true_lit->occ_list.first))
+            propagate_truth (nenofex, occ);
+          while (nenofex->graph_root && (occ = false_lit->occ_list.first))
+            propagate_falsity (nenofex, occ);
+        }
+    }
+
+  mem_free (mm, values, num_vars + 1);
+}
+
+
+/*
+- rebuild graph saved by 'take_snapshot' under a root AND to which
+  clauses can be added
+*/
+static void
+restore_snapshot_graph (Nenofex * nenofex)
+{
+  MemManager *mm = nenofex->mm;
+  Stack *saved = create_stack (mm, count_stack (nenofex->snapshot.graph));
+  Stack *graph = nenofex->snapshot.graph;
+
+  void **entry = graph->elems;
+  while (entry < graph->top)
+    {
+      NodeType type = (NodeType) (long) *entry++;
+      push_stack (mm, saved, (void *) (long) type);
+      if (type != NODE_TYPE_LITERAL)
+        {
+          push_stack (mm, saved, *entry++);
+          push_stack (mm, saved, *entry++);
+          continue;
+        }
+      long int lit = (long int) *entry++;
+      unsigned int id = lit < 0 ? -lit : lit;
+      if (!nenofex->vars[id])
+        init_variable (nenofex, id, 0);
+      push_stack (mm, saved, nenofex->vars[id]->lits + (lit > 0));
+    }
+
+  /* replace empty root set up with preamble */
+  delete_node (nenofex, nenofex->graph_root);
+  nenofex->graph_root = 0;
+  restore_graph_from_rollback (nenofex, saved);
+  delete_stack (mm, saved);
+
+  Node *root = nenofex->graph_root;
+  if (is_and_node (root))
+    {
+      nenofex->num_added_clauses = root->num_children;
+      return;
+    }
+
+  /* graph is a single clause which must be simplified again */
+  nenofex->graph_root = and_node (nenofex);
+  nenofex->graph_root->size_subformula = 1 + root->size_subformula;
+  add_node_to_child_list (nenofex, nenofex->graph_root, root);
+  update_level (nenofex, root);
+  nenofex->num_added_clauses = 1;
+  nenofex->first_added_clause = root;
+}
+
+
+/*
+- release graph left by previous call of 'nenofex_solve' and rebuild the
+  simplified graph saved by 'take_snapshot'
+- clauses added since then are added to the graph, then the snapshot is
+  taken again; assumptions are applied after taking it
+*/
+static void
+restore_snapshot (Nenofex * nenofex)
+{
+  MemManager *mm = nenofex->mm;
+  unsigned int num_vars = nenofex->num_orig_vars;
+
+  post_formula_addition_cleanup (nenofex);
+  free_solver_state (nenofex);
+
+  Nenofex saved = *nenofex;
+  memset (nenofex, 0, sizeof (Nenofex));
+  nenofex->mm = mm;
+  nenofex->options = saved.options;
+  nenofex->snapshot = saved.snapshot;
+  init_solver_state (nenofex);
 
-      nenofex->first_added_clause = nenofex->second_added_clause = 0; /* need not simplify afterwards */
-    }                           /* end: root had only one clause */
+  nenofex->snapshot.replaying = 1;
 
-  /* simplify first two clauses */
-  assert (is_literal_node (nenofex->graph_root)
-          || nenofex->graph_root->num_children >= 2);
+  nenofex_set_up_preamble (nenofex, num_vars, 0);
 
-  if (nenofex->first_added_clause && !is_literal_node (nenofex->first_added_clause))  /* if is not unit */
+  Stack *prefix = nenofex->snapshot.prefix;
+  void **start = prefix->elems, **elem;
+  while (start < prefix->top)
     {
-      simplify_one_level (nenofex, nenofex->first_added_clause);
-      if (nenofex->graph_root && is_or_node (nenofex->graph_root))      /* only 1 non-unit left */
-        simplify_one_level (nenofex, nenofex->graph_root);
-      else if (nenofex->graph_root && !is_literal_node (nenofex->second_added_clause)) /* if not unit */
-        simplify_one_level (nenofex, nenofex->second_added_clause);
+      ScopeType type = (ScopeType) (long int) *start++;
+      for (elem = start; *elem; elem++)
+        ;
+      nenofex_add_orig_scope (nenofex, start, elem - start, type);
+      start = elem + 1;
     }
-  else if (nenofex->first_added_clause)        /* first is unit, check second */
+
+  Stack *clauses = nenofex->snapshot.clauses;
+  if (nenofex->snapshot.unsat)
     {
-      if (nenofex->second_added_clause && !is_literal_node (nenofex->second_added_clause))    /* if not unit */
-        simplify_one_level (nenofex, nenofex->second_added_clause);
+      nenofex->empty_clause_added = 1;
+      nenofex->num_added_clauses = 1;
+      reset_stack (clauses);
     }
+  else if (count_stack (nenofex->snapshot.graph))
+    restore_snapshot_graph (nenofex);
 
-  /* NOTE: unit elimination is performed -> actually need no 1-l-simp */
-  if (nenofex->graph_root && !is_literal_node (nenofex->graph_root))
-    simplify_one_level (nenofex, nenofex->graph_root);
-}
+  nenofex->num_orig_clauses =
+    nenofex->num_added_clauses + nenofex->snapshot.num_clauses;
 
-static void
-post_formula_addition_cleanup (Nenofex *nenofex)
-{
-  if (nenofex->vars)
+  for (start = clauses->elems; start < clauses->top; start = elem + 1)
     {
-      mem_free (nenofex->mm, nenofex->vars, (nenofex->num_orig_vars + 1) * sizeof (Var *));
-      nenofex->vars = (Var **) 0;
+      for (elem = start; *elem; elem++)
+        ;
+      nenofex_add_orig_clause (nenofex, start, elem - start);
+      nenofex->snapshot.saved = 0;
     }
+  reset_stack (clauses);
+  nenofex->snapshot.num_clauses = 0;
+
+  nenofex->snapshot.replaying = 0;
 }
 
+/* --------- END: SNAPSHOT --------- */
+
 /* --------- START: API FUNCTIONS --------- */
 
 Nenofex *
@@ -10639,20 +13028,10 @@ nenofex_create ()
 
   result->mm = mm;
 
-  result->start_time = time_stamp ();
-
-  result->scopes = create_stack (mm, DEFAULT_STACK_SIZE);
-  result->unates = create_stack (mm, DEFAULT_STACK_SIZE);
-  result->depending_vars = create_stack (mm, DEFAULT_STACK_SIZE);
-  result->vars_marked_for_update = create_stack (mm, DEFAULT_STACK_SIZE);
-  result->atpg_rr = create_atpg_redundancy_remover (mm);
-
-  init_lca_object (result, &(result->changed_subformula));
-
   /* default settings */
   set_default_cmd_line_options (result);
 
-  add_default_scope (result);
+  init_solver_state (result);
 
 #ifndef NDEBUG
   assert_solver_options (result);
@@ -10666,31 +13045,8 @@ nenofex_delete (Nenofex *nenofex)
 {
   assert (!nenofex->vars);
   MemManager *mm = nenofex->mm;
-  free_graph (nenofex);
-
-  free_lca_children (nenofex, &(nenofex->changed_subformula));
-
-  Scope *scope;
-  while ((scope = pop_stack (nenofex->scopes)))
-    {
-      Var *var;
-      while ((var = pop_stack (scope->vars)))
-        {
-          delete_stack (mm, var->pos_in_lca_child_list_occs);
-          free_lca_children (nenofex, &(var->exp_costs.lca_object));
-          assert (!var->subformula_pos_occs);
-          assert (!var->subformula_neg_occs);
-          mem_free (mm, var, sizeof (Var));
-        }
-      delete_scope (nenofex, scope);
-    }
-  delete_stack (mm, nenofex->scopes);
-
-  delete_stack (mm, nenofex->unates);
-  delete_stack (mm, nenofex->vars_marked_for_update);
-  delete_stack (mm, nenofex->depending_vars);
-
-  free_atpg_redundancy_remover (nenofex->atpg_rr);
+  free_solver_state (nenofex);
+  delete_snapshot (nenofex);
   mem_free (mm, nenofex, sizeof (Nenofex));
   memmanager_delete (mm);
 }
@@ -10699,13 +13055,27 @@ nenofex_delete (Nenofex *nenofex)
 NenofexResult 
 nenofex_solve (Nenofex *nenofex)
 {
-  if (nenofex->solve_called)
+  if (nenofex->solve_called && !nenofex->options.incremental_specified)
     {
       fprintf (stderr, "Must not call 'nenofex_solve' more than once!\n");
       exit (1);
     }
+
+  if (nenofex->options.incremental_specified && nenofex->preamble_set_up
+      && nenofex->solve_called)
+    restore_snapshot (nenofex);
+
   nenofex->solve_called = 1;
 
+  start_deadline (nenofex);
+  profile_enter (nenofex, NENOFEX_PHASE_SOLVE);
+
+  if (nenofex->options.incremental_specified && nenofex->preamble_set_up)
+    {
+      take_snapshot (nenofex);
+      apply_assumptions (nenofex);
+    }
+
 #if 0
   /* It should not matter if fewer clauses are added than were declared before. */
   if (!nenofex->empty_clause_added &&
@@ -10761,9 +13131,14 @@ nenofex_solve (Nenofex *nenofex)
   nenofex->is_universal = is_formula_universal (nenofex);
 
   if (nenofex->result == NENOFEX_RESULT_UNKNOWN &&
-      (nenofex->is_existential || nenofex->is_universal) &&
-      (!nenofex->options.no_sat_solving_specified
-       || nenofex->options.dump_cnf_specified))
+      deadline_expired (nenofex, 1))
+    {
+      /* result unknown: neither SAT solving nor dumping */
+    }
+  else if (nenofex->result == NENOFEX_RESULT_UNKNOWN &&
+           (nenofex->is_existential || nenofex->is_universal) &&
+           (!nenofex->options.no_sat_solving_specified
+            || nenofex->options.dump_cnf_specified))
     {
       sat_solving_phase (nenofex);
     }
@@ -10782,6 +13157,8 @@ nenofex_solve (Nenofex *nenofex)
                nenofex->cur_expansions);
     }
 
+  profile_leave (nenofex, NENOFEX_PHASE_SOLVE);
+
   nenofex->end_time = time_stamp ();
 
   double total_time = nenofex->end_time - nenofex->start_time;
@@ -10796,11 +13173,80 @@ nenofex_solve (Nenofex *nenofex)
     fprintf (stderr, "time:\t%.2fs with %.2fs in expansions\n",
              total_time, expansion_time);
     fprintf (stderr, "SAT solver decisions: %llu\n", nenofex->stats.sat_solver_decisions);
+    if (stats_basic (nenofex))
+      print_profile (nenofex);
     }
 
   return nenofex->result;
 }
 
+
+void
+nenofex_get_stats (Nenofex * nenofex, NenofexStats * stats)
+{
+  memset (stats, 0, sizeof (NenofexStats));
+
+  memcpy (stats->phase_seconds, nenofex->profile.seconds,
+          sizeof (stats->phase_seconds));
+  memcpy (stats->phase_calls, nenofex->profile.calls,
+          sizeof (stats->phase_calls));
+
+  stats->level = nenofex->options.stats_level;
+
+  stats->max_bytes = get_max_bytes (nenofex->mm);
+  stats->cur_bytes = get_cur_bytes (nenofex->mm);
+  stats->expansions = nenofex->cur_expansions;
+  stats->optimizations_called = nenofex->performed_optimizations;
+  stats->optimizations_succeeded = nenofex->successful_optimizations;
+  stats->sat_solver_decisions = nenofex->stats.sat_solver_decisions;
+
+  stats->max_tree_size = nenofex->stats.max_tree_size;
+  stats->units = nenofex->stats.num_units;
+  stats->unates = nenofex->stats.num_unates;
+  stats->created_nodes = nenofex->stats.num_total_created_nodes;
+  stats->deleted_nodes = nenofex->stats.total_deleted_nodes;
+  stats->non_inc_expansions = nenofex->stats.num_non_inc_expansions;
+  stats->exp_case_e_or_all = nenofex->stats.num_exp_case_E_OR_ALL;
+  stats->exp_case_e_or_subset = nenofex->stats.num_exp_case_E_OR_SUBSET;
+  stats->exp_case_e_and_all = nenofex->stats.num_exp_case_E_AND_ALL;
+  stats->exp_case_e_and_subset = nenofex->stats.num_exp_case_E_AND_SUBSET;
+  stats->exp_case_a_or_all = nenofex->stats.num_exp_case_A_OR_ALL;
+  stats->exp_case_a_or_subset = nenofex->stats.num_exp_case_A_OR_SUBSET;
+  stats->exp_case_a_and_all = nenofex->stats.num_exp_case_A_AND_ALL;
+  stats->exp_case_a_and_subset = nenofex->stats.num_exp_case_A_AND_SUBSET;
+  stats->atpg_tested_faults = nenofex->stats.atpg_tested_faults;
+  stats->atpg_redundant_faults = nenofex->stats.atpg_redundant_faults;
+  stats->atpg_sim_detected_faults = nenofex->stats.atpg_sim_detected_faults;
+  stats->global_flow_tested_nodes = nenofex->stats.global_flow_tested_nodes;
+  stats->global_flow_implications = nenofex->stats.global_flow_implications;
+  stats->opt_propagations = nenofex->stats.opt_propagations;
+  /* maintained for adaptive propagation budget at any level */
+  if (stats_basic (nenofex))
+    stats->deleted_nodes_by_optimizations =
+      nenofex->stats.deleted_nodes_by_global_flow_redundancy;
+
+  stats->non_inc_expansions_in_scores =
+    nenofex->stats.num_non_inc_expansions_in_scores;
+  stats->lca_algo_calls = nenofex->stats.num_total_lca_algo_calls;
+  stats->lca_parent_visits = nenofex->stats.num_total_lca_parent_visits;
+  stats->lca_plain_parent_visits =
+    nenofex->stats.num_total_lca_plain_parent_visits;
+  stats->lca_jump_updates = nenofex->stats.num_total_lca_jump_updates;
+  stats->lca_jump_invalidations =
+    nenofex->stats.num_total_lca_jump_invalidations;
+  stats->size_update_visits = nenofex->stats.num_total_size_update_visits;
+  stats->size_update_plain_visits =
+    nenofex->stats.num_total_size_update_plain_visits;
+}
+
+
+const char *
+nenofex_phase_name (NenofexPhase phase)
+{
+  assert (phase < NENOFEX_NUM_PHASES);
+  return phase_names[phase];
+}
+
 /*
 - parse and configure by configure-string
 */
@@ -10850,6 +13296,50 @@ nenofex_configure (Nenofex * nenofex, char *opt_str)
 	  exit (1);
         }
     }
+  else if (!strcmp (opt_str, "--cutoff-rollback"))
+    {
+      nenofex->options.cutoff_rollback_specified = 1;
+    }
+  else if (!strncmp (opt_str, "--mem-limit=", strlen ("--mem-limit=")))
+    {
+      opt_str += strlen ("--mem-limit=");
+
+      if (!is_unsigned_string (opt_str) || !strtoul (opt_str, 0, 10))
+	{
+	  fprintf (stderr,
+		   "Expecting non-zero positive integer after '--mem-limit='\n\n");
+	  exit (1);
+	}
+
+      mem_set_limit (nenofex->mm, (size_t) strtoul (opt_str, 0, 10) << 20);
+    }
+  else if (!strncmp (opt_str, "--time-limit=", strlen ("--time-limit=")))
+    {
+      opt_str += strlen ("--time-limit=");
+
+      if (!is_unsigned_string (opt_str) || !atoi (opt_str))
+	{
+	  fprintf (stderr,
+		   "Expecting non-zero positive integer after '--time-limit='\n\n");
+	  exit (1);
+	}
+
+      nenofex->options.time_limit = atoi (opt_str);
+    }
+  else if (!strncmp (opt_str, "--cpu-time-limit=",
+                     strlen ("--cpu-time-limit=")))
+    {
+      opt_str += strlen ("--cpu-time-limit=");
+
+      if (!is_unsigned_string (opt_str) || !atoi (opt_str))
+	{
+	  fprintf (stderr,
+		   "Expecting non-zero positive integer after '--cpu-time-limit='\n\n");
+	  exit (1);
+	}
+
+      nenofex->options.cpu_time_limit = atoi (opt_str);
+    }
   else if (!strncmp (opt_str, "--size-cutoff=", strlen ("--size-cutoff=")))
     {
       opt_str += strlen ("--size-cutoff=");
@@ -10922,6 +13412,71 @@ nenofex_configure (Nenofex * nenofex, char *opt_str)
 	  exit (1);
 	}
     }
+  else if (!strcmp (opt_str, "--incremental"))
+    {
+      if (nenofex->preamble_set_up)
+	{
+	  fprintf (stderr,
+		   "Option '--incremental' must be given before adding formula\n\n");
+	  exit (1);
+	}
+      nenofex->options.incremental_specified = 1;
+    }
+  else if (!strncmp (opt_str, "--stats=", strlen ("--stats=")))
+    {
+      opt_str += strlen ("--stats=");
+
+      if (!strcmp (opt_str, "off"))
+	nenofex->options.stats_level = NENOFEX_STATS_OFF;
+      else if (!strcmp (opt_str, "basic"))
+	nenofex->options.stats_level = NENOFEX_STATS_BASIC;
+      else if (!strcmp (opt_str, "full"))
+	nenofex->options.stats_level = NENOFEX_STATS_FULL;
+      else
+	{
+	  fprintf (stderr,
+		   "Expecting 'off', 'basic' or 'full' after '--stats='\n\n");
+	  exit (1);
+	}
+    }
+  else if (!strncmp
+	   (opt_str, "--opt-budget=", strlen ("--opt-budget=")))
+    {
+      opt_str += strlen ("--opt-budget=");
+
+      if (!strcmp (opt_str, "static"))
+	nenofex->options.opt_budget_static_specified = 1;
+      else if (!strcmp (opt_str, "adaptive"))
+	nenofex->options.opt_budget_static_specified = 0;
+      else
+	{
+	  fprintf (stderr,
+		   "Expecting 'static' or 'adaptive' after '--opt-budget='\n\n");
+	  exit (1);
+	}
+    }
+  else if (!strncmp
+	   (opt_str, "--opt-time-share=", strlen ("--opt-time-share=")))
+    {
+      opt_str += strlen ("--opt-time-share=");
+
+      if (strlen (opt_str) == 0)
+	{
+	  fprintf (stderr, "Expecting value after '--opt-time-share='\n\n");
+	  exit (1);
+	}
+
+      if (is_unsigned_string (opt_str) && atoi (opt_str) <= 100)
+	{
+	  nenofex->options.opt_time_share = atoi (opt_str);
+	}
+      else
+	{
+	  fprintf (stderr,
+		   "Expecting integer in [0,100] after '--opt-time-share='\n\n");
+	  exit (1);
+	}
+    }
   else if (!strncmp (opt_str, "--univ-trigger=", strlen ("--univ-trigger=")))
     {
       opt_str += strlen ("--univ-trigger=");
@@ -11003,6 +13558,20 @@ nenofex_configure (Nenofex * nenofex, char *opt_str)
 
       nenofex->options.opt_subgraph_limit_specified = 1;
     }
+  else if (!strncmp
+	   (opt_str, "--score-threads=", strlen ("--score-threads=")))
+    {
+      opt_str += strlen ("--score-threads=");
+
+      if (is_unsigned_string (opt_str) && atoi (opt_str) > 0)
+	nenofex->options.score_threads = atoi (opt_str);
+      else
+	{
+	  fprintf (stderr,
+		   "Expecting non-zero positive integer after '--score-threads='\n\n");
+	  exit (1);
+	}
+    }
   else if (!strncmp
 	   (opt_str, "--sat-solver-dec-limit=",
 	    strlen ("--sat-solver-dec-limit=")))
@@ -11023,6 +13592,21 @@ nenofex_configure (Nenofex * nenofex, char *opt_str)
 	  exit (1);
 	}
     }
+  else if (!strncmp
+	   (opt_str, "--sat-backend=", strlen ("--sat-backend=")))
+    {
+      opt_str += strlen ("--sat-backend=");
+      const SATSolverBackend *backend = find_sat_solver_backend (opt_str);
+      if (backend)
+	nenofex->options.sat_solver_backend = backend;
+      else
+	{
+	  fprintf (stderr, "Unknown SAT backend '%s', available: ", opt_str);
+	  print_sat_solver_backends (stderr);
+	  fprintf (stderr, "\n\n");
+	  exit (1);
+	}
+    }
   else if (!strcmp (opt_str, "--verbose-sat-solving"))
     {
       nenofex->options.verbose_sat_solving_specified = 1;
@@ -11039,6 +13623,18 @@ nenofex_configure (Nenofex * nenofex, char *opt_str)
     {
       nenofex->options.post_expansion_flattening_specified = 1;
     }
+  else if (!strcmp (opt_str, "--dedup-sibling-clauses"))
+    {
+      nenofex->options.dedup_sibling_clauses_specified = 1;
+    }
+  else if (!strcmp (opt_str, "--lazy-scores"))
+    {
+      nenofex->options.lazy_scores_specified = 1;
+    }
+  else if (!strcmp (opt_str, "--bounded-scores"))
+    {
+      nenofex->options.bounded_scores_specified = 1;
+    }
   else if (!strcmp (opt_str, "--no-atpg"))
     {
       nenofex->options.no_atpg_specified = 1;
@@ -11133,56 +13729,18 @@ nenofex_parse (Nenofex * nenofex, FILE * input_file)
   ScopeType parsed_scope_type = 0;
   Stack *lit_stack = create_stack (nenofex->mm, DEFAULT_STACK_SIZE);
 
-  char c;
-  while ((c = fgetc (input_file)) != EOF)
-    {
-      assert (nenofex->result == NENOFEX_RESULT_UNKNOWN);
-
-      if (c == 'c')
-        {
-          while ((c = fgetc (input_file)) != EOF && c != '\n')
-            ;
-        }
-      else if (c == 'p')
-        {
-          if (preamble_found)
-            {
-              fprintf (stderr, "Preamble already occurred!\n\n");
-              exit (1);
-            }
-
-          if ((c = fgetc (input_file)) != ' ' ||
-              (c = fgetc (input_file)) != 'c' ||
-              (c = fgetc (input_file)) != 'n' ||
-              (c = fgetc (input_file)) != 'f' ||
-              (c = fgetc (input_file)) != ' ')
-            {
-              fprintf (stderr, "Malformed preamble!\n\n");
-              exit (1);
-            }
-
-          char num_vars_str[128] = { '\0' };
-          char num_clauses_str[128] = { '\0' };
-
-          fscanf (input_file, "%s", num_vars_str);
-          fscanf (input_file, "%s", num_clauses_str);
-
-          if (!is_unsigned_string (num_vars_str)
-              || !is_unsigned_string (num_clauses_str))
-            {
-              fprintf (stderr, "Malformed preamble!\n\n");
-              exit (1);
-            }
+  profile_enter (nenofex, NENOFEX_PHASE_PARSE);
 
-          unsigned int num_vars, num_clauses;
-          num_vars = atoi (num_vars_str);
-          num_clauses = atoi (num_clauses_str);
+  double parse_time = time_stamp ();
+  ParseBuffer pb;
+  init_parse_buffer (nenofex, &pb, input_file);
 
-          nenofex_set_up_preamble (nenofex, num_vars, num_clauses);
+  int c;
+  while ((c = parse_buffer_peek (&pb)) != EOF)
+    {
+      assert (nenofex->result == NENOFEX_RESULT_UNKNOWN);
 
-          preamble_found = 1;
-        }
-      else if (c == '-' || isdigit (c))
+      if (c == '-' || isdigit (c))
         {
           if (!preamble_found)
             {
@@ -11190,13 +13748,14 @@ nenofex_parse (Nenofex * nenofex, FILE * input_file)
               exit (1);
             }
 
-
           closed = 0;
 
-          ungetc (c, input_file);
-
           long int val;
-          fscanf (input_file, "%ld", &val);
+          if (!parse_buffer_scan_int (&pb, &val))
+            {
+              fprintf (stderr, "Parsing: malformed literal!\n");
+              exit (1);
+            }
 
           if (val == 0)
             {
@@ -11211,6 +13770,7 @@ nenofex_parse (Nenofex * nenofex, FILE * input_file)
                     {           /* empty clause */
                       result = NENOFEX_RESULT_UNSAT;
                       nenofex->result = NENOFEX_RESULT_UNSAT;
+                      parse_time = time_stamp () - parse_time;
                       goto SKIP_SIMPLIFY;
                     }
 
@@ -11229,6 +13789,42 @@ nenofex_parse (Nenofex * nenofex, FILE * input_file)
             {
               push_stack (nenofex->mm, lit_stack, (void *) val);
             }
+          continue;
+        }
+
+      parse_buffer_skip (&pb);
+
+      if (c == 'c')
+        {
+          parse_buffer_skip_line (&pb);
+        }
+      else if (c == 'p')
+        {
+          if (preamble_found)
+            {
+              fprintf (stderr, "Preamble already occurred!\n\n");
+              exit (1);
+            }
+
+          const char *cnf = " cnf ";
+          while (*cnf && parse_buffer_peek (&pb) == *cnf)
+            {
+              parse_buffer_skip (&pb);
+              cnf++;
+            }
+
+          long int num_vars, num_clauses;
+
+          if (*cnf || !parse_buffer_scan_unsigned (&pb, &num_vars)
+              || !parse_buffer_scan_unsigned (&pb, &num_clauses))
+            {
+              fprintf (stderr, "Malformed preamble!\n\n");
+              exit (1);
+            }
+
+          nenofex_set_up_preamble (nenofex, num_vars, num_clauses);
+
+          preamble_found = 1;
         }
       else if (c == 'a')
         {
@@ -11256,6 +13852,8 @@ nenofex_parse (Nenofex * nenofex, FILE * input_file)
 
     }                           /* end: while not end of file */
 
+  parse_time = time_stamp () - parse_time;
+
   assert (nenofex->result == NENOFEX_RESULT_UNKNOWN);
 
   if (!preamble_found)
@@ -11300,9 +13898,22 @@ nenofex_parse (Nenofex * nenofex, FILE * input_file)
 
 SKIP_SIMPLIFY:
 
+  if (!nenofex->options.print_short_answer_specified)
+    {
+      double mb = pb.total_bytes / (1024.0 * 1024.0);
+      fprintf (stderr, "parsing: %.2f MB%s in %.2fs", mb,
+               pb.mapped ? " (mapped)" : "", parse_time);
+      if (parse_time > 0)
+        fprintf (stderr, " (%.2f MB/s)", mb / parse_time);
+      fprintf (stderr, "\n");
+    }
+
+  free_parse_buffer (nenofex, &pb);
   post_formula_addition_cleanup (nenofex);
   delete_stack (nenofex->mm, lit_stack);
 
+  profile_leave (nenofex, NENOFEX_PHASE_PARSE);
+
   return result;
 }
 
@@ -11332,6 +13943,18 @@ nenofex_set_up_preamble (Nenofex * nenofex, unsigned int num_vars,
   nenofex->tseitin_next_id = num_vars + 1;
   nenofex->num_orig_clauses = num_clauses;
   set_cnf_root (nenofex);
+
+  if (snapshot_recording (nenofex))
+    {
+      nenofex->snapshot.prefix = create_stack (nenofex->mm,
+                                               DEFAULT_STACK_SIZE);
+      nenofex->snapshot.graph = create_stack (nenofex->mm,
+                                              DEFAULT_STACK_SIZE);
+      nenofex->snapshot.clauses = create_stack (nenofex->mm,
+                                                DEFAULT_STACK_SIZE);
+      nenofex->snapshot.assumptions = create_stack (nenofex->mm,
+                                                    DEFAULT_STACK_SIZE);
+    }
 }
 
 /*
@@ -11389,6 +14012,13 @@ nenofex_add_orig_scope (Nenofex * nenofex, void **lits, unsigned int lit_cnt,
     }
 
   push_stack (nenofex->mm, nenofex->scopes, scope);
+
+  if (snapshot_recording (nenofex))
+    {
+      push_stack (nenofex->mm, nenofex->snapshot.prefix,
+                  (void *) (long int) parsed_scope_type);
+      snapshot_record (nenofex, nenofex->snapshot.prefix, lits, lit_cnt);
+    }
 }
 
 /*
@@ -11403,6 +14033,20 @@ nenofex_add_orig_clause (Nenofex * nenofex, void **lits, unsigned int lit_cnt)
       exit (1);
     }
 
+  if (nenofex->solve_called)
+    {
+      if (!nenofex->options.incremental_specified)
+        {
+          fprintf (stderr, "Must not call 'nenofex_add_orig_clause' after solving!\n");
+          exit (1);
+        }
+      /* added to graph by next call of 'nenofex_solve' */
+      snapshot_check_lits (nenofex, lits, lit_cnt);
+      snapshot_record (nenofex, nenofex->snapshot.clauses, lits, lit_cnt);
+      nenofex->snapshot.num_clauses++;
+      return;
+    }
+
   nenofex->num_added_clauses++;
 
   if (lit_cnt == 0)
@@ -11496,4 +14140,20 @@ nenofex_add_orig_clause (Nenofex * nenofex, void **lits, unsigned int lit_cnt)
   return;
 }
 
+void
+nenofex_assume (Nenofex * nenofex, void **lits, unsigned int lit_cnt)
+{
+  if (!nenofex->options.incremental_specified || !nenofex->preamble_set_up)
+    {
+      fprintf (stderr, "ERROR: 'nenofex_assume' requires option '--incremental' and a preamble!\n");
+      exit (1);
+    }
+
+  snapshot_check_lits (nenofex, lits, lit_cnt);
+
+  unsigned int i;
+  for (i = 0; i < lit_cnt; i++)
+    push_stack (nenofex->mm, nenofex->snapshot.assumptions, lits[i]);
+}
+
 /* --------- END: API FUNCTIONS --------- */
@@ -36,8 +36,97 @@ enum ScopeType
   SCOPE_TYPE_UNIVERSAL = 2
 };
 
+/* Phases timed by the built-in profiler. Time spent in a nested phase, e.g.
+   copying subgraphs during an expansion, is not counted for the enclosing
+   phase. */
+enum NenofexPhase
+{
+  NENOFEX_PHASE_PARSE = 0,      /* 'nenofex_parse' */
+  NENOFEX_PHASE_SOLVE,          /* 'nenofex_solve' outside other phases */
+  NENOFEX_PHASE_SIMPLIFY,       /* units, unates, duplicate sibling clauses */
+  NENOFEX_PHASE_SCORES,         /* computing and updating expansion costs */
+  NENOFEX_PHASE_EXPAND,         /* expansions except copying */
+  NENOFEX_PHASE_COPY,           /* copying subgraphs */
+  NENOFEX_PHASE_OPTIMIZE,       /* set up and clean up of optimizations */
+  NENOFEX_PHASE_GLOBAL_FLOW,    /* global flow optimization */
+  NENOFEX_PHASE_ATPG,           /* ATPG redundancy removal */
+  NENOFEX_PHASE_CNF,            /* NNF-to-CNF conversion */
+  NENOFEX_PHASE_SAT,            /* SAT solver */
+  NENOFEX_NUM_PHASES
+};
+
+/* Statistics collected by a solver object, see '--stats=<level>'. */
+enum NenofexStatsLevel
+{
+  NENOFEX_STATS_OFF = 0,        /* nothing except counters needed anyway */
+  NENOFEX_STATS_BASIC = 1,      /* cheap counters and profiler (default) */
+  NENOFEX_STATS_FULL = 2        /* also counters in inner loops, slower */
+};
+
 typedef enum NenofexResult NenofexResult;
 typedef enum ScopeType ScopeType;
+typedef enum NenofexPhase NenofexPhase;
+typedef enum NenofexStatsLevel NenofexStatsLevel;
+typedef struct NenofexStats NenofexStats;
+
+/* Statistics of a solver object, filled by 'nenofex_get_stats'. */
+struct NenofexStats
+{
+  /* Per phase: wall-clock time in seconds measured by a monotonic clock and
+     number of times the phase was entered. */
+  double phase_seconds[NENOFEX_NUM_PHASES];
+  unsigned long long phase_calls[NENOFEX_NUM_PHASES];
+
+  /* Level the statistics were collected with. Counters belonging to a
+     higher level are zero. */
+  NenofexStatsLevel level;
+
+  /* Collected at any level. Peak and current number of bytes allocated
+     by the solver object, not including the SAT solver. */
+  unsigned long long max_bytes;
+  unsigned long long cur_bytes;
+  unsigned long long expansions;
+  unsigned long long optimizations_called;
+  unsigned long long optimizations_succeeded;
+  unsigned long long sat_solver_decisions;
+
+  /* Level 'NENOFEX_STATS_BASIC'. */
+  unsigned long long max_tree_size;
+  unsigned long long units;
+  unsigned long long unates;
+  unsigned long long created_nodes;
+  unsigned long long deleted_nodes;
+  unsigned long long deleted_nodes_by_optimizations;
+  unsigned long long non_inc_expansions;
+  /* Expansions by quantifier of variable ('e' or 'a'), type of LCA ('or' or
+     'and') and whether the LCA has occurrences of the variable as children
+     only ('all') or other children as well ('subset'). */
+  unsigned long long exp_case_e_or_all;
+  unsigned long long exp_case_e_or_subset;
+  unsigned long long exp_case_e_and_all;
+  unsigned long long exp_case_e_and_subset;
+  unsigned long long exp_case_a_or_all;
+  unsigned long long exp_case_a_or_subset;
+  unsigned long long exp_case_a_and_all;
+  unsigned long long exp_case_a_and_subset;
+  /* Optimizations, summed up over all calls. */
+  unsigned long long atpg_tested_faults;
+  unsigned long long atpg_redundant_faults;
+  unsigned long long atpg_sim_detected_faults;
+  unsigned long long global_flow_tested_nodes;
+  unsigned long long global_flow_implications;
+  unsigned long long opt_propagations;
+
+  /* Level 'NENOFEX_STATS_FULL'. */
+  unsigned long long non_inc_expansions_in_scores;
+  unsigned long long lca_algo_calls;
+  unsigned long long lca_parent_visits;
+  unsigned long long lca_plain_parent_visits;
+  unsigned long long lca_jump_updates;
+  unsigned long long lca_jump_invalidations;
+  unsigned long long size_update_visits;
+  unsigned long long size_update_plain_visits;
+};
 
 /****************************************************************************
 IMPORTANT NOTE: please see also the example program
@@ -70,10 +159,26 @@ void nenofex_add_orig_clause (Nenofex *, void **, unsigned int);
 void nenofex_configure (Nenofex *, char *);
 
 /* Solve added formula. 
-   IMPORTANT NOTE: this function can be called at most once, i.e., the library
-   cannot be used in an incremental way. In particular, it is not possible to
-   modify the formula after a call of 'nenofex_solve' and then call
-   'nenofex_solve' again. */
+   IMPORTANT NOTE: this function can be called at most once unless the solver
+   object was configured by '--incremental' before the preamble was set up.
+   In incremental mode, the formula is kept and clauses may be added by
+   'nenofex_add_orig_clause' after solving. Every further call rebuilds the
+   simplified formula saved before expansions started. Statistics refer to
+   the most recent call. */
 NenofexResult nenofex_solve (Nenofex *);
 
+/* Incremental mode only: fix the values of the given literals for the next
+   call of 'nenofex_solve'. Assignments are applied to the formula before
+   solving, which for a universal variable is different from adding a unit
+   clause. Conflicting assumptions make the formula unsatisfiable. */
+void nenofex_assume (Nenofex *, void **, unsigned int);
+
+/* Copy statistics collected so far to the given object. Can be called before
+   and after 'nenofex_solve' but not concurrently with other functions on the
+   same solver object. */
+void nenofex_get_stats (Nenofex *, NenofexStats *);
+
+/* Return printable name of phase. */
+const char *nenofex_phase_name (NenofexPhase);
+
 #endif /* _NENOFEX_H_ */
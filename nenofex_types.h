@@ -21,13 +21,17 @@
 #ifndef _NENOFEX_TYPES_H_
 #define _NENOFEX_TYPES_H_
 
-#include "../picosat/picosat.h"
+#include <stdint.h>
+#include "satsolver.h"
 #include "mem.h"
 #include "stack.h"
+#include "pqueue.h"
 #include "queue.h"
 #include "nenofex.h"
 
 typedef struct Node Node;
+typedef struct NodeCold NodeCold;
+typedef struct NodeBlock NodeBlock;
 typedef struct Var Var;
 typedef struct Lit Lit;
 typedef struct LevelLink LevelLink;
@@ -74,13 +78,32 @@ typedef enum NodeType NodeType;
 #define is_or_node(node) ((node)->type == NODE_TYPE_OR)
 #define is_and_node(node) ((node)->type == NODE_TYPE_AND)
 
+/*
+- set to 1 in order to keep nodes in a node arena where links between nodes
+  are 32-bit references instead of pointers (see 'NodeBlock')
+*/
+#ifndef NODE_ARENA
+#define NODE_ARENA 0
+#endif
+
+/*
+- link from a node to another node
+- 'node_at' yields the node a link refers to, 'node_ref' the link to a node
+- null link is 0 in both modes
+*/
+#if NODE_ARENA
+typedef unsigned int NodeRef;
+#else
+typedef Node *NodeRef;
+#endif
+
 /*
 - all children of a node are linked
 */
 struct LevelLink
 {
-  Node *next;
-  Node *prev;
+  NodeRef next;
+  NodeRef prev;
 };
 
 /*
@@ -88,8 +111,8 @@ struct LevelLink
 */
 struct OccurrenceLink
 {
-  Node *next;
-  Node *prev;
+  NodeRef next;
+  NodeRef prev;
 };
 
 /*
@@ -98,8 +121,8 @@ struct OccurrenceLink
 */
 struct ChildList
 {
-  Node *first;
-  Node *last;
+  NodeRef first;
+  NodeRef last;
 };
 
 /*
@@ -198,21 +221,32 @@ struct Var
 
   SameLCALink same_lca_link;
 
-  int priority_pos;
+  /* slot in priority queue of scope or -1 */
+  int priority_slot;
 
   Var *copied;                  /* during universal expansions: pointer to copied variable */
 };
 
+/* counters maintained at given level of 'options.stats_level' */
+#define stats_basic(nenofex) \
+  ((nenofex)->options.stats_level >= NENOFEX_STATS_BASIC)
+#define stats_full(nenofex) \
+  ((nenofex)->options.stats_level >= NENOFEX_STATS_FULL)
+
+/* maximum nesting of profiled phases */
+#define PROFILE_MAX_DEPTH 8
+
 struct Nenofex
 {
   MemManager *mm;
-  PicoSAT *picosat;
+  /* instance of SAT solver backend, see 'options.sat_solver_backend' */
+  void *sat_solver;
   /* Keeping track of first two added clauses for special cases in
      graph simplification. */
   Node *first_added_clause;
   Node *second_added_clause;
   unsigned int preamble_set_up:1;
-  /* Must not call 'solve' function multiple time. */
+  /* Must not call 'solve' function multiple time unless incremental. */
   unsigned int solve_called:1;
   unsigned int post_formula_addition_simplified:1;
   unsigned int empty_clause_added:1;
@@ -221,6 +255,22 @@ struct Nenofex
   unsigned int num_added_clauses;
   unsigned int num_cur_remaining_scope_vars;
   unsigned int next_free_node_id;
+
+  /* cold parts of nodes, record 0 is all-zero and never handed out */
+  NodeCold *node_colds;
+  unsigned int size_node_colds;
+  unsigned int next_node_cold;
+  unsigned int free_node_cold;  /* released records, linked by 'next_free' */
+
+#if NODE_ARENA
+  /* node arena, see 'NodeBlock' */
+  NodeBlock **node_blocks;
+  unsigned int size_node_blocks;
+  unsigned int num_node_blocks;
+  unsigned int next_node_slot;  /* first never used slot in last block */
+  NodeRef free_node;            /* released nodes, linked by 'parent' */
+#endif
+
   Var **vars;
   Node *graph_root;
   NenofexResult result;
@@ -255,6 +305,12 @@ struct Nenofex
 
   LCAObject changed_subformula;
 
+  Stack *lca_index_stack;
+
+  /* nodes with pending size deltas while size updates are deferred */
+  Stack *size_delta_nodes;
+  int size_updates_deferred;
+
   int tseitin_next_id;
   int tseitin_first_op_node_id;
 
@@ -263,11 +319,18 @@ struct Nenofex
   int is_existential;
   int is_universal;
 
+  /* sums of 'occ_var_cnt' over existential and universal scopes */
+  unsigned int exist_occ_var_cnt;
+  unsigned int univ_occ_var_cnt;
+
   int cur_expansions;
   int first_successful_opt;
   int performed_optimizations;
   int successful_optimizations;
   int cnt_post_expansion_flattenings;
+  /* duplicate sibling clauses (nodes) deleted */
+  int cnt_dedup_sibling_clauses;
+  int cnt_dedup_sibling_nodes;
 
   struct
   {
@@ -300,10 +363,34 @@ struct Nenofex
     int num_total_created_nodes;
     unsigned int max_tree_size;
 
-    int num_total_lca_parent_visits;
-    int num_total_lca_algo_calls;
+    long long num_total_lca_parent_visits;
+    long long num_total_lca_algo_calls;
+    /* parent visits without LCA index, jump pointers (re)computed, reset */
+    long long num_total_lca_plain_parent_visits;
+    long long num_total_lca_jump_updates;
+    long long num_total_lca_jump_invalidations;
+
+    /* nodes visited by size updates, visits when updating eagerly */
+    long long num_total_size_update_visits;
+    long long num_total_size_update_plain_visits;
 
     unsigned long long sat_solver_decisions;
+
+    /* optimizations, summed up over all calls */
+    unsigned long long atpg_tested_faults;
+    unsigned long long atpg_redundant_faults;
+    unsigned long long atpg_sim_detected_faults;
+    unsigned long long global_flow_tested_nodes;
+    unsigned long long global_flow_implications;
+    unsigned long long opt_propagations;
+    /* '--lazy-scores': variables left marked, scores updated at top */
+    unsigned long long lazy_deferred_updates;
+    unsigned long long lazy_score_updates;
+    /* '--bounded-scores': decrease scores replaced by upper bound */
+    unsigned long long bounded_dec_scores;
+    /* '--cutoff-rollback': graphs saved before, restored after expansions */
+    unsigned long long rollback_snapshots;
+    unsigned long long rollbacks;
   } stats;
 
   struct
@@ -322,6 +409,9 @@ struct Nenofex
     int propagation_limit_specified;
     int propagation_limit;
 
+    int opt_budget_static_specified;
+    unsigned int opt_time_share;
+
     int opt_subgraph_limit_specified;
     int opt_subgraph_limit;
 
@@ -334,6 +424,13 @@ struct Nenofex
     int no_global_flow_specified;
 
     int post_expansion_flattening_specified;
+    int dedup_sibling_clauses_specified;
+    /* update scores of marked variables only at top of priority queue */
+    int lazy_scores_specified;
+    /* skip decrease score if costs exceed cheapest variable anyway */
+    int bounded_scores_specified;
+    /* threads for initial scoring of scope variables */
+    unsigned int score_threads;
 
     int verbose_sat_solving_specified;
     int full_expansion_specified;
@@ -349,6 +446,8 @@ struct Nenofex
     int cnf_generator_tseitin_revised_specified;
     /* Decision limit for SAT solver called in the end. */
     int sat_solver_dec_limit;
+    /* SAT solver called in the end, PicoSAT by default. */
+    const SATSolverBackend *sat_solver_backend;
     /* Limit (factor) on the absolute size of the graph, which is different
        from 'size_cutoff' or 'cost_cutoff' limits, which allow to bound the
        growth of the graph after expansions. Cut off will occur if the current
@@ -356,8 +455,55 @@ struct Nenofex
        abs_graph_size_cutoff', where 'initial_graph' is the size at the beginning
        of the expansion phase. */
     float abs_graph_size_cutoff;
+    /* undo expansion exceeding a size cutoff if formula before it was
+       propositional, which is then forwarded to the SAT solver */
+    int cutoff_rollback_specified;
+    /* Limits in seconds on wall-clock time and CPU time of the calling
+       thread spent in 'nenofex_solve', '0' if none. */
+    unsigned int time_limit;
+    unsigned int cpu_time_limit;
+    /* which counters in 'stats' and 'profile' are maintained */
+    NenofexStatsLevel stats_level;
+    /* keep 'snapshot' to allow several calls of 'nenofex_solve' */
+    int incremental_specified;
   } options;
 
+  /* Incremental mode: simplified graph saved before expansions, rebuilt
+     by a further call of 'nenofex_solve'. Elements of 'prefix' are the
+     scope type, its variables and '0' for each scope, 'graph' is saved by
+     'take_snapshot', 'clauses' are literals terminated by '0'. */
+  struct
+  {
+    Stack *prefix;
+    Stack *graph;
+    Stack *clauses;             /* added after last call, not in 'graph' */
+    Stack *assumptions;         /* for next call of 'nenofex_solve' only */
+    unsigned int num_clauses;   /* in 'clauses' */
+    unsigned int saved:1;       /* 'graph' is up to date */
+    unsigned int unsat:1;       /* graph is false, 'graph' is empty */
+    unsigned int replaying:1;
+  } snapshot;
+
+  /* Built-in profiler, see 'profile_enter' and 'profile_leave'. */
+  struct
+  {
+    double seconds[NENOFEX_NUM_PHASES];
+    unsigned long long calls[NENOFEX_NUM_PHASES];
+    NenofexPhase stack[PROFILE_MAX_DEPTH];  /* nested phases entered */
+    unsigned int depth;
+    double last;                /* time of last phase change */
+  } profile;
+
+  /* Deadline derived from 'time_limit' and 'cpu_time_limit', polled by
+     expansions, optimizations and the SAT solving phase. */
+  struct
+  {
+    double wall_start;
+    double cpu_start;
+    unsigned int countdown;
+    unsigned int expired:1;
+  } deadline;
+
   double start_time;
   double expansion_phase_end_time;
   double end_time;
@@ -367,25 +513,66 @@ struct Nenofex
 /*
 - some fields are used for literal nodes / operator nodes only
 */
+/*
+- anonymous unions are not part of C99 but accepted by GCC and Clang
+*/
+#ifdef __GNUC__
+#define NENOFEX_ANONYMOUS __extension__
+#else
+#define NENOFEX_ANONYMOUS
+#endif
+
+#define NODE_LEVEL_BITS 26
+
+/*
+- only fields read on (almost) every step of a traversal, fits into one 
+  cache line of 64 bytes on 64-bit platforms (48 bytes with 'NODE_ARENA')
+- fields used either by literals or by operators share storage
+- remaining fields are kept in a 'NodeCold' record allocated on demand
+*/
 struct Node
 {
-  int id;
-  unsigned int level;
-  NodeType type;
-  Node *parent;
+  NodeRef parent;
   LevelLink level_link;
 
-  ChildList child_list;         /* for operators only */
-  OccurrenceLink occ_link;      /* for literals only */
+  NENOFEX_ANONYMOUS union
+  {
+    ChildList child_list;       /* for operators only */
+    OccurrenceLink occ_link;    /* for literals only */
+  };
 
-  Lit *lit;                     /* for literals only */
-  unsigned int num_children;    /* actually not needed for literals */
+  NENOFEX_ANONYMOUS union
+  {
+    Lit *lit;                   /* for literals only */
+    unsigned int num_children;  /* for operators only */
+  };
 
+  int id;
   unsigned int size_subformula; /* node count in subformula rooted at 'node' */
-#ifndef NDEBUG
-  unsigned int test_size_subformula;    /* size is recalculated during testing */
-#endif
 
+  /* index of cold part in 'nenofex->node_colds', zero if none */
+  unsigned int cold;
+
+  unsigned int level:NODE_LEVEL_BITS;
+  unsigned int type:2;          /* NodeType */
+
+  /* multi-purpose marks */
+  unsigned int mark1:1;
+  unsigned int mark2:1;
+/* #ifndef NDEBUG */
+  unsigned int mark3:1;
+/* #endif */
+};
+
+/*
+- rarely used fields of a node
+- read by 'node_cold' which yields the all-zero record 0 for nodes
+  without cold part: call 'alloc_node_cold' before writing
+- records move when the table grows: do not keep pointers to records
+  across calls of 'alloc_node_cold'
+*/
+struct NodeCold
+{
   ATPGInfo *atpg_info;
 
   VarLCAList var_lca_list;      /* CONJECTURE: not for lits if unates fully elim. */
@@ -395,19 +582,80 @@ struct Node
    */
   Node **changed_ch_list_pos;
 
+  /* jump pointer for LCA queries, null if not computed since last change */
+  Node *lca_jump;
+
   /* stores pointers to vars where 'node' occurs in LCA child-list of vars */
   Stack *lca_child_list_occs;
   /* parallel collection to 'occs': position of 'node' in LCA-children of variable */
   Stack *pos_in_lca_children;
 
-  /* multi-purpose marks */
-  unsigned int mark1:1;
-  unsigned int mark2:1;
-/* #ifndef NDEBUG */
-  unsigned int mark3:1;
-/* #endif */
+  /* deferred size update: delta not yet added to 'node' and its ancestors,
+     position in 'size_delta_nodes' (offset by one, zero if none) */
+  int size_delta;
+  unsigned int size_delta_pos;
+
+#ifndef NDEBUG
+  unsigned int test_size_subformula;    /* size is recalculated during testing */
+#endif
+  unsigned int next_free;       /* link in list of released records */
+};
+
+#if NODE_ARENA
+
+/*
+- nodes are carved out of blocks of 'NODE_BLOCK_BYTES' bytes, each block 
+  aligned to its size
+- reference to a node: index of block in 'nenofex->node_blocks' in upper
+  bits, index of node in block in lower 'NODE_BLOCK_SLOT_BITS' bits
+- block of a node is found by masking the node's address, hence nodes need
+  not store their own reference
+- reference 0 is never handed out (first slot of block 0 is unused)
+*/
+#define NODE_BLOCK_BYTES (64 * 1024)
+#define NODE_BLOCK_SLOT_BITS 11
+#define NODE_BLOCK_SLOTS \
+  ((NODE_BLOCK_BYTES - offsetof (NodeBlock, nodes)) / sizeof (Node))
+
+struct NodeBlock
+{
+  unsigned int index;           /* position in 'nenofex->node_blocks' */
+  Node nodes[];
 };
 
+static inline Node *
+node_block_at (NodeBlock ** blocks, NodeRef ref)
+{
+  if (!ref)
+    return 0;
+  return blocks[ref >> NODE_BLOCK_SLOT_BITS]->nodes +
+    (ref & ((1u << NODE_BLOCK_SLOT_BITS) - 1));
+}
+
+static inline NodeRef
+node_block_ref (Node * node)
+{
+  if (!node)
+    return 0;
+  NodeBlock *block = (NodeBlock *) ((uintptr_t) node &
+                                    ~((uintptr_t) NODE_BLOCK_BYTES - 1));
+  return (block->index << NODE_BLOCK_SLOT_BITS) |
+    (unsigned int) (node - block->nodes);
+}
+
+#define node_at(nenofex, ref) (node_block_at ((nenofex)->node_blocks, (ref)))
+#define node_ref(nenofex, node) (node_block_ref (node))
+
+#else
+
+#define node_at(nenofex, ref) (ref)
+#define node_ref(nenofex, node) (node)
+
+#endif
+
+#define node_cold(nenofex, node) ((nenofex)->node_colds + (node)->cold)
+#define node_atpg_info(nenofex, node) (node_cold (nenofex, node)->atpg_info)
+
 #define is_existential_scope(scope) ((scope)->type == SCOPE_TYPE_EXISTENTIAL)
 #define is_universal_scope(scope) ((scope)->type == SCOPE_TYPE_UNIVERSAL)
 
@@ -416,9 +664,11 @@ struct Scope
   unsigned int nesting;
   ScopeType type;
   Stack *vars;
-  Stack *priority_heap;
+  PQueue *priority_heap;
   unsigned int is_empty:1;
   int remaining_var_cnt;
+  /* variables having occurrences, maintained by occurrence list updates */
+  unsigned int occ_var_cnt;
 };
 
 void remove_and_free_subformula (Nenofex * nenofex, Node * root);
@@ -448,6 +698,16 @@ void reset_changed_lca_object (Nenofex * nenofex);
 
 void add_changed_lca_child (Nenofex * nenofex, Node * node);
 
+double solve_cpu_time (Nenofex * nenofex);
+
+int deadline_expired (Nenofex * nenofex, int force);
+
+void profile_enter (Nenofex * nenofex, NenofexPhase phase);
+
+void profile_leave (Nenofex * nenofex, NenofexPhase phase);
+
+NodeCold *alloc_node_cold (Nenofex * nenofex, Node * node);
+
 
 #define variable_has_occs(var) ((var)->lits[0].occ_list.first || \
 				(var)->lits[1].occ_list.first)
@@ -476,8 +736,9 @@ void collect_variable_for_update (Nenofex * nenofex, Var * var);
 - NOT YET COMPLETED NOR VERIFIED -> handle with care
 */
 #define RESTRICT_ATPG_FAULT_NODE_SET 0  /* disabling recommended */
-#define node_taken_from_fault_queue(node) ((node)->atpg_info->queue_mark != \
-			     nenofex->atpg_rr->global_atpg_test_node_mark)
+#define node_taken_from_fault_queue(node) \
+  (node_atpg_info (nenofex, node)->queue_mark != \
+   nenofex->atpg_rr->global_atpg_test_node_mark)
 
 int simplify_by_global_flow_and_atpg_main (Nenofex * nenofex);
 
@@ -487,20 +748,20 @@ void free_atpg_redundancy_remover (ATPGRedundancyRemover * atpg_rr);
 
 void mark_fault_node_as_deleted (FaultNode * fault_node);
 
-void collect_assigned_node (ATPGRedundancyRemover * atpg_rr, Node * node);
+void collect_assigned_node (Nenofex * nenofex, Node * node);
 
-#define node_assigned(node) ((node)->atpg_info->assignment)
+#define node_assigned(node) (node_atpg_info (nenofex, node)->assignment)
 #define node_assigned_true(node) \
-  ((node)->atpg_info->assignment == ATPG_ASSIGNMENT_TRUE)
+  (node_atpg_info (nenofex, node)->assignment == ATPG_ASSIGNMENT_TRUE)
 #define node_assigned_false(node) \
-  ((node)->atpg_info->assignment == ATPG_ASSIGNMENT_FALSE)
+  (node_atpg_info (nenofex, node)->assignment == ATPG_ASSIGNMENT_FALSE)
 
 #define node_unassign(node) \
-  ((node)->atpg_info->assignment = ATPG_ASSIGNMENT_UNDEFINED)
+  (node_atpg_info (nenofex, node)->assignment = ATPG_ASSIGNMENT_UNDEFINED)
 #define node_assign_true(node) \
-  ((node)->atpg_info->assignment = ATPG_ASSIGNMENT_TRUE)
+  (node_atpg_info (nenofex, node)->assignment = ATPG_ASSIGNMENT_TRUE)
 #define node_assign_false(node) \
-  ((node)->atpg_info->assignment = ATPG_ASSIGNMENT_FALSE)
+  (node_atpg_info (nenofex, node)->assignment = ATPG_ASSIGNMENT_FALSE)
 
 enum ATPGFaultType
 {
@@ -532,11 +793,21 @@ enum ATPGAssignment
 
 typedef enum ATPGAssignment ATPGAssignment;
 
+/* patterns of random simulation, one bit per pattern */
+typedef unsigned long long ATPGSimWord;
+
 struct ATPGInfo
 {
   FaultNode *fault_node;
   ATPGAssignment assignment;
 
+  /* random simulation: node value, controlling children (at least two) and
+     observability at root of "changed-subformula" */
+  ATPGSimWord sim_value;
+  ATPGSimWord sim_ctrl2;
+  ATPGSimWord sim_obs;
+  unsigned int sim_detected:1;
+
   Node *watcher;
   unsigned int unassigned_ch_cnt;
   Stack *atpg_ch;
@@ -563,6 +834,10 @@ struct ATPGRedundancyRemover
   unsigned int global_flow_prop_cutoff;
   unsigned int atpg_prop_cutoff;
 
+  /* propagation limits, set with respect to subgraph size */
+  unsigned int atpg_prop_limit;
+  unsigned int global_flow_prop_limit;
+
   unsigned int restricted_clean_up;
 
   unsigned int global_flow_fwd_prop_cnt;
@@ -583,8 +858,21 @@ struct ATPGRedundancyRemover
     unsigned int bwd_prop_cnt;
     unsigned int fault_cnt;
     unsigned int red_fault_cnt;
+    unsigned int sim_detected_fault_cnt;
     unsigned int derived_implications_cnt;
   } stats;
+  /* advanced in each round of random simulation */
+  ATPGSimWord sim_seed;
+
+  /* adaptive propagation budget, kept across calls of optimizations */
+  struct
+  {
+    double scale;               /* applied to size-based limit */
+    double yield;               /* deleted nodes per 1000 props., averaged */
+    double time;                /* thread CPU time spent in optimizations */
+    double call_start_time;
+    int call_start_deleted;
+  } budget;
 
   ATPGInfo *atpg_info_array;
   size_t byte_size_atpg_info_array;
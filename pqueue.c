@@ -0,0 +1,295 @@
+/*
+ This file is part of Nenofex.
+
+ Nenofex, an expansion-based QBF solver for negation normal form.
+ Copyright 2008, 2012, 2017 Florian Lonsing.
+
+ Nenofex is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or (at
+ your option) any later version.
+
+ Nenofex is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Nenofex.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "pqueue.h"
+#include <assert.h>
+#include <stdlib.h>
+
+
+PQueue *
+create_pqueue (MemManager *mm, unsigned int size)
+{
+  PQueue *pqueue = (PQueue *) mem_malloc (mm, sizeof (PQueue));
+  assert (pqueue);
+  size = size ? size : 1;
+  pqueue->heap = (PQueueEntry *) mem_malloc (mm, size * sizeof (PQueueEntry));
+  pqueue->elems = (void **) mem_malloc (mm, size * sizeof (void *));
+  pqueue->pos = (unsigned int *) mem_malloc (mm, size * sizeof (unsigned int));
+  assert (pqueue->heap && pqueue->elems && pqueue->pos);
+  pqueue->size = size;
+  reset_pqueue (pqueue);
+  return pqueue;
+}
+
+
+void
+delete_pqueue (MemManager *mm, PQueue * pqueue)
+{
+  mem_free (mm, pqueue->heap, pqueue->size * sizeof (PQueueEntry));
+  mem_free (mm, pqueue->elems, pqueue->size * sizeof (void *));
+  mem_free (mm, pqueue->pos, pqueue->size * sizeof (unsigned int));
+  mem_free (mm, pqueue, sizeof (PQueue));
+}
+
+
+unsigned int
+count_pqueue (PQueue * pqueue)
+{
+  return pqueue->count;
+}
+
+
+void
+reset_pqueue (PQueue * pqueue)
+{
+  pqueue->count = 0;
+  pqueue->num_slots = 0;
+  pqueue->free_slot = PQUEUE_NO_SLOT;
+}
+
+
+static void
+enlarge_pqueue (MemManager *mm, PQueue * pqueue)
+{
+  assert (pqueue->num_slots == pqueue->size);
+  assert (pqueue->free_slot == PQUEUE_NO_SLOT);
+
+  unsigned int old_size = pqueue->size, new_size = old_size * 2;
+  pqueue->heap = mem_realloc (mm, pqueue->heap,
+                              old_size * sizeof (PQueueEntry),
+                              new_size * sizeof (PQueueEntry));
+  pqueue->elems = mem_realloc (mm, pqueue->elems, old_size * sizeof (void *),
+                               new_size * sizeof (void *));
+  pqueue->pos = mem_realloc (mm, pqueue->pos, old_size * sizeof (unsigned int),
+                             new_size * sizeof (unsigned int));
+  pqueue->size = new_size;
+}
+
+
+/*
+- move entry at 'pos' towards the root while it is smaller than its parent
+- entries on the way are shifted down instead of swapped
+*/
+static void
+up_pqueue (PQueue * pqueue, unsigned int pos)
+{
+  PQueueEntry *heap = pqueue->heap;
+  PQueueEntry entry = heap[pos];
+  unsigned int start = pos;
+
+  while (pos > 0)
+    {
+      unsigned int parent = (pos - 1) / PQUEUE_ARITY;
+      if (heap[parent].score <= entry.score)
+        break;
+      heap[pos] = heap[parent];
+      pqueue->pos[heap[pos].slot] = pos;
+      pos = parent;
+    }
+
+  if (pos != start)
+    {
+      heap[pos] = entry;
+      pqueue->pos[entry.slot] = pos;
+    }
+}
+
+
+/*
+- move entry at 'pos' towards the leaves while a child is smaller
+*/
+static void
+down_pqueue (PQueue * pqueue, unsigned int pos)
+{
+  PQueueEntry *heap = pqueue->heap;
+  PQueueEntry entry = heap[pos];
+  unsigned int count = pqueue->count, start = pos;
+
+  for (;;)
+    {
+      unsigned int child = PQUEUE_ARITY * pos + 1;
+      if (child >= count)
+        break;
+
+      unsigned int min_child = child, end = child + PQUEUE_ARITY;
+      if (end > count)
+        end = count;
+      for (child++; child < end; child++)
+        if (heap[child].score < heap[min_child].score)
+          min_child = child;
+
+      if (heap[min_child].score >= entry.score)
+        break;
+      heap[pos] = heap[min_child];
+      pqueue->pos[heap[pos].slot] = pos;
+      pos = min_child;
+    }
+
+  if (pos != start)
+    {
+      heap[pos] = entry;
+      pqueue->pos[entry.slot] = pos;
+    }
+}
+
+
+/*
+- add 'elem' as last entry without restoring the heap condition,
+  which is done by 'heapify_pqueue' after a series of additions
+- returns slot of 'elem'
+*/
+unsigned int
+append_pqueue (MemManager *mm, PQueue * pqueue, void *elem, int score)
+{
+  unsigned int slot = pqueue->free_slot;
+
+  if (slot != PQUEUE_NO_SLOT)
+    pqueue->free_slot = pqueue->pos[slot];
+  else
+    {
+      if (pqueue->num_slots == pqueue->size)
+        enlarge_pqueue (mm, pqueue);
+      slot = pqueue->num_slots++;
+    }
+
+  unsigned int pos = pqueue->count++;
+  pqueue->heap[pos].score = score;
+  pqueue->heap[pos].slot = slot;
+  pqueue->elems[slot] = elem;
+  pqueue->pos[slot] = pos;
+
+  return slot;
+}
+
+
+unsigned int
+insert_pqueue (MemManager *mm, PQueue * pqueue, void *elem, int score)
+{
+  unsigned int slot = append_pqueue (mm, pqueue, elem, score);
+  up_pqueue (pqueue, pqueue->pos[slot]);
+  return slot;
+}
+
+
+/*
+- establish heap condition bottom-up in linear time
+*/
+void
+heapify_pqueue (PQueue * pqueue)
+{
+  if (pqueue->count < 2)
+    return;
+
+  /* start at parent of last entry */
+  unsigned int pos = (pqueue->count - 2) / PQUEUE_ARITY + 1;
+
+  while (pos-- > 0)
+    down_pqueue (pqueue, pos);
+}
+
+
+void *
+access_min_pqueue (PQueue * pqueue)
+{
+  if (!pqueue->count)
+    return 0;
+  else
+    return pqueue->elems[pqueue->heap[0].slot];
+}
+
+
+void *
+remove_pqueue (PQueue * pqueue, unsigned int slot)
+{
+  assert (slot < pqueue->num_slots);
+
+  unsigned int pos = pqueue->pos[slot];
+  void *elem = pqueue->elems[slot];
+  assert (pos < pqueue->count);
+  assert (pqueue->heap[pos].slot == slot);
+
+  pqueue->elems[slot] = 0;
+  pqueue->pos[slot] = pqueue->free_slot;
+  pqueue->free_slot = slot;
+
+  pqueue->count--;
+  if (pos < pqueue->count)
+    {
+      int score = pqueue->heap[pos].score;
+      pqueue->heap[pos] = pqueue->heap[pqueue->count];
+      pqueue->pos[pqueue->heap[pos].slot] = pos;
+      if (pqueue->heap[pos].score < score)
+        up_pqueue (pqueue, pos);
+      else
+        down_pqueue (pqueue, pos);
+    }
+
+  return elem;
+}
+
+
+void *
+remove_min_pqueue (PQueue * pqueue)
+{
+  if (!pqueue->count)
+    return 0;
+  else
+    return remove_pqueue (pqueue, pqueue->heap[0].slot);
+}
+
+
+/*
+- set score of element in 'slot' and restore heap condition
+- returns -1, 0 or 1 if score has decreased, not changed or increased
+*/
+int
+update_key_pqueue (PQueue * pqueue, unsigned int slot, int score)
+{
+  assert (slot < pqueue->num_slots);
+
+  unsigned int pos = pqueue->pos[slot];
+  assert (pos < pqueue->count);
+  assert (pqueue->heap[pos].slot == slot);
+
+  int old_score = pqueue->heap[pos].score;
+  pqueue->heap[pos].score = score;
+
+  if (score < old_score)
+    {
+      up_pqueue (pqueue, pos);
+      return -1;
+    }
+  else if (score > old_score)
+    {
+      down_pqueue (pqueue, pos);
+      return 1;
+    }
+  else
+    return 0;
+}
+
+
+int
+score_pqueue (PQueue * pqueue, unsigned int slot)
+{
+  assert (slot < pqueue->num_slots);
+  assert (pqueue->pos[slot] < pqueue->count);
+  return pqueue->heap[pqueue->pos[slot]].score;
+}
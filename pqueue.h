@@ -0,0 +1,82 @@
+/*
+ This file is part of Nenofex.
+
+ Nenofex, an expansion-based QBF solver for negation normal form.
+ Copyright 2008, 2012, 2017 Florian Lonsing.
+
+ Nenofex is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or (at
+ your option) any later version.
+
+ Nenofex is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Nenofex.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _PQUEUE_H_
+#define _PQUEUE_H_
+
+#include "mem.h"
+
+/*
+- min-priority queue as 4-ary heap of (score, slot) pairs: sifting compares
+  and moves entries within one array and never touches the elements
+- an element is known by its slot which does not change while the element
+  is in the queue; slots of removed elements are reused
+*/
+
+#define PQUEUE_ARITY 4
+#define PQUEUE_NO_SLOT ((unsigned int) -1)
+
+typedef struct PQueueEntry PQueueEntry;
+
+struct PQueueEntry
+{
+  int score;
+  unsigned int slot;
+};
+
+typedef struct PQueue PQueue;
+
+struct PQueue
+{
+  PQueueEntry *heap;
+  unsigned int count;
+  unsigned int size;
+  /* element and heap position by slot, free slots are linked via 'pos' */
+  void **elems;
+  unsigned int *pos;
+  unsigned int num_slots;
+  unsigned int free_slot;
+};
+
+PQueue *create_pqueue (MemManager *, unsigned int size);
+
+void delete_pqueue (MemManager *, PQueue *);
+
+unsigned int insert_pqueue (MemManager *, PQueue *, void *elem, int score);
+
+unsigned int append_pqueue (MemManager *, PQueue *, void *elem, int score);
+
+void heapify_pqueue (PQueue *);
+
+void *access_min_pqueue (PQueue *);
+
+void *remove_min_pqueue (PQueue *);
+
+void *remove_pqueue (PQueue *, unsigned int slot);
+
+int update_key_pqueue (PQueue *, unsigned int slot, int score);
+
+int score_pqueue (PQueue *, unsigned int slot);
+
+unsigned int count_pqueue (PQueue *);
+
+void reset_pqueue (PQueue *);
+
+#endif /* _PQUEUE_H_ */
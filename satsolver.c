@@ -0,0 +1,251 @@
+/*
+ This file is part of Nenofex.
+
+ Nenofex, an expansion-based QBF solver for negation normal form.        
+ Copyright 2008, 2012, 2017 Florian Lonsing.
+
+ Nenofex is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or (at
+ your option) any later version.
+
+ Nenofex is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Nenofex.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "../picosat/picosat.h"
+#include "satsolver.h"
+
+
+/* ------- START: PICOSAT ------- */
+
+static void *
+picosat_backend_init (void)
+{
+  return picosat_init ();
+}
+
+
+static void
+picosat_backend_set_verbosity (void *solver, int verbosity)
+{
+  picosat_set_verbosity (solver, verbosity);
+}
+
+
+static void
+picosat_backend_add (void *solver, int lit)
+{
+  picosat_add (solver, lit);
+}
+
+
+static int
+picosat_backend_sat (void *solver, int decision_limit)
+{
+  return picosat_sat (solver, decision_limit);
+}
+
+
+/*
+- PicoSAT is called with decision limits instead, 
+  see 'run_sat_solver' in 'nenofex.c'
+*/
+static void
+picosat_backend_set_terminate (void *solver, void *state,
+                               int (*terminate) (void *state))
+{
+  (void) solver;
+  (void) state;
+  (void) terminate;
+}
+
+
+static int
+picosat_backend_deref (void *solver, int lit)
+{
+  return picosat_deref (solver, lit);
+}
+
+
+static unsigned long long
+picosat_backend_decisions (void *solver)
+{
+  return picosat_decisions (solver);
+}
+
+
+static void
+picosat_backend_reset (void *solver)
+{
+  picosat_reset (solver);
+}
+
+
+static const SATSolverBackend picosat_backend = {
+  "picosat",
+  picosat_backend_init,
+  picosat_backend_set_verbosity,
+  picosat_backend_add,
+  picosat_backend_sat,
+  picosat_backend_set_terminate,
+  picosat_backend_deref,
+  picosat_backend_decisions,
+  picosat_backend_reset
+};
+
+/* ------- END: PICOSAT ------- */
+
+
+#ifdef NENOFEX_IPASIR
+
+/* ------- START: IPASIR ------- */
+
+/*
+- any solver implementing the IPASIR interface can be linked in, 
+  see makefile
+- IPASIR has no decision limit and does not report decisions: 
+  limits are ignored and '0' decisions are reported
+- time limits interrupt solving via 'ipasir_set_terminate'
+*/
+
+const char *ipasir_signature (void);
+void *ipasir_init (void);
+void ipasir_release (void *solver);
+void ipasir_add (void *solver, int lit_or_zero);
+int ipasir_solve (void *solver);
+int ipasir_val (void *solver, int lit);
+void ipasir_set_terminate (void *solver, void *state,
+                           int (*terminate) (void *state));
+
+
+static void *
+ipasir_backend_init (void)
+{
+  return ipasir_init ();
+}
+
+
+static void
+ipasir_backend_set_verbosity (void *solver, int verbosity)
+{
+  (void) solver;
+  if (verbosity)
+    fprintf (stderr, "c IPASIR solver: %s\n", ipasir_signature ());
+}
+
+
+static void
+ipasir_backend_add (void *solver, int lit)
+{
+  ipasir_add (solver, lit);
+}
+
+
+static int
+ipasir_backend_sat (void *solver, int decision_limit)
+{
+  (void) decision_limit;
+  int res = ipasir_solve (solver);
+  /* '0' if interrupted by terminate callback */
+  if (res != SAT_SOLVER_RESULT_SATISFIABLE
+      && res != SAT_SOLVER_RESULT_UNSATISFIABLE)
+    return SAT_SOLVER_RESULT_UNKNOWN;
+  return res;
+}
+
+
+static void
+ipasir_backend_set_terminate (void *solver, void *state,
+                              int (*terminate) (void *state))
+{
+  ipasir_set_terminate (solver, state, terminate);
+}
+
+
+static int
+ipasir_backend_deref (void *solver, int lit)
+{
+  int val = ipasir_val (solver, lit);
+  if (val == lit)
+    return 1;
+  if (val == -lit)
+    return -1;
+  return 0;
+}
+
+
+static unsigned long long
+ipasir_backend_decisions (void *solver)
+{
+  (void) solver;
+  return 0;
+}
+
+
+static void
+ipasir_backend_reset (void *solver)
+{
+  ipasir_release (solver);
+}
+
+
+static const SATSolverBackend ipasir_backend = {
+  "ipasir",
+  ipasir_backend_init,
+  ipasir_backend_set_verbosity,
+  ipasir_backend_add,
+  ipasir_backend_sat,
+  ipasir_backend_set_terminate,
+  ipasir_backend_deref,
+  ipasir_backend_decisions,
+  ipasir_backend_reset
+};
+
+/* ------- END: IPASIR ------- */
+
+#endif /* NENOFEX_IPASIR */
+
+
+static const SATSolverBackend *const backends[] = {
+  &picosat_backend,
+#ifdef NENOFEX_IPASIR
+  &ipasir_backend,
+#endif
+  0
+};
+
+
+const SATSolverBackend *
+default_sat_solver_backend (void)
+{
+  return backends[0];
+}
+
+
+const SATSolverBackend *
+find_sat_solver_backend (const char *name)
+{
+  const SATSolverBackend *const *b;
+  for (b = backends; *b; b++)
+    if (!strcmp ((*b)->name, name))
+      return *b;
+  return 0;
+}
+
+
+void
+print_sat_solver_backends (FILE * out)
+{
+  const SATSolverBackend *const *b;
+  for (b = backends; *b; b++)
+    fprintf (out, "%s%s", b == backends ? "" : " ", (*b)->name);
+}
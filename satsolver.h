@@ -0,0 +1,67 @@
+/*
+ This file is part of Nenofex.
+
+ Nenofex, an expansion-based QBF solver for negation normal form.        
+ Copyright 2008, 2012, 2017 Florian Lonsing.
+
+ Nenofex is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or (at
+ your option) any later version.
+
+ Nenofex is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with Nenofex.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _SATSOLVER_H_
+#define _SATSOLVER_H_
+
+#include <stdio.h>
+
+/*
+- interface to SAT solvers which decide the propositional formula left
+  after the expansion phase
+- results and literal values follow PicoSAT and IPASIR conventions
+*/
+
+#define SAT_SOLVER_RESULT_UNKNOWN 0
+#define SAT_SOLVER_RESULT_SATISFIABLE 10
+#define SAT_SOLVER_RESULT_UNSATISFIABLE 20
+
+typedef struct SATSolverBackend SATSolverBackend;
+
+struct SATSolverBackend
+{
+  const char *name;
+  /* create solver instance */
+  void *(*init) (void);
+  void (*set_verbosity) (void *solver, int verbosity);
+  /* add literal of current clause, '0' terminates clause */
+  void (*add) (void *solver, int lit);
+  /* negative decision limit means no limit */
+  int (*sat) (void *solver, int decision_limit);
+  /* 'sat' returns unknown once 'terminate (state)' returns non-zero */
+  void (*set_terminate) (void *solver, void *state,
+                         int (*terminate) (void *state));
+  /* '1' if 'lit' is true, '-1' if false, '0' if unassigned */
+  int (*deref) (void *solver, int lit);
+  unsigned long long (*decisions) (void *solver);
+  /* delete solver instance */
+  void (*reset) (void *solver);
+};
+
+/* PicoSAT is the default backend */
+const SATSolverBackend *default_sat_solver_backend (void);
+
+/* returns NULL if there is no backend called 'name' */
+const SATSolverBackend *find_sat_solver_backend (const char *name);
+
+/* prints names of available backends, separated by blanks */
+void print_sat_solver_backends (FILE * out);
+
+#endif /* _SATSOLVER_H_ */
@@ -0,0 +1,241 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "../nenofex.h"
+
+/*
+  Solve random formulas incrementally: after each call of 'nenofex_solve'
+  a few clauses are added and the formula is solved again, once plainly and
+  once under assumptions on an existential and a universal variable. Each
+  result must match a fresh solver object given all clauses so far, with
+  assumptions substituted. Both solvers expand fully, so the results are
+  exact.
+  Solving the same formula again must not use more memory, also if the
+  graph is left over after a single expansion.
+*/
+
+#define NUM_FORMULAS 100
+#define NUM_VARS 18
+#define NUM_BASE_CLAUSES 12
+#define NUM_ROUNDS 6
+#define CLAUSES_PER_ROUND 3
+#define MAX_CLAUSES (NUM_BASE_CLAUSES + NUM_ROUNDS * CLAUSES_PER_ROUND + 2)
+#define NUM_SCOPES 3
+
+typedef struct Clauses Clauses;
+
+struct Clauses
+{
+  void *lits[MAX_CLAUSES][5];
+  unsigned int len[MAX_CLAUSES];
+  unsigned int cnt;
+};
+
+static unsigned int
+next_rand (unsigned int *seed)
+{
+  *seed = *seed * 1103515245 + 12345;
+  return (*seed >> 16) & 0x7fff;
+}
+
+static int
+is_universal (long int var)
+{
+  return ((var - 1) * NUM_SCOPES / NUM_VARS) % 2;
+}
+
+static void
+add_prefix (Nenofex * nenofex, unsigned int num_clauses)
+{
+  void *lits[NUM_VARS];
+  long int v;
+  int i;
+
+  nenofex_set_up_preamble (nenofex, NUM_VARS, num_clauses);
+  for (i = 0; i < NUM_SCOPES; i++)
+    {
+      int cnt = 0;
+      for (v = i * NUM_VARS / NUM_SCOPES + 1;
+           v <= (i + 1) * NUM_VARS / NUM_SCOPES; v++)
+        lits[cnt++] = (void *) v;
+      nenofex_add_orig_scope (nenofex, lits, cnt,
+                              i % 2 ? SCOPE_TYPE_UNIVERSAL :
+                              SCOPE_TYPE_EXISTENTIAL);
+    }
+}
+
+static void
+random_clause (Clauses * clauses, unsigned int *seed)
+{
+  unsigned int j, len = 3 + next_rand (seed) % 3;
+  for (j = 0; j < len; j++)
+    {
+      long int v = 1 + next_rand (seed) % NUM_VARS;
+      clauses->lits[clauses->cnt][j] = (void *) (next_rand (seed) % 2 ? v : -v);
+    }
+  clauses->len[clauses->cnt++] = len;
+}
+
+static NenofexResult
+solve_fresh (Clauses * clauses, void **assumptions,
+             unsigned int num_assumptions)
+{
+  Nenofex *nenofex = nenofex_create ();
+  void *lits[MAX_CLAUSES][5];
+  unsigned int len[MAX_CLAUSES];
+  unsigned int cnt = 0;
+  unsigned int i, j, k;
+
+  /* substitute assumptions, conflicting ones make the formula false */
+  for (i = 0; i < clauses->cnt; i++)
+    {
+      int satisfied = 0;
+      len[cnt] = 0;
+      for (j = 0; j < clauses->len[i]; j++)
+        {
+          void *lit = clauses->lits[i][j];
+          for (k = 0; k < num_assumptions; k++)
+            if (assumptions[k] == lit)
+              satisfied = 1;
+            else if ((long int) assumptions[k] == -(long int) lit)
+              break;
+          if (k == num_assumptions)
+            lits[cnt][len[cnt]++] = lit;
+        }
+      if (!satisfied)
+        cnt++;
+    }
+  for (k = 1; k < num_assumptions; k++)
+    if ((long int) assumptions[k] == -(long int) assumptions[0])
+      len[cnt++] = 0;
+
+  nenofex_configure (nenofex, "--full-expansion");
+  add_prefix (nenofex, cnt);
+  for (i = 0; i < cnt; i++)
+    nenofex_add_orig_clause (nenofex, lits[i], len[i]);
+
+  NenofexResult res = nenofex_solve (nenofex);
+  nenofex_delete (nenofex);
+  return res;
+}
+
+static void
+check (unsigned int formula, unsigned int round, NenofexResult res,
+       NenofexResult expected)
+{
+  if (res != expected)
+    {
+      fprintf (stderr, "formula %u, round %u: result %d, expected %d\n",
+               formula, round, res, expected);
+      abort ();
+    }
+}
+
+static void
+solve_formula (unsigned int formula)
+{
+  Nenofex *nenofex = nenofex_create ();
+  Clauses clauses;
+  unsigned int seed = formula + 1;
+  unsigned int i, round;
+
+  clauses.cnt = 0;
+  for (i = 0; i < NUM_BASE_CLAUSES; i++)
+    random_clause (&clauses, &seed);
+
+  nenofex_configure (nenofex, "--incremental");
+  nenofex_configure (nenofex, "--full-expansion");
+  add_prefix (nenofex, clauses.cnt);
+  for (i = 0; i < clauses.cnt; i++)
+    nenofex_add_orig_clause (nenofex, clauses.lits[i], clauses.len[i]);
+
+  check (formula, 0, nenofex_solve (nenofex), solve_fresh (&clauses, 0, 0));
+
+  for (round = 1; round <= NUM_ROUNDS; round++)
+    {
+      for (i = 0; i < CLAUSES_PER_ROUND; i++)
+        {
+          random_clause (&clauses, &seed);
+          nenofex_add_orig_clause (nenofex, clauses.lits[clauses.cnt - 1],
+                                   clauses.len[clauses.cnt - 1]);
+        }
+      check (formula, round, nenofex_solve (nenofex),
+             solve_fresh (&clauses, 0, 0));
+
+      /* existential and universal assumption, for the next call only */
+      void *assumptions[2];
+      for (i = 0; i < 2;)
+        {
+          long int v = 1 + next_rand (&seed) % NUM_VARS;
+          if (is_universal (v) == (int) i)
+            assumptions[i++] = (void *) (next_rand (&seed) % 2 ? v : -v);
+        }
+      nenofex_assume (nenofex, assumptions, 2);
+      check (formula, round, nenofex_solve (nenofex),
+             solve_fresh (&clauses, assumptions, 2));
+    }
+
+  /* conflicting assumptions */
+  void *conflict[2] = { (void *) 1, (void *) -1 };
+  nenofex_assume (nenofex, conflict, 2);
+  check (formula, round, nenofex_solve (nenofex), NENOFEX_RESULT_UNSAT);
+
+  /* assumptions are gone, empty clause added */
+  check (formula, round, nenofex_solve (nenofex),
+         solve_fresh (&clauses, 0, 0));
+  nenofex_add_orig_clause (nenofex, 0, 0);
+  check (formula, round, nenofex_solve (nenofex), NENOFEX_RESULT_UNSAT);
+
+  nenofex_delete (nenofex);
+}
+
+static void
+check_memory (unsigned int formula)
+{
+  Nenofex *nenofex = nenofex_create ();
+  Clauses clauses;
+  unsigned int seed = formula + 1;
+  unsigned int i;
+  unsigned long long bytes = 0;
+
+  clauses.cnt = 0;
+  for (i = 0; i < NUM_BASE_CLAUSES; i++)
+    random_clause (&clauses, &seed);
+
+  nenofex_configure (nenofex, "--incremental");
+  nenofex_configure (nenofex, "-n=1");
+  nenofex_configure (nenofex, "--no-sat-solving");
+  add_prefix (nenofex, clauses.cnt);
+  for (i = 0; i < clauses.cnt; i++)
+    nenofex_add_orig_clause (nenofex, clauses.lits[i], clauses.len[i]);
+
+  for (i = 0; i < NUM_ROUNDS; i++)
+    {
+      NenofexStats stats;
+      nenofex_solve (nenofex);
+      nenofex_get_stats (nenofex, &stats);
+      if (i && stats.cur_bytes != bytes)
+        {
+          fprintf (stderr, "formula %u: %llu bytes after solving, was %llu\n",
+                   formula, stats.cur_bytes, bytes);
+          abort ();
+        }
+      bytes = stats.cur_bytes;
+    }
+
+  nenofex_delete (nenofex);
+}
+
+int
+main (int argc, char **argv)
+{
+  unsigned int i;
+
+  for (i = 0; i < NUM_FORMULAS; i++)
+    {
+      solve_formula (i);
+      check_memory (i);
+    }
+
+  return 0;
+}
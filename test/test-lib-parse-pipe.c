@@ -0,0 +1,21 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "../nenofex.h"
+
+/* Input which cannot be mapped into memory is read block-wise. */
+
+int main (int argc, char ** argv)
+{
+  Nenofex *nenofex = nenofex_create ();
+
+  FILE *input_file = popen ("cat ./test-lib-parse-easy-unsat.qdimacs", "r");
+
+  nenofex_parse (nenofex, input_file);
+  NenofexResult res = nenofex_solve (nenofex);
+  assert (res == NENOFEX_RESULT_UNSAT);
+
+  pclose (input_file);
+  nenofex_delete (nenofex);
+  return 0;
+}
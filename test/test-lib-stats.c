@@ -0,0 +1,139 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "../nenofex.h"
+
+/*
+  Solve random formulas at each statistics level and check the counters
+  returned by 'nenofex_get_stats': results must not depend on the level,
+  counters of a level must be zero below that level and the counters
+  collected at any level must be the same for all levels.
+*/
+
+#define NUM_FORMULAS 100
+#define NUM_VARS 18
+#define NUM_CLAUSES 30
+#define NUM_SCOPES 3
+
+static char *levels[] = { "--stats=off", "--stats=basic", "--stats=full" };
+
+static unsigned int
+next_rand (unsigned int *seed)
+{
+  *seed = *seed * 1103515245 + 12345;
+  return (*seed >> 16) & 0x7fff;
+}
+
+static NenofexResult
+solve_formula (unsigned int formula, char *level, NenofexStats * stats)
+{
+  Nenofex *nenofex = nenofex_create ();
+  void **lits = calloc (NUM_VARS, sizeof (void *));
+  unsigned int seed = formula + 1;
+  long int v;
+  int i, j;
+
+  if (level)
+    nenofex_configure (nenofex, level);
+  nenofex_set_up_preamble (nenofex, NUM_VARS, NUM_CLAUSES);
+
+  for (i = 0; i < NUM_SCOPES; i++)
+    {
+      int cnt = 0;
+      for (v = i * NUM_VARS / NUM_SCOPES + 1;
+           v <= (i + 1) * NUM_VARS / NUM_SCOPES; v++)
+        lits[cnt++] = (void *) v;
+      nenofex_add_orig_scope (nenofex, lits, cnt,
+                              i % 2 ? SCOPE_TYPE_UNIVERSAL :
+                              SCOPE_TYPE_EXISTENTIAL);
+    }
+
+  for (i = 0; i < NUM_CLAUSES; i++)
+    {
+      int len = 3 + next_rand (&seed) % 3;
+      for (j = 0; j < len; j++)
+        {
+          v = 1 + next_rand (&seed) % NUM_VARS;
+          lits[j] = (void *) (next_rand (&seed) % 2 ? v : -v);
+        }
+      nenofex_add_orig_clause (nenofex, lits, len);
+    }
+
+  NenofexResult res = nenofex_solve (nenofex);
+  nenofex_get_stats (nenofex, stats);
+
+  nenofex_delete (nenofex);
+  free (lits);
+  return res;
+}
+
+int
+main (int argc, char **argv)
+{
+  unsigned long long created_nodes = 0, lca_algo_calls = 0;
+  unsigned int i, level;
+
+  for (i = 0; i < NUM_FORMULAS; i++)
+    {
+      NenofexStats def, stats[3];
+      NenofexResult res = solve_formula (i, 0, &def);
+      assert (res != NENOFEX_RESULT_UNKNOWN);
+      assert (def.level == NENOFEX_STATS_BASIC);
+
+      for (level = NENOFEX_STATS_OFF; level <= NENOFEX_STATS_FULL; level++)
+        {
+          NenofexStats *s = stats + level;
+          if (solve_formula (i, levels[level], s) != res)
+            {
+              fprintf (stderr, "formula %u: result differs with '%s'\n",
+                       i, levels[level]);
+              abort ();
+            }
+          assert (s->level == level);
+
+          /* same search at all levels */
+          assert (s->expansions == def.expansions);
+          assert (s->optimizations_called == def.optimizations_called);
+          assert (s->optimizations_succeeded ==
+                  def.optimizations_succeeded);
+          assert (s->sat_solver_decisions == def.sat_solver_decisions);
+
+          if (level == NENOFEX_STATS_OFF)
+            {
+              assert (!s->phase_calls[NENOFEX_PHASE_SOLVE]);
+              assert (!s->created_nodes && !s->deleted_nodes);
+              assert (!s->deleted_nodes_by_optimizations);
+              assert (!s->atpg_tested_faults && !s->opt_propagations);
+            }
+          else
+            {
+              assert (s->phase_calls[NENOFEX_PHASE_SOLVE] == 1);
+              assert (s->created_nodes == def.created_nodes);
+              assert (s->deleted_nodes == def.deleted_nodes);
+              assert (s->deleted_nodes_by_optimizations <= s->deleted_nodes);
+              assert (s->max_tree_size == def.max_tree_size);
+              assert (s->atpg_tested_faults == def.atpg_tested_faults);
+              assert (s->atpg_redundant_faults <= s->atpg_tested_faults);
+              assert (s->opt_propagations == def.opt_propagations);
+              assert (s->exp_case_e_or_all + s->exp_case_e_or_subset +
+                      s->exp_case_e_and_all + s->exp_case_e_and_subset +
+                      s->exp_case_a_or_all + s->exp_case_a_or_subset +
+                      s->exp_case_a_and_all + s->exp_case_a_and_subset ==
+                      s->expansions);
+            }
+
+          if (level != NENOFEX_STATS_FULL)
+            assert (!s->lca_algo_calls && !s->size_update_visits &&
+                    !s->lca_parent_visits && !s->lca_jump_updates &&
+                    !s->lca_jump_invalidations);
+        }
+
+      created_nodes += def.created_nodes;
+      lca_algo_calls += stats[NENOFEX_STATS_FULL].lca_algo_calls;
+    }
+
+  assert (created_nodes);
+  assert (lca_algo_calls);
+
+  return 0;
+}
@@ -0,0 +1,113 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <pthread.h>
+#include "../nenofex.h"
+
+/*
+  Solve the same set of random formulas sequentially and then concurrently
+  in several threads, each thread using its own solver instances. Results
+  must not depend on other solver instances running at the same time.
+*/
+
+#define NUM_THREADS 8
+#define NUM_FORMULAS 200
+#define NUM_VARS 18
+#define NUM_CLAUSES 30
+#define NUM_SCOPES 3
+
+static NenofexResult expected[NUM_FORMULAS];
+
+static unsigned int
+next_rand (unsigned int *seed)
+{
+  *seed = *seed * 1103515245 + 12345;
+  return (*seed >> 16) & 0x7fff;
+}
+
+static NenofexResult
+solve_formula (unsigned int formula)
+{
+  Nenofex *nenofex = nenofex_create ();
+  void **lits = calloc (NUM_VARS, sizeof (void *));
+  unsigned int seed = formula + 1;
+  long int v;
+  int i, j;
+
+  nenofex_set_up_preamble (nenofex, NUM_VARS, NUM_CLAUSES);
+
+  /* quantify variables in blocks of consecutive variables */
+  for (i = 0; i < NUM_SCOPES; i++)
+    {
+      int cnt = 0;
+      for (v = i * NUM_VARS / NUM_SCOPES + 1;
+           v <= (i + 1) * NUM_VARS / NUM_SCOPES; v++)
+        lits[cnt++] = (void *) v;
+      nenofex_add_orig_scope (nenofex, lits, cnt,
+                              i % 2 ? SCOPE_TYPE_UNIVERSAL :
+                              SCOPE_TYPE_EXISTENTIAL);
+    }
+
+  for (i = 0; i < NUM_CLAUSES; i++)
+    {
+      int len = 3 + next_rand (&seed) % 3;
+      for (j = 0; j < len; j++)
+        {
+          v = 1 + next_rand (&seed) % NUM_VARS;
+          lits[j] = (void *) (next_rand (&seed) % 2 ? v : -v);
+        }
+      nenofex_add_orig_clause (nenofex, lits, len);
+    }
+
+  NenofexResult res = nenofex_solve (nenofex);
+
+  nenofex_delete (nenofex);
+  free (lits);
+  return res;
+}
+
+static void *
+solve_all (void *arg)
+{
+  unsigned int offset = *((unsigned int *) arg);
+  unsigned int i;
+
+  for (i = 0; i < NUM_FORMULAS; i++)
+    {
+      unsigned int formula = (i + offset) % NUM_FORMULAS;
+      NenofexResult res = solve_formula (formula);
+      if (res != expected[formula])
+        {
+          fprintf (stderr, "formula %u: result %d, expected %d\n",
+                   formula, res, expected[formula]);
+          abort ();
+        }
+    }
+
+  return 0;
+}
+
+int main (int argc, char ** argv)
+{
+  pthread_t threads[NUM_THREADS];
+  unsigned int offsets[NUM_THREADS];
+  unsigned int i;
+
+  for (i = 0; i < NUM_FORMULAS; i++)
+    {
+      expected[i] = solve_formula (i);
+      assert (expected[i] != NENOFEX_RESULT_UNKNOWN);
+    }
+
+  /* threads start at different formulas */
+  for (i = 0; i < NUM_THREADS; i++)
+    {
+      offsets[i] = i * NUM_FORMULAS / NUM_THREADS;
+      pthread_create (threads + i, 0, solve_all, offsets + i);
+    }
+
+  for (i = 0; i < NUM_THREADS; i++)
+    pthread_join (threads[i], 0);
+
+  return 0;
+}